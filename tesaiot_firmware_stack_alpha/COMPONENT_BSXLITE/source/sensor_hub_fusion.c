@@ -145,6 +145,31 @@ static float lsb_to_rps(int16_t val, float dps, uint8_t bit_width)
   return ((DEG_TO_RAD) * ((dps) / (half_scale)) * (val));
 }
 
+/*******************************************************************************
+ * Function Name: sensor_hub_fusion_publish_sample
+ *******************************************************************************
+ * Summary:
+ * Publishes the latest fusion sample to the IPC blackboard, where CM55 reads
+ * it as the IPC_BLACKBOARD_ORIENTATION slot.
+ *
+ *******************************************************************************/
+static void sensor_hub_fusion_publish_sample(void)
+{
+  ipc_orientation_t orientation;
+
+  orientation.qw = s_fusion_sample.qw;
+  orientation.qx = s_fusion_sample.qx;
+  orientation.qy = s_fusion_sample.qy;
+  orientation.qz = s_fusion_sample.qz;
+  orientation.ax = s_fusion_sample.ax;
+  orientation.ay = s_fusion_sample.ay;
+  orientation.az = s_fusion_sample.az;
+  orientation.gx = s_fusion_sample.gx;
+  orientation.gy = s_fusion_sample.gy;
+  orientation.gz = s_fusion_sample.gz;
+  (void)cm33_ipc_publish(IPC_BLACKBOARD_ORIENTATION, &orientation, sizeof(orientation));
+}
+
 static void i2c_scan_bus(CySCB_Type *base, cy_stc_scb_i2c_context_t *context, const char *name)
 {
   uint32_t found = 0U;
@@ -584,6 +609,7 @@ static void sensor_hub_fusion_task(void *pvParameters)
         s_fusion_sample.qx = bsxlite_fusion_out.rotation_vector.x;
         s_fusion_sample.qy = bsxlite_fusion_out.rotation_vector.y;
         s_fusion_sample.qz = bsxlite_fusion_out.rotation_vector.z;
+        sensor_hub_fusion_publish_sample();
         if (true == s_stream_enabled)
         {
           if (true == s_fusion_enabled)
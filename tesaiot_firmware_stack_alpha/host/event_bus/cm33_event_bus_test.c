@@ -0,0 +1,285 @@
+/*******************************************************************************
+ * File Name        : cm33_event_bus_test.c
+ *
+ * Description      : Checks of the CM33 event_bus on the host port: payload
+ *                    copies of asynchronous subscribers (short ISR and sized
+ *                    publishes must not be read past their size), their
+ *                    overflow policies, the ISR worker's drop counter, and
+ *                    event_bus_destroy() while the ISR worker is inside a
+ *                    publish. Prints one line per check and exits non-zero
+ *                    if any fails. Build with CFLAGS+=-fsanitize=address to
+ *                    also catch over-reads.
+ *
+ * Author           : Asst.Prof.Santi Nuratch, Ph.D
+ *                    Thailand Embedded Systems Association (TESA)
+ *
+ *******************************************************************************/
+
+#include "event_bus.h"
+#include "semphr.h"
+#include "sim_port.h"
+#include "task.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define TEST_EVENT_IDS (4U)
+#define TEST_EVENT_ID (1U)
+#define TEST_QUEUE_LENGTH (2U)
+#define TEST_STACK_WORDS (1024U)
+#define TEST_PRIORITY (2U)
+#define TEST_WAIT_MS (1000U)  /* Longest a check waits for a worker */
+#define TEST_HOLD_MS (20U)    /* How long a blocked destroy must stay blocked */
+
+/*******************************************************************************
+ * Global Variables
+ *******************************************************************************/
+static uint8_t s_last[EVENT_BUS_ASYNC_DATA_MAX]; /* Payload of the last callback */
+static volatile uint32_t s_calls;
+static SemaphoreHandle_t s_entered; /* Given by gated_callback() on entry */
+static SemaphoreHandle_t s_gate;    /* Taken by gated_callback() before it returns */
+static SemaphoreHandle_t s_destroyed;
+static event_bus_t s_destroy_bus;
+
+/*******************************************************************************
+ * Function Definitions
+ *******************************************************************************/
+
+/** Copies a whole payload; only for subscribers with data_size EVENT_BUS_ASYNC_DATA_MAX. */
+static void copy_callback(uint32_t event_id, void *event_data)
+{
+  (void)event_id;
+  if (NULL != event_data)
+  {
+    (void)memcpy(s_last, event_data, sizeof(s_last));
+  }
+  s_calls++;
+}
+
+/** Records the first payload byte, then blocks until the test opens s_gate. */
+static void gated_callback(uint32_t event_id, void *event_data)
+{
+  (void)event_id;
+  s_last[0] = (NULL != event_data) ? *(const uint8_t *)event_data : 0U;
+  (void)xSemaphoreGive(s_entered);
+  (void)xSemaphoreTake(s_gate, portMAX_DELAY);
+  s_calls++;
+}
+
+static void open_gate(uint32_t count)
+{
+  for (uint32_t i = 0U; i < count; i++)
+  {
+    (void)xSemaphoreGive(s_gate);
+  }
+}
+
+/** Waits until the asynchronous subscriber has run delivered callbacks. */
+static bool wait_delivered(event_bus_t bus, event_callback_t callback, uint32_t delivered)
+{
+  event_bus_async_stats_t stats;
+
+  for (uint32_t ms = 0U; ms < TEST_WAIT_MS; ms++)
+  {
+    if (event_bus_get_async_stats(bus, TEST_EVENT_ID, callback, &stats) && (stats.delivered >= delivered))
+    {
+      return true;
+    }
+    vTaskDelay(pdMS_TO_TICKS(1U));
+  }
+  return false;
+}
+
+static bool all_zero(const uint8_t *data, size_t len)
+{
+  for (size_t i = 0U; i < len; i++)
+  {
+    if (0U != data[i])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool report(const char *name, bool ok)
+{
+  (void)printf("%-28s %s\n", name, ok ? "ok" : "FAILED");
+  return ok;
+}
+
+/**
+ * A 4-byte ISR publish to a subscriber copying 64 bytes: the 12 bytes a
+ * previous 16-byte event left in the worker's buffer must not reach it.
+ */
+static bool test_isr_short_payload(void)
+{
+  event_bus_async_config_t config = {TEST_QUEUE_LENGTH, EVENT_BUS_ASYNC_DATA_MAX, TEST_PRIORITY,
+                                     TEST_STACK_WORDS, EVENT_BUS_OVERFLOW_WAIT, portMAX_DELAY};
+  const uint8_t stale[EVENT_BUS_ISR_DATA_MAX] = {0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU,
+                                                 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU};
+  const uint8_t data[4] = {1U, 2U, 3U, 4U};
+  event_bus_t bus = event_bus_create(TEST_EVENT_IDS);
+  BaseType_t woken = pdFALSE;
+  bool ok;
+
+  ok = (NULL != bus) && event_bus_subscribe_async(bus, TEST_EVENT_ID, copy_callback, &config) &&
+       event_bus_start_isr_worker(bus, TEST_QUEUE_LENGTH, TEST_STACK_WORDS, TEST_PRIORITY) &&
+       event_bus_publish_from_isr(bus, TEST_EVENT_ID, stale, sizeof(stale), &woken) &&
+       wait_delivered(bus, copy_callback, 1U) &&
+       event_bus_publish_from_isr(bus, TEST_EVENT_ID, data, sizeof(data), &woken) &&
+       wait_delivered(bus, copy_callback, 2U);
+  ok = ok && (0 == memcmp(s_last, data, sizeof(data))) && all_zero(&s_last[sizeof(data)], sizeof(s_last) - sizeof(data));
+  event_bus_destroy(bus);
+  return report("ISR short payload", ok);
+}
+
+/** event_bus_publish_sized() copies size bytes; event_bus_publish() all data_size. */
+static bool test_sized_publish(void)
+{
+  event_bus_async_config_t config = {TEST_QUEUE_LENGTH, EVENT_BUS_ASYNC_DATA_MAX, TEST_PRIORITY,
+                                     TEST_STACK_WORDS, EVENT_BUS_OVERFLOW_WAIT, portMAX_DELAY};
+  uint8_t full[EVENT_BUS_ASYNC_DATA_MAX];
+  uint8_t small[8];
+  event_bus_t bus = event_bus_create(TEST_EVENT_IDS);
+  bool ok;
+
+  (void)memset(full, 0xA5, sizeof(full));
+  (void)memset(small, 0x5A, sizeof(small));
+  ok = (NULL != bus) && event_bus_subscribe_async(bus, TEST_EVENT_ID, copy_callback, &config) &&
+       event_bus_publish(bus, TEST_EVENT_ID, full) && wait_delivered(bus, copy_callback, 1U) &&
+       (0 == memcmp(s_last, full, sizeof(full)));
+  ok = ok && event_bus_publish_sized(bus, TEST_EVENT_ID, small, sizeof(small)) &&
+       wait_delivered(bus, copy_callback, 2U) && (0 == memcmp(s_last, small, sizeof(small))) &&
+       all_zero(&s_last[sizeof(small)], sizeof(s_last) - sizeof(small));
+  event_bus_destroy(bus);
+  return report("sized publish", ok);
+}
+
+/**
+ * Event 0 blocks the worker in its callback, then events 1 to 5 meet a queue
+ * of TEST_QUEUE_LENGTH. Checks the counters and the last event delivered.
+ */
+static bool test_overflow(event_bus_overflow_t overflow, TickType_t wait_ticks, const char *name, uint32_t queued,
+                          uint32_t dropped, uint8_t last)
+{
+  event_bus_async_config_t config = {TEST_QUEUE_LENGTH, 1U, TEST_PRIORITY, TEST_STACK_WORDS, overflow, wait_ticks};
+  event_bus_t bus = event_bus_create(TEST_EVENT_IDS);
+  event_bus_async_stats_t stats;
+  bool ok;
+
+  ok = (NULL != bus) && event_bus_subscribe_async(bus, TEST_EVENT_ID, gated_callback, &config);
+  for (uint8_t n = 0U; ok && (n <= 5U); n++)
+  {
+    ok = event_bus_publish(bus, TEST_EVENT_ID, &n);
+    if (0U == n)
+    {
+      ok = ok && (pdTRUE == xSemaphoreTake(s_entered, pdMS_TO_TICKS(TEST_WAIT_MS)));
+    }
+  }
+  ok = ok && event_bus_get_async_stats(bus, TEST_EVENT_ID, gated_callback, &stats) && (queued == stats.queued) &&
+       (dropped == stats.dropped) && (TEST_QUEUE_LENGTH == stats.high_water);
+  open_gate(TEST_QUEUE_LENGTH + 1U);
+  ok = ok && wait_delivered(bus, gated_callback, TEST_QUEUE_LENGTH + 1U) && (last == s_last[0]);
+  event_bus_destroy(bus);
+  while (pdTRUE == xSemaphoreTake(s_entered, 0U))
+  {
+  }
+  return report(name, ok);
+}
+
+/** A queue of one behind a blocked worker takes one ISR event and drops the rest. */
+static bool test_isr_dropped(void)
+{
+  event_bus_t bus = event_bus_create(TEST_EVENT_IDS);
+  BaseType_t woken = pdFALSE;
+  uint8_t n = 0U;
+  bool ok;
+
+  ok = (NULL != bus) && event_bus_subscribe(bus, TEST_EVENT_ID, gated_callback) &&
+       event_bus_start_isr_worker(bus, 1U, TEST_STACK_WORDS, TEST_PRIORITY) &&
+       event_bus_publish_from_isr(bus, TEST_EVENT_ID, &n, 1U, &woken) &&
+       (pdTRUE == xSemaphoreTake(s_entered, pdMS_TO_TICKS(TEST_WAIT_MS)));
+  ok = ok && event_bus_publish_from_isr(bus, TEST_EVENT_ID, &n, 1U, &woken);
+  ok = ok && !event_bus_publish_from_isr(bus, TEST_EVENT_ID, &n, 1U, &woken);
+  ok = ok && !event_bus_publish_from_isr(bus, TEST_EVENT_ID, &n, 1U, &woken);
+  ok = ok && (2U == event_bus_get_isr_dropped(bus));
+  open_gate(2U);
+  ok = ok && (pdTRUE == xSemaphoreTake(s_entered, pdMS_TO_TICKS(TEST_WAIT_MS)));
+  event_bus_destroy(bus);
+  return report("ISR drop counter", ok);
+}
+
+static void destroy_task(void *arg)
+{
+  (void)arg;
+  event_bus_destroy(s_destroy_bus);
+  (void)xSemaphoreGive(s_destroyed);
+  vTaskDelete(NULL);
+}
+
+/**
+ * Destroys a bus while its ISR worker is blocked inside a publish that also
+ * feeds an asynchronous subscriber: destroy must wait for that publish to
+ * finish, then return.
+ */
+static bool test_destroy_mid_publish(void)
+{
+  event_bus_async_config_t config = {TEST_QUEUE_LENGTH, EVENT_BUS_ASYNC_DATA_MAX, TEST_PRIORITY,
+                                     TEST_STACK_WORDS, EVENT_BUS_OVERFLOW_DROP_NEWEST, 0U};
+  BaseType_t woken = pdFALSE;
+  uint8_t n = 0U;
+  bool ok;
+
+  s_destroy_bus = event_bus_create(TEST_EVENT_IDS);
+  ok = (NULL != s_destroy_bus) && event_bus_subscribe(s_destroy_bus, TEST_EVENT_ID, gated_callback) &&
+       event_bus_subscribe_async(s_destroy_bus, TEST_EVENT_ID, copy_callback, &config) &&
+       event_bus_start_isr_worker(s_destroy_bus, TEST_QUEUE_LENGTH, TEST_STACK_WORDS, TEST_PRIORITY) &&
+       event_bus_publish_from_isr(s_destroy_bus, TEST_EVENT_ID, &n, 1U, &woken) &&
+       (pdTRUE == xSemaphoreTake(s_entered, pdMS_TO_TICKS(TEST_WAIT_MS)));
+  if (!ok)
+  {
+    open_gate(1U);
+    return report("destroy during ISR publish", false);
+  }
+
+  ok = (pdPASS == xTaskCreate(destroy_task, "Destroy", TEST_STACK_WORDS, NULL, TEST_PRIORITY, NULL));
+  ok = ok && (pdTRUE != xSemaphoreTake(s_destroyed, pdMS_TO_TICKS(TEST_HOLD_MS)));
+  open_gate(1U);
+  ok = ok && (pdTRUE == xSemaphoreTake(s_destroyed, pdMS_TO_TICKS(TEST_WAIT_MS)));
+  return report("destroy during ISR publish", ok);
+}
+
+int main(void)
+{
+  bool ok = true;
+
+  sim_port_set_core(SIM_CORE_CM33);
+  s_entered = xSemaphoreCreateCounting(16U, 0U);
+  s_gate = xSemaphoreCreateCounting(16U, 0U);
+  s_destroyed = xSemaphoreCreateBinary();
+  if ((NULL == s_entered) || (NULL == s_gate) || (NULL == s_destroyed))
+  {
+    return EXIT_FAILURE;
+  }
+
+  ok = test_isr_short_payload() && ok;
+  ok = test_sized_publish() && ok;
+  /* Event 0 is in the callback; DROP_NEWEST and WAIT (timing out) keep 1 and 2, DROP_OLDEST 4 and 5 */
+  ok = test_overflow(EVENT_BUS_OVERFLOW_DROP_NEWEST, 0U, "overflow DROP_NEWEST", 3U, 3U, 2U) && ok;
+  ok = test_overflow(EVENT_BUS_OVERFLOW_DROP_OLDEST, 0U, "overflow DROP_OLDEST", 6U, 3U, 5U) && ok;
+  ok = test_overflow(EVENT_BUS_OVERFLOW_WAIT, pdMS_TO_TICKS(2U), "overflow WAIT", 3U, 3U, 2U) && ok;
+  ok = test_isr_dropped() && ok;
+  ok = test_destroy_mid_publish() && ok;
+
+  if (!ok)
+  {
+    (void)printf("\ncm33_event_bus_test: failed\n");
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
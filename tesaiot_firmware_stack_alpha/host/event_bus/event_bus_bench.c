@@ -0,0 +1,729 @@
+/*******************************************************************************
+ * File Name        : event_bus_bench.c
+ *
+ * Description      : tesa_event_bus benchmark on the host port. Posts events
+ *                    to a channel with 1 to 8 subscriber queues, receives and
+ *                    frees them in the same thread, and prints the cost of one
+ *                    post-to-receive cycle and the pool blocks one post holds,
+ *                    for several payload sizes. A second table compares
+ *                    subscriber wake-ups on mixed traffic with and without
+ *                    per-subscriber type filters. A policy sweep then posts
+ *                    from one task to 1 to 8 consumer tasks for each queue
+ *                    policy and prints accepted posts/s, drops and pool
+ *                    high-water,
+ *                    and a stress run posts from several producer tasks at
+ *                    once and checks every consumer for lost and duplicated
+ *                    events. Built with tracing
+ *                    (make TRACE=1), it then decodes the trace dump and
+ *                    prints latency and pool use per channel.
+ *
+ * Author           : Asst.Prof.Santi Nuratch, Ph.D
+ *                    Thailand Embedded Systems Association (TESA)
+ *
+ *******************************************************************************/
+
+#include "semphr.h"
+#include "sim_port.h"
+#include "tesa_event_bus.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define BENCH_CHANNEL_ID (0x0100U)
+#define BENCH_EVENT_TYPE (0x0001U)
+#define BENCH_QUEUE_LENGTH (8U)
+#define BENCH_BURST (4U) /* Posts held at once to measure blocks per post */
+#define BENCH_ITERATIONS_DEFAULT (200000U)
+#define BENCH_MIXED_CHANNEL_ID (0x0200U)
+#define BENCH_MIXED_CONSUMERS (4U) /* Consumer k handles event type k */
+#define BENCH_POLICY_CHANNEL_ID (0x0300U) /* One channel per policy, from here up */
+#define BENCH_STRESS_CHANNEL_ID (0x0400U) /* One channel per stress policy, from here up */
+#define BENCH_CONSUMER_QUEUE_LENGTH (8U) /* Sweep and stress queues; see the pool check below */
+#define BENCH_STRESS_PRODUCERS (4U)
+#define BENCH_STRESS_CONSUMERS (4U)
+#define BENCH_STRESS_PAYLOAD (8U) /* Sequence number and producer index */
+#define BENCH_POSTS_DEFAULT (20000U)
+#define BENCH_TASK_PRIORITY (2U)
+#define BENCH_DRAIN_TIMEOUT_US (5000000U)
+
+/* A sweep post holds its block until the slowest consumer frees it: at most a full queue, the event
+ * in hand and the post under way. Every pool class must cover that, or NO_DROP and WAIT rows fail
+ * for want of a block before their queues ever fill. */
+#if ((BENCH_CONSUMER_QUEUE_LENGTH + 2U) > TESA_EVENT_BUS_POOL_SMALL_COUNT) ||                                   \
+    ((BENCH_CONSUMER_QUEUE_LENGTH + 2U) > TESA_EVENT_BUS_POOL_MEDIUM_COUNT) ||                                  \
+    ((BENCH_CONSUMER_QUEUE_LENGTH + 2U) > TESA_EVENT_BUS_POOL_LARGE_COUNT)
+#error "BENCH_CONSUMER_QUEUE_LENGTH + 2 must not exceed any TESA_EVENT_BUS_POOL_*_COUNT"
+#endif
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+
+/**
+ * Consumer task of the policy sweep and stress runs. Each checks the sequence numbers it receives
+ * per producer: a number below the next expected one is a duplicate, a gap is counted as skipped
+ * (dropped by the bus or lost; the totals tell which).
+ */
+typedef struct
+{
+  QueueHandle_t queue;
+  volatile uint32_t received;
+  volatile uint32_t duplicates;
+  volatile uint32_t skipped;
+  uint32_t next_seq[BENCH_STRESS_PRODUCERS];
+} bench_consumer_t;
+
+typedef struct
+{
+  tesa_event_channel_id_t channel_id;
+  uint8_t index;
+  uint32_t posts;
+  size_t payload_size;
+  volatile uint32_t no_block; /* Posts refused with TESA_EVENT_BUS_ERROR_MEMORY */
+  volatile uint32_t retries;  /* ... and posted again (stress) */
+} bench_producer_t;
+
+typedef struct
+{
+  tesa_event_bus_queue_policy_t policy;
+  const char *name;
+  TickType_t timeout;
+} bench_policy_t;
+
+/*******************************************************************************
+ * Global Variables
+ *******************************************************************************/
+static const uint8_t s_subscriber_counts[] = {1U, 2U, 4U, 8U};
+static const size_t s_payload_sizes[] = {4U, 64U, 224U};
+
+/* Mixed traffic: mostly type 0 (IMU samples), then one each of types 1 to 3 */
+static const tesa_event_type_t s_mixed_types[] = {0U, 0U, 0U, 0U, 0U, 0U, 0U, 1U, 2U, 3U};
+
+static QueueHandle_t s_queues[TESA_EVENT_BUS_MAX_SUBSCRIBERS_PER_CHANNEL];
+static uint8_t s_payload[TESA_EVENT_BUS_MAX_PAYLOAD_SIZE];
+
+/* NO_DROP waits for queue space indefinitely, WAIT up to the bus default timeout */
+static const bench_policy_t s_policies[] = {
+    {TESA_EVENT_BUS_QUEUE_DROP_NEWEST, "DROP_NEWEST", 0U},
+    {TESA_EVENT_BUS_QUEUE_DROP_OLDEST, "DROP_OLDEST", 0U},
+    {TESA_EVENT_BUS_QUEUE_NO_DROP, "NO_DROP", portMAX_DELAY},
+    {TESA_EVENT_BUS_QUEUE_WAIT, "WAIT", pdMS_TO_TICKS(TESA_EVENT_BUS_DEFAULT_QUEUE_TIMEOUT_MS)},
+};
+
+static bench_consumer_t s_consumers[TESA_EVENT_BUS_MAX_SUBSCRIBERS_PER_CHANNEL];
+static bench_producer_t s_producers[BENCH_STRESS_PRODUCERS];
+static SemaphoreHandle_t s_producers_done;
+
+/*******************************************************************************
+ * Function Definitions
+ *******************************************************************************/
+
+/** Receives and frees everything queued; returns the number of events. */
+static uint32_t bench_drain(uint8_t subscribers)
+{
+  tesa_event_t *event = NULL;
+  uint32_t received = 0U;
+
+  for (uint8_t i = 0U; i < subscribers; i++)
+  {
+    while (pdTRUE == tesa_event_bus_receive(s_queues[i], &event, 0U))
+    {
+      tesa_event_bus_free_event(event);
+      received++;
+    }
+  }
+  return received;
+}
+
+/** Pool class a payload of size lands in (the smallest that fits). */
+static uint8_t bench_pool_class(size_t size)
+{
+  tesa_event_bus_pool_stats_t stats;
+
+  for (uint8_t c = 0U; c < TESA_EVENT_BUS_POOL_CLASS_COUNT; c++)
+  {
+    if ((TESA_EVENT_BUS_SUCCESS == tesa_event_bus_get_pool_stats(c, &stats)) && (size <= stats.payload_size))
+    {
+      return c;
+    }
+  }
+  return 0U;
+}
+
+/**
+ * One row: BENCH_BURST posts held to count pool blocks, then iterations post-receive-free cycles.
+ * Returns false if an event was lost.
+ */
+static bool bench_run(uint8_t subscribers, size_t payload_size, uint32_t iterations)
+{
+  tesa_event_bus_pool_stats_t stats;
+  uint8_t pool_class = bench_pool_class(payload_size);
+  uint32_t received = 0U;
+  uint64_t start_us;
+  uint64_t elapsed_us;
+
+  for (uint8_t i = 0U; i < subscribers; i++)
+  {
+    (void)tesa_event_bus_subscribe(BENCH_CHANNEL_ID, s_queues[i]);
+  }
+
+  (void)tesa_event_bus_reset_pool_stats();
+  for (uint32_t n = 0U; n < BENCH_BURST; n++)
+  {
+    (void)tesa_event_bus_post(BENCH_CHANNEL_ID, BENCH_EVENT_TYPE, s_payload, payload_size);
+  }
+  (void)tesa_event_bus_get_pool_stats(pool_class, &stats);
+  (void)bench_drain(subscribers);
+
+  start_us = sim_port_now_us();
+  for (uint32_t n = 0U; n < iterations; n++)
+  {
+    s_payload[0] = (uint8_t)n;
+    (void)tesa_event_bus_post(BENCH_CHANNEL_ID, BENCH_EVENT_TYPE, s_payload, payload_size);
+    received += bench_drain(subscribers);
+  }
+  elapsed_us = sim_port_now_us() - start_us;
+
+  for (uint8_t i = 0U; i < subscribers; i++)
+  {
+    (void)tesa_event_bus_unsubscribe(BENCH_CHANNEL_ID, s_queues[i]);
+  }
+
+  (void)printf("%11u %8lu %12.1f %14.1f %12.2f %10lu\n", (unsigned)subscribers, (unsigned long)payload_size,
+               (1000.0 * (double)elapsed_us) / (double)iterations,
+               (1000.0 * (double)elapsed_us) / ((double)iterations * (double)subscribers),
+               (double)stats.high_water / (double)BENCH_BURST,
+               (unsigned long)(payload_size * (size_t)stats.high_water / BENCH_BURST));
+  return (received == (iterations * subscribers));
+}
+
+/**
+ * Mixed traffic on one channel with BENCH_MIXED_CONSUMERS queues. Unfiltered, every consumer dequeues
+ * every event and discards the types it does not handle; filtered, each subscribes with the type mask
+ * of its own type. Returns false if a consumer missed an event of its type.
+ */
+static bool bench_mixed(bool filtered, uint32_t iterations)
+{
+  tesa_event_bus_pool_stats_t stats;
+  tesa_event_t *event = NULL;
+  uint32_t wakeups = 0U;
+  uint32_t discarded = 0U;
+  uint32_t handled = 0U;
+  uint32_t allocations = 0U;
+  uint64_t start_us;
+  uint64_t elapsed_us;
+
+  for (uint8_t k = 0U; k < BENCH_MIXED_CONSUMERS; k++)
+  {
+    tesa_event_bus_filter_t filter = {
+        .type_mask = TESA_EVENT_BUS_TYPE_BIT(k), .accept = NULL, .context = NULL};
+
+    (void)tesa_event_bus_subscribe_with_filter(BENCH_MIXED_CHANNEL_ID, s_queues[k], filtered ? &filter : NULL);
+  }
+
+  (void)tesa_event_bus_reset_pool_stats();
+  start_us = sim_port_now_us();
+  for (uint32_t n = 0U; n < iterations; n++)
+  {
+    (void)tesa_event_bus_post(BENCH_MIXED_CHANNEL_ID, s_mixed_types[n % (sizeof(s_mixed_types) / sizeof(s_mixed_types[0]))],
+                              s_payload, 16U);
+    for (uint8_t k = 0U; k < BENCH_MIXED_CONSUMERS; k++)
+    {
+      while (pdTRUE == tesa_event_bus_receive(s_queues[k], &event, 0U))
+      {
+        wakeups++;
+        if (k == event->event_type)
+        {
+          handled++;
+        }
+        else
+        {
+          discarded++;
+        }
+        tesa_event_bus_free_event(event);
+      }
+    }
+  }
+  elapsed_us = sim_port_now_us() - start_us;
+
+  for (uint8_t c = 0U; c < TESA_EVENT_BUS_POOL_CLASS_COUNT; c++)
+  {
+    (void)tesa_event_bus_get_pool_stats(c, &stats);
+    allocations += stats.allocations;
+  }
+  for (uint8_t k = 0U; k < BENCH_MIXED_CONSUMERS; k++)
+  {
+    (void)tesa_event_bus_unsubscribe(BENCH_MIXED_CHANNEL_ID, s_queues[k]);
+  }
+
+  (void)printf("%11s %12.1f %10lu %10lu %10lu %12lu\n", filtered ? "type mask" : "none",
+               (1000.0 * (double)elapsed_us) / (double)iterations, (unsigned long)wakeups, (unsigned long)handled,
+               (unsigned long)discarded, (unsigned long)allocations);
+  return (handled == iterations);
+}
+
+static void bench_put_u32(uint8_t *p, uint32_t value)
+{
+  p[0] = (uint8_t)value;
+  p[1] = (uint8_t)(value >> 8);
+  p[2] = (uint8_t)(value >> 16);
+  p[3] = (uint8_t)(value >> 24);
+}
+
+static uint32_t bench_get_u32(const uint8_t *p)
+{
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/** Receives forever; payload bytes 0-3 hold the sequence number, 4-7 (if present) the producer index. */
+static void bench_consumer_task(void *arg)
+{
+  bench_consumer_t *consumer = (bench_consumer_t *)arg;
+  tesa_event_t *event = NULL;
+
+  for (;;)
+  {
+    if (pdTRUE != tesa_event_bus_receive(consumer->queue, &event, portMAX_DELAY))
+    {
+      continue;
+    }
+
+    const uint8_t *payload = (const uint8_t *)event->payload;
+    uint32_t seq = bench_get_u32(payload);
+    uint32_t producer = (8U <= event->payload_size) ? bench_get_u32(payload + 4) : 0U;
+
+    if (BENCH_STRESS_PRODUCERS > producer)
+    {
+      if (seq < consumer->next_seq[producer])
+      {
+        consumer->duplicates++;
+      }
+      else
+      {
+        consumer->skipped += seq - consumer->next_seq[producer];
+        consumer->next_seq[producer] = seq + 1U;
+      }
+    }
+    consumer->received++;
+    /* Counters are written before the block is freed, so an empty pool means they are final */
+    tesa_event_bus_free_event(event);
+  }
+}
+
+static void bench_consumers_reset(uint8_t count)
+{
+  for (uint8_t i = 0U; i < count; i++)
+  {
+    s_consumers[i].received = 0U;
+    s_consumers[i].duplicates = 0U;
+    s_consumers[i].skipped = 0U;
+    (void)memset(s_consumers[i].next_seq, 0, sizeof(s_consumers[i].next_seq));
+  }
+}
+
+/** Waits until every event has been received and freed. Returns false on timeout. */
+static bool bench_wait_drained(void)
+{
+  tesa_event_bus_pool_stats_t stats;
+  uint64_t deadline_us = sim_port_now_us() + BENCH_DRAIN_TIMEOUT_US;
+
+  for (;;)
+  {
+    uint32_t in_use = 0U;
+
+    for (uint8_t c = 0U; c < TESA_EVENT_BUS_POOL_CLASS_COUNT; c++)
+    {
+      (void)tesa_event_bus_get_pool_stats(c, &stats);
+      in_use += stats.blocks_in_use;
+    }
+    if (0U == in_use)
+    {
+      return true;
+    }
+    if (sim_port_now_us() > deadline_us)
+    {
+      return false;
+    }
+    vTaskDelay(1U);
+  }
+}
+
+/**
+ * Posts producer->posts numbered events. In the stress run (retry), a post refused for want of a pool
+ * block is repeated until it gets one, so every number is posted exactly once.
+ */
+static void bench_produce(bench_producer_t *producer, bool retry)
+{
+  uint8_t payload[TESA_EVENT_BUS_MAX_PAYLOAD_SIZE];
+
+  (void)memset(payload, 0x5A, producer->payload_size);
+  if (8U <= producer->payload_size)
+  {
+    bench_put_u32(payload + 4, producer->index);
+  }
+  for (uint32_t n = 0U; n < producer->posts; n++)
+  {
+    bench_put_u32(payload, n);
+    while (TESA_EVENT_BUS_ERROR_MEMORY ==
+           tesa_event_bus_post(producer->channel_id, BENCH_EVENT_TYPE, payload, producer->payload_size))
+    {
+      if (!retry)
+      {
+        producer->no_block++;
+        break;
+      }
+      producer->retries++;
+      vTaskDelay(0U);
+    }
+  }
+}
+
+static void bench_producer_task(void *arg)
+{
+  bench_produce((bench_producer_t *)arg, true);
+  (void)xSemaphoreGive(s_producers_done);
+  vTaskDelete(NULL);
+}
+
+/** Highest pool class high-water mark, as a percentage of that class's blocks. */
+static uint32_t bench_pool_peak(void)
+{
+  tesa_event_bus_pool_stats_t stats;
+  uint32_t peak = 0U;
+
+  for (uint8_t c = 0U; c < TESA_EVENT_BUS_POOL_CLASS_COUNT; c++)
+  {
+    if ((TESA_EVENT_BUS_SUCCESS == tesa_event_bus_get_pool_stats(c, &stats)) && (0U < stats.block_count))
+    {
+      uint32_t percent = (100U * (uint32_t)stats.high_water) / (uint32_t)stats.block_count;
+      peak = (percent > peak) ? percent : peak;
+    }
+  }
+  return peak;
+}
+
+/**
+ * One sweep row: the calling task posts posts events to subscribers consumer tasks on the channel
+ * of policy. Every subscriber must account for each post that got a pool block, as received or as
+ * dropped by the bus, and see no number twice. Returns false otherwise.
+ */
+static bool bench_policy_run(size_t policy, uint8_t subscribers, size_t payload_size, uint32_t posts)
+{
+  tesa_event_channel_id_t channel_id = (tesa_event_channel_id_t)(BENCH_POLICY_CHANNEL_ID + policy);
+  bench_producer_t producer = {
+      .channel_id = channel_id, .index = 0U, .posts = posts, .payload_size = payload_size};
+  tesa_event_bus_subscriber_stats_t stats;
+  uint32_t dropped = 0U;
+  uint32_t received = 0U;
+  uint32_t duplicates = 0U;
+  uint32_t lost = 0U;
+  uint64_t start_us;
+  uint64_t elapsed_us;
+  bool drained;
+
+  bench_consumers_reset(subscribers);
+  for (uint8_t i = 0U; i < subscribers; i++)
+  {
+    (void)tesa_event_bus_subscribe(channel_id, s_consumers[i].queue);
+  }
+
+  (void)tesa_event_bus_reset_pool_stats();
+  start_us = sim_port_now_us();
+  bench_produce(&producer, false);
+  elapsed_us = sim_port_now_us() - start_us;
+  drained = bench_wait_drained();
+
+  for (uint8_t i = 0U; i < subscribers; i++)
+  {
+    uint32_t accounted;
+
+    (void)tesa_event_bus_get_subscriber_stats(channel_id, s_consumers[i].queue, &stats);
+    accounted = s_consumers[i].received + stats.posts_dropped;
+    if (accounted < (posts - producer.no_block))
+    {
+      lost += (posts - producer.no_block) - accounted;
+    }
+    dropped += stats.posts_dropped;
+    received += s_consumers[i].received;
+    duplicates += s_consumers[i].duplicates;
+    (void)tesa_event_bus_unsubscribe(channel_id, s_consumers[i].queue);
+  }
+
+  /* Refused posts return at once; counting them would inflate the rate */
+  (void)printf("%-11s %4u %7lu %11.0f %10lu %10lu %8lu %5lu%% %6lu %6lu\n", s_policies[policy].name,
+               (unsigned)subscribers, (unsigned long)payload_size,
+               (1000000.0 * (double)(posts - producer.no_block)) / (double)((0U < elapsed_us) ? elapsed_us : 1U),
+               (unsigned long)received,
+               (unsigned long)dropped, (unsigned long)producer.no_block, (unsigned long)bench_pool_peak(),
+               (unsigned long)lost, (unsigned long)duplicates);
+  return drained && (0U == lost) && (0U == duplicates);
+}
+
+/**
+ * Stress run: BENCH_STRESS_PRODUCERS tasks post posts numbered events each, at once, to
+ * BENCH_STRESS_CONSUMERS consumer tasks. Posts refused for want of a pool block are retried, so each
+ * consumer must receive every (producer, number) pair exactly once, less what the bus counted as
+ * dropped. Returns false if an event was lost or duplicated.
+ */
+static bool bench_stress(size_t policy, uint32_t posts)
+{
+  tesa_event_channel_id_t channel_id = (tesa_event_channel_id_t)(BENCH_STRESS_CHANNEL_ID + policy);
+  tesa_event_bus_subscriber_stats_t stats;
+  uint32_t expected = posts * BENCH_STRESS_PRODUCERS;
+  uint32_t received = 0U;
+  uint32_t dropped = 0U;
+  uint32_t duplicates = 0U;
+  uint32_t retries = 0U;
+  uint32_t lost = 0U;
+  uint64_t start_us;
+  uint64_t elapsed_us;
+  bool drained;
+
+  bench_consumers_reset(BENCH_STRESS_CONSUMERS);
+  for (uint8_t i = 0U; i < BENCH_STRESS_CONSUMERS; i++)
+  {
+    (void)tesa_event_bus_subscribe(channel_id, s_consumers[i].queue);
+  }
+
+  (void)tesa_event_bus_reset_pool_stats();
+  start_us = sim_port_now_us();
+  for (uint8_t p = 0U; p < BENCH_STRESS_PRODUCERS; p++)
+  {
+    char name[8];
+
+    s_producers[p] = (bench_producer_t){
+        .channel_id = channel_id, .index = p, .posts = posts, .payload_size = BENCH_STRESS_PAYLOAD};
+    (void)snprintf(name, sizeof(name), "Prod%u", (unsigned)p);
+    if (pdPASS != xTaskCreate(bench_producer_task, name, configMINIMAL_STACK_SIZE, &s_producers[p],
+                              BENCH_TASK_PRIORITY, NULL))
+    {
+      return false;
+    }
+  }
+  for (uint8_t p = 0U; p < BENCH_STRESS_PRODUCERS; p++)
+  {
+    (void)xSemaphoreTake(s_producers_done, portMAX_DELAY);
+    retries += s_producers[p].retries;
+  }
+  drained = bench_wait_drained();
+  elapsed_us = sim_port_now_us() - start_us;
+
+  for (uint8_t i = 0U; i < BENCH_STRESS_CONSUMERS; i++)
+  {
+    uint32_t accounted;
+
+    (void)tesa_event_bus_get_subscriber_stats(channel_id, s_consumers[i].queue, &stats);
+    accounted = s_consumers[i].received + stats.posts_dropped;
+    lost += (accounted < expected) ? (expected - accounted) : 0U;
+    received += s_consumers[i].received;
+    dropped += stats.posts_dropped;
+    duplicates += s_consumers[i].duplicates;
+    (void)tesa_event_bus_unsubscribe(channel_id, s_consumers[i].queue);
+  }
+
+  (void)printf("%-11s %11.0f %10lu %10lu %10lu %5lu%% %6lu %6lu\n", s_policies[policy].name,
+               (1000000.0 * (double)expected) / (double)((0U < elapsed_us) ? elapsed_us : 1U),
+               (unsigned long)received, (unsigned long)dropped, (unsigned long)retries,
+               (unsigned long)bench_pool_peak(), (unsigned long)lost, (unsigned long)duplicates);
+  return drained && (0U == lost) && (0U == duplicates);
+}
+
+#if (0 != TESA_EVENT_BUS_TRACE_ENABLE)
+static uint16_t bench_get_u16(const uint8_t *p)
+{
+  return (uint16_t)((uint16_t)p[0] | ((uint16_t)p[1] << 8));
+}
+
+/** Upper bound of the log2 bucket holding the given percentile of a dumped histogram (max for the last). */
+static uint32_t bench_hist_percentile(const uint8_t *hist, uint8_t buckets, uint32_t percent)
+{
+  uint32_t count = bench_get_u32(hist);
+  uint32_t max_us = bench_get_u32(hist + 4);
+  uint32_t target = (uint32_t)((((uint64_t)count * percent) + 99U) / 100U);
+  uint32_t seen = 0U;
+
+  for (uint8_t b = 0U; (0U < count) && (b < buckets); b++)
+  {
+    seen += bench_get_u32(hist + 8 + (4U * b));
+    if (seen >= target)
+    {
+      uint32_t upper = (0U == b) ? 0U : ((1UL << b) - 1U);
+      return ((b == (buckets - 1U)) || (upper > max_us)) ? max_us : upper;
+    }
+  }
+  return max_us;
+}
+
+/** Decodes the trace dump (layout in docs/event_bus_tracing.md) into one line per channel and subscriber. */
+static void bench_trace_report(void)
+{
+  static uint8_t dump[TESA_EVENT_BUS_TRACE_DUMP_MAX_SIZE];
+  size_t written = 0U;
+  const uint8_t *p = dump;
+
+  if ((TESA_EVENT_BUS_SUCCESS != tesa_event_bus_trace_dump(dump, sizeof(dump), &written)) ||
+      (TESA_EVENT_BUS_TRACE_DUMP_MAGIC != bench_get_u32(dump)))
+  {
+    (void)printf("\nevent_bus_bench: trace dump failed\n");
+    return;
+  }
+
+  uint8_t buckets = p[5];
+  uint8_t classes = p[6];
+  uint8_t channels = p[7];
+  size_t hist_size = 8U + (4U * (size_t)buckets);
+
+  (void)printf("\nTrace (%lu bytes): post-to-receive latency in us, p50/p99/max\n\n", (unsigned long)written);
+  p += 12;
+  for (uint8_t c = 0U; c < classes; c++, p += 12)
+  {
+    (void)printf("pool %3u bytes: high water %u of %u blocks, %lu allocation failures\n", (unsigned)bench_get_u16(p),
+                 (unsigned)bench_get_u16(p + 6), (unsigned)bench_get_u16(p + 2), (unsigned long)bench_get_u32(p + 8));
+  }
+  for (uint8_t ch = 0U; ch < channels; ch++)
+  {
+    uint8_t subscribers = p[2];
+    uint8_t producers = p[3];
+
+    (void)printf("\nchannel 0x%04X: %lu blocks, high water %u; received %lu, latency %lu/%lu/%lu\n",
+                 (unsigned)bench_get_u16(p), (unsigned long)bench_get_u32(p + 4), (unsigned)bench_get_u16(p + 10),
+                 (unsigned long)bench_get_u32(p + 16), (unsigned long)bench_hist_percentile(p + 16, buckets, 50U),
+                 (unsigned long)bench_hist_percentile(p + 16, buckets, 99U), (unsigned long)bench_get_u32(p + 20));
+    p += 16U + hist_size;
+    for (uint8_t i = 0U; i < producers; i++, p += 12)
+    {
+      (void)printf("  producer %-8.8s %10lu posts\n", (const char *)p, (unsigned long)bench_get_u32(p + 8));
+    }
+    for (uint8_t i = 0U; i < subscribers; i++, p += 2U + hist_size)
+    {
+      (void)printf("  subscriber %u: peak depth %u, latency %lu/%lu/%lu\n", (unsigned)i, (unsigned)bench_get_u16(p),
+                   (unsigned long)bench_hist_percentile(p + 2, buckets, 50U),
+                   (unsigned long)bench_hist_percentile(p + 2, buckets, 99U), (unsigned long)bench_get_u32(p + 6));
+    }
+  }
+}
+#endif
+
+int main(int argc, char **argv)
+{
+  uint32_t iterations = BENCH_ITERATIONS_DEFAULT;
+  uint32_t posts = BENCH_POSTS_DEFAULT;
+  bool ok = true;
+  int opt;
+
+  while (-1 != (opt = getopt(argc, argv, "n:p:h")))
+  {
+    switch (opt)
+    {
+    case 'n':
+      iterations = (uint32_t)strtoul(optarg, NULL, 0);
+      break;
+    case 'p':
+      posts = (uint32_t)strtoul(optarg, NULL, 0);
+      break;
+    default:
+      (void)fprintf(stderr, "usage: %s [-n iterations] [-p posts]\n", argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  sim_port_set_core(SIM_CORE_CM55);
+  if ((TESA_EVENT_BUS_SUCCESS != tesa_event_bus_init()) ||
+      (TESA_EVENT_BUS_SUCCESS != tesa_event_bus_register_channel(BENCH_CHANNEL_ID, "Bench")) ||
+      (TESA_EVENT_BUS_SUCCESS != tesa_event_bus_register_channel(BENCH_MIXED_CHANNEL_ID, "Mixed")))
+  {
+    (void)fprintf(stderr, "event_bus_bench: init failed\n");
+    return EXIT_FAILURE;
+  }
+  for (size_t p = 0U; p < (sizeof(s_policies) / sizeof(s_policies[0])); p++)
+  {
+    tesa_event_bus_channel_config_t config = {.queue_policy = s_policies[p].policy,
+                                              .queue_timeout_ticks = s_policies[p].timeout};
+
+    if ((TESA_EVENT_BUS_SUCCESS !=
+         tesa_event_bus_register_channel_with_config((tesa_event_channel_id_t)(BENCH_POLICY_CHANNEL_ID + p), "Policy",
+                                                     &config)) ||
+        (TESA_EVENT_BUS_SUCCESS !=
+         tesa_event_bus_register_channel_with_config((tesa_event_channel_id_t)(BENCH_STRESS_CHANNEL_ID + p), "Stress",
+                                                     &config)))
+    {
+      (void)fprintf(stderr, "event_bus_bench: init failed\n");
+      return EXIT_FAILURE;
+    }
+  }
+  for (uint8_t i = 0U; i < TESA_EVENT_BUS_MAX_SUBSCRIBERS_PER_CHANNEL; i++)
+  {
+    s_queues[i] = xQueueCreate(BENCH_QUEUE_LENGTH, sizeof(tesa_event_t *));
+    s_consumers[i].queue = xQueueCreate(BENCH_CONSUMER_QUEUE_LENGTH, sizeof(tesa_event_t *));
+    if ((NULL == s_queues[i]) || (NULL == s_consumers[i].queue) ||
+        (pdPASS != xTaskCreate(bench_consumer_task, "Consumer", configMINIMAL_STACK_SIZE, &s_consumers[i],
+                               BENCH_TASK_PRIORITY, NULL)))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+  s_producers_done = xSemaphoreCreateCounting(BENCH_STRESS_PRODUCERS, 0U);
+  if (NULL == s_producers_done)
+  {
+    return EXIT_FAILURE;
+  }
+  (void)memset(s_payload, 0xA5, sizeof(s_payload));
+
+  (void)printf("event_bus_bench: %lu post-receive cycles per row\n\n", (unsigned long)iterations);
+  (void)printf("%11s %8s %12s %14s %12s %10s\n", "subscribers", "payload", "ns/post", "ns/delivery", "blocks/post",
+               "bytes/post");
+  for (size_t p = 0U; p < (sizeof(s_payload_sizes) / sizeof(s_payload_sizes[0])); p++)
+  {
+    for (size_t s = 0U; s < sizeof(s_subscriber_counts); s++)
+    {
+      ok = bench_run(s_subscriber_counts[s], s_payload_sizes[p], iterations) && ok;
+    }
+  }
+
+  (void)printf("\nMixed traffic, %lu posts: 70%% type 0, 10%% each types 1-3; %u consumers, one type each\n\n",
+               (unsigned long)iterations, (unsigned)BENCH_MIXED_CONSUMERS);
+  (void)printf("%11s %12s %10s %10s %10s %12s\n", "filter", "ns/post", "wake-ups", "handled", "discarded",
+               "allocations");
+  ok = bench_mixed(false, iterations) && ok;
+  ok = bench_mixed(true, iterations) && ok;
+
+  (void)printf("\nPolicy sweep, %lu posts per row from one task to consumer tasks (queues of %u)\n\n",
+               (unsigned long)posts, (unsigned)BENCH_CONSUMER_QUEUE_LENGTH);
+  (void)printf("%-11s %4s %7s %11s %10s %10s %8s %6s %6s %6s\n", "policy", "subs", "payload", "accepted/s",
+               "received", "dropped", "no block", "pool", "lost", "dup");
+  for (size_t p = 0U; p < (sizeof(s_policies) / sizeof(s_policies[0])); p++)
+  {
+    for (size_t z = 0U; z < (sizeof(s_payload_sizes) / sizeof(s_payload_sizes[0])); z++)
+    {
+      for (size_t s = 0U; s < sizeof(s_subscriber_counts); s++)
+      {
+        ok = bench_policy_run(p, s_subscriber_counts[s], s_payload_sizes[z], posts) && ok;
+      }
+    }
+  }
+
+  (void)printf("\nStress, %u producer tasks x %lu posts to %u consumer tasks; refused posts retried\n\n",
+               (unsigned)BENCH_STRESS_PRODUCERS, (unsigned long)posts, (unsigned)BENCH_STRESS_CONSUMERS);
+  (void)printf("%-11s %11s %10s %10s %10s %6s %6s %6s\n", "policy", "posts/s", "received", "dropped", "retries",
+               "pool", "lost", "dup");
+  for (size_t p = 0U; p < (sizeof(s_policies) / sizeof(s_policies[0])); p++)
+  {
+    ok = bench_stress(p, posts) && ok;
+  }
+
+#if (0 != TESA_EVENT_BUS_TRACE_ENABLE)
+  bench_trace_report();
+#endif
+
+  if (!ok)
+  {
+    (void)printf("\nevent_bus_bench: events lost or duplicated\n");
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
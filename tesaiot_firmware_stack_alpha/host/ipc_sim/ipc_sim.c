@@ -0,0 +1,258 @@
+/*******************************************************************************
+ * File Name        : ipc_sim.c
+ *
+ * Description      : IPC simulator driver. Boots the CM33 and CM55 IPC stacks
+ *                    in one host process (see host/README.md), warms the link
+ *                    up, clears the statistics, runs the configured traffic
+ *                    for the requested time and prints per-command throughput
+ *                    and latency from both cores' ipc_stats.
+ *
+ * Author           : Asst.Prof.Santi Nuratch, Ph.D
+ *                    Thailand Embedded Systems Association (TESA)
+ *
+ *******************************************************************************/
+
+#include "sim_board.h"
+
+#include "ipc_communication.h"
+#include "sim_port.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define IPC_SIM_WARMUP_MS (1500U) /* Boot, credit grant and the first time sync */
+#define IPC_SIM_DRAIN_MS (200U)   /* Lets frames in flight land before the report */
+#define IPC_SIM_SECONDS_DEFAULT (5U)
+
+/*******************************************************************************
+ * Global Variables
+ *******************************************************************************/
+static FILE *s_uart = NULL;
+
+/*******************************************************************************
+ * Function Definitions
+ *******************************************************************************/
+
+/** CM33 debug UART: discarded (only counted) unless -u names a file. */
+static void ipc_sim_uart(const char *data, size_t len)
+{
+  if (NULL != s_uart)
+  {
+    (void)fwrite(data, 1U, len, s_uart);
+  }
+}
+
+static void ipc_sim_sleep_ms(uint32_t ms)
+{
+  struct timespec ts = {.tv_sec = (time_t)(ms / 1000U), .tv_nsec = (long)(ms % 1000U) * 1000000L};
+
+  while (0 != nanosleep(&ts, &ts))
+  {
+  }
+}
+
+static void ipc_sim_usage(const char *prog)
+{
+  (void)fprintf(stderr,
+                "usage: %s [-t seconds] [-g gyro_hz] [-T touch_hz] [-p print_hz] [-l print_len]\n"
+                "          [-w scan_period_ms] [-a scan_aps] [-d scan_delay_ms] [-e event_hz] [-u uart_file]\n",
+                prog);
+}
+
+static void ipc_sim_print_latency(const char *name, const sim_latency_t *latency)
+{
+  (void)printf("  %-22s n=%-8lu p50<=%-7lu p99<=%-7lu max=%lu us\n", name, (unsigned long)latency->count,
+               (unsigned long)latency->p50_us, (unsigned long)latency->p99_us, (unsigned long)latency->max_us);
+}
+
+/**
+ * One row per command that moved: the sender's counters with the receiver's transit and dispatch
+ * latency (both measured where the frame arrives).
+ */
+static void ipc_sim_print_cmds(uint32_t seconds)
+{
+  (void)printf("%-22s %-9s %8s %6s %6s %9s %10s  %-17s %-17s %-17s\n", "command", "dir", "msgs", "drop", "ovf",
+               "msgs/s", "bytes/s", "queue p50/p99", "transit p50/p99", "dispatch p50/p99");
+  for (uint32_t cmd = IPC_CMD_ID_FIRST; cmd <= IPC_CMD_ID_LAST; cmd++)
+  {
+    sim_cmd_report_t cm33;
+    sim_cmd_report_t cm55;
+    bool has_cm33;
+    bool has_cm55;
+
+    sim_port_set_core(SIM_CORE_CM33);
+    has_cm33 = cm33_sim_cmd_report(cmd, &cm33);
+    sim_port_set_core(SIM_CORE_CM55);
+    has_cm55 = cm55_sim_cmd_report(cmd, &cm55);
+    if (!has_cm33 && !has_cm55)
+    {
+      continue;
+    }
+    for (uint32_t dir = 0U; dir < 2U; dir++)
+    {
+      const sim_cmd_report_t *tx = (0U == dir) ? &cm33 : &cm55;
+      const sim_cmd_report_t *rx = (0U == dir) ? &cm55 : &cm33;
+      char queue[24];
+      char transit[24];
+      char dispatch[24];
+
+      if (!((0U == dir) ? has_cm33 : has_cm55) || ((0U == tx->sent) && (0U == tx->dropped)))
+      {
+        continue;
+      }
+      (void)snprintf(queue, sizeof(queue), "%lu/%lu", (unsigned long)tx->queue.p50_us,
+                     (unsigned long)tx->queue.p99_us);
+      (void)snprintf(transit, sizeof(transit), "%lu/%lu", (unsigned long)rx->transit.p50_us,
+                     (unsigned long)rx->transit.p99_us);
+      (void)snprintf(dispatch, sizeof(dispatch), "%lu/%lu", (unsigned long)rx->dispatch.p50_us,
+                     (unsigned long)rx->dispatch.p99_us);
+      (void)printf("%-22s %-9s %8lu %6lu %6lu %9lu %10lu  %-17s %-17s %-17s\n", cm55_sim_cmd_name(cmd),
+                   (0U == dir) ? "CM33>CM55" : "CM55>CM33", (unsigned long)tx->sent, (unsigned long)tx->dropped,
+                   (unsigned long)rx->overflows, (unsigned long)(rx->received / seconds),
+                   (unsigned long)(rx->received_bytes / seconds), queue, transit, dispatch);
+    }
+  }
+}
+
+int main(int argc, char **argv)
+{
+  sim_load_t load = {
+      .gyro_hz = 100U,
+      .touch_hz = 60U,
+      .print_hz = 50U,
+      .print_len = 64U,
+      .scan_period_ms = 500U,
+      .scan_aps = 16U,
+      .scan_delay_ms = 20U,
+      .event_hz = 200U,
+  };
+  sim_cm33_report_t cm33;
+  sim_cm55_report_t cm55;
+  uint32_t seconds = IPC_SIM_SECONDS_DEFAULT;
+  int opt;
+
+  while (-1 != (opt = getopt(argc, argv, "t:g:T:p:l:w:a:d:e:u:h")))
+  {
+    switch (opt)
+    {
+    case 't':
+      seconds = (uint32_t)strtoul(optarg, NULL, 0);
+      break;
+    case 'g':
+      load.gyro_hz = (uint32_t)strtoul(optarg, NULL, 0);
+      break;
+    case 'T':
+      load.touch_hz = (uint32_t)strtoul(optarg, NULL, 0);
+      break;
+    case 'p':
+      load.print_hz = (uint32_t)strtoul(optarg, NULL, 0);
+      break;
+    case 'l':
+      load.print_len = (uint32_t)strtoul(optarg, NULL, 0);
+      break;
+    case 'w':
+      load.scan_period_ms = (uint32_t)strtoul(optarg, NULL, 0);
+      break;
+    case 'a':
+      load.scan_aps = (uint32_t)strtoul(optarg, NULL, 0);
+      break;
+    case 'd':
+      load.scan_delay_ms = (uint32_t)strtoul(optarg, NULL, 0);
+      break;
+    case 'e':
+      load.event_hz = (uint32_t)strtoul(optarg, NULL, 0);
+      break;
+    case 'u':
+      s_uart = fopen(optarg, "w");
+      if (NULL == s_uart)
+      {
+        perror(optarg);
+        return EXIT_FAILURE;
+      }
+      break;
+    default:
+      ipc_sim_usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+  if (0U == seconds)
+  {
+    seconds = 1U;
+  }
+
+  sim_port_set_console(SIM_CORE_CM33, ipc_sim_uart);
+  sim_port_set_core(SIM_CORE_CM33);
+  if (!cm33_sim_start(&load))
+  {
+    (void)fprintf(stderr, "ipc_sim: CM33 start failed\n");
+    return EXIT_FAILURE;
+  }
+  sim_port_set_core(SIM_CORE_CM55);
+  if (!cm55_sim_start(&load))
+  {
+    (void)fprintf(stderr, "ipc_sim: CM55 start failed\n");
+    return EXIT_FAILURE;
+  }
+
+  ipc_sim_sleep_ms(IPC_SIM_WARMUP_MS);
+  sim_port_set_core(SIM_CORE_CM33);
+  cm33_sim_reset();
+  sim_port_set_core(SIM_CORE_CM55);
+  cm55_sim_reset();
+
+  sim_port_set_core(SIM_CORE_CM33);
+  cm33_sim_load(true);
+  sim_port_set_core(SIM_CORE_CM55);
+  cm55_sim_load(true);
+  ipc_sim_sleep_ms(seconds * 1000U);
+  sim_port_set_core(SIM_CORE_CM33);
+  cm33_sim_load(false);
+  sim_port_set_core(SIM_CORE_CM55);
+  cm55_sim_load(false);
+  ipc_sim_sleep_ms(IPC_SIM_DRAIN_MS);
+
+  sim_port_set_core(SIM_CORE_CM33);
+  cm33_sim_report(&cm33);
+  sim_port_set_core(SIM_CORE_CM55);
+  cm55_sim_report(&cm55);
+
+  (void)printf("ipc_sim: %lu s, gyro %lu Hz, touch %lu Hz, print %lu x %lu B/s, scan every %lu ms (%lu APs)\n\n",
+               (unsigned long)seconds, (unsigned long)load.gyro_hz, (unsigned long)load.touch_hz,
+               (unsigned long)load.print_hz, (unsigned long)load.print_len, (unsigned long)load.scan_period_ms,
+               (unsigned long)load.scan_aps);
+  ipc_sim_print_cmds(seconds);
+
+  (void)printf("\nCM33: gyro %lu offered / %lu refused, touch %lu / %lu, scans %lu, UART %llu B, recv peak %lu\n",
+               (unsigned long)cm33.gyro_offered, (unsigned long)cm33.gyro_refused, (unsigned long)cm33.touch_offered,
+               (unsigned long)cm33.touch_refused, (unsigned long)cm33.scans, (unsigned long long)cm33.uart_bytes,
+               (unsigned long)cm33.recv_peak);
+  (void)printf("CM55: touches %lu, gyro reads %lu, scan calls %lu ok %lu, credit stalls %lu, bulk throttles %lu\n",
+               (unsigned long)cm55.touches, (unsigned long)cm55.gyro_reads, (unsigned long)cm55.calls,
+               (unsigned long)cm55.calls_ok, (unsigned long)cm55.credit_stalls, (unsigned long)cm55.bulk_throttles);
+  (void)printf("CM55 stdout: written %lu B, dropped %lu B, frames %lu, retries %lu\n",
+               (unsigned long)cm55.stdout_written, (unsigned long)cm55.stdout_dropped,
+               (unsigned long)cm55.stdout_frames, (unsigned long)cm55.stdout_retries);
+  (void)printf("Event bridge: CM55>CM33 %lu posted / %lu received / %lu lost, CM33>CM55 %lu / %lu / %lu\n",
+               (unsigned long)cm55.events_offered, (unsigned long)cm33.events_received,
+               (unsigned long)cm33.events_lost, (unsigned long)cm33.events_offered,
+               (unsigned long)cm55.events_received, (unsigned long)cm55.events_lost);
+  (void)printf("  batches CM55 %lu, CM33 %lu; dropped for no free buffer CM55 %lu, CM33 %lu\n",
+               (unsigned long)cm55.bridge_batches, (unsigned long)cm33.bridge_batches,
+               (unsigned long)cm55.bridge_dropped, (unsigned long)cm33.bridge_dropped);
+  ipc_sim_print_latency("Wi-Fi scan call", &cm55.call_rtt);
+  ipc_sim_print_latency("Blackboard IMU age", &cm55.gyro_age);
+  (void)printf("Time sync: offset %ld us, rtt %lu us; shared memory %lu B\n", (long)cm55.sync_offset_us,
+               (unsigned long)cm55.sync_rtt_us, (unsigned long)sim_port_sharedmem_bytes());
+
+  if (NULL != s_uart)
+  {
+    (void)fclose(s_uart);
+  }
+  return EXIT_SUCCESS;
+}
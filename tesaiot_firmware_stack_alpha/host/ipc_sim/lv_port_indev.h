@@ -0,0 +1,19 @@
+/*******************************************************************************
+ * File Name        : lv_port_indev.h
+ *
+ * Description      : IPC simulator stand-in for the LVGL input port: only the
+ *                    entry point the CM55 IPC app feeds touch events into.
+ *
+ * Author           : Asst.Prof.Santi Nuratch, Ph.D
+ *                    Thailand Embedded Systems Association (TESA)
+ *
+ *******************************************************************************/
+
+#ifndef LV_PORT_INDEV_H
+#define LV_PORT_INDEV_H
+
+#include <stdint.h>
+
+void lv_port_indev_touch_from_ipc_set(int16_t x, int16_t y, uint8_t pressed);
+
+#endif /* LV_PORT_INDEV_H */
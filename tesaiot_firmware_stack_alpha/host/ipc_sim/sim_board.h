@@ -0,0 +1,137 @@
+/*******************************************************************************
+ * File Name        : sim_board.h
+ *
+ * Description      : Interface between the IPC simulator driver and the two
+ *                    emulated cores. Each core is linked into one relocatable
+ *                    object that exports only its cm33_ / cm55_ symbols, so
+ *                    both copies of the shared IPC sources coexist in one
+ *                    process; the driver talks to them only through the
+ *                    functions and plain structs below.
+ *
+ * Author           : Asst.Prof.Santi Nuratch, Ph.D
+ *                    Thailand Embedded Systems Association (TESA)
+ *
+ *******************************************************************************/
+
+#ifndef SIM_BOARD_H
+#define SIM_BOARD_H
+
+/*******************************************************************************
+ * Header Files
+ *******************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+
+/** Traffic offered by the load generators; a rate or period of 0 turns that source off. */
+typedef struct
+{
+  uint32_t gyro_hz;        /* CM33 -> CM55 IPC_CMD_GYRO frames (plus blackboard publish) per second */
+  uint32_t touch_hz;       /* CM33 -> CM55 IPC_CMD_TOUCH frames per second */
+  uint32_t print_hz;       /* CM55 printf() lines per second, sent as IPC_CMD_PRINT */
+  uint32_t print_len;      /* Characters per printed line, newline included */
+  uint32_t scan_period_ms; /* CM55 Wi-Fi scan calls, one at a time, at most this often */
+  uint32_t scan_aps;       /* Access points in each emulated scan result */
+  uint32_t scan_delay_ms;  /* Emulated radio time of one scan on CM33 */
+  uint32_t event_hz;       /* Bridged events per second in each direction (event bus <-> tesa_event_bus) */
+} sim_load_t;
+
+/** Latency of one distribution in microseconds. */
+typedef struct
+{
+  uint32_t count;
+  uint32_t p50_us;
+  uint32_t p99_us;
+  uint32_t max_us;
+} sim_latency_t;
+
+/** ipc_stats counters of one command on one core, percentiles already taken. */
+typedef struct
+{
+  uint32_t sent;
+  uint32_t dropped;
+  uint32_t received;
+  uint32_t received_bytes;
+  uint32_t overflows;
+  sim_latency_t queue;
+  sim_latency_t transit;
+  sim_latency_t dispatch;
+} sim_cmd_report_t;
+
+typedef struct
+{
+  uint32_t gyro_offered;  /* cm33_ipc_send_gyro_data() calls */
+  uint32_t gyro_refused;  /* ... that returned false */
+  uint32_t touch_offered; /* cm33_ipc_send_touch() calls */
+  uint32_t touch_refused;
+  uint32_t scans;         /* Scans run by the emulated Wi-Fi manager */
+  uint64_t uart_bytes;    /* Bytes written to the CM33 debug UART (CM55 prints included) */
+  uint32_t recv_peak;     /* Peak receive backlog over both classes */
+  uint32_t events_offered;  /* Remote events published on the CM33 event bus */
+  uint32_t events_received; /* Events from CM55 seen by the CM33 subscriber */
+  uint32_t events_lost;     /* ... missing from the CM55 sequence */
+  uint32_t bridge_dropped;  /* Events the CM33 bridge could not batch */
+  uint32_t bridge_batches;  /* Batches the CM33 bridge sent */
+} sim_cm33_report_t;
+
+typedef struct
+{
+  uint32_t touches;         /* Touch events delivered to the input driver */
+  uint32_t gyro_reads;      /* New blackboard samples seen by the reader task */
+  sim_latency_t gyro_age;   /* Publish on CM33 -> first read on CM55 (one-tick poll) */
+  uint32_t calls;           /* Wi-Fi scan calls started */
+  uint32_t calls_ok;        /* ... answered with CM55_IPC_CALL_OK */
+  sim_latency_t call_rtt;   /* Scan call start -> answer */
+  uint32_t stdout_written;  /* cm55_stdout_ipc counters */
+  uint32_t stdout_dropped;
+  uint32_t stdout_frames;
+  uint32_t stdout_retries;
+  uint32_t credit_stalls;   /* Sender waits for ring credits */
+  uint32_t bulk_throttles;  /* Bulk sends held back by the CM33 receive backlog */
+  int32_t sync_offset_us;   /* Timebase offset to CM33 */
+  uint32_t sync_rtt_us;
+  uint32_t events_offered;  /* Remote events posted on tesa_event_bus */
+  uint32_t events_received; /* Events from CM33 seen by the CM55 subscriber */
+  uint32_t events_lost;     /* ... missing from the CM33 sequence */
+  uint32_t bridge_dropped;  /* Events the CM55 bridge could not batch */
+  uint32_t bridge_batches;  /* Batches the CM55 bridge sent */
+} sim_cm55_report_t;
+
+/*******************************************************************************
+ * Function prototypes
+ *
+ * Call each core's functions from a thread set to that core with sim_port_set_core().
+ *******************************************************************************/
+
+/** Starts the CM33 IPC pipe, the emulated Wi-Fi manager and the CM33 load tasks (idle until cm33_sim_load()). */
+bool cm33_sim_start(const sim_load_t *load);
+
+/** Starts or stops the CM33 load generators. */
+void cm33_sim_load(bool on);
+
+/** Clears the CM33 pipe statistics and the counters of sim_cm33_report_t. */
+void cm33_sim_reset(void);
+
+/** ipc_stats of cmd on CM33. Returns false if the command was neither sent nor received. */
+bool cm33_sim_cmd_report(uint32_t cmd, sim_cmd_report_t *report);
+
+void cm33_sim_report(sim_cm33_report_t *report);
+
+/** Starts the CM55 IPC app and the CM55 load tasks (idle until cm55_sim_load()). */
+bool cm55_sim_start(const sim_load_t *load);
+
+void cm55_sim_load(bool on);
+
+void cm55_sim_reset(void);
+
+bool cm55_sim_cmd_report(uint32_t cmd, sim_cmd_report_t *report);
+
+void cm55_sim_report(sim_cm55_report_t *report);
+
+/** Registry name of cmd, "?" for an ID outside the registry. */
+const char *cm55_sim_cmd_name(uint32_t cmd);
+
+#endif /* SIM_BOARD_H */
@@ -0,0 +1,427 @@
+/*******************************************************************************
+ * File Name        : sim_cm33.c
+ *
+ * Description      : CM33 side of the IPC simulator: stand-ins for the board
+ *                    modules cm33_ipc_pipe.c calls (Wi-Fi manager, UDP
+ *                    server, user buttons), the gyro and touch load tasks,
+ *                    and the CM33 half of the report.
+ *
+ * Author           : Asst.Prof.Santi Nuratch, Ph.D
+ *                    Thailand Embedded Systems Association (TESA)
+ *
+ *******************************************************************************/
+
+#include "sim_board.h"
+
+#include "cm33_ipc_pipe.h"
+#include "event_bus.h"
+#include "ipc_stats.h"
+#include "queue.h"
+#include "sim_port.h"
+#include "task.h"
+#include "udp_server_app.h"
+#include "user_buttons.h"
+#include "wifi_manager.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define SIM_CM33_TASK_STACK (1024U)
+#define SIM_CM33_LOAD_PRIO (2U)
+#define SIM_CM33_WIFI_PRIO (3U)
+#define SIM_CM33_WIFI_QUEUE_LEN (4U)
+#define SIM_EVENT_TO_CM33 (1U) /* Bridged event IDs, the same channel IDs on CM55 */
+#define SIM_EVENT_TO_CM55 (2U)
+#define SIM_EVENT_COUNT (3U)
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+
+typedef struct
+{
+  uint32_t request; /* IPC_CMD_WIFI_*_REQ */
+  uint32_t call_id;
+} sim_wifi_request_t;
+
+/* One periodic traffic source */
+typedef struct
+{
+  const uint32_t *hz;
+  bool (*emit)(uint32_t sequence);
+  volatile uint32_t offered;
+  volatile uint32_t refused;
+} sim_source_t;
+
+/*******************************************************************************
+ * Global Variables
+ *******************************************************************************/
+static sim_load_t s_load;
+static volatile bool s_load_on = false;
+static wifi_manager_event_cb_t s_wifi_cb = NULL;
+static void *s_wifi_cb_user_data = NULL;
+static QueueHandle_t s_wifi_queue = NULL;
+static ipc_wifi_status_t s_wifi_status;
+static wifi_info_t s_scan_list[IPC_WIFI_SCAN_BULK_MAX];
+static volatile uint32_t s_scans = 0U;
+static uint64_t s_uart_base = 0U;
+static event_bus_t s_bus = NULL;
+static volatile uint32_t s_events_received = 0U;
+static volatile uint32_t s_events_lost = 0U;
+static uint32_t s_events_next = 0U; /* Next sequence expected from CM55 */
+static ipc_event_bridge_stats_t s_bridge_base;
+
+static bool sim_emit_gyro(uint32_t sequence);
+static bool sim_emit_touch(uint32_t sequence);
+static bool sim_emit_event(uint32_t sequence);
+
+static sim_source_t s_gyro_source = {.hz = &s_load.gyro_hz, .emit = sim_emit_gyro};
+static sim_source_t s_touch_source = {.hz = &s_load.touch_hz, .emit = sim_emit_touch};
+static sim_source_t s_event_source = {.hz = &s_load.event_hz, .emit = sim_emit_event};
+
+/*******************************************************************************
+ * Board module stand-ins
+ *******************************************************************************/
+
+bool udp_server_app_process(void)
+{
+  return false;
+}
+
+void udp_server_app_set_rx_notify(udp_server_app_rx_notify_t notify)
+{
+  (void)notify;
+}
+
+void udp_server_app_send_led_toggle(void)
+{
+}
+
+void udp_server_app_start(void)
+{
+}
+
+void udp_server_app_stop(void)
+{
+}
+
+bool user_button_on_changed(button_id_t id, user_button_event_cb_t callback)
+{
+  (void)id;
+  (void)callback;
+  return true;
+}
+
+bool wifi_manager_set_event_callback(wifi_manager_event_cb_t callback, void *user_data)
+{
+  s_wifi_cb_user_data = user_data;
+  s_wifi_cb = callback;
+  return true;
+}
+
+/**
+ * Queues a request for the emulated Wi-Fi manager task; a full queue is answered with BUSY at once,
+ * as the real manager does.
+ */
+static bool sim_wifi_request(uint32_t request, uint32_t call_id)
+{
+  sim_wifi_request_t item = {.request = request, .call_id = call_id};
+
+  if ((NULL != s_wifi_queue) && (pdPASS == xQueueSend(s_wifi_queue, &item, 0U)))
+  {
+    return true;
+  }
+  if ((NULL != s_wifi_cb) && (IPC_CALL_ID_NONE != call_id))
+  {
+    ipc_wifi_status_t busy = s_wifi_status;
+
+    busy.reason = IPC_WIFI_REASON_BUSY;
+    s_wifi_cb(WIFI_MANAGER_EVENT_STATUS, &busy, 1U, call_id, s_wifi_cb_user_data);
+  }
+  return false;
+}
+
+bool wifi_manager_request_scan(const ipc_wifi_scan_request_t *request, uint32_t call_id)
+{
+  (void)request;
+  return sim_wifi_request(IPC_CMD_WIFI_SCAN_REQ, call_id);
+}
+
+bool wifi_manager_request_connect(const ipc_wifi_connect_request_t *request, uint32_t call_id)
+{
+  (void)request;
+  return sim_wifi_request(IPC_CMD_WIFI_CONNECT_REQ, call_id);
+}
+
+bool wifi_manager_request_disconnect(uint32_t call_id)
+{
+  return sim_wifi_request(IPC_CMD_WIFI_DISCONNECT_REQ, call_id);
+}
+
+bool wifi_manager_request_status(uint32_t call_id)
+{
+  return sim_wifi_request(IPC_CMD_WIFI_STATUS_REQ, call_id);
+}
+
+/**
+ * Emulated Wi-Fi manager: a scan takes scan_delay_ms and reports scan_aps access points, then
+ * completes; connect and disconnect switch the link state at once.
+ */
+static void sim_wifi_task(void *arg)
+{
+  sim_wifi_request_t item;
+
+  (void)arg;
+  for (;;)
+  {
+    if (pdPASS != xQueueReceive(s_wifi_queue, &item, portMAX_DELAY))
+    {
+      continue;
+    }
+    if (IPC_CMD_WIFI_SCAN_REQ == item.request)
+    {
+      uint32_t count = (s_load.scan_aps < IPC_WIFI_SCAN_BULK_MAX) ? s_load.scan_aps : IPC_WIFI_SCAN_BULK_MAX;
+      ipc_wifi_scan_complete_t complete = {.total_count = (uint16_t)count, .status = 0U};
+
+      vTaskDelay(pdMS_TO_TICKS(s_load.scan_delay_ms));
+      for (uint32_t i = 0U; i < count; i++)
+      {
+        s_scan_list[i].rssi = -40 - (int32_t)i;
+        s_scan_list[i].channel = (uint8_t)(1U + (i % 13U));
+        s_scan_list[i].mac[5] = (uint8_t)i;
+      }
+      s_scans++;
+      if (0U != count)
+      {
+        s_wifi_cb(WIFI_MANAGER_EVENT_SCAN_RESULT, s_scan_list, count, item.call_id, s_wifi_cb_user_data);
+      }
+      s_wifi_cb(WIFI_MANAGER_EVENT_SCAN_COMPLETE, &complete, 1U, item.call_id, s_wifi_cb_user_data);
+      continue;
+    }
+    if (IPC_CMD_WIFI_CONNECT_REQ == item.request)
+    {
+      s_wifi_status.state = (uint8_t)IPC_WIFI_LINK_CONNECTED;
+      s_wifi_status.rssi = -42;
+    }
+    else if (IPC_CMD_WIFI_DISCONNECT_REQ == item.request)
+    {
+      s_wifi_status.state = (uint8_t)IPC_WIFI_LINK_DISCONNECTED;
+      s_wifi_status.rssi = 0;
+    }
+    s_wifi_status.reason = 0U;
+    s_wifi_cb(WIFI_MANAGER_EVENT_STATUS, &s_wifi_status, 1U, item.call_id, s_wifi_cb_user_data);
+  }
+}
+
+/*******************************************************************************
+ * Load generators
+ *******************************************************************************/
+
+static bool sim_emit_gyro(uint32_t sequence)
+{
+  gyro_data_t data;
+
+  data.ax = (float)(sequence % 100U) * 0.01f;
+  data.ay = -data.ax;
+  data.az = 1.0f;
+  return cm33_ipc_send_gyro_data(&data, sequence);
+}
+
+static bool sim_emit_touch(uint32_t sequence)
+{
+  return cm33_ipc_send_touch((int16_t)(sequence % 480U), (int16_t)(sequence % 320U), (uint8_t)(sequence & 1U));
+}
+
+static bool sim_emit_event(uint32_t sequence)
+{
+  return event_bus_publish(s_bus, SIM_EVENT_TO_CM55, &sequence);
+}
+
+/**
+ * Subscriber of the events CM55 posts (ipc_task): counts them and the gaps in their sequence.
+ */
+static void sim_event_cb(uint32_t event_id, void *event_data)
+{
+  uint32_t sequence;
+
+  (void)event_id;
+  (void)memcpy(&sequence, event_data, sizeof(sequence));
+  if (sequence > s_events_next)
+  {
+    s_events_lost += sequence - s_events_next;
+  }
+  s_events_next = sequence + 1U;
+  s_events_received++;
+}
+
+/**
+ * Sends what a source owes at its rate since the load was switched on, then sleeps one tick. Rates
+ * above the tick rate are met on average, in bursts of several samples per tick.
+ */
+static void sim_source_task(void *arg)
+{
+  sim_source_t *source = (sim_source_t *)arg;
+  uint64_t start_us = 0U;
+  uint32_t sequence = 0U;
+  bool running = false;
+
+  for (;;)
+  {
+    if (!s_load_on || (0U == *source->hz))
+    {
+      running = false;
+      vTaskDelay(1U);
+      continue;
+    }
+    if (!running)
+    {
+      running = true;
+      start_us = sim_port_now_us();
+      sequence = 0U;
+    }
+    while (sequence < (uint32_t)(((sim_port_now_us() - start_us) * *source->hz) / 1000000ULL))
+    {
+      source->offered++;
+      if (!source->emit(sequence))
+      {
+        source->refused++;
+      }
+      sequence++;
+    }
+    vTaskDelay(1U);
+  }
+}
+
+/*******************************************************************************
+ * Simulator interface
+ *******************************************************************************/
+
+bool cm33_sim_start(const sim_load_t *load)
+{
+  if (NULL == load)
+  {
+    return false;
+  }
+  s_load = *load;
+  (void)memset(&s_wifi_status, 0, sizeof(s_wifi_status));
+  for (uint32_t i = 0U; i < IPC_WIFI_SCAN_BULK_MAX; i++)
+  {
+    (void)snprintf(s_scan_list[i].ssid, sizeof(s_scan_list[i].ssid), "sim-ap-%02lu", (unsigned long)i);
+    (void)snprintf(s_scan_list[i].security, sizeof(s_scan_list[i].security), "WPA2_AES_PSK");
+  }
+
+  s_wifi_queue = xQueueCreate(SIM_CM33_WIFI_QUEUE_LEN, sizeof(sim_wifi_request_t));
+  if ((NULL == s_wifi_queue) ||
+      (pdPASS != xTaskCreate(sim_wifi_task, "WiFi Mgr", SIM_CM33_TASK_STACK, NULL, SIM_CM33_WIFI_PRIO, NULL)))
+  {
+    return false;
+  }
+  if (!cm33_ipc_pipe_start())
+  {
+    return false;
+  }
+  s_bus = event_bus_create(SIM_EVENT_COUNT);
+  if ((NULL == s_bus) || !event_bus_set_remote(s_bus, SIM_EVENT_TO_CM33, true, sizeof(uint32_t)) ||
+      !event_bus_set_remote(s_bus, SIM_EVENT_TO_CM55, true, sizeof(uint32_t)) ||
+      !event_bus_subscribe(s_bus, SIM_EVENT_TO_CM33, sim_event_cb) || !cm33_ipc_bridge_attach(s_bus))
+  {
+    return false;
+  }
+  return (pdPASS == xTaskCreate(sim_source_task, "Gyro", SIM_CM33_TASK_STACK, &s_gyro_source,
+                                SIM_CM33_LOAD_PRIO, NULL)) &&
+         (pdPASS == xTaskCreate(sim_source_task, "Touch", SIM_CM33_TASK_STACK, &s_touch_source,
+                                SIM_CM33_LOAD_PRIO, NULL)) &&
+         (pdPASS == xTaskCreate(sim_source_task, "Events", SIM_CM33_TASK_STACK, &s_event_source,
+                                SIM_CM33_LOAD_PRIO, NULL));
+}
+
+void cm33_sim_load(bool on)
+{
+  s_load_on = on;
+}
+
+void cm33_sim_reset(void)
+{
+  cm33_ipc_reset_cmd_stats();
+  cm33_ipc_reset_recv_stats();
+  s_gyro_source.offered = 0U;
+  s_gyro_source.refused = 0U;
+  s_touch_source.offered = 0U;
+  s_touch_source.refused = 0U;
+  s_event_source.offered = 0U;
+  s_event_source.refused = 0U;
+  s_scans = 0U;
+  s_uart_base = sim_port_console_bytes(SIM_CORE_CM33);
+  taskENTER_CRITICAL();
+  s_events_received = 0U;
+  s_events_lost = 0U;
+  s_events_next = 0U;
+  taskEXIT_CRITICAL();
+  (void)cm33_ipc_get_bridge_stats(&s_bridge_base);
+}
+
+/**
+ * Count and percentiles of one ipc_stats histogram.
+ */
+static void sim_cm33_latency(const ipc_stats_hist_t *hist, sim_latency_t *latency)
+{
+  latency->count = hist->count;
+  latency->p50_us = ipc_stats_hist_percentile(hist, 50U);
+  latency->p99_us = ipc_stats_hist_percentile(hist, 99U);
+  latency->max_us = hist->max_us;
+}
+
+bool cm33_sim_cmd_report(uint32_t cmd, sim_cmd_report_t *report)
+{
+  ipc_stats_cmd_t stats;
+
+  if ((NULL == report) || !cm33_ipc_get_cmd_stats(cmd, &stats))
+  {
+    return false;
+  }
+  report->sent = stats.sent;
+  report->dropped = stats.dropped;
+  report->received = stats.received;
+  report->received_bytes = stats.received_bytes;
+  report->overflows = stats.overflows;
+  sim_cm33_latency(&stats.queue, &report->queue);
+  sim_cm33_latency(&stats.transit, &report->transit);
+  sim_cm33_latency(&stats.dispatch, &report->dispatch);
+  return (0U != stats.sent) || (0U != stats.dropped) || (0U != stats.received);
+}
+
+void cm33_sim_report(sim_cm33_report_t *report)
+{
+  cm33_ipc_recv_stats_t recv;
+  ipc_event_bridge_stats_t bridge;
+
+  if (NULL == report)
+  {
+    return;
+  }
+  (void)memset(report, 0, sizeof(*report));
+  report->gyro_offered = s_gyro_source.offered;
+  report->gyro_refused = s_gyro_source.refused;
+  report->touch_offered = s_touch_source.offered;
+  report->touch_refused = s_touch_source.refused;
+  report->scans = s_scans;
+  report->uart_bytes = sim_port_console_bytes(SIM_CORE_CM33) - s_uart_base;
+  for (uint32_t lane = 0U; lane < (uint32_t)IPC_LANE_COUNT; lane++)
+  {
+    if (cm33_ipc_get_recv_stats((ipc_lane_t)lane, &recv))
+    {
+      report->recv_peak += recv.peak;
+    }
+  }
+  report->events_offered = s_event_source.offered;
+  report->events_received = s_events_received;
+  report->events_lost = s_events_lost;
+  if (cm33_ipc_get_bridge_stats(&bridge))
+  {
+    report->bridge_dropped = bridge.dropped - s_bridge_base.dropped;
+    report->bridge_batches = bridge.batches_sent - s_bridge_base.batches_sent;
+  }
+}
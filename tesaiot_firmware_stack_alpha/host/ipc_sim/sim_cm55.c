@@ -0,0 +1,403 @@
+/*******************************************************************************
+ * File Name        : sim_cm55.c
+ *
+ * Description      : CM55 side of the IPC simulator: stand-ins for the modules
+ *                    the CM55 IPC app calls (touch input, fatal error), the
+ *                    print, Wi-Fi call and blackboard reader load tasks, and
+ *                    the CM55 half of the report.
+ *
+ * Author           : Asst.Prof.Santi Nuratch, Ph.D
+ *                    Thailand Embedded Systems Association (TESA)
+ *
+ *******************************************************************************/
+
+#include "sim_board.h"
+
+#include "cm55_fatal_error.h"
+#include "cm55_ipc_app.h"
+#include "cm55_ipc_pipe.h"
+#include "cm55_stdout_ipc.h"
+#include "ipc_blackboard.h"
+#include "ipc_cmd.h"
+#include "ipc_stats.h"
+#include "lv_port_indev.h"
+#include "sim_port.h"
+#include "task.h"
+#include "tesa_event_bus.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define SIM_CM55_TASK_STACK (1024U)
+#define SIM_CM55_LOAD_PRIO (2U)
+#define SIM_CM55_LINE_MAX (256U) /* Longest printed line */
+#define SIM_EVENT_TO_CM33 (1U)    /* Bridged channels, the same event IDs on CM33 */
+#define SIM_EVENT_TO_CM55 (2U)
+#define SIM_EVENT_QUEUE_LEN (32U)
+
+/*******************************************************************************
+ * Global Variables
+ *******************************************************************************/
+static sim_load_t s_load;
+static volatile bool s_load_on = false;
+static volatile uint32_t s_touches = 0U;
+static volatile uint32_t s_gyro_reads = 0U;
+static volatile uint32_t s_calls = 0U;
+static volatile uint32_t s_calls_ok = 0U;
+static ipc_stats_hist_t s_gyro_age;
+static ipc_stats_hist_t s_call_rtt;
+static cm55_stdout_ipc_stats_t s_stdout_base;
+static uint32_t s_credit_stalls_base = 0U;
+static uint32_t s_bulk_throttles_base = 0U;
+static QueueHandle_t s_event_queue = NULL;
+static volatile uint32_t s_events_offered = 0U;
+static volatile uint32_t s_events_received = 0U;
+static volatile uint32_t s_events_lost = 0U;
+static uint32_t s_events_next = 0U; /* Next sequence expected from CM33 */
+static ipc_event_bridge_stats_t s_bridge_base;
+
+int _write(int fd, const char *ptr, int len);
+
+/*******************************************************************************
+ * Module stand-ins
+ *******************************************************************************/
+
+void cm55_handle_fatal_error(const char *format, ...)
+{
+  va_list args;
+
+  va_start(args, format);
+  (void)vfprintf(stderr, format, args);
+  va_end(args);
+  (void)fputc('\n', stderr);
+  abort();
+}
+
+void lv_port_indev_touch_from_ipc_set(int16_t x, int16_t y, uint8_t pressed)
+{
+  (void)x;
+  (void)y;
+  (void)pressed;
+  s_touches++;
+}
+
+/**
+ * CM55 console: what the app prints goes through cm55_stdout_ipc, as newlib's _write() does on target.
+ */
+static void sim_cm55_console(const char *data, size_t len)
+{
+  (void)_write(1, data, (int)len);
+}
+
+/*******************************************************************************
+ * Load generators
+ *******************************************************************************/
+
+/**
+ * Prints print_len-character lines at print_hz, paced like the CM33 sources.
+ */
+static void sim_print_task(void *arg)
+{
+  char line[SIM_CM55_LINE_MAX + 1U];
+  uint64_t start_us = 0U;
+  uint32_t sequence = 0U;
+  bool running = false;
+
+  (void)arg;
+  for (;;)
+  {
+    uint32_t len = (s_load.print_len < SIM_CM55_LINE_MAX) ? s_load.print_len : SIM_CM55_LINE_MAX;
+
+    if (!s_load_on || (0U == s_load.print_hz) || (len < 2U))
+    {
+      running = false;
+      vTaskDelay(1U);
+      continue;
+    }
+    if (!running)
+    {
+      running = true;
+      start_us = sim_port_now_us();
+      sequence = 0U;
+    }
+    while (sequence < (uint32_t)(((sim_port_now_us() - start_us) * s_load.print_hz) / 1000000ULL))
+    {
+      (void)memset(line, (int)('a' + (sequence % 26U)), len - 1U);
+      line[len - 1U] = '\n';
+      line[len] = '\0';
+      (void)fputs(line, stdout);
+      sequence++;
+    }
+    vTaskDelay(1U);
+  }
+}
+
+/**
+ * Runs one Wi-Fi scan call at a time and waits for its answer, then sleeps out the rest of scan_period_ms.
+ */
+static void sim_call_task(void *arg)
+{
+  cm55_ipc_call_reply_t reply;
+
+  (void)arg;
+  for (;;)
+  {
+    uint32_t call_id;
+    uint32_t start_us;
+    uint32_t elapsed_ms;
+
+    if (!s_load_on || (0U == s_load.scan_period_ms))
+    {
+      vTaskDelay(1U);
+      continue;
+    }
+    start_us = ipc_stats_now_us();
+    call_id = cm55_call_scan(NULL, 0U, NULL, NULL);
+    s_calls++;
+    if ((IPC_CALL_ID_NONE != call_id) && (CM55_IPC_CALL_OK == cm55_call_wait(call_id, &reply)))
+    {
+      s_calls_ok++;
+      ipc_stats_hist_record(&s_call_rtt, ipc_stats_now_us() - start_us);
+    }
+    elapsed_ms = (ipc_stats_now_us() - start_us) / 1000U;
+    if (elapsed_ms < s_load.scan_period_ms)
+    {
+      vTaskDelay(pdMS_TO_TICKS(s_load.scan_period_ms - elapsed_ms));
+    }
+  }
+}
+
+/**
+ * Posts event_hz events on the channel CM33 subscribes to, paced like the print task.
+ */
+static void sim_event_task(void *arg)
+{
+  uint64_t start_us = 0U;
+  uint32_t sequence = 0U;
+  bool running = false;
+
+  (void)arg;
+  for (;;)
+  {
+    if (!s_load_on || (0U == s_load.event_hz))
+    {
+      running = false;
+      vTaskDelay(1U);
+      continue;
+    }
+    if (!running)
+    {
+      running = true;
+      start_us = sim_port_now_us();
+      sequence = 0U;
+    }
+    while (sequence < (uint32_t)(((sim_port_now_us() - start_us) * s_load.event_hz) / 1000000ULL))
+    {
+      (void)tesa_event_bus_post(SIM_EVENT_TO_CM33, 0U, &sequence, sizeof(sequence));
+      s_events_offered++;
+      sequence++;
+    }
+    vTaskDelay(1U);
+  }
+}
+
+/**
+ * Subscriber of the events CM33 publishes: counts them and the gaps in their sequence.
+ */
+static void sim_event_reader_task(void *arg)
+{
+  tesa_event_t *event;
+  uint32_t sequence;
+
+  (void)arg;
+  for (;;)
+  {
+    if (pdTRUE != tesa_event_bus_receive(s_event_queue, &event, portMAX_DELAY))
+    {
+      continue;
+    }
+    (void)memcpy(&sequence, event->payload, sizeof(sequence));
+    tesa_event_bus_free_event(event);
+    taskENTER_CRITICAL();
+    if (sequence > s_events_next)
+    {
+      s_events_lost += sequence - s_events_next;
+    }
+    s_events_next = sequence + 1U;
+    s_events_received++;
+    taskEXIT_CRITICAL();
+  }
+}
+
+/**
+ * Polls the IMU blackboard slot once a tick and records how old each new sample is.
+ */
+static void sim_gyro_reader_task(void *arg)
+{
+  ipc_imu_sample_t sample;
+  uint32_t last_version = 0U;
+
+  (void)arg;
+  for (;;)
+  {
+    const ipc_blackboard_t *board = cm55_ipc_pipe_get_blackboard();
+    uint32_t version = 0U;
+    uint32_t stamp_us = 0U;
+
+    if (s_load_on && (NULL != board) &&
+        ipc_blackboard_read(board, IPC_BLACKBOARD_IMU, &sample, sizeof(sample), &version, &stamp_us) &&
+        (version != last_version))
+    {
+      last_version = version;
+      s_gyro_reads++;
+      ipc_stats_hist_record(&s_gyro_age, ipc_stats_now_us() - stamp_us);
+    }
+    vTaskDelay(1U);
+  }
+}
+
+/*******************************************************************************
+ * Simulator interface
+ *******************************************************************************/
+
+bool cm55_sim_start(const sim_load_t *load)
+{
+  if (NULL == load)
+  {
+    return false;
+  }
+  s_load = *load;
+  sim_port_set_console(SIM_CORE_CM55, sim_cm55_console);
+  if (!cm55_ipc_app_init())
+  {
+    return false;
+  }
+  s_event_queue = xQueueCreate(SIM_EVENT_QUEUE_LEN, sizeof(tesa_event_t *));
+  if ((NULL == s_event_queue) || (TESA_EVENT_BUS_SUCCESS != tesa_event_bus_init()) ||
+      (TESA_EVENT_BUS_SUCCESS != tesa_event_bus_register_channel(SIM_EVENT_TO_CM33, "sim_to_cm33")) ||
+      (TESA_EVENT_BUS_SUCCESS != tesa_event_bus_register_channel(SIM_EVENT_TO_CM55, "sim_to_cm55")) ||
+      (TESA_EVENT_BUS_SUCCESS != tesa_event_bus_set_channel_remote(SIM_EVENT_TO_CM33, true)) ||
+      (TESA_EVENT_BUS_SUCCESS != tesa_event_bus_set_channel_remote(SIM_EVENT_TO_CM55, true)) ||
+      (TESA_EVENT_BUS_SUCCESS != tesa_event_bus_subscribe(SIM_EVENT_TO_CM55, s_event_queue)) ||
+      !cm55_ipc_app_bridge_start())
+  {
+    return false;
+  }
+  return (pdPASS == xTaskCreate(sim_print_task, "Print", SIM_CM55_TASK_STACK, NULL, SIM_CM55_LOAD_PRIO, NULL)) &&
+         (pdPASS == xTaskCreate(sim_event_task, "Events", SIM_CM55_TASK_STACK, NULL, SIM_CM55_LOAD_PRIO, NULL)) &&
+         (pdPASS == xTaskCreate(sim_event_reader_task, "Event Reader", SIM_CM55_TASK_STACK, NULL,
+                                SIM_CM55_LOAD_PRIO, NULL)) &&
+         (pdPASS == xTaskCreate(sim_call_task, "Calls", SIM_CM55_TASK_STACK, NULL, SIM_CM55_LOAD_PRIO, NULL)) &&
+         (pdPASS == xTaskCreate(sim_gyro_reader_task, "Gyro Reader", SIM_CM55_TASK_STACK, NULL,
+                                SIM_CM55_LOAD_PRIO, NULL));
+}
+
+void cm55_sim_load(bool on)
+{
+  s_load_on = on;
+}
+
+void cm55_sim_reset(void)
+{
+  cm55_ipc_pipe_reset_cmd_stats();
+  taskENTER_CRITICAL();
+  s_touches = 0U;
+  s_gyro_reads = 0U;
+  s_calls = 0U;
+  s_calls_ok = 0U;
+  (void)memset(&s_gyro_age, 0, sizeof(s_gyro_age));
+  (void)memset(&s_call_rtt, 0, sizeof(s_call_rtt));
+  s_events_offered = 0U;
+  s_events_received = 0U;
+  s_events_lost = 0U;
+  s_events_next = 0U;
+  taskEXIT_CRITICAL();
+  (void)cm55_ipc_app_get_bridge_stats(&s_bridge_base);
+  if (!cm55_stdout_ipc_get_stats(&s_stdout_base))
+  {
+    (void)memset(&s_stdout_base, 0, sizeof(s_stdout_base));
+  }
+  s_credit_stalls_base = cm55_ipc_pipe_get_credit_stalls();
+  s_bulk_throttles_base = cm55_ipc_pipe_get_bulk_throttles();
+}
+
+/**
+ * Count and percentiles of one ipc_stats histogram.
+ */
+static void sim_cm55_latency(const ipc_stats_hist_t *hist, sim_latency_t *latency)
+{
+  latency->count = hist->count;
+  latency->p50_us = ipc_stats_hist_percentile(hist, 50U);
+  latency->p99_us = ipc_stats_hist_percentile(hist, 99U);
+  latency->max_us = hist->max_us;
+}
+
+bool cm55_sim_cmd_report(uint32_t cmd, sim_cmd_report_t *report)
+{
+  ipc_stats_cmd_t stats;
+
+  if ((NULL == report) || !cm55_ipc_pipe_get_cmd_stats(cmd, &stats))
+  {
+    return false;
+  }
+  report->sent = stats.sent;
+  report->dropped = stats.dropped;
+  report->received = stats.received;
+  report->received_bytes = stats.received_bytes;
+  report->overflows = stats.overflows;
+  sim_cm55_latency(&stats.queue, &report->queue);
+  sim_cm55_latency(&stats.transit, &report->transit);
+  sim_cm55_latency(&stats.dispatch, &report->dispatch);
+  return (0U != stats.sent) || (0U != stats.dropped) || (0U != stats.received);
+}
+
+void cm55_sim_report(sim_cm55_report_t *report)
+{
+  cm55_stdout_ipc_stats_t out;
+  ipc_stats_sync_t sync;
+  ipc_event_bridge_stats_t bridge;
+
+  if (NULL == report)
+  {
+    return;
+  }
+  (void)memset(report, 0, sizeof(*report));
+  report->touches = s_touches;
+  report->gyro_reads = s_gyro_reads;
+  sim_cm55_latency(&s_gyro_age, &report->gyro_age);
+  report->calls = s_calls;
+  report->calls_ok = s_calls_ok;
+  sim_cm55_latency(&s_call_rtt, &report->call_rtt);
+  if (cm55_stdout_ipc_get_stats(&out))
+  {
+    report->stdout_written = out.written - s_stdout_base.written;
+    report->stdout_dropped = out.dropped - s_stdout_base.dropped;
+    report->stdout_frames = out.frames - s_stdout_base.frames;
+    report->stdout_retries = out.retries - s_stdout_base.retries;
+  }
+  report->credit_stalls = cm55_ipc_pipe_get_credit_stalls() - s_credit_stalls_base;
+  report->bulk_throttles = cm55_ipc_pipe_get_bulk_throttles() - s_bulk_throttles_base;
+  if (cm55_ipc_pipe_get_time_sync(&sync))
+  {
+    report->sync_offset_us = sync.offset_us;
+    report->sync_rtt_us = sync.rtt_us;
+  }
+  report->events_offered = s_events_offered;
+  report->events_received = s_events_received;
+  report->events_lost = s_events_lost;
+  if (cm55_ipc_app_get_bridge_stats(&bridge))
+  {
+    report->bridge_dropped = bridge.dropped - s_bridge_base.dropped;
+    report->bridge_batches = bridge.batches_sent - s_bridge_base.batches_sent;
+  }
+}
+
+const char *cm55_sim_cmd_name(uint32_t cmd)
+{
+  return ipc_cmd_name(cmd);
+}
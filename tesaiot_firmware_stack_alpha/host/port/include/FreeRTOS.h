@@ -0,0 +1,70 @@
+/*******************************************************************************
+ * File Name        : FreeRTOS.h
+ *
+ * Description      : Host simulator: FreeRTOS base types and configuration.
+ *                    Only the subset used by the IPC modules is provided;
+ *                    see sim_port.h.
+ *
+ * Author           : Asst.Prof.Santi Nuratch, Ph.D
+ *                    Thailand Embedded Systems Association (TESA)
+ *
+ *******************************************************************************/
+
+#ifndef INC_FREERTOS_H
+#define INC_FREERTOS_H
+
+#include "sim_port.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t TickType_t;
+typedef uint32_t StackType_t;
+typedef uint32_t configSTACK_DEPTH_TYPE;
+
+#define pdTRUE ((BaseType_t)1)
+#define pdFALSE ((BaseType_t)0)
+#define pdPASS (pdTRUE)
+#define pdFAIL (pdFALSE)
+#define errQUEUE_FULL ((BaseType_t)0)
+#define errQUEUE_EMPTY ((BaseType_t)0)
+
+#define configTICK_RATE_HZ (1000U)
+#define configMAX_PRIORITIES (7U)
+#define configMINIMAL_STACK_SIZE (128U)
+#define configTIMER_TASK_PRIORITY (configMAX_PRIORITIES - 1U)
+#define configUSE_TASK_NOTIFICATIONS (1)
+#define configUSE_TIMERS (1)
+#define configSUPPORT_STATIC_ALLOCATION (1)
+#define configSUPPORT_DYNAMIC_ALLOCATION (1)
+#define configASSERT(x)                                                                                                \
+  do                                                                                                                   \
+  {                                                                                                                    \
+    if (!(x))                                                                                                          \
+    {                                                                                                                  \
+      __builtin_trap();                                                                                                \
+    }                                                                                                                  \
+  } while (0)
+
+#define tskIDLE_PRIORITY (0U)
+#define portMAX_DELAY ((TickType_t)0xFFFFFFFFUL)
+#define portTICK_PERIOD_MS ((TickType_t)1000U / configTICK_RATE_HZ)
+#define pdMS_TO_TICKS(ms) ((TickType_t)(((uint64_t)(ms) * configTICK_RATE_HZ) / 1000U))
+#define pdTICKS_TO_MS(ticks) ((TickType_t)(((uint64_t)(ticks) * 1000U) / configTICK_RATE_HZ))
+
+#define portYIELD() sim_port_yield()
+#define portYIELD_FROM_ISR(woken) ((void)(woken))
+#define portEND_SWITCHING_ISR(woken) ((void)(woken))
+#define portMEMORY_BARRIER() __sync_synchronize()
+#define portDISABLE_INTERRUPTS() sim_port_enter_critical()
+#define portENABLE_INTERRUPTS() sim_port_exit_critical()
+#define portSET_INTERRUPT_MASK_FROM_ISR() (sim_port_enter_critical(), 0U)
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR(state) ((void)(state), sim_port_exit_critical())
+
+BaseType_t xPortIsInsideInterrupt(void);
+void *pvPortMalloc(size_t size);
+void vPortFree(void *ptr);
+
+#endif /* INC_FREERTOS_H */
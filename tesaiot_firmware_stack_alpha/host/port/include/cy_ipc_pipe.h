@@ -0,0 +1,92 @@
+/*******************************************************************************
+ * File Name        : cy_ipc_pipe.h
+ *
+ * Description      : Host simulator: IPC pipe driver. An endpoint's channel
+ *                    stays busy from Cy_IPC_Pipe_SendMessage() until the
+ *                    receiving core's interrupt has run the client callback,
+ *                    as on the device; the interrupt runs on a thread of the
+ *                    core that called Cy_IPC_Pipe_Init() for that endpoint.
+ *
+ * Author           : Asst.Prof.Santi Nuratch, Ph.D
+ *                    Thailand Embedded Systems Association (TESA)
+ *
+ *******************************************************************************/
+
+#ifndef CY_IPC_PIPE_H
+#define CY_IPC_PIPE_H
+
+#include "cy_utils.h"
+
+#define CY_IPC_CH_MASK(chan) (1UL << (chan))
+#define CY_IPC_INTR_MASK(intr) (1UL << (intr))
+#define CY_IPC0_INTR_MUX(intr) (intr)
+#define CY_IPC_PIPE_MSG_CLIENT_MASK (0xFFUL) /* Client ID: low byte of the first message word */
+#define CY_IPC_PIPE_EP_COUNT (8UL)
+
+#define IPC0_SEMA_CH_NUM (0UL)
+#define CY_IPC_SEMA_COUNT (128UL)
+#define CY_IPC_SEMA_PER_WORD (32UL)
+
+typedef void (*cy_ipc_pipe_callback_ptr_t)(uint32_t *msg_data);
+typedef void (*cy_ipc_pipe_relcallback_ptr_t)(void);
+typedef cy_ipc_pipe_callback_ptr_t cy_ipc_pipe_callback_array_ptr_t;
+
+typedef enum
+{
+  CY_IPC_PIPE_SUCCESS = 0x00U,
+  CY_IPC_PIPE_ERROR_NO_IPC = 0x01U,
+  CY_IPC_PIPE_ERROR_SEND_BUSY = 0x02U,
+  CY_IPC_PIPE_ERROR_BAD_CLIENT = 0x03U,
+  CY_IPC_PIPE_ERROR_BAD_HANDLE = 0x04U
+} cy_en_ipc_pipe_status_t;
+
+typedef enum
+{
+  CY_IPC_SEMA_SUCCESS = 0x00U,
+  CY_IPC_SEMA_NOT_ACQUIRED = 0x01U,
+  CY_IPC_SEMA_OUT_OF_RANGE = 0x02U
+} cy_en_ipc_sema_status_t;
+
+typedef struct
+{
+  uint32_t reserved;
+} cy_stc_ipc_pipe_ep_t;
+
+typedef struct
+{
+  uint32_t epChannel;
+  uint32_t epIntr;
+  uint32_t epIntrmask;
+} cy_stc_ipc_pipe_ep_intr_t;
+
+typedef struct
+{
+  uint32_t ipcNotifierNumber;
+  uint32_t ipcNotifierPriority;
+  uint32_t ipcNotifierMuxNumber;
+  uint32_t epAddress;
+  cy_stc_ipc_pipe_ep_intr_t epConfig;
+} cy_stc_ipc_pipe_ep_config_t;
+
+typedef struct
+{
+  cy_stc_ipc_pipe_ep_config_t ep0ConfigData; /* Receiver endpoint of the calling core */
+  cy_stc_ipc_pipe_ep_config_t ep1ConfigData; /* Sender endpoint (the other core) */
+  uint32_t endpointClientsCount;
+  cy_ipc_pipe_callback_array_ptr_t *endpointsCallbacksArray;
+  void (*userPipeIsrHandler)(void);
+} cy_stc_ipc_pipe_config_t;
+
+void Cy_IPC_Pipe_Config(cy_stc_ipc_pipe_ep_t *endpoints);
+void Cy_IPC_Pipe_Init(const cy_stc_ipc_pipe_config_t *config);
+cy_en_ipc_pipe_status_t Cy_IPC_Pipe_RegisterCallback(uint32_t ep_addr, cy_ipc_pipe_callback_ptr_t callback,
+                                                     uint32_t client_id);
+cy_en_ipc_pipe_status_t Cy_IPC_Pipe_SendMessage(uint32_t to_addr, uint32_t from_addr, void *msg,
+                                                cy_ipc_pipe_relcallback_ptr_t callback);
+void Cy_IPC_Pipe_ExecuteCallback(uint32_t ep_addr);
+
+void Cy_IPC_Sema_Init(uint32_t ipc_channel, uint32_t count, uint32_t *memory);
+cy_en_ipc_sema_status_t Cy_IPC_Sema_Set(uint32_t ipc_channel, uint32_t sema_number);
+cy_en_ipc_sema_status_t Cy_IPC_Sema_Clear(uint32_t ipc_channel, uint32_t sema_number);
+
+#endif /* CY_IPC_PIPE_H */
@@ -0,0 +1,23 @@
+/*******************************************************************************
+ * File Name        : cy_pdl.h
+ *
+ * Description      : Host simulator: the PDL subset used by the IPC modules.
+ *
+ * Author           : Asst.Prof.Santi Nuratch, Ph.D
+ *                    Thailand Embedded Systems Association (TESA)
+ *
+ *******************************************************************************/
+
+#ifndef CY_PDL_H
+#define CY_PDL_H
+
+#include "cy_ipc_pipe.h"
+#include "cy_sysint.h"
+#include "cy_syslib.h"
+#include "cy_utils.h"
+
+void Cy_GPIO_Inv(GPIO_PRT_Type *base, uint32_t pin);
+void Cy_GPIO_Write(GPIO_PRT_Type *base, uint32_t pin, uint32_t value);
+uint32_t Cy_GPIO_Read(GPIO_PRT_Type *base, uint32_t pin);
+
+#endif /* CY_PDL_H */
@@ -0,0 +1,34 @@
+/*******************************************************************************
+ * File Name        : cy_sysint.h
+ *
+ * Description      : Host simulator: interrupt configuration. The IPC pipe
+ *                    interrupt is wired by Cy_IPC_Pipe_Init(); this only
+ *                    accepts the calls.
+ *
+ * Author           : Asst.Prof.Santi Nuratch, Ph.D
+ *                    Thailand Embedded Systems Association (TESA)
+ *
+ *******************************************************************************/
+
+#ifndef CY_SYSINT_H
+#define CY_SYSINT_H
+
+#include "cy_utils.h"
+
+typedef void (*cy_israddress)(void);
+
+typedef enum
+{
+  CY_SYSINT_SUCCESS = 0x00U,
+  CY_SYSINT_BAD_PARAM = 0x01U
+} cy_en_sysint_status_t;
+
+typedef struct
+{
+  IRQn_Type intrSrc;
+  uint32_t intrPriority;
+} cy_stc_sysint_t;
+
+cy_en_sysint_status_t Cy_SysInt_Init(const cy_stc_sysint_t *config, cy_israddress user_isr);
+
+#endif /* CY_SYSINT_H */
@@ -0,0 +1,24 @@
+/*******************************************************************************
+ * File Name        : cy_syslib.h
+ *
+ * Description      : Host simulator: SysLib critical sections and delays.
+ *                    A critical section holds the calling core's interrupt
+ *                    lock (see sim_port_enter_critical()).
+ *
+ * Author           : Asst.Prof.Santi Nuratch, Ph.D
+ *                    Thailand Embedded Systems Association (TESA)
+ *
+ *******************************************************************************/
+
+#ifndef CY_SYSLIB_H
+#define CY_SYSLIB_H
+
+#include "cy_utils.h"
+
+uint32_t Cy_SysLib_EnterCriticalSection(void);
+void Cy_SysLib_ExitCriticalSection(uint32_t saved_intr_status);
+void Cy_SysLib_Delay(uint32_t milliseconds);
+void Cy_SysLib_DelayUs(uint16_t microseconds);
+uint32_t Cy_SysLib_GetResetReason(void);
+
+#endif /* CY_SYSLIB_H */
@@ -0,0 +1,18 @@
+/*******************************************************************************
+ * File Name        : cy_time.h
+ *
+ * Description      : Host simulator: the tesa modules include the PDL time
+ *                    header but use only the C library time functions, which
+ *                    the host provides.
+ *
+ * Author           : Asst.Prof.Santi Nuratch, Ph.D
+ *                    Thailand Embedded Systems Association (TESA)
+ *
+ *******************************************************************************/
+
+#ifndef CY_TIME_H
+#define CY_TIME_H
+
+#include <time.h>
+
+#endif /* CY_TIME_H */
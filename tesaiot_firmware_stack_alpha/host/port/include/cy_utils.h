@@ -0,0 +1,81 @@
+/*******************************************************************************
+ * File Name        : cy_utils.h
+ *
+ * Description      : Host simulator: PDL utility macros and the CMSIS core
+ *                    registers the IPC modules touch. CY_SECTION_SHAREDMEM
+ *                    places objects in the sim_sharedmem section; DWT and
+ *                    SystemCoreClock read the calling thread's core.
+ *
+ * Author           : Asst.Prof.Santi Nuratch, Ph.D
+ *                    Thailand Embedded Systems Association (TESA)
+ *
+ *******************************************************************************/
+
+#ifndef CY_UTILS_H
+#define CY_UTILS_H
+
+#include "sim_port.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define CY_SECTION(name) __attribute__((section(name)))
+#define CY_SECTION_SHAREDMEM CY_SECTION("sim_sharedmem")
+#define CY_ALIGN(align) __attribute__((aligned(align)))
+#define CY_UNUSED_PARAMETER(x) ((void)(x))
+#define CY_ASSERT(x)                                                                                                   \
+  do                                                                                                                   \
+  {                                                                                                                    \
+    if (!(x))                                                                                                          \
+    {                                                                                                                  \
+      __builtin_trap();                                                                                                \
+    }                                                                                                                  \
+  } while (0)
+
+#define __DMB() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define __DSB() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define __ISB() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define __NOP() ((void)0)
+#define __WFI() sim_port_yield()
+#define __STATIC_INLINE static inline
+#define __STATIC_FORCEINLINE static inline __attribute__((always_inline))
+#define __ALIGNED(align) __attribute__((aligned(align)))
+#define __PACKED __attribute__((packed))
+#define __WEAK __attribute__((weak))
+
+typedef int IRQn_Type;
+typedef uint32_t cy_rslt_t;
+#define CY_RSLT_SUCCESS ((cy_rslt_t)0U)
+
+typedef struct
+{
+  volatile uint32_t DEMCR;
+} CoreDebug_Type;
+
+typedef struct
+{
+  volatile uint32_t CTRL;
+  volatile uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct
+{
+  volatile uint32_t OUT;
+} GPIO_PRT_Type;
+
+CoreDebug_Type *sim_port_core_debug(void);
+DWT_Type *sim_port_dwt(void);
+
+#define CoreDebug (sim_port_core_debug())
+#define DCB (sim_port_core_debug())
+#define DWT (sim_port_dwt()) /* CYCCNT is sampled on every access */
+#define CoreDebug_DEMCR_TRCENA_Msk (1UL << 24U)
+#define DCB_DEMCR_TRCENA_Msk (1UL << 24U)
+#define DWT_CTRL_CYCCNTENA_Msk (1UL)
+#define SystemCoreClock (sim_port_core_clock())
+
+void NVIC_EnableIRQ(IRQn_Type irq);
+void NVIC_DisableIRQ(IRQn_Type irq);
+void NVIC_SystemReset(void);
+
+#endif /* CY_UTILS_H */
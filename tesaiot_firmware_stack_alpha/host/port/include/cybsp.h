@@ -0,0 +1,23 @@
+/*******************************************************************************
+ * File Name        : cybsp.h
+ *
+ * Description      : Host simulator: board pins used by the IPC modules.
+ *
+ * Author           : Asst.Prof.Santi Nuratch, Ph.D
+ *                    Thailand Embedded Systems Association (TESA)
+ *
+ *******************************************************************************/
+
+#ifndef CYBSP_H
+#define CYBSP_H
+
+#include "cy_pdl.h"
+
+extern GPIO_PRT_Type sim_port_gpio;
+
+#define CYBSP_USER_LED_PORT (&sim_port_gpio)
+#define CYBSP_USER_LED_PIN (0UL)
+#define CYBSP_USER_LED2_PORT (&sim_port_gpio)
+#define CYBSP_USER_LED2_PIN (1UL)
+
+#endif /* CYBSP_H */
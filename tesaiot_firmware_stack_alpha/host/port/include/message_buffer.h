@@ -0,0 +1,38 @@
+/*******************************************************************************
+ * File Name        : message_buffer.h
+ *
+ * Description      : Host simulator: FreeRTOS message buffers. Each message
+ *                    costs its length plus a size_t length word, as in the
+ *                    kernel.
+ *
+ * Author           : Asst.Prof.Santi Nuratch, Ph.D
+ *                    Thailand Embedded Systems Association (TESA)
+ *
+ *******************************************************************************/
+
+#ifndef FREERTOS_MESSAGE_BUFFER_H
+#define FREERTOS_MESSAGE_BUFFER_H
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+typedef struct sim_message_buffer *MessageBufferHandle_t;
+typedef struct
+{
+  uint8_t reserved[64];
+} StaticMessageBuffer_t;
+
+MessageBufferHandle_t xMessageBufferCreate(size_t buffer_bytes);
+MessageBufferHandle_t xMessageBufferCreateStatic(size_t buffer_bytes, uint8_t *storage, StaticMessageBuffer_t *buffer);
+void vMessageBufferDelete(MessageBufferHandle_t mb);
+size_t xMessageBufferSend(MessageBufferHandle_t mb, const void *data, size_t length, TickType_t ticks_to_wait);
+size_t xMessageBufferSendFromISR(MessageBufferHandle_t mb, const void *data, size_t length, BaseType_t *woken);
+size_t xMessageBufferReceive(MessageBufferHandle_t mb, void *data, size_t max_length, TickType_t ticks_to_wait);
+size_t xMessageBufferReceiveFromISR(MessageBufferHandle_t mb, void *data, size_t max_length, BaseType_t *woken);
+size_t xMessageBufferNextLengthBytes(MessageBufferHandle_t mb);
+size_t xMessageBufferSpacesAvailable(MessageBufferHandle_t mb);
+BaseType_t xMessageBufferIsEmpty(MessageBufferHandle_t mb);
+BaseType_t xMessageBufferIsFull(MessageBufferHandle_t mb);
+BaseType_t xMessageBufferReset(MessageBufferHandle_t mb);
+
+#endif /* FREERTOS_MESSAGE_BUFFER_H */
@@ -0,0 +1,17 @@
+/*******************************************************************************
+ * File Name        : portmacro.h
+ *
+ * Description      : Host simulator: the port types and macros live in
+ *                    FreeRTOS.h; this header only satisfies direct includes.
+ *
+ * Author           : Asst.Prof.Santi Nuratch, Ph.D
+ *                    Thailand Embedded Systems Association (TESA)
+ *
+ *******************************************************************************/
+
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#include "FreeRTOS.h"
+
+#endif /* PORTMACRO_H */
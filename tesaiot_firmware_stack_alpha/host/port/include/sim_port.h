@@ -0,0 +1,112 @@
+/*******************************************************************************
+ * File Name        : sim_port.h
+ *
+ * Description      : Host (Linux, pthreads) stand-in for the parts of FreeRTOS
+ *                    and the PDL that the IPC modules use, so that CM33 and
+ *                    CM55 code can run side by side in one process. Every
+ *                    thread belongs to one emulated core: tasks, timers and
+ *                    the IPC interrupt inherit the core of the thread that
+ *                    created them, and critical sections, the DWT cycle
+ *                    counter and the timer service task are per core.
+ *
+ * Author           : Asst.Prof.Santi Nuratch, Ph.D
+ *                    Thailand Embedded Systems Association (TESA)
+ *
+ *******************************************************************************/
+
+#ifndef SIM_PORT_H
+#define SIM_PORT_H
+
+/*******************************************************************************
+ * Header Files
+ *******************************************************************************/
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define SIM_PORT_CM33_CLOCK_HZ (200000000UL) /* DWT rate of the emulated CM33 */
+#define SIM_PORT_CM55_CLOCK_HZ (400000000UL) /* DWT rate of the emulated CM55 */
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+
+typedef enum
+{
+  SIM_CORE_CM33 = 0U,
+  SIM_CORE_CM55 = 1U,
+  SIM_CORE_COUNT
+} sim_core_t;
+
+/** Console sink of a core: receives everything its stdout carries. */
+typedef void (*sim_port_console_t)(const char *data, size_t len);
+
+/*******************************************************************************
+ * Function prototypes
+ *******************************************************************************/
+
+/**
+ * Makes the calling thread run as core (the driver calls it before starting each core's firmware).
+ * Threads created afterwards from this thread belong to the same core.
+ */
+void sim_port_set_core(sim_core_t core);
+
+/**
+ * Core of the calling thread; SIM_CORE_CM33 for a thread that never chose one.
+ */
+sim_core_t sim_port_core(void);
+
+/**
+ * Microseconds since the first port call, from the host monotonic clock. Common to both cores.
+ */
+uint64_t sim_port_now_us(void);
+
+/**
+ * Lets the other tasks of the calling thread's core run (taskYIELD, __WFI).
+ */
+void sim_port_yield(void);
+
+/**
+ * Critical section of the calling thread's core: masks its emulated interrupts and keeps its other
+ * tasks out. Recursive. The other core is not affected.
+ */
+void sim_port_enter_critical(void);
+void sim_port_exit_critical(void);
+
+/**
+ * DWT cycle counter of the calling thread's core. Runs at the core's clock and starts at an
+ * arbitrary per-core offset, so the two cores never agree and wrap at different times.
+ */
+uint32_t sim_port_cycle_count(void);
+
+/**
+ * Clock of the calling thread's core in Hz (what SystemCoreClock reads).
+ */
+uint32_t sim_port_core_clock(void);
+
+/**
+ * Stdout of the calling thread's core, a line-buffered stream that feeds the core's console sink.
+ * The IPC sources are compiled with sim_stdio.h, which routes stdout, printf, puts and putchar here.
+ */
+FILE *sim_port_stdout(void);
+
+/**
+ * Sets the console sink of core (NULL: output is only counted). Call before the core starts.
+ */
+void sim_port_set_console(sim_core_t core, sim_port_console_t console);
+
+/**
+ * Bytes written to the console of core so far.
+ */
+uint64_t sim_port_console_bytes(sim_core_t core);
+
+/**
+ * Bytes of the shared-memory section: every CY_SECTION_SHAREDMEM object of both cores.
+ */
+size_t sim_port_sharedmem_bytes(void);
+
+#endif /* SIM_PORT_H */
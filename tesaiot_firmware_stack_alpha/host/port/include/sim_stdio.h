@@ -0,0 +1,29 @@
+/*******************************************************************************
+ * File Name        : sim_stdio.h
+ *
+ * Description      : Host simulator: forced include (-include sim_stdio.h)
+ *                    for firmware sources. Routes stdout and the stdio calls
+ *                    that write to it to the console of the calling thread's
+ *                    core, so CM33 output goes to the emulated UART and CM55
+ *                    output through its _write() retarget.
+ *
+ * Author           : Asst.Prof.Santi Nuratch, Ph.D
+ *                    Thailand Embedded Systems Association (TESA)
+ *
+ *******************************************************************************/
+
+#ifndef SIM_STDIO_H
+#define SIM_STDIO_H
+
+#include "sim_port.h"
+#include <stdarg.h>
+#include <stdio.h>
+
+#undef stdout
+#define stdout (sim_port_stdout())
+#define printf(...) fprintf(stdout, __VA_ARGS__)
+#define vprintf(fmt, args) vfprintf(stdout, (fmt), (args))
+#define putchar(c) fputc((c), stdout)
+#define puts(s) ((fputs((s), stdout) < 0) ? EOF : fputc('\n', stdout))
+
+#endif /* SIM_STDIO_H */
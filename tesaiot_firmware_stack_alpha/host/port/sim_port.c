@@ -0,0 +1,1745 @@
+/*******************************************************************************
+ * File Name        : sim_port.c
+ *
+ * Description      : Host simulator port: the FreeRTOS and PDL subset used
+ *                    by the IPC modules, on pthreads. Tasks are threads,
+ *                    blocking calls wait on condition variables against the
+ *                    monotonic clock, and each emulated core has its own
+ *                    interrupt lock, DWT counter, timer service thread and
+ *                    console. Priorities are recorded but not enforced:
+ *                    tasks of one core run in parallel, not by preemption.
+ *
+ * Author           : Asst.Prof.Santi Nuratch, Ph.D
+ *                    Thailand Embedded Systems Association (TESA)
+ *
+ *******************************************************************************/
+
+#define _GNU_SOURCE
+
+#include "FreeRTOS.h"
+#include "cy_pdl.h"
+#include "cybsp.h"
+#include "message_buffer.h"
+#include "queue.h"
+#include "semphr.h"
+#include "sim_port.h"
+#include "task.h"
+#include "timers.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define SIM_TASK_NAME_LEN (16U)
+#define SIM_TIMER_QUEUE_LEN (16U) /* Pended calls waiting for the timer service, as configTIMER_QUEUE_LENGTH */
+#define SIM_CONSOLE_BUF_SIZE (256U)
+#define SIM_WAIT_FOREVER (UINT64_MAX)
+
+/*
+ * DWT start values: each counter wraps a few seconds into a run (CM55 after 3 s, CM33 after 5 s), so
+ * every benchmark crosses a wrap on both cores at different times.
+ */
+#define SIM_CM33_CYCLE_OFFSET ((uint32_t)(0x100000000ULL - (5ULL * SIM_PORT_CM33_CLOCK_HZ)))
+#define SIM_CM55_CYCLE_OFFSET ((uint32_t)(0x100000000ULL - (3ULL * SIM_PORT_CM55_CLOCK_HZ)))
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+
+struct sim_task
+{
+  pthread_t thread;
+  TaskFunction_t code;
+  void *param;
+  char name[SIM_TASK_NAME_LEN];
+  UBaseType_t priority;
+  sim_core_t core;
+  pthread_mutex_t lock;
+  pthread_cond_t cond;
+  uint32_t notify_value;
+  bool notify_pending;
+};
+
+/* Queue, semaphore or mutex: item_size 0 makes count the semaphore value */
+struct sim_queue
+{
+  pthread_mutex_t lock;
+  pthread_cond_t cond;
+  uint8_t *items;
+  UBaseType_t length;
+  UBaseType_t item_size;
+  UBaseType_t head;
+  UBaseType_t count;
+  struct sim_task *holder; /* Mutexes: task that took it */
+  UBaseType_t recursion;   /* Recursive mutexes: nested takes of holder */
+};
+
+struct sim_message_buffer
+{
+  pthread_mutex_t lock;
+  pthread_cond_t cond;
+  uint8_t *buf;
+  size_t size;
+  size_t used;
+  size_t read;
+  size_t write;
+};
+
+struct sim_timer
+{
+  struct sim_timer *next; /* Timers of the same core */
+  const char *name;
+  TickType_t period;
+  bool auto_reload;
+  bool active;
+  uint64_t due_us;
+  void *timer_id;
+  TimerCallbackFunction_t callback;
+  sim_core_t core;
+};
+
+typedef struct
+{
+  PendedFunction_t function;
+  void *param1;
+  uint32_t param2;
+} sim_pended_t;
+
+/* Per-core state */
+typedef struct
+{
+  pthread_mutex_t intr_lock; /* Held by critical sections and by the core's interrupt threads */
+  uint32_t clock_hz;
+  uint32_t cycle_offset;
+  pthread_mutex_t timer_lock;
+  pthread_cond_t timer_cond;
+  bool timer_started;
+  struct sim_timer *timers;
+  sim_pended_t pended[SIM_TIMER_QUEUE_LEN];
+  uint32_t pended_head;
+  uint32_t pended_count;
+  FILE *console;
+  sim_port_console_t console_sink;
+  uint64_t console_bytes;
+} sim_core_state_t;
+
+/* One IPC pipe endpoint; the receiving core's interrupt thread serves it */
+typedef struct
+{
+  pthread_mutex_t lock;
+  pthread_cond_t cond;
+  bool configured;
+  sim_core_t core;
+  void (*isr)(void);
+  cy_ipc_pipe_callback_ptr_t *callbacks;
+  uint32_t client_count;
+  uint32_t *msg;                         /* Message of the pending notify, NULL when the channel is free */
+  cy_ipc_pipe_relcallback_ptr_t release; /* Sender's release callback of the pending notify */
+  uint32_t notifies;                     /* Notifies accepted so far */
+} sim_ipc_ep_t;
+
+/*******************************************************************************
+ * Global Variables
+ *******************************************************************************/
+GPIO_PRT_Type sim_port_gpio;
+
+static struct timespec s_epoch;
+static sim_core_state_t s_cores[SIM_CORE_COUNT];
+static sim_ipc_ep_t s_endpoints[CY_IPC_PIPE_EP_COUNT];
+static pthread_condattr_t s_cond_attr;
+
+static __thread sim_core_t t_core = SIM_CORE_CM33;
+static __thread struct sim_task *t_task = NULL;
+static __thread bool t_in_isr = false; /* Interrupt threads */
+static __thread DWT_Type t_dwt;
+static __thread CoreDebug_Type t_core_debug;
+
+/*******************************************************************************
+ * Clock, cores and blocking helpers
+ *******************************************************************************/
+
+__attribute__((constructor)) static void sim_port_init(void)
+{
+  pthread_mutexattr_t attr;
+
+  (void)clock_gettime(CLOCK_MONOTONIC, &s_epoch);
+  (void)pthread_condattr_init(&s_cond_attr);
+  (void)pthread_condattr_setclock(&s_cond_attr, CLOCK_MONOTONIC);
+  (void)pthread_mutexattr_init(&attr);
+  (void)pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+
+  for (uint32_t i = 0U; i < (uint32_t)SIM_CORE_COUNT; i++)
+  {
+    (void)pthread_mutex_init(&s_cores[i].intr_lock, &attr);
+    (void)pthread_mutex_init(&s_cores[i].timer_lock, NULL);
+    (void)pthread_cond_init(&s_cores[i].timer_cond, &s_cond_attr);
+  }
+  s_cores[SIM_CORE_CM33].clock_hz = SIM_PORT_CM33_CLOCK_HZ;
+  s_cores[SIM_CORE_CM33].cycle_offset = SIM_CM33_CYCLE_OFFSET;
+  s_cores[SIM_CORE_CM55].clock_hz = SIM_PORT_CM55_CLOCK_HZ;
+  s_cores[SIM_CORE_CM55].cycle_offset = SIM_CM55_CYCLE_OFFSET;
+
+  for (uint32_t i = 0U; i < CY_IPC_PIPE_EP_COUNT; i++)
+  {
+    (void)pthread_mutex_init(&s_endpoints[i].lock, NULL);
+    (void)pthread_cond_init(&s_endpoints[i].cond, &s_cond_attr);
+  }
+  (void)pthread_mutexattr_destroy(&attr);
+}
+
+static uint64_t sim_now_ns(void)
+{
+  struct timespec now;
+
+  (void)clock_gettime(CLOCK_MONOTONIC, &now);
+  return ((uint64_t)(now.tv_sec - s_epoch.tv_sec) * 1000000000ULL) + (uint64_t)now.tv_nsec -
+         (uint64_t)s_epoch.tv_nsec;
+}
+
+uint64_t sim_port_now_us(void)
+{
+  return sim_now_ns() / 1000ULL;
+}
+
+/**
+ * Deadline on the port clock for a FreeRTOS block time; SIM_WAIT_FOREVER for portMAX_DELAY.
+ */
+static uint64_t sim_deadline_us(TickType_t ticks)
+{
+  if (portMAX_DELAY == ticks)
+  {
+    return SIM_WAIT_FOREVER;
+  }
+  return sim_port_now_us() + ((uint64_t)ticks * (1000000ULL / configTICK_RATE_HZ));
+}
+
+/**
+ * Waits on cond until signalled or deadline_us. Returns false once the deadline has passed.
+ */
+static bool sim_wait(pthread_cond_t *cond, pthread_mutex_t *lock, uint64_t deadline_us)
+{
+  struct timespec abs;
+  uint64_t at_ns;
+
+  if (SIM_WAIT_FOREVER == deadline_us)
+  {
+    (void)pthread_cond_wait(cond, lock);
+    return true;
+  }
+  if (sim_port_now_us() >= deadline_us)
+  {
+    return false;
+  }
+  at_ns = (deadline_us * 1000ULL) + (uint64_t)s_epoch.tv_nsec;
+  abs.tv_sec = s_epoch.tv_sec + (time_t)(at_ns / 1000000000ULL);
+  abs.tv_nsec = (long)(at_ns % 1000000000ULL);
+  return (ETIMEDOUT != pthread_cond_timedwait(cond, lock, &abs)) || (sim_port_now_us() < deadline_us);
+}
+
+static void sim_sleep_us(uint64_t us)
+{
+  struct timespec ts;
+
+  ts.tv_sec = (time_t)(us / 1000000ULL);
+  ts.tv_nsec = (long)((us % 1000000ULL) * 1000ULL);
+  while (EINTR == clock_nanosleep(CLOCK_MONOTONIC, 0, &ts, &ts))
+  {
+  }
+}
+
+void sim_port_set_core(sim_core_t core)
+{
+  if ((uint32_t)core < (uint32_t)SIM_CORE_COUNT)
+  {
+    t_core = core;
+    if (NULL != t_task)
+    {
+      t_task->core = core;
+    }
+  }
+}
+
+sim_core_t sim_port_core(void)
+{
+  return t_core;
+}
+
+void sim_port_yield(void)
+{
+  (void)sched_yield();
+}
+
+void sim_port_enter_critical(void)
+{
+  (void)pthread_mutex_lock(&s_cores[t_core].intr_lock);
+}
+
+void sim_port_exit_critical(void)
+{
+  (void)pthread_mutex_unlock(&s_cores[t_core].intr_lock);
+}
+
+uint32_t sim_port_cycle_count(void)
+{
+  const sim_core_state_t *core = &s_cores[t_core];
+
+  return core->cycle_offset + (uint32_t)((sim_now_ns() * (core->clock_hz / 1000000U)) / 1000ULL);
+}
+
+uint32_t sim_port_core_clock(void)
+{
+  return s_cores[t_core].clock_hz;
+}
+
+DWT_Type *sim_port_dwt(void)
+{
+  t_dwt.CYCCNT = sim_port_cycle_count();
+  return &t_dwt;
+}
+
+CoreDebug_Type *sim_port_core_debug(void)
+{
+  return &t_core_debug;
+}
+
+size_t sim_port_sharedmem_bytes(void)
+{
+  extern char __start_sim_sharedmem[] __attribute__((weak));
+  extern char __stop_sim_sharedmem[] __attribute__((weak));
+
+  return (size_t)(__stop_sim_sharedmem - __start_sim_sharedmem);
+}
+
+/*******************************************************************************
+ * Consoles
+ *******************************************************************************/
+
+static ssize_t sim_console_write(void *cookie, const char *data, size_t len)
+{
+  sim_core_state_t *core = (sim_core_state_t *)cookie;
+  sim_port_console_t sink = core->console_sink;
+
+  __atomic_fetch_add(&core->console_bytes, (uint64_t)len, __ATOMIC_RELAXED);
+  if (NULL != sink)
+  {
+    sink(data, len);
+  }
+  return (ssize_t)len;
+}
+
+FILE *sim_port_stdout(void)
+{
+  static pthread_mutex_t create_lock = PTHREAD_MUTEX_INITIALIZER;
+  sim_core_state_t *core = &s_cores[t_core];
+  FILE *console = __atomic_load_n(&core->console, __ATOMIC_ACQUIRE);
+
+  if (NULL == console)
+  {
+    cookie_io_functions_t io = {.read = NULL, .write = sim_console_write, .seek = NULL, .close = NULL};
+
+    (void)pthread_mutex_lock(&create_lock);
+    console = core->console;
+    if (NULL == console)
+    {
+      console = fopencookie(core, "w", io);
+      if (NULL == console)
+      {
+        abort();
+      }
+      (void)setvbuf(console, NULL, _IOLBF, SIM_CONSOLE_BUF_SIZE);
+      __atomic_store_n(&core->console, console, __ATOMIC_RELEASE);
+    }
+    (void)pthread_mutex_unlock(&create_lock);
+  }
+  return console;
+}
+
+void sim_port_set_console(sim_core_t core, sim_port_console_t console)
+{
+  if ((uint32_t)core < (uint32_t)SIM_CORE_COUNT)
+  {
+    s_cores[core].console_sink = console;
+  }
+}
+
+uint64_t sim_port_console_bytes(sim_core_t core)
+{
+  if ((uint32_t)core >= (uint32_t)SIM_CORE_COUNT)
+  {
+    return 0U;
+  }
+  return __atomic_load_n(&s_cores[core].console_bytes, __ATOMIC_RELAXED);
+}
+
+/*******************************************************************************
+ * Heap
+ *******************************************************************************/
+
+void *pvPortMalloc(size_t size)
+{
+  return malloc(size);
+}
+
+void vPortFree(void *ptr)
+{
+  free(ptr);
+}
+
+/*******************************************************************************
+ * Tasks and notifications
+ *******************************************************************************/
+
+static struct sim_task *sim_task_new(const char *name, UBaseType_t priority, sim_core_t core)
+{
+  struct sim_task *task = calloc(1U, sizeof(*task));
+
+  if (NULL == task)
+  {
+    return NULL;
+  }
+  (void)snprintf(task->name, sizeof(task->name), "%s", (NULL != name) ? name : "");
+  task->priority = priority;
+  task->core = core;
+  (void)pthread_mutex_init(&task->lock, NULL);
+  (void)pthread_cond_init(&task->cond, &s_cond_attr);
+  return task;
+}
+
+/**
+ * Task of the calling thread. Threads the port did not create (the driver's main thread) get one on
+ * first use, so they may block on notifications like a task.
+ */
+static struct sim_task *sim_task_self(void)
+{
+  if (NULL == t_task)
+  {
+    t_task = sim_task_new("main", tskIDLE_PRIORITY, t_core);
+    if (NULL == t_task)
+    {
+      abort();
+    }
+  }
+  return t_task;
+}
+
+static void *sim_task_entry(void *arg)
+{
+  struct sim_task *task = (struct sim_task *)arg;
+
+  t_task = task;
+  t_core = task->core;
+  task->code(task->param);
+  return NULL;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t code, const char *name, configSTACK_DEPTH_TYPE stack_depth, void *param,
+                       UBaseType_t priority, TaskHandle_t *created)
+{
+  struct sim_task *task;
+
+  (void)stack_depth;
+  if (NULL == code)
+  {
+    return pdFAIL;
+  }
+  task = sim_task_new(name, priority, t_core);
+  if (NULL == task)
+  {
+    return pdFAIL;
+  }
+  task->code = code;
+  task->param = param;
+  if (NULL != created)
+  {
+    *created = task;
+  }
+  if (0 != pthread_create(&task->thread, NULL, sim_task_entry, task))
+  {
+    free(task);
+    return pdFAIL;
+  }
+  (void)pthread_detach(task->thread);
+  return pdPASS;
+}
+
+TaskHandle_t xTaskCreateStatic(TaskFunction_t code, const char *name, uint32_t stack_depth, void *param,
+                               UBaseType_t priority, StackType_t *stack, StaticTask_t *tcb)
+{
+  TaskHandle_t task = NULL;
+
+  (void)stack;
+  (void)tcb;
+  (void)xTaskCreate(code, name, stack_depth, param, priority, &task);
+  return task;
+}
+
+void vTaskDelete(TaskHandle_t task)
+{
+  /* Only self-deletion is supported: a thread cannot be stopped safely from outside */
+  if ((NULL == task) || (task == t_task))
+  {
+    pthread_exit(NULL);
+  }
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+  if (0U == ticks)
+  {
+    sim_port_yield();
+    return;
+  }
+  sim_sleep_us((uint64_t)ticks * (1000000ULL / configTICK_RATE_HZ));
+}
+
+BaseType_t xTaskDelayUntil(TickType_t *previous_wake, TickType_t increment)
+{
+  TickType_t wake = *previous_wake + increment;
+  TickType_t now = xTaskGetTickCount();
+  BaseType_t delayed = pdFALSE;
+
+  if ((int32_t)(wake - now) > 0)
+  {
+    vTaskDelay(wake - now);
+    delayed = pdTRUE;
+  }
+  *previous_wake = wake;
+  return delayed;
+}
+
+void vTaskDelayUntil(TickType_t *previous_wake, TickType_t increment)
+{
+  (void)xTaskDelayUntil(previous_wake, increment);
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+  return (TickType_t)(sim_port_now_us() / (1000000ULL / configTICK_RATE_HZ));
+}
+
+TickType_t xTaskGetTickCountFromISR(void)
+{
+  return xTaskGetTickCount();
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+  return sim_task_self();
+}
+
+const char *pcTaskGetName(TaskHandle_t task)
+{
+  return ((NULL != task) ? task : sim_task_self())->name;
+}
+
+UBaseType_t uxTaskPriorityGet(TaskHandle_t task)
+{
+  return ((NULL != task) ? task : sim_task_self())->priority;
+}
+
+void vTaskPrioritySet(TaskHandle_t task, UBaseType_t priority)
+{
+  ((NULL != task) ? task : sim_task_self())->priority = priority;
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task)
+{
+  (void)task;
+  return configMINIMAL_STACK_SIZE; /* Host stacks are not measured */
+}
+
+BaseType_t xTaskGetSchedulerState(void)
+{
+  return taskSCHEDULER_RUNNING;
+}
+
+BaseType_t xPortIsInsideInterrupt(void)
+{
+  return t_in_isr ? pdTRUE : pdFALSE;
+}
+
+void vTaskStartScheduler(void)
+{
+  for (;;)
+  {
+    (void)pause();
+  }
+}
+
+void vTaskSuspendAll(void)
+{
+  sim_port_enter_critical();
+}
+
+BaseType_t xTaskResumeAll(void)
+{
+  sim_port_exit_critical();
+  return pdFALSE;
+}
+
+BaseType_t xTaskNotify(TaskHandle_t task, uint32_t value, eNotifyAction action)
+{
+  BaseType_t result = pdPASS;
+
+  if (NULL == task)
+  {
+    return pdFAIL;
+  }
+  (void)pthread_mutex_lock(&task->lock);
+  switch (action)
+  {
+  case eSetBits:
+    task->notify_value |= value;
+    break;
+  case eIncrement:
+    task->notify_value++;
+    break;
+  case eSetValueWithOverwrite:
+    task->notify_value = value;
+    break;
+  case eSetValueWithoutOverwrite:
+    if (task->notify_pending)
+    {
+      result = pdFAIL;
+    }
+    else
+    {
+      task->notify_value = value;
+    }
+    break;
+  case eNoAction:
+  default:
+    break;
+  }
+  task->notify_pending = true;
+  (void)pthread_cond_broadcast(&task->cond);
+  (void)pthread_mutex_unlock(&task->lock);
+  return result;
+}
+
+BaseType_t xTaskNotifyFromISR(TaskHandle_t task, uint32_t value, eNotifyAction action, BaseType_t *woken)
+{
+  if (NULL != woken)
+  {
+    *woken = pdFALSE;
+  }
+  return xTaskNotify(task, value, action);
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task)
+{
+  return xTaskNotify(task, 0U, eIncrement);
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *woken)
+{
+  (void)xTaskNotifyFromISR(task, 0U, eIncrement, woken);
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks_to_wait)
+{
+  struct sim_task *task = sim_task_self();
+  uint64_t deadline = sim_deadline_us(ticks_to_wait);
+  uint32_t value;
+
+  (void)pthread_mutex_lock(&task->lock);
+  while ((0U == task->notify_value) && sim_wait(&task->cond, &task->lock, deadline))
+  {
+  }
+  value = task->notify_value;
+  if (0U != value)
+  {
+    task->notify_value = (pdFALSE != clear_on_exit) ? 0U : (value - 1U);
+  }
+  task->notify_pending = false;
+  (void)pthread_mutex_unlock(&task->lock);
+  return value;
+}
+
+BaseType_t xTaskNotifyWait(uint32_t clear_on_entry, uint32_t clear_on_exit, uint32_t *value, TickType_t ticks_to_wait)
+{
+  struct sim_task *task = sim_task_self();
+  uint64_t deadline = sim_deadline_us(ticks_to_wait);
+  BaseType_t received;
+
+  (void)pthread_mutex_lock(&task->lock);
+  if (!task->notify_pending)
+  {
+    task->notify_value &= ~clear_on_entry;
+  }
+  while (!task->notify_pending && sim_wait(&task->cond, &task->lock, deadline))
+  {
+  }
+  received = task->notify_pending ? pdTRUE : pdFALSE;
+  if (NULL != value)
+  {
+    *value = task->notify_value;
+  }
+  if (pdFALSE != received)
+  {
+    task->notify_value &= ~clear_on_exit;
+  }
+  task->notify_pending = false;
+  (void)pthread_mutex_unlock(&task->lock);
+  return received;
+}
+
+BaseType_t xTaskNotifyStateClear(TaskHandle_t task)
+{
+  BaseType_t was_pending;
+
+  task = (NULL != task) ? task : sim_task_self();
+  (void)pthread_mutex_lock(&task->lock);
+  was_pending = task->notify_pending ? pdTRUE : pdFALSE;
+  task->notify_pending = false;
+  (void)pthread_mutex_unlock(&task->lock);
+  return was_pending;
+}
+
+uint32_t ulTaskNotifyValueClear(TaskHandle_t task, uint32_t bits_to_clear)
+{
+  uint32_t value;
+
+  task = (NULL != task) ? task : sim_task_self();
+  (void)pthread_mutex_lock(&task->lock);
+  value = task->notify_value;
+  task->notify_value &= ~bits_to_clear;
+  (void)pthread_mutex_unlock(&task->lock);
+  return value;
+}
+
+/*******************************************************************************
+ * Queues, semaphores and mutexes
+ *******************************************************************************/
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size)
+{
+  struct sim_queue *queue;
+
+  if (0U == length)
+  {
+    return NULL;
+  }
+  queue = calloc(1U, sizeof(*queue));
+  if (NULL == queue)
+  {
+    return NULL;
+  }
+  if (0U != item_size)
+  {
+    queue->items = calloc(length, item_size);
+    if (NULL == queue->items)
+    {
+      free(queue);
+      return NULL;
+    }
+  }
+  queue->length = length;
+  queue->item_size = item_size;
+  (void)pthread_mutex_init(&queue->lock, NULL);
+  (void)pthread_cond_init(&queue->cond, &s_cond_attr);
+  return queue;
+}
+
+QueueHandle_t xQueueCreateStatic(UBaseType_t length, UBaseType_t item_size, uint8_t *storage, StaticQueue_t *queue)
+{
+  (void)storage;
+  (void)queue;
+  return xQueueCreate(length, item_size);
+}
+
+void vQueueDelete(QueueHandle_t queue)
+{
+  if (NULL != queue)
+  {
+    (void)pthread_mutex_destroy(&queue->lock);
+    (void)pthread_cond_destroy(&queue->cond);
+    free(queue->items);
+    free(queue);
+  }
+}
+
+static BaseType_t sim_queue_put(QueueHandle_t queue, const void *item, TickType_t ticks_to_wait, bool to_front,
+                                bool overwrite)
+{
+  uint64_t deadline = sim_deadline_us(ticks_to_wait);
+  UBaseType_t index;
+
+  (void)pthread_mutex_lock(&queue->lock);
+  if (overwrite && (queue->count == queue->length))
+  {
+    queue->count = 0U; /* Overwrite is for length-1 queues */
+  }
+  while (queue->count >= queue->length)
+  {
+    if (!sim_wait(&queue->cond, &queue->lock, deadline))
+    {
+      (void)pthread_mutex_unlock(&queue->lock);
+      return errQUEUE_FULL;
+    }
+  }
+  if (to_front)
+  {
+    queue->head = (queue->head + queue->length - 1U) % queue->length;
+    index = queue->head;
+  }
+  else
+  {
+    index = (queue->head + queue->count) % queue->length;
+  }
+  if (0U != queue->item_size)
+  {
+    (void)memcpy(&queue->items[index * queue->item_size], item, queue->item_size);
+  }
+  queue->count++;
+  (void)pthread_cond_broadcast(&queue->cond);
+  (void)pthread_mutex_unlock(&queue->lock);
+  return pdPASS;
+}
+
+static BaseType_t sim_queue_get(QueueHandle_t queue, void *item, TickType_t ticks_to_wait, bool peek)
+{
+  uint64_t deadline = sim_deadline_us(ticks_to_wait);
+
+  (void)pthread_mutex_lock(&queue->lock);
+  while (0U == queue->count)
+  {
+    if (!sim_wait(&queue->cond, &queue->lock, deadline))
+    {
+      (void)pthread_mutex_unlock(&queue->lock);
+      return errQUEUE_EMPTY;
+    }
+  }
+  if ((0U != queue->item_size) && (NULL != item))
+  {
+    (void)memcpy(item, &queue->items[queue->head * queue->item_size], queue->item_size);
+  }
+  if (!peek)
+  {
+    queue->head = (queue->head + 1U) % queue->length;
+    queue->count--;
+    (void)pthread_cond_broadcast(&queue->cond);
+  }
+  (void)pthread_mutex_unlock(&queue->lock);
+  return pdPASS;
+}
+
+static BaseType_t sim_from_isr(BaseType_t result, BaseType_t *woken)
+{
+  if (NULL != woken)
+  {
+    *woken = pdFALSE;
+  }
+  return result;
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void *item, TickType_t ticks_to_wait)
+{
+  return sim_queue_put(queue, item, ticks_to_wait, false, false);
+}
+
+BaseType_t xQueueSendToBack(QueueHandle_t queue, const void *item, TickType_t ticks_to_wait)
+{
+  return sim_queue_put(queue, item, ticks_to_wait, false, false);
+}
+
+BaseType_t xQueueSendToFront(QueueHandle_t queue, const void *item, TickType_t ticks_to_wait)
+{
+  return sim_queue_put(queue, item, ticks_to_wait, true, false);
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t queue, const void *item, BaseType_t *woken)
+{
+  return sim_from_isr(sim_queue_put(queue, item, 0U, false, false), woken);
+}
+
+BaseType_t xQueueSendToBackFromISR(QueueHandle_t queue, const void *item, BaseType_t *woken)
+{
+  return sim_from_isr(sim_queue_put(queue, item, 0U, false, false), woken);
+}
+
+BaseType_t xQueueSendToFrontFromISR(QueueHandle_t queue, const void *item, BaseType_t *woken)
+{
+  return sim_from_isr(sim_queue_put(queue, item, 0U, true, false), woken);
+}
+
+BaseType_t xQueueOverwrite(QueueHandle_t queue, const void *item)
+{
+  return sim_queue_put(queue, item, 0U, false, true);
+}
+
+BaseType_t xQueueOverwriteFromISR(QueueHandle_t queue, const void *item, BaseType_t *woken)
+{
+  return sim_from_isr(sim_queue_put(queue, item, 0U, false, true), woken);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t ticks_to_wait)
+{
+  return sim_queue_get(queue, item, ticks_to_wait, false);
+}
+
+BaseType_t xQueueReceiveFromISR(QueueHandle_t queue, void *item, BaseType_t *woken)
+{
+  return sim_from_isr(sim_queue_get(queue, item, 0U, false), woken);
+}
+
+BaseType_t xQueuePeek(QueueHandle_t queue, void *item, TickType_t ticks_to_wait)
+{
+  return sim_queue_get(queue, item, ticks_to_wait, true);
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue)
+{
+  UBaseType_t count;
+
+  (void)pthread_mutex_lock(&queue->lock);
+  count = queue->count;
+  (void)pthread_mutex_unlock(&queue->lock);
+  return count;
+}
+
+UBaseType_t uxQueueMessagesWaitingFromISR(QueueHandle_t queue)
+{
+  return uxQueueMessagesWaiting(queue);
+}
+
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t queue)
+{
+  return queue->length - uxQueueMessagesWaiting(queue);
+}
+
+BaseType_t xQueueReset(QueueHandle_t queue)
+{
+  (void)pthread_mutex_lock(&queue->lock);
+  queue->head = 0U;
+  queue->count = 0U;
+  (void)pthread_cond_broadcast(&queue->cond);
+  (void)pthread_mutex_unlock(&queue->lock);
+  return pdPASS;
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void)
+{
+  return xQueueCreate(1U, 0U);
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinaryStatic(StaticSemaphore_t *buffer)
+{
+  (void)buffer;
+  return xSemaphoreCreateBinary();
+}
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t max_count, UBaseType_t initial_count)
+{
+  SemaphoreHandle_t sem = xQueueCreate(max_count, 0U);
+
+  if ((NULL != sem) && (initial_count <= max_count))
+  {
+    sem->count = initial_count;
+  }
+  return sem;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+  SemaphoreHandle_t mutex = xQueueCreate(1U, 0U);
+
+  if (NULL != mutex)
+  {
+    mutex->count = 1U;
+  }
+  return mutex;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutexStatic(StaticSemaphore_t *buffer)
+{
+  (void)buffer;
+  return xSemaphoreCreateMutex();
+}
+
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex(void)
+{
+  return xSemaphoreCreateMutex();
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks_to_wait)
+{
+  BaseType_t taken = sim_queue_get(sem, NULL, ticks_to_wait, false);
+
+  if (pdPASS == taken)
+  {
+    sem->holder = sim_task_self();
+  }
+  return taken;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem)
+{
+  sem->holder = NULL;
+  return sim_queue_put(sem, NULL, 0U, false, false);
+}
+
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t sem, TickType_t ticks_to_wait)
+{
+  if (sem->holder == sim_task_self())
+  {
+    sem->recursion++;
+    return pdPASS;
+  }
+  if (pdPASS != xSemaphoreTake(sem, ticks_to_wait))
+  {
+    return pdFAIL;
+  }
+  sem->recursion = 1U;
+  return pdPASS;
+}
+
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t sem)
+{
+  if ((sem->holder != sim_task_self()) || (0U == sem->recursion))
+  {
+    return pdFAIL;
+  }
+  sem->recursion--;
+  if (0U != sem->recursion)
+  {
+    return pdPASS;
+  }
+  return xSemaphoreGive(sem);
+}
+
+BaseType_t xSemaphoreTakeFromISR(SemaphoreHandle_t sem, BaseType_t *woken)
+{
+  return sim_from_isr(sim_queue_get(sem, NULL, 0U, false), woken);
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t sem, BaseType_t *woken)
+{
+  return sim_from_isr(sim_queue_put(sem, NULL, 0U, false, false), woken);
+}
+
+UBaseType_t uxSemaphoreGetCount(SemaphoreHandle_t sem)
+{
+  return uxQueueMessagesWaiting(sem);
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t sem)
+{
+  vQueueDelete(sem);
+}
+
+/*******************************************************************************
+ * Message buffers
+ *******************************************************************************/
+
+MessageBufferHandle_t xMessageBufferCreate(size_t buffer_bytes)
+{
+  struct sim_message_buffer *mb;
+
+  if (buffer_bytes <= sizeof(size_t))
+  {
+    return NULL;
+  }
+  mb = calloc(1U, sizeof(*mb));
+  if (NULL == mb)
+  {
+    return NULL;
+  }
+  mb->buf = malloc(buffer_bytes);
+  if (NULL == mb->buf)
+  {
+    free(mb);
+    return NULL;
+  }
+  mb->size = buffer_bytes;
+  (void)pthread_mutex_init(&mb->lock, NULL);
+  (void)pthread_cond_init(&mb->cond, &s_cond_attr);
+  return mb;
+}
+
+MessageBufferHandle_t xMessageBufferCreateStatic(size_t buffer_bytes, uint8_t *storage, StaticMessageBuffer_t *buffer)
+{
+  (void)storage;
+  (void)buffer;
+  return xMessageBufferCreate(buffer_bytes);
+}
+
+void vMessageBufferDelete(MessageBufferHandle_t mb)
+{
+  if (NULL != mb)
+  {
+    (void)pthread_mutex_destroy(&mb->lock);
+    (void)pthread_cond_destroy(&mb->cond);
+    free(mb->buf);
+    free(mb);
+  }
+}
+
+static void sim_mb_copy_in(struct sim_message_buffer *mb, const void *data, size_t len)
+{
+  size_t first = mb->size - mb->write;
+
+  if (first > len)
+  {
+    first = len;
+  }
+  (void)memcpy(&mb->buf[mb->write], data, first);
+  (void)memcpy(mb->buf, (const uint8_t *)data + first, len - first);
+  mb->write = (mb->write + len) % mb->size;
+}
+
+static void sim_mb_copy_out(const struct sim_message_buffer *mb, size_t at, void *data, size_t len)
+{
+  size_t first = mb->size - at;
+
+  if (first > len)
+  {
+    first = len;
+  }
+  (void)memcpy(data, &mb->buf[at], first);
+  (void)memcpy((uint8_t *)data + first, mb->buf, len - first);
+}
+
+size_t xMessageBufferSend(MessageBufferHandle_t mb, const void *data, size_t length, TickType_t ticks_to_wait)
+{
+  uint64_t deadline = sim_deadline_us(ticks_to_wait);
+  size_t needed = length + sizeof(size_t);
+
+  if (needed > mb->size)
+  {
+    return 0U;
+  }
+  (void)pthread_mutex_lock(&mb->lock);
+  while ((mb->size - mb->used) < needed)
+  {
+    if (!sim_wait(&mb->cond, &mb->lock, deadline))
+    {
+      (void)pthread_mutex_unlock(&mb->lock);
+      return 0U;
+    }
+  }
+  sim_mb_copy_in(mb, &length, sizeof(size_t));
+  sim_mb_copy_in(mb, data, length);
+  mb->used += needed;
+  (void)pthread_cond_broadcast(&mb->cond);
+  (void)pthread_mutex_unlock(&mb->lock);
+  return length;
+}
+
+size_t xMessageBufferSendFromISR(MessageBufferHandle_t mb, const void *data, size_t length, BaseType_t *woken)
+{
+  if (NULL != woken)
+  {
+    *woken = pdFALSE;
+  }
+  return xMessageBufferSend(mb, data, length, 0U);
+}
+
+size_t xMessageBufferReceive(MessageBufferHandle_t mb, void *data, size_t max_length, TickType_t ticks_to_wait)
+{
+  uint64_t deadline = sim_deadline_us(ticks_to_wait);
+  size_t length;
+
+  (void)pthread_mutex_lock(&mb->lock);
+  while (0U == mb->used)
+  {
+    if (!sim_wait(&mb->cond, &mb->lock, deadline))
+    {
+      (void)pthread_mutex_unlock(&mb->lock);
+      return 0U;
+    }
+  }
+  sim_mb_copy_out(mb, mb->read, &length, sizeof(size_t));
+  if (length > max_length)
+  {
+    (void)pthread_mutex_unlock(&mb->lock); /* As the kernel: the message stays in the buffer */
+    return 0U;
+  }
+  sim_mb_copy_out(mb, (mb->read + sizeof(size_t)) % mb->size, data, length);
+  mb->read = (mb->read + sizeof(size_t) + length) % mb->size;
+  mb->used -= sizeof(size_t) + length;
+  (void)pthread_cond_broadcast(&mb->cond);
+  (void)pthread_mutex_unlock(&mb->lock);
+  return length;
+}
+
+size_t xMessageBufferReceiveFromISR(MessageBufferHandle_t mb, void *data, size_t max_length, BaseType_t *woken)
+{
+  if (NULL != woken)
+  {
+    *woken = pdFALSE;
+  }
+  return xMessageBufferReceive(mb, data, max_length, 0U);
+}
+
+size_t xMessageBufferNextLengthBytes(MessageBufferHandle_t mb)
+{
+  size_t length = 0U;
+
+  (void)pthread_mutex_lock(&mb->lock);
+  if (0U != mb->used)
+  {
+    sim_mb_copy_out(mb, mb->read, &length, sizeof(size_t));
+  }
+  (void)pthread_mutex_unlock(&mb->lock);
+  return length;
+}
+
+size_t xMessageBufferSpacesAvailable(MessageBufferHandle_t mb)
+{
+  size_t space;
+
+  (void)pthread_mutex_lock(&mb->lock);
+  space = mb->size - mb->used;
+  (void)pthread_mutex_unlock(&mb->lock);
+  return space;
+}
+
+BaseType_t xMessageBufferIsEmpty(MessageBufferHandle_t mb)
+{
+  return (xMessageBufferSpacesAvailable(mb) == mb->size) ? pdTRUE : pdFALSE;
+}
+
+BaseType_t xMessageBufferIsFull(MessageBufferHandle_t mb)
+{
+  return (xMessageBufferSpacesAvailable(mb) <= sizeof(size_t)) ? pdTRUE : pdFALSE;
+}
+
+BaseType_t xMessageBufferReset(MessageBufferHandle_t mb)
+{
+  (void)pthread_mutex_lock(&mb->lock);
+  mb->used = 0U;
+  mb->read = 0U;
+  mb->write = 0U;
+  (void)pthread_cond_broadcast(&mb->cond);
+  (void)pthread_mutex_unlock(&mb->lock);
+  return pdPASS;
+}
+
+/*******************************************************************************
+ * Timer service
+ *******************************************************************************/
+
+/**
+ * Timer service thread of one core: runs pended calls first, then expired timers, one at a time and
+ * without the timer lock, like the kernel's timer task.
+ */
+static void *sim_timer_service(void *arg)
+{
+  sim_core_state_t *core = (sim_core_state_t *)arg;
+
+  t_task = sim_task_new("Tmr Svc", configTIMER_TASK_PRIORITY, (sim_core_t)(core - s_cores));
+  t_core = t_task->core;
+
+  (void)pthread_mutex_lock(&core->timer_lock);
+  for (;;)
+  {
+    struct sim_timer *next = NULL;
+    uint64_t now;
+
+    if (0U != core->pended_count)
+    {
+      sim_pended_t call = core->pended[core->pended_head];
+
+      core->pended_head = (core->pended_head + 1U) % SIM_TIMER_QUEUE_LEN;
+      core->pended_count--;
+      (void)pthread_mutex_unlock(&core->timer_lock);
+      call.function(call.param1, call.param2);
+      (void)pthread_mutex_lock(&core->timer_lock);
+      continue;
+    }
+
+    for (struct sim_timer *timer = core->timers; NULL != timer; timer = timer->next)
+    {
+      if (timer->active && ((NULL == next) || (timer->due_us < next->due_us)))
+      {
+        next = timer;
+      }
+    }
+    now = sim_port_now_us();
+    if ((NULL != next) && (next->due_us <= now))
+    {
+      if (next->auto_reload)
+      {
+        next->due_us += (uint64_t)next->period * (1000000ULL / configTICK_RATE_HZ);
+      }
+      else
+      {
+        next->active = false;
+      }
+      (void)pthread_mutex_unlock(&core->timer_lock);
+      next->callback(next);
+      (void)pthread_mutex_lock(&core->timer_lock);
+      continue;
+    }
+    (void)sim_wait(&core->timer_cond, &core->timer_lock, (NULL != next) ? next->due_us : SIM_WAIT_FOREVER);
+  }
+  return NULL;
+}
+
+/**
+ * Timer service state of the calling core, starting its thread on first use. Called with the lock
+ * not held; returns with it held.
+ */
+static sim_core_state_t *sim_timer_core_lock(sim_core_t owner)
+{
+  sim_core_state_t *core = &s_cores[owner];
+
+  (void)pthread_mutex_lock(&core->timer_lock);
+  if (!core->timer_started)
+  {
+    pthread_t thread;
+
+    if (0 != pthread_create(&thread, NULL, sim_timer_service, core))
+    {
+      abort();
+    }
+    (void)pthread_detach(thread);
+    core->timer_started = true;
+  }
+  return core;
+}
+
+static void sim_timer_core_unlock(sim_core_state_t *core)
+{
+  (void)pthread_cond_broadcast(&core->timer_cond);
+  (void)pthread_mutex_unlock(&core->timer_lock);
+}
+
+TimerHandle_t xTimerCreate(const char *name, TickType_t period, UBaseType_t auto_reload, void *timer_id,
+                           TimerCallbackFunction_t callback)
+{
+  struct sim_timer *timer;
+  sim_core_state_t *core;
+
+  if ((0U == period) || (NULL == callback))
+  {
+    return NULL;
+  }
+  timer = calloc(1U, sizeof(*timer));
+  if (NULL == timer)
+  {
+    return NULL;
+  }
+  timer->name = name;
+  timer->period = period;
+  timer->auto_reload = (pdFALSE != (BaseType_t)auto_reload);
+  timer->timer_id = timer_id;
+  timer->callback = callback;
+  timer->core = t_core;
+
+  core = sim_timer_core_lock(timer->core);
+  timer->next = core->timers;
+  core->timers = timer;
+  sim_timer_core_unlock(core);
+  return timer;
+}
+
+TimerHandle_t xTimerCreateStatic(const char *name, TickType_t period, UBaseType_t auto_reload, void *timer_id,
+                                 TimerCallbackFunction_t callback, StaticTimer_t *buffer)
+{
+  (void)buffer;
+  return xTimerCreate(name, period, auto_reload, timer_id, callback);
+}
+
+/**
+ * Applies a timer command: (re)starts the timer with period from now, or stops it.
+ */
+static BaseType_t sim_timer_command(TimerHandle_t timer, bool start, TickType_t period)
+{
+  sim_core_state_t *core;
+
+  if (NULL == timer)
+  {
+    return pdFAIL;
+  }
+  core = sim_timer_core_lock(timer->core);
+  if (0U != period)
+  {
+    timer->period = period;
+  }
+  timer->active = start;
+  timer->due_us = sim_port_now_us() + ((uint64_t)timer->period * (1000000ULL / configTICK_RATE_HZ));
+  sim_timer_core_unlock(core);
+  return pdPASS;
+}
+
+BaseType_t xTimerStart(TimerHandle_t timer, TickType_t ticks_to_wait)
+{
+  (void)ticks_to_wait;
+  return sim_timer_command(timer, true, 0U);
+}
+
+BaseType_t xTimerStartFromISR(TimerHandle_t timer, BaseType_t *woken)
+{
+  return sim_from_isr(sim_timer_command(timer, true, 0U), woken);
+}
+
+BaseType_t xTimerStop(TimerHandle_t timer, TickType_t ticks_to_wait)
+{
+  (void)ticks_to_wait;
+  return sim_timer_command(timer, false, 0U);
+}
+
+BaseType_t xTimerReset(TimerHandle_t timer, TickType_t ticks_to_wait)
+{
+  (void)ticks_to_wait;
+  return sim_timer_command(timer, true, 0U);
+}
+
+BaseType_t xTimerChangePeriod(TimerHandle_t timer, TickType_t period, TickType_t ticks_to_wait)
+{
+  (void)ticks_to_wait;
+  if (0U == period)
+  {
+    return pdFAIL;
+  }
+  return sim_timer_command(timer, true, period);
+}
+
+BaseType_t xTimerIsTimerActive(TimerHandle_t timer)
+{
+  sim_core_state_t *core = &s_cores[timer->core];
+  bool active;
+
+  (void)pthread_mutex_lock(&core->timer_lock);
+  active = timer->active;
+  (void)pthread_mutex_unlock(&core->timer_lock);
+  return active ? pdTRUE : pdFALSE;
+}
+
+void *pvTimerGetTimerID(TimerHandle_t timer)
+{
+  return timer->timer_id;
+}
+
+BaseType_t xTimerPendFunctionCall(PendedFunction_t function, void *param1, uint32_t param2, TickType_t ticks_to_wait)
+{
+  sim_core_state_t *core;
+  BaseType_t result = pdFAIL;
+
+  (void)ticks_to_wait;
+  if (NULL == function)
+  {
+    return pdFAIL;
+  }
+  core = sim_timer_core_lock(t_core);
+  if (core->pended_count < SIM_TIMER_QUEUE_LEN)
+  {
+    sim_pended_t *call = &core->pended[(core->pended_head + core->pended_count) % SIM_TIMER_QUEUE_LEN];
+
+    call->function = function;
+    call->param1 = param1;
+    call->param2 = param2;
+    core->pended_count++;
+    result = pdPASS;
+  }
+  sim_timer_core_unlock(core);
+  return result;
+}
+
+BaseType_t xTimerPendFunctionCallFromISR(PendedFunction_t function, void *param1, uint32_t param2, BaseType_t *woken)
+{
+  return sim_from_isr(xTimerPendFunctionCall(function, param1, param2, 0U), woken);
+}
+
+/*******************************************************************************
+ * IPC pipe and semaphores
+ *******************************************************************************/
+
+/**
+ * Frees the channel of ep so the sender may notify again, then runs the sender's release callback.
+ */
+static void sim_ipc_release(sim_ipc_ep_t *ep)
+{
+  cy_ipc_pipe_relcallback_ptr_t release;
+
+  (void)pthread_mutex_lock(&ep->lock);
+  release = ep->release;
+  ep->msg = NULL;
+  ep->release = NULL;
+  (void)pthread_mutex_unlock(&ep->lock);
+  if (NULL != release)
+  {
+    release();
+  }
+}
+
+/**
+ * Interrupt thread of one receiving endpoint: waits for a notify, then runs the user ISR with the
+ * owning core's interrupts masked. A notify the ISR did not serve is released so the sender never
+ * stays locked out.
+ */
+static void *sim_ipc_isr_thread(void *arg)
+{
+  sim_ipc_ep_t *ep = (sim_ipc_ep_t *)arg;
+
+  t_task = sim_task_new("IPC ISR", configMAX_PRIORITIES, ep->core);
+  t_core = ep->core;
+  t_in_isr = true;
+
+  for (;;)
+  {
+    uint32_t notify;
+
+    (void)pthread_mutex_lock(&ep->lock);
+    while (NULL == ep->msg)
+    {
+      (void)pthread_cond_wait(&ep->cond, &ep->lock);
+    }
+    notify = ep->notifies;
+    (void)pthread_mutex_unlock(&ep->lock);
+
+    sim_port_enter_critical();
+    ep->isr();
+    sim_port_exit_critical();
+
+    (void)pthread_mutex_lock(&ep->lock);
+    if ((NULL != ep->msg) && (notify == ep->notifies))
+    {
+      (void)pthread_mutex_unlock(&ep->lock);
+      sim_ipc_release(ep);
+    }
+    else
+    {
+      (void)pthread_mutex_unlock(&ep->lock);
+    }
+  }
+  return NULL;
+}
+
+void Cy_IPC_Pipe_Config(cy_stc_ipc_pipe_ep_t *endpoints)
+{
+  (void)endpoints;
+}
+
+void Cy_IPC_Pipe_Init(const cy_stc_ipc_pipe_config_t *config)
+{
+  uint32_t addr;
+  sim_ipc_ep_t *ep;
+  pthread_t thread;
+
+  if ((NULL == config) || (NULL == config->userPipeIsrHandler))
+  {
+    return;
+  }
+  addr = config->ep0ConfigData.epAddress;
+  if (addr >= CY_IPC_PIPE_EP_COUNT)
+  {
+    return;
+  }
+  ep = &s_endpoints[addr];
+
+  (void)pthread_mutex_lock(&ep->lock);
+  if (ep->configured)
+  {
+    (void)pthread_mutex_unlock(&ep->lock);
+    return;
+  }
+  ep->core = t_core;
+  ep->isr = config->userPipeIsrHandler;
+  ep->callbacks = config->endpointsCallbacksArray;
+  ep->client_count = config->endpointClientsCount;
+  for (uint32_t i = 0U; i < ep->client_count; i++)
+  {
+    ep->callbacks[i] = NULL;
+  }
+  if (0 != pthread_create(&thread, NULL, sim_ipc_isr_thread, ep))
+  {
+    abort();
+  }
+  (void)pthread_detach(thread);
+  ep->configured = true;
+  (void)pthread_mutex_unlock(&ep->lock);
+}
+
+cy_en_ipc_pipe_status_t Cy_IPC_Pipe_RegisterCallback(uint32_t ep_addr, cy_ipc_pipe_callback_ptr_t callback,
+                                                     uint32_t client_id)
+{
+  sim_ipc_ep_t *ep;
+  cy_en_ipc_pipe_status_t status = CY_IPC_PIPE_SUCCESS;
+
+  if (ep_addr >= CY_IPC_PIPE_EP_COUNT)
+  {
+    return CY_IPC_PIPE_ERROR_BAD_HANDLE;
+  }
+  ep = &s_endpoints[ep_addr];
+  (void)pthread_mutex_lock(&ep->lock);
+  if (!ep->configured)
+  {
+    status = CY_IPC_PIPE_ERROR_BAD_HANDLE;
+  }
+  else if (client_id >= ep->client_count)
+  {
+    status = CY_IPC_PIPE_ERROR_BAD_CLIENT;
+  }
+  else
+  {
+    ep->callbacks[client_id] = callback;
+  }
+  (void)pthread_mutex_unlock(&ep->lock);
+  return status;
+}
+
+cy_en_ipc_pipe_status_t Cy_IPC_Pipe_SendMessage(uint32_t to_addr, uint32_t from_addr, void *msg,
+                                                cy_ipc_pipe_relcallback_ptr_t callback)
+{
+  sim_ipc_ep_t *ep;
+  cy_en_ipc_pipe_status_t status = CY_IPC_PIPE_SUCCESS;
+
+  (void)from_addr;
+  if ((to_addr >= CY_IPC_PIPE_EP_COUNT) || (NULL == msg))
+  {
+    return CY_IPC_PIPE_ERROR_BAD_HANDLE;
+  }
+  ep = &s_endpoints[to_addr];
+  (void)pthread_mutex_lock(&ep->lock);
+  if (!ep->configured)
+  {
+    status = CY_IPC_PIPE_ERROR_NO_IPC;
+  }
+  else if (NULL != ep->msg)
+  {
+    status = CY_IPC_PIPE_ERROR_SEND_BUSY;
+  }
+  else
+  {
+    ep->msg = (uint32_t *)msg;
+    ep->release = callback;
+    ep->notifies++;
+    (void)pthread_cond_broadcast(&ep->cond);
+  }
+  (void)pthread_mutex_unlock(&ep->lock);
+  return status;
+}
+
+void Cy_IPC_Pipe_ExecuteCallback(uint32_t ep_addr)
+{
+  sim_ipc_ep_t *ep;
+  uint32_t *msg;
+  cy_ipc_pipe_callback_ptr_t callback = NULL;
+
+  if (ep_addr >= CY_IPC_PIPE_EP_COUNT)
+  {
+    return;
+  }
+  ep = &s_endpoints[ep_addr];
+  (void)pthread_mutex_lock(&ep->lock);
+  msg = ep->msg;
+  if ((NULL != msg) && ((msg[0] & CY_IPC_PIPE_MSG_CLIENT_MASK) < ep->client_count))
+  {
+    callback = ep->callbacks[msg[0] & CY_IPC_PIPE_MSG_CLIENT_MASK];
+  }
+  (void)pthread_mutex_unlock(&ep->lock);
+  if (NULL == msg)
+  {
+    return;
+  }
+
+  if (NULL != callback)
+  {
+    callback(msg);
+  }
+  sim_ipc_release(ep);
+}
+
+void Cy_IPC_Sema_Init(uint32_t ipc_channel, uint32_t count, uint32_t *memory)
+{
+  (void)ipc_channel;
+  if (NULL != memory)
+  {
+    (void)memset(memory, 0, ((count + CY_IPC_SEMA_PER_WORD - 1U) / CY_IPC_SEMA_PER_WORD) * sizeof(uint32_t));
+  }
+}
+
+cy_en_ipc_sema_status_t Cy_IPC_Sema_Set(uint32_t ipc_channel, uint32_t sema_number)
+{
+  (void)ipc_channel;
+  return (sema_number < CY_IPC_SEMA_COUNT) ? CY_IPC_SEMA_SUCCESS : CY_IPC_SEMA_OUT_OF_RANGE;
+}
+
+cy_en_ipc_sema_status_t Cy_IPC_Sema_Clear(uint32_t ipc_channel, uint32_t sema_number)
+{
+  (void)ipc_channel;
+  return (sema_number < CY_IPC_SEMA_COUNT) ? CY_IPC_SEMA_SUCCESS : CY_IPC_SEMA_OUT_OF_RANGE;
+}
+
+/*******************************************************************************
+ * SysLib, interrupts and GPIO
+ *******************************************************************************/
+
+uint32_t Cy_SysLib_EnterCriticalSection(void)
+{
+  sim_port_enter_critical();
+  return 0U;
+}
+
+void Cy_SysLib_ExitCriticalSection(uint32_t saved_intr_status)
+{
+  (void)saved_intr_status;
+  sim_port_exit_critical();
+}
+
+void Cy_SysLib_Delay(uint32_t milliseconds)
+{
+  sim_sleep_us((uint64_t)milliseconds * 1000ULL);
+}
+
+void Cy_SysLib_DelayUs(uint16_t microseconds)
+{
+  sim_sleep_us(microseconds);
+}
+
+uint32_t Cy_SysLib_GetResetReason(void)
+{
+  return 0U;
+}
+
+cy_en_sysint_status_t Cy_SysInt_Init(const cy_stc_sysint_t *config, cy_israddress user_isr)
+{
+  return ((NULL == config) || (NULL == user_isr)) ? CY_SYSINT_BAD_PARAM : CY_SYSINT_SUCCESS;
+}
+
+void NVIC_EnableIRQ(IRQn_Type irq)
+{
+  (void)irq;
+}
+
+void NVIC_DisableIRQ(IRQn_Type irq)
+{
+  (void)irq;
+}
+
+void NVIC_SystemReset(void)
+{
+  abort();
+}
+
+void Cy_GPIO_Inv(GPIO_PRT_Type *base, uint32_t pin)
+{
+  __atomic_fetch_xor(&base->OUT, 1UL << pin, __ATOMIC_RELAXED);
+}
+
+void Cy_GPIO_Write(GPIO_PRT_Type *base, uint32_t pin, uint32_t value)
+{
+  if (0U != value)
+  {
+    __atomic_fetch_or(&base->OUT, 1UL << pin, __ATOMIC_RELAXED);
+  }
+  else
+  {
+    __atomic_fetch_and(&base->OUT, ~(1UL << pin), __ATOMIC_RELAXED);
+  }
+}
+
+uint32_t Cy_GPIO_Read(GPIO_PRT_Type *base, uint32_t pin)
+{
+  return (__atomic_load_n(&base->OUT, __ATOMIC_RELAXED) >> pin) & 1UL;
+}
@@ -2,11 +2,20 @@
 
 #include "cy_syslib.h"
 #include "cybsp.h"
+#include "ipc_blackboard.h"
+#include "ipc_cmd.h"
+#include "ipc_crc.h"
+#include "ipc_event_bridge.h"
+#include "ipc_lane.h"
+#include "ipc_liveness.h"
 #include "ipc_log.h"
+#include "ipc_ring.h"
+#include "ipc_stats.h"
 #include "udp_server_app.h"
 #include "user_buttons.h"
 #include "wifi_manager.h"
-#include <queue.h>
+#include <message_buffer.h>
+#include <semphr.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -14,93 +23,556 @@
 #define IPC_TASK_PRIO (3U)
 #define CM33_APP_DELAY_MS (50U)
 #define RESET_VAL (0U)
-#define IPC_SEND_QUEUE_LEN (16U)
-#define IPC_RECV_RING_LEN (16U)
+#define IPC_CONTROL_LANE_BYTES (512U) /* Lane send buffers hold variable-length entries plus a size_t length word each */
+#define IPC_BULK_LANE_BYTES (2048U)
+#define IPC_CONTROL_LANE_BLOCK_MS (2U)
+#define IPC_RECV_RING_LEN (IPC_RING_CREDITS) /* Per class; one slot per CM55 credit, so CM55 can never overrun it */
+#define IPC_RECV_BULK_LIMIT (IPC_RING_CREDITS - IPC_LANE_CONTROL_RESERVE_CREDITS) /* Default bulk share */
+#define IPC_CREDIT_WAKE_LEVEL (IPC_RING_BACKLOG_THROTTLE - 1U) /* Wake a credit-starved or throttled CM55 below this */
+#define IPC_RETRY_TICKS (1U)
+#define IPC_SEND_LOCK_TIMEOUT_MS (20U)
+#define IPC_BENCH_ENQUEUE_TIMEOUT_MS (100U)
+#define IPC_BENCH_REPORT_TIMEOUT_MS (2000U)
+#define IPC_SCAN_ACK_TIMEOUT_MS (200U)
+#define IPC_SCAN_RECLAIM_MS (2000U) /* ipc_task takes back a scan buffer left unacknowledged this long */
+#define IPC_SCAN_SEND_TIMEOUT_MS (20U)
+#define IPC_LANE_BENCH_PAYLOAD (IPC_DATA_MAX_LEN)
+#define IPC_LANE_BENCH_CONTROL_EVERY (16U)
+
+typedef struct
+{
+  MessageBufferHandle_t buf;
+  SemaphoreHandle_t lock; /* Message buffers allow one writer at a time */
+  ipc_lane_stats_t stats;
+} cm33_ipc_lane_t;
+
+/** Received frames of one command class, waiting for ipc_task. Written in the pipe ISR or with interrupts masked. */
+typedef struct
+{
+  ipc_msg_t msg[IPC_RECV_RING_LEN];
+  uint32_t stamp[IPC_RECV_RING_LEN]; /* ipc_stats_on_receive() time of each slot */
+  uint32_t head;
+  uint32_t tail;
+  cm33_ipc_recv_stats_t stats; /* Policy, limit, queued, peak, dropped */
+} cm33_ipc_recv_queue_t;
+
+static const ipc_lane_config_t s_lane_config[IPC_LANE_COUNT] = {
+    [IPC_LANE_CONTROL] = { IPC_CONTROL_LANE_BYTES, IPC_LANE_POLICY_BLOCK, IPC_CONTROL_LANE_BLOCK_MS },
+    [IPC_LANE_BULK] = { IPC_BULK_LANE_BYTES, IPC_LANE_POLICY_DROP_NEWEST, 0U },
+};
 
 static TaskHandle_t ipc_task_handle;
-CY_SECTION_SHAREDMEM static ipc_msg_t cm33_msg_data;
-static int ipc_counter = 0;
-static QueueHandle_t s_ipc_send_queue = NULL;
-static ipc_msg_t s_ipc_recv_ring[IPC_RECV_RING_LEN];
-static volatile uint32_t s_ipc_recv_head = 0U;
-static volatile uint32_t s_ipc_recv_tail = 0U;
-static volatile uint32_t s_ipc_recv_count = 0U;
+CY_SECTION_SHAREDMEM static ipc_doorbell_t cm33_doorbell;
+CY_SECTION_SHAREDMEM CY_ALIGN(IPC_RING_CACHE_LINE) static ipc_ring_t cm33_tx_ring;
+CY_SECTION_SHAREDMEM CY_ALIGN(IPC_RING_CACHE_LINE) static ipc_blackboard_t cm33_blackboard;
+CY_SECTION_SHAREDMEM CY_ALIGN(IPC_RING_CACHE_LINE) static ipc_liveness_t cm33_liveness;
+static ipc_liveness_monitor_t s_peer_live; /* CM55 record; checked by ipc_task only */
+static ipc_liveness_config_t s_live_config; /* Set by cm33_ipc_set_liveness_config(), applied by ipc_task */
+static volatile bool s_live_config_pending = false;
+static ipc_button_state_t s_button_state; /* Source of the IPC_BLACKBOARD_BUTTONS slot */
+static ipc_ring_t *volatile s_peer_ring = NULL;
+static bool s_doorbell_pending = false;
+static bool s_credit_doorbell = false;
+static cm33_ipc_lane_t s_lanes[IPC_LANE_COUNT];
+static cm33_ipc_recv_queue_t s_recv[IPC_LANE_COUNT] = {
+    [IPC_LANE_CONTROL] = { .stats = { CM33_IPC_RECV_BLOCK, IPC_RECV_RING_LEN, 0U, 0U, 0U } },
+    [IPC_LANE_BULK] = { .stats = { CM33_IPC_RECV_BLOCK, IPC_RECV_BULK_LIMIT, 0U, 0U, 0U } },
+};
+static volatile uint32_t s_ipc_recv_count = 0U;   /* Frames queued in both classes */
 static volatile uint32_t s_ipc_recv_total = 0U;
+static volatile uint32_t s_recv_credits_owed = 0U; /* Credits of dropped frames, returned by ipc_task */
+static SemaphoreHandle_t s_bench_done = NULL;
+static SemaphoreHandle_t s_bench_lock = NULL;
+static ipc_bench_report_t s_bench_report;
+CY_SECTION_SHAREDMEM static wifi_info_t cm33_scan_buf[IPC_WIFI_SCAN_BULK_MAX];
+static SemaphoreHandle_t s_scan_buf_free = NULL;
+static uint16_t s_scan_transfer_id = 0U;
+static TickType_t s_scan_taken_tick = 0U; /* When the scan buffer was last acquired */
+static wifi_info_t s_scan_pending[IPC_WIFI_SCAN_BULK_MAX]; /* Latest results still to send, see cm33_scan_flush_pending() */
+static uint32_t s_scan_pending_count = 0U;                 /* 0 if none */
+static SemaphoreHandle_t s_scan_pending_lock = NULL;
+static volatile uint32_t s_scan_crc_errors = 0U;
+#if (0 != IPC_EVENT_BRIDGE_ENABLE)
+CY_SECTION_SHAREDMEM CY_ALIGN(IPC_RING_CACHE_LINE) static ipc_event_bridge_buffers_t cm33_bridge_buffers;
+static event_bus_t volatile s_bridge_bus = NULL; /* Bus that events from CM55 are published on */
+#endif
 
-static bool internal_send_message(uint32_t cmd, uint32_t value, const void *data, uint32_t data_size)
+/**
+ * Queues one frame on its command's lane for ipc_task. Only the header and data_size payload bytes
+ * are copied, together with the enqueue stamp. Several tasks send concurrently, so writers are
+ * serialized per lane as message buffers require; a control sender never waits for a bulk writer.
+ * Waits up to lock_ticks for the lane lock and send_ticks for space.
+ */
+static bool internal_enqueue_message(uint32_t cmd, uint32_t value, const void *data, uint32_t data_size,
+                                     TickType_t lock_ticks, TickType_t send_ticks)
 {
-  if (NULL == s_ipc_send_queue)
+  ipc_lane_t lane = ipc_lane_of(cmd);
+  cm33_ipc_lane_t *l = &s_lanes[lane];
+  ipc_lane_entry_t entry;
+  ipc_msg_t *msg = &entry.msg;
+  size_t entry_len;
+  bool sent;
+
+  if (NULL == l->buf)
   {
     return false;
   }
 
-  ipc_msg_t msg;
-  (void)memset(&msg, 0, sizeof(msg));
-  msg.cmd = cmd;
-  msg.value = value;
-
-  if ((NULL != data) && (data_size > 0U))
+  if (NULL == data)
   {
-    uint32_t copy_size = data_size;
-    if (copy_size > IPC_DATA_MAX_LEN)
-    {
-      copy_size = IPC_DATA_MAX_LEN;
-    }
-    (void)memcpy(msg.data, data, copy_size);
+    data_size = 0U;
+  }
+  else if (data_size > IPC_DATA_MAX_LEN)
+  {
+    data_size = IPC_DATA_MAX_LEN;
+  }
+  msg->cmd = cmd;
+  msg->value = value;
+  msg->len = (uint16_t)data_size;
+  msg->reserved = 0U;
+  if (0U < data_size)
+  {
+    (void)memcpy(msg->data, data, data_size);
   }
+  entry_len = IPC_LANE_ENTRY_LEN(data_size);
+  if (pdPASS != xSemaphoreTake(l->lock, lock_ticks))
+  {
+    l->stats.dropped++;
+    ipc_stats_on_drop(cmd);
+    return false;
+  }
+  entry.enqueue_stamp = ipc_lane_stamp();
+  sent = (entry_len == xMessageBufferSend(l->buf, &entry, entry_len, send_ticks));
+  if (!sent)
+  {
+    l->stats.dropped++;
+    ipc_stats_on_drop(cmd);
+  }
+  (void)xSemaphoreGive(l->lock);
 
-  return (pdPASS == xQueueSend(s_ipc_send_queue, &msg, 0U));
+  if (sent && (NULL != ipc_task_handle))
+  {
+    (void)xTaskNotifyGive(ipc_task_handle);
+  }
+  return sent;
 }
 
+/**
+ * Queues one frame (see internal_enqueue_message()). timeout_ticks 0 applies the lane's drop policy;
+ * otherwise the caller's wait overrides it.
+ */
 static bool internal_send_message_ticks(uint32_t cmd, uint32_t value, const void *data,
                                         uint32_t data_size, TickType_t timeout_ticks)
 {
-  if (NULL == s_ipc_send_queue)
+  ipc_lane_t lane = ipc_lane_of(cmd);
+  TickType_t lock_ticks;
+
+  if ((0U == timeout_ticks) && (IPC_LANE_POLICY_BLOCK == s_lane_config[lane].policy))
+  {
+    timeout_ticks = pdMS_TO_TICKS(s_lane_config[lane].block_ms);
+  }
+
+  /* A zero-timeout send still waits briefly for another writer to finish its copy. */
+  lock_ticks = (0U == timeout_ticks) ? pdMS_TO_TICKS(IPC_SEND_LOCK_TIMEOUT_MS) : timeout_ticks;
+  return internal_enqueue_message(cmd, value, data, data_size, lock_ticks, timeout_ticks);
+}
+
+static bool internal_send_message(uint32_t cmd, uint32_t value, const void *data, uint32_t data_size)
+{
+  return internal_send_message_ticks(cmd, value, data, data_size, 0U);
+}
+
+#if (0 != IPC_EVENT_BRIDGE_ENABLE)
+/**
+ * Event bridge frames are sent from the timer task, so they never wait for the lane lock or for
+ * space; the bridge retries what the lane refuses.
+ */
+static bool cm33_bridge_send(uint32_t cmd, const void *data, uint32_t len)
+{
+  return internal_enqueue_message(cmd, RESET_VAL, data, len, 0U, 0U);
+}
+
+/**
+ * Publishes an event from CM55 on the attached bus (ipc_task context). payload points into the CM55
+ * batch buffer, so asynchronous subscribers copy only its len bytes. CM33 buses have no event types,
+ * so event_type is dropped.
+ */
+static bool cm33_bridge_deliver(uint16_t channel_id, uint32_t event_type, const void *payload, uint32_t len)
+{
+  (void)event_type;
+  if (NULL == s_bridge_bus)
   {
     return false;
   }
+  return event_bus_publish_sized(s_bridge_bus, channel_id, (void *)payload, len);
+}
+
+static bool cm33_bridge_forward(uint32_t event_id, const void *event_data, uint32_t size)
+{
+  if (UINT16_MAX < event_id)
+  {
+    return false;
+  }
+  return ipc_event_bridge_forward((uint16_t)event_id, 0U, event_data, size, false);
+}
+
+static void cm33_bridge_subscribers_changed(uint32_t event_id, uint32_t subscriber_count)
+{
+  if (UINT16_MAX >= event_id)
+  {
+    (void)ipc_event_bridge_set_interest((uint16_t)event_id, 0U < subscriber_count);
+  }
+}
+
+static const event_bus_bridge_t s_bus_bridge = { cm33_bridge_forward, cm33_bridge_subscribers_changed };
+#endif /* IPC_EVENT_BRIDGE_ENABLE */
+
+/**
+ * Discards the frame at the tail of q (or, if it was never queued, the arriving frame of command cmd)
+ * and owes CM55 its credit. Runs in the pipe ISR or with interrupts masked.
+ */
+static void cm33_recv_drop(cm33_ipc_recv_queue_t *q, uint32_t cmd)
+{
+  q->stats.dropped++;
+  s_recv_credits_owed++;
+  ipc_stats_on_overflow(cmd);
+}
+
+/**
+ * Copies messages from the CM55 ring into the receive queue of their class until the CM55 ring is
+ * empty, stamping each with its receive time. A class at its limit applies its policy: BLOCK leaves
+ * the frame (and everything behind it) in the shared ring, so CM55 runs out of credits rather than
+ * losing it; DROP_NEWEST discards the arriving frame, DROP_OLDEST the oldest queued frame of the
+ * class. Publishes the resulting backlog for CM55. Runs in the pipe ISR or with interrupts masked.
+ */
+static void cm33_drain_peer_ring(void)
+{
+  ipc_ring_t *ring = s_peer_ring;
+  const ipc_msg_t *msg;
 
-  ipc_msg_t msg;
-  (void)memset(&msg, 0, sizeof(msg));
-  msg.cmd = cmd;
-  msg.value = value;
+  if (NULL == ring)
+  {
+    return;
+  }
 
-  if ((NULL != data) && (data_size > 0U))
+  while (NULL != (msg = ipc_ring_peek(ring)))
   {
-    uint32_t copy_size = data_size;
-    if (copy_size > IPC_DATA_MAX_LEN)
+    cm33_ipc_recv_queue_t *q = &s_recv[ipc_lane_of(msg->cmd)];
+    uint32_t rx_us;
+
+    if (q->stats.queued >= q->stats.limit)
+    {
+      if (CM33_IPC_RECV_BLOCK == q->stats.policy)
+      {
+        break;
+      }
+      if (CM33_IPC_RECV_DROP_NEWEST == q->stats.policy)
+      {
+        (void)ipc_stats_on_receive(msg->cmd, msg->sent_us, msg->len);
+        cm33_recv_drop(q, msg->cmd);
+        ipc_ring_release(ring);
+        continue;
+      }
+      cm33_recv_drop(q, q->msg[q->tail].cmd);
+      q->tail = (q->tail + 1U) % IPC_RECV_RING_LEN;
+      q->stats.queued--;
+      s_ipc_recv_count--;
+    }
+
+    rx_us = ipc_stats_on_receive(msg->cmd, msg->sent_us, msg->len);
+    (void)memcpy(&q->msg[q->head], msg, IPC_MSG_FRAME_LEN(msg->len));
+    q->stamp[q->head] = rx_us;
+    ipc_ring_release(ring);
+
+    q->head = (q->head + 1U) % IPC_RECV_RING_LEN;
+    q->stats.queued++;
+    if (q->stats.queued > q->stats.peak)
     {
-      copy_size = IPC_DATA_MAX_LEN;
+      q->stats.peak = q->stats.queued;
     }
-    (void)memcpy(msg.data, data, copy_size);
+    s_ipc_recv_count++;
+    s_ipc_recv_total++;
   }
 
-  return (pdPASS == xQueueSend(s_ipc_send_queue, &msg, timeout_ticks));
+  ipc_ring_set_backlog(ring, s_ipc_recv_count);
 }
 
+/**
+ * Doorbell from CM55: remembers its ring, drains everything queued so far and wakes ipc_task.
+ */
 static void cm33_msg_callback(uint32_t *msg_data)
 {
-  uint32_t next_head;
+  const ipc_doorbell_t *doorbell = (const ipc_doorbell_t *)msg_data;
+  BaseType_t woken = pdFALSE;
 
-  if (NULL == msg_data)
+  if ((NULL == doorbell) || (NULL == doorbell->ring))
   {
     return;
   }
 
-  if (s_ipc_recv_count >= IPC_RECV_RING_LEN)
+  s_peer_ring = doorbell->ring;
+  ipc_liveness_monitor_attach(&s_peer_live, doorbell->live);
+  cm33_drain_peer_ring();
+
+  if (NULL != ipc_task_handle)
+  {
+    vTaskNotifyGiveFromISR(ipc_task_handle, &woken);
+    portYIELD_FROM_ISR(woken);
+  }
+}
+
+/**
+ * Takes the oldest received frame and its receive time, control class first, and refills the
+ * receive queues from the CM55 ring. Returns false when nothing is pending.
+ */
+static bool ipc_recv_pop(ipc_msg_t *msg, uint32_t *rx_us)
+{
+  bool popped = false;
+  uint32_t intr_state = Cy_SysLib_EnterCriticalSection();
+  cm33_ipc_recv_queue_t *q =
+      (0U < s_recv[IPC_LANE_CONTROL].stats.queued) ? &s_recv[IPC_LANE_CONTROL] : &s_recv[IPC_LANE_BULK];
+
+  if (0U < q->stats.queued)
+  {
+    (void)memcpy(msg, &q->msg[q->tail], IPC_MSG_FRAME_LEN(q->msg[q->tail].len));
+    *rx_us = q->stamp[q->tail];
+    q->tail = (q->tail + 1U) % IPC_RECV_RING_LEN;
+    q->stats.queued--;
+    s_ipc_recv_count--;
+    popped = true;
+    cm33_drain_peer_ring();
+  }
+  Cy_SysLib_ExitCriticalSection(intr_state);
+
+  return popped;
+}
+
+/**
+ * Takes the credits owed for frames dropped by a receive policy. Returns their number.
+ */
+static uint32_t ipc_recv_take_owed_credits(void)
+{
+  uint32_t intr_state = Cy_SysLib_EnterCriticalSection();
+  uint32_t owed = s_recv_credits_owed;
+
+  s_recv_credits_owed = 0U;
+  Cy_SysLib_ExitCriticalSection(intr_state);
+
+  return owed;
+}
+
+/**
+ * Moves the oldest frame of one lane into the shared ring, copying only its used bytes, stamps its
+ * send time and accounts its queueing delay. The bulk lane leaves IPC_LANE_CONTROL_RESERVE_BYTES of the ring free so a
+ * control frame always finds room. Returns false when the lane is empty or the frame does not fit
+ * (then *ring_full is set).
+ */
+static bool ipc_tx_move(ipc_lane_t lane, bool *ring_full)
+{
+  cm33_ipc_lane_t *l = &s_lanes[lane];
+  ipc_lane_entry_t entry;
+  size_t entry_len = xMessageBufferNextLengthBytes(l->buf);
+  uint32_t frame_len;
+  uint32_t queue_us;
+  ipc_msg_t *slot;
+
+  if (0U == entry_len)
+  {
+    return false;
+  }
+  frame_len = (uint32_t)(entry_len - offsetof(ipc_lane_entry_t, msg));
+  if ((IPC_LANE_BULK == lane) &&
+      ((IPC_RING_BYTES - ipc_ring_used(&cm33_tx_ring)) <
+       (IPC_LANE_CONTROL_RESERVE_BYTES + IPC_RING_FRAME_SPAN(frame_len - IPC_MSG_HDR_LEN))))
+  {
+    *ring_full = true;
+    return false;
+  }
+  slot = ipc_ring_claim(&cm33_tx_ring, frame_len);
+  if (NULL == slot)
+  {
+    *ring_full = true;
+    return false;
+  }
+  (void)xMessageBufferReceive(l->buf, &entry, entry_len, 0U);
+  (void)memcpy(slot, &entry.msg, frame_len);
+  slot->sent_us = ipc_stats_now_us();
+  ipc_ring_commit(&cm33_tx_ring, frame_len);
+  queue_us = ipc_lane_elapsed_us(entry.enqueue_stamp);
+  ipc_stats_hist_record(&l->stats.delay, queue_us);
+  ipc_stats_on_send(entry.msg.cmd, queue_us);
+  return true;
+}
+
+/**
+ * Moves queued frames into the shared ring with strict priority: the control lane is emptied first
+ * and re-checked before every bulk frame. Never blocks; stops when both lanes are empty or the ring
+ * has no room for the next frame. Sets *ring_full in the latter case. Returns the number of frames
+ * published.
+ */
+static uint32_t ipc_tx_pump(bool *ring_full)
+{
+  uint32_t moved = 0U;
+
+  *ring_full = false;
+  while (!*ring_full)
+  {
+    if (!ipc_tx_move(IPC_LANE_CONTROL, ring_full) && (*ring_full || !ipc_tx_move(IPC_LANE_BULK, ring_full)))
+    {
+      break;
+    }
+    moved++;
+  }
+
+  return moved;
+}
+
+/**
+ * Rings CM55 once for everything published so far, or because credits were returned while CM55 was
+ * waiting for them. If the channel is still busy with the previous doorbell the ring is retried by
+ * ipc_task until it succeeds or there is nothing left to signal.
+ */
+static void ipc_tx_doorbell(void)
+{
+  if (ipc_ring_is_empty(&cm33_tx_ring) && !s_credit_doorbell)
   {
+    s_doorbell_pending = false;
     return;
   }
 
-  (void)memcpy(&s_ipc_recv_ring[s_ipc_recv_head], msg_data, sizeof(ipc_msg_t));
-  next_head = s_ipc_recv_head + 1U;
-  if (next_head >= IPC_RECV_RING_LEN)
+  s_doorbell_pending = (CY_IPC_PIPE_SUCCESS != Cy_IPC_Pipe_SendMessage(CM55_IPC_PIPE_EP_ADDR, CM33_IPC_PIPE_EP_ADDR,
+                                                                        (void *)&cm33_doorbell, NULL));
+  if (!s_doorbell_pending)
+  {
+    s_credit_doorbell = false;
+  }
+}
+
+/**
+ * Returns count credits for frames taken out of, or dropped from, the receive queues. CM55 is only
+ * woken once the receive backlog is half drained, so a flood moves in batches rather than one
+ * doorbell per frame.
+ */
+static void ipc_return_credit(uint32_t count)
+{
+  if ((0U < count) && ipc_ring_credit_return(s_peer_ring, count) && (s_ipc_recv_count <= IPC_CREDIT_WAKE_LEVEL))
   {
-    next_head = 0U;
+    s_credit_doorbell = true;
+    ipc_tx_doorbell();
   }
-  s_ipc_recv_head = next_head;
-  s_ipc_recv_count++;
-  s_ipc_recv_total++;
+}
+
+/**
+ * Takes ownership of the shared scan buffer, waiting up to timeout_ticks for CM55 to acknowledge the
+ * previous transfer. Returns false if it did not; the buffer must then be left alone. The next
+ * transfer ID is taken before the buffer is written, so a late ack of the previous transfer can no
+ * longer free it.
+ */
+static bool cm33_scan_buf_acquire(TickType_t timeout_ticks)
+{
+  if (pdPASS != xSemaphoreTake(s_scan_buf_free, timeout_ticks))
+  {
+    return false;
+  }
+  taskENTER_CRITICAL();
+  s_scan_transfer_id++;
+  s_scan_taken_tick = xTaskGetTickCount();
+  taskEXIT_CRITICAL();
+  return true;
+}
+
+/**
+ * Takes the scan buffer back from a transfer CM55 has not acknowledged within IPC_SCAN_RECLAIM_MS:
+ * a lost ack or descriptor, or a CM55 restart, would otherwise hold it for good. ipc_task only, so
+ * no ack is handled in between. The new transfer ID makes a late ack of the abandoned transfer miss,
+ * and CM55 checks the CRC of its copy, so a list it was still reading is caught. Returns false, with
+ * the ticks left in *wait_ticks, if the buffer was acquired too recently.
+ */
+static bool cm33_scan_buf_reclaim(TickType_t *wait_ticks)
+{
+  TickType_t held = xTaskGetTickCount() - s_scan_taken_tick;
+
+  if (held < pdMS_TO_TICKS(IPC_SCAN_RECLAIM_MS))
+  {
+    *wait_ticks = pdMS_TO_TICKS(IPC_SCAN_RECLAIM_MS) - held;
+    return false;
+  }
+  taskENTER_CRITICAL();
+  s_scan_transfer_id++;
+  s_scan_taken_tick = xTaskGetTickCount();
+  taskEXIT_CRITICAL();
+  return true;
+}
+
+/**
+ * Hands count entries of cm33_scan_buf to CM55 with one IPC_EVT_WIFI_SCAN_BULK descriptor. The
+ * buffer stays owned by CM55 until IPC_CMD_WIFI_SCAN_ACK for this transfer arrives.
+ */
+static bool cm33_scan_buf_publish(uint32_t count, uint32_t flags, TickType_t timeout_ticks)
+{
+  ipc_wifi_scan_bulk_t bulk;
+
+  bulk.transfer_id = s_scan_transfer_id;
+  bulk.count = (uint16_t)count;
+  bulk.crc32 = ipc_crc32(cm33_scan_buf, count * (uint32_t)sizeof(wifi_info_t));
+  bulk.list = cm33_scan_buf;
+
+  if (!internal_send_message_ticks(IPC_EVT_WIFI_SCAN_BULK, flags, &bulk, sizeof(bulk), timeout_ticks))
+  {
+    (void)xSemaphoreGive(s_scan_buf_free);
+    return false;
+  }
+  return true;
+}
+
+/**
+ * Keeps results that could not be sent now in place of any older ones and wakes ipc_task to send
+ * them once the scan buffer is free.
+ */
+static void cm33_scan_defer(const wifi_info_t *results, uint32_t count)
+{
+  if (pdPASS != xSemaphoreTake(s_scan_pending_lock, portMAX_DELAY))
+  {
+    return;
+  }
+  (void)memcpy(s_scan_pending, results, count * sizeof(wifi_info_t));
+  s_scan_pending_count = count;
+  (void)xSemaphoreGive(s_scan_pending_lock);
+
+  if (NULL != ipc_task_handle)
+  {
+    (void)xTaskNotifyGive(ipc_task_handle);
+  }
+}
+
+/**
+ * Sends deferred scan results if CM55 has acknowledged the previous transfer, or reclaims the buffer
+ * if it never did (ipc_task context, no waiting). Returns how long ipc_task may sleep before calling
+ * again: IPC_RETRY_TICKS if the lane was full, the ticks until the buffer may be reclaimed, or
+ * portMAX_DELAY if nothing is left to send.
+ */
+static TickType_t cm33_scan_flush_pending(void)
+{
+  TickType_t wait_ticks = portMAX_DELAY;
+
+  if ((0U == s_scan_pending_count) || (pdPASS != xSemaphoreTake(s_scan_pending_lock, 0U)))
+  {
+    return portMAX_DELAY; /* A writer holding the lock notifies ipc_task when it is done */
+  }
+  if ((0U < s_scan_pending_count) && (cm33_scan_buf_acquire(0U) || cm33_scan_buf_reclaim(&wait_ticks)))
+  {
+    (void)memcpy(cm33_scan_buf, s_scan_pending, s_scan_pending_count * sizeof(wifi_info_t));
+    if (cm33_scan_buf_publish(s_scan_pending_count, 0U, 0U))
+    {
+      s_scan_pending_count = 0U;
+    }
+    else
+    {
+      wait_ticks = IPC_RETRY_TICKS;
+    }
+  }
+  (void)xSemaphoreGive(s_scan_pending_lock);
+  return wait_ticks;
 }
 
 static void ipc_button_event_handler(user_buttons_t switch_handle, const button_event_t *evt)
@@ -121,7 +593,8 @@ static void ipc_button_event_handler(user_buttons_t switch_handle, const button_
   (void)cm33_ipc_send_button_event(evt);
 }
 
-static void cm33_wifi_manager_event_callback(wifi_manager_event_t event, const void *data, uint32_t count, void *user_data)
+static void cm33_wifi_manager_event_callback(wifi_manager_event_t event, const void *data, uint32_t count, uint32_t call_id,
+                                             void *user_data)
 {
   (void)user_data;
 
@@ -131,7 +604,7 @@ static void cm33_wifi_manager_event_callback(wifi_manager_event_t event, const v
   }
   else if ((WIFI_MANAGER_EVENT_SCAN_COMPLETE == event) && (NULL != data))
   {
-    (void)cm33_ipc_send_wifi_scan_complete((const ipc_wifi_scan_complete_t *)data);
+    (void)cm33_ipc_send_wifi_scan_complete((const ipc_wifi_scan_complete_t *)data, call_id);
   }
   else if ((WIFI_MANAGER_EVENT_STATUS == event) && (NULL != data))
   {
@@ -144,113 +617,256 @@ static void cm33_wifi_manager_event_callback(wifi_manager_event_t event, const v
     {
       udp_server_app_stop();
     }
-    (void)cm33_ipc_send_wifi_status(status);
+    (void)cm33_ipc_send_wifi_status(status, call_id);
   }
 }
 
-static void ipc_process_incoming(const ipc_msg_t *msg)
+/**
+ * CM55 time sync request: replies with the request's send time and our receive time.
+ */
+static void ipc_on_time_sync(const ipc_msg_t *msg, void *arg)
 {
-  if (NULL == msg)
-  {
-    return;
-  }
+  ipc_time_sync_t sync;
 
-  if (IPC_CMD_WIFI_SCAN_REQ == msg->cmd)
-  {
-    ipc_wifi_scan_request_t req;
-    (void)memset(&req, 0, sizeof(req));
-    (void)memcpy(&req, msg->data, sizeof(req));
-    (void)wifi_manager_request_scan(&req);
-  }
-  else if (IPC_CMD_WIFI_CONNECT_REQ == msg->cmd)
+  sync.t0_us = msg->sent_us;
+  sync.t1_us = *(const uint32_t *)arg;
+  (void)internal_send_message(IPC_CMD_TIME_SYNC, RESET_VAL, &sync, sizeof(sync));
+}
+
+static void ipc_on_wifi_scan_req(const ipc_msg_t *msg, void *arg)
+{
+  ipc_wifi_scan_request_t req;
+
+  (void)arg;
+  (void)memset(&req, 0, sizeof(req));
+  (void)memcpy(&req, msg->data, (msg->len < sizeof(req)) ? msg->len : sizeof(req));
+  (void)wifi_manager_request_scan(&req, msg->value);
+}
+
+static void ipc_on_wifi_connect_req(const ipc_msg_t *msg, void *arg)
+{
+  ipc_wifi_connect_request_t req;
+
+  (void)arg;
+  (void)memset(&req, 0, sizeof(req));
+  (void)memcpy(&req, msg->data, (msg->len < sizeof(req)) ? msg->len : sizeof(req));
+  req.ssid[sizeof(req.ssid) - 1U] = '\0';
+  req.password[sizeof(req.password) - 1U] = '\0';
+  (void)wifi_manager_request_connect(&req, msg->value);
+}
+
+static void ipc_on_wifi_disconnect_req(const ipc_msg_t *msg, void *arg)
+{
+  (void)arg;
+  (void)wifi_manager_request_disconnect(msg->value);
+}
+
+static void ipc_on_wifi_status_req(const ipc_msg_t *msg, void *arg)
+{
+  (void)arg;
+  (void)wifi_manager_request_status(msg->value);
+}
+
+/**
+ * CM55 acknowledged a bulk scan transfer: frees the scan buffer if it is the one in flight.
+ */
+static void ipc_on_wifi_scan_ack(const ipc_msg_t *msg, void *arg)
+{
+  ipc_wifi_scan_ack_t ack;
+
+  (void)arg;
+  (void)memcpy(&ack, msg->data, sizeof(ack));
+  if (IPC_WIFI_SCAN_ACK_OK != ack.status)
   {
-    ipc_wifi_connect_request_t req;
-    (void)memset(&req, 0, sizeof(req));
-    (void)memcpy(&req, msg->data, sizeof(req));
-    req.ssid[sizeof(req.ssid) - 1U] = '\0';
-    req.password[sizeof(req.password) - 1U] = '\0';
-    (void)wifi_manager_request_connect(&req);
+    s_scan_crc_errors++;
   }
-  else if (IPC_CMD_WIFI_DISCONNECT_REQ == msg->cmd)
+  if (ack.transfer_id == s_scan_transfer_id)
   {
-    (void)wifi_manager_request_disconnect();
+    (void)xSemaphoreGive(s_scan_buf_free);
   }
-  else if (IPC_CMD_WIFI_STATUS_REQ == msg->cmd)
+}
+
+static void ipc_on_bench_report(const ipc_msg_t *msg, void *arg)
+{
+  (void)arg;
+  (void)memcpy(&s_bench_report, msg->data, sizeof(s_bench_report));
+  (void)xSemaphoreGive(s_bench_done);
+}
+
+static void ipc_on_print(const ipc_msg_t *msg, void *arg)
+{
+  (void)arg;
+  (void)fwrite(msg->data, 1U, msg->len, stdout);
+}
+
+#if (0 != IPC_EVENT_BRIDGE_ENABLE)
+/**
+ * CM55 event batch: its records are published on the attached bus, then the buffer is acknowledged.
+ */
+static void ipc_on_event_batch(const ipc_msg_t *msg, void *arg)
+{
+  ipc_event_batch_t batch;
+
+  (void)arg;
+  (void)memcpy(&batch, msg->data, sizeof(batch));
+  ipc_event_bridge_receive(&batch);
+}
+
+static void ipc_on_event_batch_ack(const ipc_msg_t *msg, void *arg)
+{
+  ipc_event_batch_ack_t ack;
+
+  (void)arg;
+  (void)memcpy(&ack, msg->data, sizeof(ack));
+  ipc_event_bridge_on_ack(&ack);
+}
+
+static void ipc_on_event_subscribe(const ipc_msg_t *msg, void *arg)
+{
+  ipc_event_subscribe_t subscribe;
+
+  (void)arg;
+  (void)memcpy(&subscribe, msg->data, sizeof(subscribe));
+  ipc_event_bridge_on_subscribe(&subscribe);
+}
+#endif /* IPC_EVENT_BRIDGE_ENABLE */
+
+/* Handlers for CM55 -> CM33 commands, indexed like the registry in ipc_cmd.h */
+static const ipc_cmd_handler_t s_ipc_handlers[IPC_CMD_ID_SLOTS] = {
+    [IPC_CMD_SLOT(IPC_CMD_TIME_SYNC)] = ipc_on_time_sync,
+    [IPC_CMD_SLOT(IPC_CMD_WIFI_SCAN_REQ)] = ipc_on_wifi_scan_req,
+    [IPC_CMD_SLOT(IPC_CMD_WIFI_CONNECT_REQ)] = ipc_on_wifi_connect_req,
+    [IPC_CMD_SLOT(IPC_CMD_WIFI_DISCONNECT_REQ)] = ipc_on_wifi_disconnect_req,
+    [IPC_CMD_SLOT(IPC_CMD_WIFI_STATUS_REQ)] = ipc_on_wifi_status_req,
+    [IPC_CMD_SLOT(IPC_CMD_WIFI_SCAN_ACK)] = ipc_on_wifi_scan_ack,
+    [IPC_CMD_SLOT(IPC_CMD_BENCH_REPORT)] = ipc_on_bench_report,
+    [IPC_CMD_SLOT(IPC_CMD_PRINT)] = ipc_on_print,
+#if (0 != IPC_EVENT_BRIDGE_ENABLE)
+    [IPC_CMD_SLOT(IPC_CMD_EVENT_BATCH)] = ipc_on_event_batch,
+    [IPC_CMD_SLOT(IPC_CMD_EVENT_BATCH_ACK)] = ipc_on_event_batch_ack,
+    [IPC_CMD_SLOT(IPC_CMD_EVENT_SUBSCRIBE)] = ipc_on_event_subscribe,
+#endif
+};
+
+/**
+ * Runs the handler of one received frame (ipc_task context). rx_us is its receive time on the
+ * shared timebase.
+ */
+static void ipc_process_incoming(const ipc_msg_t *msg, uint32_t rx_us)
+{
+  if (NULL == msg)
   {
-    (void)wifi_manager_request_status();
+    return;
   }
-  else if (IPC_CMD_PRINT == msg->cmd)
+  (void)ipc_cmd_dispatch(s_ipc_handlers, msg, &rx_us);
+}
+
+/**
+ * Default liveness callback (ipc_task): reports CM55 stalls and faults on the debug UART.
+ */
+static void ipc_peer_liveness_cb(ipc_liveness_event_t event, const ipc_liveness_status_t *status, void *user_data)
+{
+  static const char *const names[] = { "late", "stalled", "recovered", "fault" };
+
+  (void)user_data;
+  printf("[IPC] CM55 %s: state %s, beat %lu, silent %lu ms\n", names[event], ipc_liveness_state_name(status->state),
+         (unsigned long)status->counter, (unsigned long)status->silent_ms);
+}
+
+/**
+ * Local milliseconds for the liveness monitor.
+ */
+static uint32_t ipc_now_ms(void)
+{
+  return (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS);
+}
+
+/**
+ * Wakes ipc_task for a queued UDP packet (socket receive context).
+ */
+static void ipc_udp_rx_notify(void)
+{
+  if (NULL != ipc_task_handle)
   {
-    char buf[IPC_DATA_MAX_LEN];
-    (void)memcpy(buf, msg->data, IPC_DATA_MAX_LEN - 1UL);
-    buf[IPC_DATA_MAX_LEN - 1UL] = '\0';
-    (void)printf("%s", buf);
+    (void)xTaskNotifyGive(ipc_task_handle);
   }
 }
 
+/**
+ * Event-driven pump. Sleeps until notified by the CM55 doorbell, a local sender or the UDP server,
+ * then handles everything pending in one pass: up to a full receive ring of CM55 frames (credits
+ * returned as they go), every queued send (one doorbell for all of them) and the UDP RX batch. Each
+ * pass beats cm33_liveness and checks the CM55 record, which owes a beat while CM55 is busy or has
+ * left frames of an earlier pass in cm33_tx_ring. It only wakes on a timeout while a doorbell or
+ * ring-full retry is outstanding or CM55 owes a beat; otherwise it blocks without one, so an idle
+ * CM33 can stay in tickless idle.
+ */
 static void ipc_task(void *arg)
 {
-  ipc_msg_t send_msg;
   ipc_msg_t recv_msg;
-  TickType_t last_heartbeat = xTaskGetTickCount();
-  bool has_recv_msg;
-  uint32_t intr_state;
+  uint32_t rx_us;
+  TickType_t wait_ticks = 0U;
+  TickType_t check_ticks;
+  bool ring_full = false;
+  bool udp_more;
+  bool busy;
+  TickType_t scan_ticks;
+  uint32_t received;
 
   (void)arg;
   vTaskDelay(pdMS_TO_TICKS(1000U));
 
   while (true)
   {
-    if ((NULL != s_ipc_send_queue) && (pdPASS == xQueueReceive(s_ipc_send_queue, &send_msg, pdMS_TO_TICKS(5U))))
+    (void)ulTaskNotifyTake(pdTRUE, wait_ticks);
+    ipc_liveness_beat(&cm33_liveness, IPC_LIVENESS_BUSY);
+    if (s_live_config_pending)
     {
-      cm33_msg_data.client_id = CM55_IPC_PIPE_CLIENT_ID;
-      cm33_msg_data.intr_mask = CY_IPC_CYPIPE_INTR_MASK_EP1;
-      cm33_msg_data.cmd = send_msg.cmd;
-      cm33_msg_data.value = send_msg.value;
-      (void)memcpy(cm33_msg_data.data, send_msg.data, IPC_DATA_MAX_LEN);
-
-      (void)Cy_IPC_Pipe_SendMessage(CM55_IPC_PIPE_EP_ADDR, CM33_IPC_PIPE_EP_ADDR, (void *)&cm33_msg_data, 0U);
+      taskENTER_CRITICAL();
+      ipc_liveness_monitor_configure(&s_peer_live, &s_live_config);
+      s_live_config_pending = false;
+      taskEXIT_CRITICAL();
     }
+    (void)ipc_liveness_check(&s_peer_live, ipc_now_ms(), !ipc_ring_is_empty(&cm33_tx_ring));
 
-    has_recv_msg = false;
-    intr_state = Cy_SysLib_EnterCriticalSection();
-    if (s_ipc_recv_count > 0U)
+    received = 0U;
+    while ((received < IPC_RECV_RING_LEN) && ipc_recv_pop(&recv_msg, &rx_us))
     {
-      recv_msg = s_ipc_recv_ring[s_ipc_recv_tail];
-      s_ipc_recv_tail++;
-      if (s_ipc_recv_tail >= IPC_RECV_RING_LEN)
-      {
-        s_ipc_recv_tail = 0U;
-      }
-      s_ipc_recv_count--;
-      has_recv_msg = true;
+      received++;
+      ipc_return_credit(1U);
+      ipc_stats_on_dispatch(recv_msg.cmd, rx_us);
+      ipc_process_incoming(&recv_msg, rx_us);
     }
-    Cy_SysLib_ExitCriticalSection(intr_state);
+    ipc_return_credit(ipc_recv_take_owed_credits());
+    scan_ticks = cm33_scan_flush_pending();
 
-    if (has_recv_msg)
+    if ((0U < ipc_tx_pump(&ring_full)) || s_doorbell_pending)
     {
-      ipc_process_incoming(&recv_msg);
+      ipc_tx_doorbell();
     }
 
-    udp_server_app_process();
+    udp_more = udp_server_app_process();
 
-    if ((xTaskGetTickCount() - last_heartbeat) >= pdMS_TO_TICKS(500U))
+    busy = true;
+    if (udp_more || (0U < s_ipc_recv_count))
     {
-      ipc_counter++;
-      last_heartbeat = xTaskGetTickCount();
-
-      cm33_msg_data.client_id = CM55_IPC_PIPE_CLIENT_ID;
-      cm33_msg_data.intr_mask = CY_IPC_CYPIPE_INTR_MASK_EP1;
-      cm33_msg_data.cmd = RESET_VAL;
-      cm33_msg_data.value = (uint32_t)ipc_counter;
-      (void)memset(cm33_msg_data.data, 0, IPC_DATA_MAX_LEN);
-
-      if (CY_IPC_PIPE_SUCCESS ==
-          Cy_IPC_Pipe_SendMessage(CM55_IPC_PIPE_EP_ADDR, CM33_IPC_PIPE_EP_ADDR, (void *)&cm33_msg_data, 0U))
-      {
-        Cy_GPIO_Inv(CYBSP_USER_LED_PORT, CYBSP_USER_LED_PIN);
-      }
+      wait_ticks = 0U;
+    }
+    else if (s_doorbell_pending || ring_full || (IPC_RETRY_TICKS >= scan_ticks))
+    {
+      wait_ticks = IPC_RETRY_TICKS;
+    }
+    else
+    {
+      wait_ticks = scan_ticks; /* portMAX_DELAY unless a scan buffer is due for reclaim */
+      busy = false;
+    }
+    check_ticks = pdMS_TO_TICKS(ipc_liveness_next_check_ms(&s_peer_live, ipc_now_ms()));
+    if ((0U < check_ticks) && (check_ticks < wait_ticks))
+    {
+      wait_ticks = check_ticks;
     }
+    ipc_liveness_beat(&cm33_liveness, busy ? IPC_LIVENESS_BUSY : IPC_LIVENESS_IDLE);
   }
 }
 
@@ -261,11 +877,42 @@ bool cm33_ipc_pipe_start(void)
   cm33_ipc_communication_setup();
   Cy_SysLib_Delay(CM33_APP_DELAY_MS);
 
-  s_ipc_send_queue = xQueueCreate(IPC_SEND_QUEUE_LEN, sizeof(ipc_msg_t));
-  if (NULL == s_ipc_send_queue)
+  ipc_lane_timebase_init();
+  for (uint32_t i = 0U; i < IPC_LANE_COUNT; i++)
+  {
+    s_lanes[i].buf = xMessageBufferCreate(s_lane_config[i].bytes);
+    s_lanes[i].lock = xSemaphoreCreateMutex();
+    if ((NULL == s_lanes[i].buf) || (NULL == s_lanes[i].lock))
+    {
+      return false;
+    }
+  }
+  s_bench_done = xSemaphoreCreateBinary();
+  s_bench_lock = xSemaphoreCreateMutex();
+  s_scan_buf_free = xSemaphoreCreateBinary();
+  s_scan_pending_lock = xSemaphoreCreateMutex();
+  if ((NULL == s_bench_done) || (NULL == s_bench_lock) || (NULL == s_scan_buf_free) || (NULL == s_scan_pending_lock))
+  {
+    return false;
+  }
+  (void)xSemaphoreGive(s_scan_buf_free);
+#if (0 != IPC_EVENT_BRIDGE_ENABLE)
+  if (!ipc_event_bridge_init(&cm33_bridge_buffers, cm33_bridge_send, cm33_bridge_deliver))
   {
     return false;
   }
+#endif
+
+  ipc_ring_init(&cm33_tx_ring);
+  ipc_blackboard_init(&cm33_blackboard);
+  ipc_liveness_init(&cm33_liveness);
+  ipc_liveness_monitor_init(&s_peer_live, &(ipc_liveness_config_t){ 0U, 0U, ipc_peer_liveness_cb, NULL });
+  (void)memset(&s_button_state, 0, sizeof(s_button_state));
+  cm33_doorbell.client_id = CM55_IPC_PIPE_CLIENT_ID;
+  cm33_doorbell.intr_mask = CY_IPC_CYPIPE_INTR_MASK_EP1;
+  cm33_doorbell.ring = &cm33_tx_ring;
+  cm33_doorbell.board = &cm33_blackboard;
+  cm33_doorbell.live = &cm33_liveness;
 
   pipe_status = Cy_IPC_Pipe_RegisterCallback(CM33_IPC_PIPE_EP_ADDR, &cm33_msg_callback, (uint32_t)CM33_IPC_PIPE_CLIENT_ID);
   if (CY_IPC_PIPE_SUCCESS != pipe_status)
@@ -276,6 +923,7 @@ bool cm33_ipc_pipe_start(void)
   (void)user_button_on_changed(BUTTON_ID_0, ipc_button_event_handler);
   (void)user_button_on_changed(BUTTON_ID_1, ipc_button_event_handler);
   (void)wifi_manager_set_event_callback(cm33_wifi_manager_event_callback, NULL);
+  udp_server_app_set_rx_notify(ipc_udp_rx_notify);
 
   if (pdPASS != xTaskCreate(ipc_task, "IPC Task", IPC_TASK_STACK, NULL, IPC_TASK_PRIO, &ipc_task_handle))
   {
@@ -285,21 +933,79 @@ bool cm33_ipc_pipe_start(void)
   return true;
 }
 
-bool cm33_ipc_send_gyro_data(const gyro_data_t *data, uint32_t sequence)
+bool cm33_ipc_bridge_attach(event_bus_t bus)
+{
+#if (0 != IPC_EVENT_BRIDGE_ENABLE)
+  if (NULL == bus)
+  {
+    return false;
+  }
+  s_bridge_bus = bus;
+  return event_bus_set_bridge(bus, &s_bus_bridge);
+#else
+  (void)bus;
+  return false;
+#endif
+}
+
+bool cm33_ipc_get_bridge_stats(ipc_event_bridge_stats_t *stats)
+{
+#if (0 != IPC_EVENT_BRIDGE_ENABLE)
+  return ipc_event_bridge_get_stats(stats);
+#else
+  (void)stats;
+  return false;
+#endif
+}
+
+bool cm33_ipc_publish(ipc_blackboard_slot_t slot, const void *value, uint32_t len)
+{
+  return ipc_blackboard_publish(&cm33_blackboard, slot, value, len);
+}
+
+bool cm33_ipc_publish_gyro_data(const gyro_data_t *data, uint32_t sequence)
 {
+  ipc_imu_sample_t sample;
+
   if (NULL == data)
   {
     return false;
   }
+  sample.data = *data;
+  sample.sequence = sequence;
+  return ipc_blackboard_publish(&cm33_blackboard, IPC_BLACKBOARD_IMU, &sample, sizeof(sample));
+}
+
+bool cm33_ipc_send_gyro_data(const gyro_data_t *data, uint32_t sequence)
+{
+  if (!cm33_ipc_publish_gyro_data(data, sequence))
+  {
+    return false;
+  }
   return internal_send_message(IPC_CMD_GYRO, sequence, data, sizeof(gyro_data_t));
 }
 
 bool cm33_ipc_send_button_event(const button_event_t *event)
 {
-  if (NULL == event)
+  if ((NULL == event) || (event->button_id >= (uint32_t)BUTTON_ID_MAX))
   {
     return false;
   }
+
+  /* Handlers of different buttons may run concurrently; the bitmap is updated and published as one */
+  taskENTER_CRITICAL();
+  if (event->is_pressed)
+  {
+    s_button_state.pressed |= (1UL << event->button_id);
+  }
+  else
+  {
+    s_button_state.pressed &= ~(1UL << event->button_id);
+  }
+  s_button_state.press_count[event->button_id] = event->press_count;
+  (void)ipc_blackboard_publish(&cm33_blackboard, IPC_BLACKBOARD_BUTTONS, &s_button_state, sizeof(s_button_state));
+  taskEXIT_CRITICAL();
+
   return internal_send_message(IPC_CMD_BUTTON_EVENT, 0U, event, sizeof(button_event_t));
 }
 
@@ -309,7 +1015,7 @@ bool cm33_ipc_send_touch(int16_t x, int16_t y, uint8_t pressed)
   evt.x = x;
   evt.y = y;
   evt.pressed = pressed;
-  return internal_send_message_ticks(IPC_CMD_TOUCH, 0U, &evt, sizeof(ipc_touch_event_t), pdMS_TO_TICKS(2U));
+  return internal_send_message(IPC_CMD_TOUCH, 0U, &evt, sizeof(ipc_touch_event_t));
 }
 
 bool cm33_ipc_send_wifi_scan_results(const wifi_info_t *results, uint32_t count)
@@ -318,36 +1024,48 @@ bool cm33_ipc_send_wifi_scan_results(const wifi_info_t *results, uint32_t count)
   {
     return false;
   }
-
-  for (uint32_t i = 0U; i < count; i++)
+  if (count > IPC_WIFI_SCAN_BULK_MAX)
   {
-    uint32_t value = (count << IPC_WIFI_SCAN_VALUE_COUNT_SHIFT) | (i & IPC_WIFI_SCAN_VALUE_INDEX_MASK);
-    if (false == internal_send_message(IPC_EVT_WIFI_SCAN_RESULT, value, &results[i], sizeof(wifi_info_t)))
-    {
-      return false;
-    }
-    vTaskDelay(pdMS_TO_TICKS(2U));
+    count = IPC_WIFI_SCAN_BULK_MAX;
   }
 
+  /* CM55 may still be copying the previous list: never overwrite it, keep these for ipc_task */
+  if (!cm33_scan_buf_acquire(pdMS_TO_TICKS(IPC_SCAN_ACK_TIMEOUT_MS)))
+  {
+    cm33_scan_defer(results, count);
+    return false;
+  }
+  (void)memcpy(cm33_scan_buf, results, count * sizeof(wifi_info_t));
+  if (pdPASS == xSemaphoreTake(s_scan_pending_lock, portMAX_DELAY))
+  {
+    s_scan_pending_count = 0U; /* Older than these */
+    (void)xSemaphoreGive(s_scan_pending_lock);
+  }
+  if (!cm33_scan_buf_publish(count, 0U, pdMS_TO_TICKS(IPC_SCAN_SEND_TIMEOUT_MS)))
+  {
+    cm33_scan_defer(results, count);
+    return false;
+  }
   return true;
 }
 
-bool cm33_ipc_send_wifi_scan_complete(const ipc_wifi_scan_complete_t *scan_complete)
+bool cm33_ipc_send_wifi_scan_complete(const ipc_wifi_scan_complete_t *scan_complete, uint32_t call_id)
 {
   if (NULL == scan_complete)
   {
     return false;
   }
-  return internal_send_message(IPC_EVT_WIFI_SCAN_COMPLETE, 0U, scan_complete, sizeof(ipc_wifi_scan_complete_t));
+  return internal_send_message(IPC_EVT_WIFI_SCAN_COMPLETE, call_id, scan_complete, sizeof(ipc_wifi_scan_complete_t));
 }
 
-bool cm33_ipc_send_wifi_status(const ipc_wifi_status_t *status)
+bool cm33_ipc_send_wifi_status(const ipc_wifi_status_t *status, uint32_t call_id)
 {
   if (NULL == status)
   {
     return false;
   }
-  return internal_send_message(IPC_EVT_WIFI_STATUS, 0U, status, sizeof(ipc_wifi_status_t));
+  (void)ipc_blackboard_publish(&cm33_blackboard, IPC_BLACKBOARD_WIFI_STATUS, status, sizeof(ipc_wifi_status_t));
+  return internal_send_message(IPC_EVT_WIFI_STATUS, call_id, status, sizeof(ipc_wifi_status_t));
 }
 
 bool cm33_ipc_send_ping(void)
@@ -381,16 +1099,351 @@ uint32_t cm33_ipc_get_recv_total(void)
   return s_ipc_recv_total;
 }
 
+bool cm33_ipc_set_recv_policy(ipc_lane_t lane, cm33_ipc_recv_policy_t policy, uint32_t limit)
+{
+  uint32_t intr_state;
+
+  if (((uint32_t)lane >= (uint32_t)IPC_LANE_COUNT) || ((uint32_t)policy > (uint32_t)CM33_IPC_RECV_DROP_OLDEST) ||
+      (0U == limit) || (limit > IPC_RECV_RING_LEN))
+  {
+    return false;
+  }
+  if ((IPC_LANE_CONTROL == lane) && (CM33_IPC_RECV_BLOCK != policy))
+  {
+    return false; /* Control commands are never dropped */
+  }
+
+  intr_state = Cy_SysLib_EnterCriticalSection();
+  s_recv[lane].stats.policy = policy;
+  s_recv[lane].stats.limit = limit;
+  while (s_recv[lane].stats.queued > limit)
+  {
+    /* Shrinking under a drop policy trims the oldest; BLOCK lets the surplus drain */
+    if (CM33_IPC_RECV_BLOCK == policy)
+    {
+      break;
+    }
+    cm33_recv_drop(&s_recv[lane], s_recv[lane].msg[s_recv[lane].tail].cmd);
+    s_recv[lane].tail = (s_recv[lane].tail + 1U) % IPC_RECV_RING_LEN;
+    s_recv[lane].stats.queued--;
+    s_ipc_recv_count--;
+  }
+  cm33_drain_peer_ring(); /* A larger limit may admit frames left in the CM55 ring */
+  Cy_SysLib_ExitCriticalSection(intr_state);
+
+  if (NULL != ipc_task_handle)
+  {
+    (void)xTaskNotifyGive(ipc_task_handle); /* Return the credits of anything trimmed */
+  }
+  return true;
+}
+
+bool cm33_ipc_get_recv_stats(ipc_lane_t lane, cm33_ipc_recv_stats_t *stats)
+{
+  uint32_t intr_state;
+
+  if (((uint32_t)lane >= (uint32_t)IPC_LANE_COUNT) || (NULL == stats))
+  {
+    return false;
+  }
+  intr_state = Cy_SysLib_EnterCriticalSection();
+  *stats = s_recv[lane].stats;
+  Cy_SysLib_ExitCriticalSection(intr_state);
+  return true;
+}
+
+void cm33_ipc_reset_recv_stats(void)
+{
+  uint32_t intr_state = Cy_SysLib_EnterCriticalSection();
+
+  for (uint32_t i = 0U; i < IPC_LANE_COUNT; i++)
+  {
+    s_recv[i].stats.peak = s_recv[i].stats.queued;
+    s_recv[i].stats.dropped = 0U;
+  }
+  if (NULL != s_peer_ring)
+  {
+    ipc_ring_reset_backlog_peak(s_peer_ring);
+  }
+  Cy_SysLib_ExitCriticalSection(intr_state);
+}
+
 uint32_t cm33_ipc_get_send_queue_used(void)
 {
-  if (NULL == s_ipc_send_queue)
+  uint32_t used = 0U;
+
+  for (uint32_t i = 0U; i < IPC_LANE_COUNT; i++)
   {
-    return 0U;
+    if (NULL != s_lanes[i].buf)
+    {
+      used += s_lane_config[i].bytes - (uint32_t)xMessageBufferSpacesAvailable(s_lanes[i].buf);
+    }
   }
-  return (uint32_t)uxQueueMessagesWaiting(s_ipc_send_queue);
+  return used;
 }
 
 uint32_t cm33_ipc_get_send_queue_capacity(void)
 {
-  return IPC_SEND_QUEUE_LEN;
+  return IPC_CONTROL_LANE_BYTES + IPC_BULK_LANE_BYTES;
+}
+
+bool cm33_ipc_get_lane_stats(ipc_lane_t lane, ipc_lane_stats_t *stats)
+{
+  if ((IPC_LANE_COUNT <= lane) || (NULL == stats))
+  {
+    return false;
+  }
+  (void)memcpy(stats, &s_lanes[lane].stats, sizeof(*stats));
+  return true;
+}
+
+void cm33_ipc_reset_lane_stats(void)
+{
+  for (uint32_t i = 0U; i < IPC_LANE_COUNT; i++)
+  {
+    (void)memset(&s_lanes[i].stats, 0, sizeof(s_lanes[i].stats));
+  }
+}
+
+bool cm33_ipc_get_cmd_stats(uint32_t cmd, ipc_stats_cmd_t *stats)
+{
+  return ipc_stats_get(cmd, stats);
+}
+
+void cm33_ipc_reset_cmd_stats(void)
+{
+  ipc_stats_reset();
+}
+
+void cm33_ipc_set_liveness_config(const ipc_liveness_config_t *config)
+{
+  ipc_liveness_config_t applied = { 0U, 0U, ipc_peer_liveness_cb, NULL };
+
+  if (NULL != config)
+  {
+    applied = *config;
+  }
+  taskENTER_CRITICAL();
+  s_live_config = applied;
+  s_live_config_pending = true;
+  taskEXIT_CRITICAL();
+  if (NULL != ipc_task_handle)
+  {
+    (void)xTaskNotifyGive(ipc_task_handle);
+  }
+}
+
+bool cm33_ipc_get_liveness(ipc_liveness_status_t *peer, uint32_t *counter, ipc_liveness_state_t *state)
+{
+  if (NULL != counter)
+  {
+    *counter = cm33_liveness.counter;
+  }
+  if (NULL != state)
+  {
+    *state = (ipc_liveness_state_t)cm33_liveness.state;
+  }
+  if (NULL == peer)
+  {
+    return true;
+  }
+  (void)ipc_liveness_get_status(&s_peer_live, peer); /* Written by ipc_task; a snapshot, not atomic */
+  return peer->attached;
+}
+
+void cm33_ipc_set_fault(void)
+{
+  ipc_liveness_fault(&cm33_liveness);
+}
+
+bool cm33_ipc_run_benchmark(uint32_t count, uint32_t payload_len, cm33_ipc_bench_result_t *result)
+{
+  uint8_t payload[IPC_DATA_MAX_LEN];
+  TickType_t start;
+  uint32_t elapsed_ms;
+  bool ok = true;
+
+  if ((NULL == result) || (0U == count) || (IPC_BENCH_VALUE_END <= count) || (IPC_DATA_MAX_LEN < payload_len) ||
+      (NULL == s_bench_lock))
+  {
+    return false;
+  }
+  if (pdPASS != xSemaphoreTake(s_bench_lock, 0U))
+  {
+    return false;
+  }
+
+  (void)memset(result, 0, sizeof(*result));
+  (void)memset(payload, 0xA5, sizeof(payload));
+  (void)xSemaphoreTake(s_bench_done, 0U);
+  start = xTaskGetTickCount();
+
+  for (uint32_t i = 0U; (i < count) && ok; i++)
+  {
+    ok = internal_send_message_ticks(IPC_CMD_BENCH, i, payload, payload_len,
+                                     pdMS_TO_TICKS(IPC_BENCH_ENQUEUE_TIMEOUT_MS));
+  }
+  if (ok)
+  {
+    ok = internal_send_message_ticks(IPC_CMD_BENCH, IPC_BENCH_VALUE_END | count, NULL, 0U,
+                                     pdMS_TO_TICKS(IPC_BENCH_ENQUEUE_TIMEOUT_MS));
+  }
+  if (ok)
+  {
+    ok = (pdPASS == xSemaphoreTake(s_bench_done, pdMS_TO_TICKS(IPC_BENCH_REPORT_TIMEOUT_MS)));
+  }
+
+  if (ok)
+  {
+    elapsed_ms = (uint32_t)((xTaskGetTickCount() - start) * portTICK_PERIOD_MS);
+    if (0U == elapsed_ms)
+    {
+      elapsed_ms = 1U;
+    }
+    result->frames = s_bench_report.frames;
+    result->bytes = s_bench_report.bytes;
+    result->lost = s_bench_report.lost;
+    result->elapsed_ms = elapsed_ms;
+    result->msgs_per_sec = (uint32_t)(((uint64_t)s_bench_report.frames * 1000U) / elapsed_ms);
+    result->bytes_per_sec = (uint32_t)(((uint64_t)s_bench_report.bytes * 1000U) / elapsed_ms);
+  }
+
+  (void)xSemaphoreGive(s_bench_lock);
+  return ok;
+}
+
+bool cm33_ipc_run_scan_benchmark(uint32_t ap_count, uint32_t reps, cm33_ipc_scan_bench_result_t *result)
+{
+  TickType_t start;
+  uint32_t crc_errors_start;
+  uint32_t elapsed_ms;
+  uint32_t done = 0U;
+  bool ok = true;
+
+  if (NULL == result)
+  {
+    return false;
+  }
+  (void)memset(result, 0, sizeof(*result));
+  if ((0U == ap_count) || (IPC_WIFI_SCAN_BULK_MAX < ap_count) || (0U == reps) || (NULL == s_bench_lock))
+  {
+    return false;
+  }
+  if (pdPASS != xSemaphoreTake(s_bench_lock, 0U))
+  {
+    return false;
+  }
+
+  crc_errors_start = s_scan_crc_errors;
+  start = xTaskGetTickCount();
+
+  for (uint32_t r = 0U; (r < reps) && ok; r++)
+  {
+    ok = cm33_scan_buf_acquire(pdMS_TO_TICKS(IPC_SCAN_ACK_TIMEOUT_MS));
+    if (ok)
+    {
+      for (uint32_t i = 0U; i < ap_count; i++)
+      {
+        wifi_info_t *info = &cm33_scan_buf[i];
+        (void)memset(info, 0, sizeof(*info));
+        (void)snprintf(info->ssid, sizeof(info->ssid), "bench-%02lu", (unsigned long)i);
+        (void)snprintf(info->security, sizeof(info->security), "WPA2_AES_PSK");
+        info->rssi = -40 - (int32_t)i;
+        info->channel = (uint8_t)(1U + (i % 11U));
+        info->mac[5] = (uint8_t)i;
+        info->mac[4] = (uint8_t)r;
+      }
+      ok = cm33_scan_buf_publish(ap_count, IPC_WIFI_SCAN_BULK_VALUE_BENCH, pdMS_TO_TICKS(IPC_SCAN_SEND_TIMEOUT_MS));
+    }
+    if (ok)
+    {
+      done++;
+    }
+  }
+  /* Wait for the last ack so its round trip is included, then hand the buffer back. */
+  if (ok && cm33_scan_buf_acquire(pdMS_TO_TICKS(IPC_SCAN_ACK_TIMEOUT_MS)))
+  {
+    (void)xSemaphoreGive(s_scan_buf_free);
+  }
+  else
+  {
+    ok = false;
+  }
+
+  elapsed_ms = (uint32_t)((xTaskGetTickCount() - start) * portTICK_PERIOD_MS);
+  result->transfers = done;
+  result->crc_errors = s_scan_crc_errors - crc_errors_start;
+  result->bytes_per_transfer = ap_count * (uint32_t)sizeof(wifi_info_t);
+  result->elapsed_ms = elapsed_ms;
+  if (0U < done)
+  {
+    result->avg_latency_us = (uint32_t)(((uint64_t)elapsed_ms * 1000U) / done);
+  }
+
+  (void)xSemaphoreGive(s_bench_lock);
+  return ok;
+}
+
+bool cm33_ipc_run_lane_benchmark(uint32_t bulk_frames, cm33_ipc_lane_bench_result_t *result)
+{
+  uint8_t payload[IPC_LANE_BENCH_PAYLOAD];
+  ipc_lane_stats_t stats;
+  bool ok = true;
+
+  if (NULL == result)
+  {
+    return false;
+  }
+  (void)memset(result, 0, sizeof(*result));
+  if ((0U == bulk_frames) || (IPC_BENCH_VALUE_END <= bulk_frames) || (NULL == s_bench_lock))
+  {
+    return false;
+  }
+  if (pdPASS != xSemaphoreTake(s_bench_lock, 0U))
+  {
+    return false;
+  }
+
+  (void)memset(payload, 0x5A, sizeof(payload));
+  (void)xSemaphoreTake(s_bench_done, 0U);
+  cm33_ipc_reset_lane_stats();
+
+  /* Keep the bulk lane saturated with full frames and slip a control frame in every few of them. */
+  for (uint32_t i = 0U; (i < bulk_frames) && ok; i++)
+  {
+    ok = internal_send_message_ticks(IPC_CMD_BENCH, i, payload, sizeof(payload),
+                                     pdMS_TO_TICKS(IPC_BENCH_ENQUEUE_TIMEOUT_MS));
+    if (ok && (0U == (i % IPC_LANE_BENCH_CONTROL_EVERY)))
+    {
+      (void)internal_send_message(IPC_CMD_PING, i, NULL, 0U);
+    }
+  }
+  if (ok)
+  {
+    ok = internal_send_message_ticks(IPC_CMD_BENCH, IPC_BENCH_VALUE_END | bulk_frames, NULL, 0U,
+                                     pdMS_TO_TICKS(IPC_BENCH_ENQUEUE_TIMEOUT_MS));
+  }
+  if (ok)
+  {
+    ok = (pdPASS == xSemaphoreTake(s_bench_done, pdMS_TO_TICKS(IPC_BENCH_REPORT_TIMEOUT_MS)));
+  }
+
+  (void)cm33_ipc_get_lane_stats(IPC_LANE_CONTROL, &stats);
+  result->control_frames = stats.delay.count;
+  result->control_dropped = stats.dropped;
+  result->control_p50_us = ipc_stats_hist_percentile(&stats.delay, 50U);
+  result->control_p99_us = ipc_stats_hist_percentile(&stats.delay, 99U);
+  result->control_max_us = stats.delay.max_us;
+  (void)cm33_ipc_get_lane_stats(IPC_LANE_BULK, &stats);
+  result->bulk_frames = stats.delay.count;
+  result->bulk_p50_us = ipc_stats_hist_percentile(&stats.delay, 50U);
+  result->bulk_p99_us = ipc_stats_hist_percentile(&stats.delay, 99U);
+  result->bulk_max_us = stats.delay.max_us;
+  if (ok)
+  {
+    result->bulk_lost = s_bench_report.lost;
+  }
+
+  (void)xSemaphoreGive(s_bench_lock);
+  return ok;
 }
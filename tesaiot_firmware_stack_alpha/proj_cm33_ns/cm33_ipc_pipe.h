@@ -1,26 +1,143 @@
 #ifndef CM33_IPC_PIPE_H
 #define CM33_IPC_PIPE_H
 
+#include "event_bus.h"
+#include "ipc_blackboard.h"
 #include "ipc_communication.h"
+#include "ipc_event_bridge.h"
+#include "ipc_lane.h"
+#include "ipc_liveness.h"
+#include "ipc_stats.h"
 #include "user_buttons.h"
 #include <stdbool.h>
 #include <stdint.h>
 
+typedef struct
+{
+  uint32_t frames;        /* Benchmark frames CM55 received */
+  uint32_t bytes;         /* Payload bytes CM55 received */
+  uint32_t lost;          /* Frames CM55 never saw */
+  uint32_t elapsed_ms;    /* First enqueue to report received */
+  uint32_t msgs_per_sec;  /* frames / elapsed */
+  uint32_t bytes_per_sec; /* bytes / elapsed */
+} cm33_ipc_bench_result_t;
+
+typedef struct
+{
+  uint32_t transfers;          /* Bulk scan transfers CM55 acknowledged */
+  uint32_t crc_errors;         /* Acks reporting a CRC mismatch */
+  uint32_t bytes_per_transfer; /* ap_count * sizeof(wifi_info_t) */
+  uint32_t elapsed_ms;         /* First transfer staged to last ack received */
+  uint32_t avg_latency_us;     /* elapsed / transfers: list staged on CM33 to list ready in the CM55 app */
+} cm33_ipc_scan_bench_result_t;
+
+typedef struct
+{
+  uint32_t control_frames;  /* Control frames moved to the ring during the run */
+  uint32_t control_dropped; /* Control frames refused (lane full) */
+  uint32_t control_p50_us;  /* Control lane enqueue-to-ring delay */
+  uint32_t control_p99_us;
+  uint32_t control_max_us;
+  uint32_t bulk_frames; /* Bulk frames moved to the ring (end marker included) */
+  uint32_t bulk_lost;   /* Bulk frames CM55 never saw */
+  uint32_t bulk_p50_us; /* Bulk lane enqueue-to-ring delay */
+  uint32_t bulk_p99_us;
+  uint32_t bulk_max_us;
+} cm33_ipc_lane_bench_result_t;
+
+/* What CM33 does with a CM55 frame whose command class already has limit frames waiting. */
+typedef enum
+{
+  CM33_IPC_RECV_BLOCK = 0U,       /* Leave it in the CM55 ring; CM55 runs out of credits, nothing is lost */
+  CM33_IPC_RECV_DROP_NEWEST = 1U, /* Discard the arriving frame */
+  CM33_IPC_RECV_DROP_OLDEST = 2U  /* Discard the oldest waiting frame of the class */
+} cm33_ipc_recv_policy_t;
+
+typedef struct
+{
+  cm33_ipc_recv_policy_t policy;
+  uint32_t limit;   /* Frames of the class held for ipc_task before the policy applies */
+  uint32_t queued;  /* Frames waiting now */
+  uint32_t peak;    /* High-water mark of queued */
+  uint32_t dropped; /* Frames discarded by the policy */
+} cm33_ipc_recv_stats_t;
+
 bool cm33_ipc_pipe_start(void);
 
+/* Latest-value state on the shared-memory blackboard (see ipc_blackboard.h). CM55 reads it without an
+ * interrupt or an IPC frame. len must be the slot's value size. Any task; returns false on a bad
+ * slot or len. */
+bool cm33_ipc_publish(ipc_blackboard_slot_t slot, const void *value, uint32_t len);
+bool cm33_ipc_publish_gyro_data(const gyro_data_t *data, uint32_t sequence);
+
+/* Event senders. Those with a blackboard slot (gyro, button, Wi-Fi status) publish it first, so a
+ * CM55 reader sees the new value no later than the event. */
 bool cm33_ipc_send_gyro_data(const gyro_data_t *data, uint32_t sequence);
 bool cm33_ipc_send_button_event(const button_event_t *event);
 bool cm33_ipc_send_touch(int16_t x, int16_t y, uint8_t pressed);
 bool cm33_ipc_send_wifi_scan_results(const wifi_info_t *results, uint32_t count);
-bool cm33_ipc_send_wifi_scan_complete(const ipc_wifi_scan_complete_t *scan_complete);
-bool cm33_ipc_send_wifi_status(const ipc_wifi_status_t *status);
+/* call_id: CM55 call this event answers (see IPC_CALL_ID_NONE in ipc_communication.h), else IPC_CALL_ID_NONE. */
+bool cm33_ipc_send_wifi_scan_complete(const ipc_wifi_scan_complete_t *scan_complete, uint32_t call_id);
+bool cm33_ipc_send_wifi_status(const ipc_wifi_status_t *status, uint32_t call_id);
 
 bool cm33_ipc_send_ping(void);
 bool cm33_ipc_send_cli_message(const char *text);
 
 uint32_t cm33_ipc_get_recv_pending(void);
 uint32_t cm33_ipc_get_recv_total(void);
+
+/* Receive overflow policy per command class (lane of the command, see ipc_cmd.h). Control accepts
+ * CM33_IPC_RECV_BLOCK only, so control commands are never dropped; limit is 1..IPC_RING_CREDITS.
+ * Defaults: both BLOCK, bulk limited to the credits CM55 may spend on bulk. Drops are also counted
+ * per command in the overflows column of the command statistics. */
+bool cm33_ipc_set_recv_policy(ipc_lane_t lane, cm33_ipc_recv_policy_t policy, uint32_t limit);
+bool cm33_ipc_get_recv_stats(ipc_lane_t lane, cm33_ipc_recv_stats_t *stats);
+/* Clears dropped counts and restarts the high-water marks, the one CM55 reads included. */
+void cm33_ipc_reset_recv_stats(void);
+/* Send buffer occupancy in bytes (frames are variable-length). */
 uint32_t cm33_ipc_get_send_queue_used(void);
 uint32_t cm33_ipc_get_send_queue_capacity(void);
 
+/* Per-lane counters and enqueue-to-ring latency histogram (see ipc_lane.h). */
+bool cm33_ipc_get_lane_stats(ipc_lane_t lane, ipc_lane_stats_t *stats);
+void cm33_ipc_reset_lane_stats(void);
+
+/* Per-command counters and enqueue/transit/dispatch latency histograms on CM33 (see ipc_stats.h).
+ * Transit is measured on the timebase shared with CM55. */
+bool cm33_ipc_get_cmd_stats(uint32_t cmd, ipc_stats_cmd_t *stats);
+void cm33_ipc_reset_cmd_stats(void);
+
+/* Connects bus to the cross-core event bridge (see ipc_event_bridge.h): event IDs marked with
+ * event_bus_set_remote() travel to CM55 while it subscribes to them, and events from CM55 are
+ * published on bus by ipc_task, so their callbacks must not block; subscribe slow handlers with
+ * event_bus_subscribe_async(). Call after cm33_ipc_pipe_start(). Returns false if the image is
+ * built without IPC_EVENT_BRIDGE_ENABLE. */
+bool cm33_ipc_bridge_attach(event_bus_t bus);
+/* Event bridge counters of CM33; false without IPC_EVENT_BRIDGE_ENABLE. */
+bool cm33_ipc_get_bridge_stats(ipc_event_bridge_stats_t *stats);
+
+/* Liveness (see ipc_liveness.h). ipc_task beats the CM33 record on every pass and checks the CM55
+ * record lazily, when it runs anyway; CM55 owes a beat while busy or while frames CM33 published on
+ * an earlier pass are still in the ring. config NULL restores the defaults, whose callback prints
+ * late, stalled, recovered and fault events on the debug UART. The callback runs in ipc_task. */
+void cm33_ipc_set_liveness_config(const ipc_liveness_config_t *config);
+/* CM55 status at the last check (peer may be NULL) and the CM33 record (counter, state may be NULL).
+ * Returns false until CM55 has rung with its record. */
+bool cm33_ipc_get_liveness(ipc_liveness_status_t *peer, uint32_t *counter, ipc_liveness_state_t *state);
+/* Marks the CM33 record IPC_LIVENESS_FAULT for good; called by the fatal error handler. */
+void cm33_ipc_set_fault(void);
+
+/* Floods CM55 with count IPC_CMD_BENCH frames of payload_len bytes (0..IPC_DATA_MAX_LEN) and waits
+ * for its report. Blocks the caller. */
+bool cm33_ipc_run_benchmark(uint32_t count, uint32_t payload_len, cm33_ipc_bench_result_t *result);
+
+/* Sends reps synthetic scan lists of ap_count entries (1..IPC_WIFI_SCAN_BULK_MAX) through the bulk
+ * scan path, one at a time, each waiting for CM55 to verify and acknowledge it. Blocks the caller. */
+bool cm33_ipc_run_scan_benchmark(uint32_t ap_count, uint32_t reps, cm33_ipc_scan_bench_result_t *result);
+
+/* Floods the bulk lane with bulk_frames full-size IPC_CMD_BENCH frames, sending a control frame
+ * (IPC_CMD_PING) every 16 of them, and reports the queueing delay of both lanes. Resets the lane
+ * statistics. Blocks the caller. */
+bool cm33_ipc_run_lane_benchmark(uint32_t bulk_frames, cm33_ipc_lane_bench_result_t *result);
+
 #endif /* CM33_IPC_PIPE_H */
@@ -33,7 +33,8 @@ void gyro_task(void *arg) {
     gyro_data.ay = gyro_generate_random_value();
     gyro_data.az = gyro_generate_random_value();
 
-    if (cm33_ipc_send_gyro_data(&gyro_data, sequence)) {
+    /* Latest sample only: CM55 reads it from the blackboard, no IPC frame per sample */
+    if (cm33_ipc_publish_gyro_data(&gyro_data, sequence)) {
       sequence++;
     }
 
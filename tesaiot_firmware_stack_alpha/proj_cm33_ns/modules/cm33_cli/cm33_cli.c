@@ -15,6 +15,7 @@
 #include "cm33_cli.h"
 #include "cm33_ipc_pipe.h"
 #include "date_time.h"
+#include "ipc_cmd.h"
 #include "ipc_communication.h"
 #include "retarget_io_init.h"
 #include "udp_server_app.h"
@@ -110,7 +111,7 @@ static const cm33_cli_cmd_t s_cmds[] =
   { "touch",   "touch status|stream|ipc status",           cm33_cli_cmd_touch },
   { "wifi",    "wifi scan|connect|disconnect|status|list|info", cm33_cli_cmd_wifi },
   { "udp",     "udp start|stop|send <msg>|status",       cm33_cli_cmd_udp },
-  { "ipc",     "ipc ping|send|status|recv",              cm33_cli_cmd_ipc },
+  { "ipc",     "ipc ping|send|status|recv|lanes|stats|bench [n] [size]", cm33_cli_cmd_ipc },
   { "reset",   "Software reset (like reset button)",     cm33_cli_cmd_reset },
   { "reboot",  "Reboot (same as reset)",                 cm33_cli_cmd_reboot },
 };
@@ -199,18 +200,237 @@ static void cm33_cli_cmd_reset(int argc, char *argv[])
   NVIC_SystemReset();
 }
 
+/* "ipc recv" names of cm33_ipc_recv_policy_t, in enum order. */
+static const char *const s_recv_policy_names[] = { "block", "newest", "oldest" };
+#define CM33_CLI_RECV_POLICY_COUNT ((uint32_t)(sizeof(s_recv_policy_names) / sizeof(s_recv_policy_names[0])))
+
+/* One "ipc stats" row; commands that neither sent nor received anything are skipped. */
+static void cm33_cli_print_ipc_cmd_stats(uint32_t cmd, const char *name)
+{
+  ipc_stats_cmd_t stats;
+
+  if (!cm33_ipc_get_cmd_stats(cmd, &stats) ||
+      ((0U == stats.sent) && (0U == stats.dropped) && (0U == stats.received) && (0U == stats.overflows)))
+  {
+    return;
+  }
+  printf("  %-18s sent %lu drop %lu recv %lu (%lu B) ovf %lu | queue %lu/%lu/%lu transit %lu/%lu/%lu dispatch %lu/%lu/%lu\n",
+         name, (unsigned long)stats.sent, (unsigned long)stats.dropped, (unsigned long)stats.received,
+         (unsigned long)stats.received_bytes, (unsigned long)stats.overflows, (unsigned long)ipc_stats_hist_percentile(&stats.queue, 50U),
+         (unsigned long)ipc_stats_hist_percentile(&stats.queue, 99U), (unsigned long)stats.queue.max_us,
+         (unsigned long)ipc_stats_hist_percentile(&stats.transit, 50U),
+         (unsigned long)ipc_stats_hist_percentile(&stats.transit, 99U), (unsigned long)stats.transit.max_us,
+         (unsigned long)ipc_stats_hist_percentile(&stats.dispatch, 50U),
+         (unsigned long)ipc_stats_hist_percentile(&stats.dispatch, 99U), (unsigned long)stats.dispatch.max_us);
+}
+
 static void cm33_cli_cmd_ipc(int argc, char *argv[])
 {
   if (argc < 2)
   {
-    printf("Usage: ipc ping|send <msg>|status|recv\n");
+    printf("Usage: ipc ping|send <msg>|status|recv [reset]|recv policy bulk <mode> [limit]|lanes [reset]|stats [reset]|bench [count] [size]|bench scan [aps] [reps]|bench lanes [count]\n");
+    return;
+  }
+  if ((strcmp(argv[1], "bench") == 0) && (argc >= 3) && (strcmp(argv[2], "lanes") == 0))
+  {
+    cm33_ipc_lane_bench_result_t result;
+    unsigned long count = 2000UL;
+    char *end_ptr = NULL;
+
+    if (argc >= 4)
+    {
+      count = strtoul(argv[3], &end_ptr, 10);
+      if ((end_ptr == argv[3]) || ('\0' != *end_ptr) || (0UL == count) || (100000UL < count))
+      {
+        printf("Usage: ipc bench lanes [count 1..100000]\n");
+        return;
+      }
+    }
+    printf("IPC bench lanes: %lu bulk frames with a control frame every 16...\n", count);
+    if (!cm33_ipc_run_lane_benchmark((uint32_t)count, &result))
+    {
+      printf("IPC bench lanes failed (busy, queue stalled or no report from CM55).\n");
+      return;
+    }
+    printf("IPC bench lanes: control %lu frames, %lu dropped, p50 %lu us, p99 %lu us, max %lu us\n",
+           (unsigned long)result.control_frames, (unsigned long)result.control_dropped,
+           (unsigned long)result.control_p50_us, (unsigned long)result.control_p99_us,
+           (unsigned long)result.control_max_us);
+    printf("IPC bench lanes: bulk    %lu frames, %lu lost,    p50 %lu us, p99 %lu us, max %lu us\n",
+           (unsigned long)result.bulk_frames, (unsigned long)result.bulk_lost,
+           (unsigned long)result.bulk_p50_us, (unsigned long)result.bulk_p99_us,
+           (unsigned long)result.bulk_max_us);
+    return;
+  }
+  if (strcmp(argv[1], "lanes") == 0)
+  {
+    ipc_lane_stats_t stats;
+
+    if ((argc >= 3) && (strcmp(argv[2], "reset") == 0))
+    {
+      cm33_ipc_reset_lane_stats();
+      printf("IPC lanes: statistics cleared.\n");
+      return;
+    }
+    for (uint32_t lane = 0U; lane < (uint32_t)IPC_LANE_COUNT; lane++)
+    {
+      if (cm33_ipc_get_lane_stats((ipc_lane_t)lane, &stats))
+      {
+        printf("IPC lane %-7s: sent %lu, dropped %lu, p50 %lu us, p99 %lu us, max %lu us\n",
+               ipc_lane_name((ipc_lane_t)lane), (unsigned long)stats.delay.count, (unsigned long)stats.dropped,
+               (unsigned long)ipc_stats_hist_percentile(&stats.delay, 50U),
+               (unsigned long)ipc_stats_hist_percentile(&stats.delay, 99U), (unsigned long)stats.delay.max_us);
+      }
+    }
+    return;
+  }
+  if (strcmp(argv[1], "stats") == 0)
+  {
+    if ((argc >= 3) && (strcmp(argv[2], "reset") == 0))
+    {
+      cm33_ipc_reset_cmd_stats();
+      printf("IPC stats: counters cleared.\n");
+      return;
+    }
+    printf("IPC stats (CM33; latencies p50/p99/max in us, transit on the CM33/CM55 shared timebase):\n");
+    for (uint32_t cmd = IPC_STATS_CMD_FIRST; cmd <= IPC_STATS_CMD_LAST; cmd++)
+    {
+      cm33_cli_print_ipc_cmd_stats(cmd, ipc_cmd_name(cmd));
+    }
+    cm33_cli_print_ipc_cmd_stats(0U, "OTHER");
+    return;
+  }
+  if ((strcmp(argv[1], "bench") == 0) && (argc >= 3) && (strcmp(argv[2], "scan") == 0))
+  {
+    cm33_ipc_scan_bench_result_t result;
+    unsigned long aps = 20UL;
+    unsigned long reps = 50UL;
+    char *end_ptr = NULL;
+
+    if (argc >= 4)
+    {
+      aps = strtoul(argv[3], &end_ptr, 10);
+      if ((end_ptr == argv[3]) || ('\0' != *end_ptr) || (0UL == aps) || (IPC_WIFI_SCAN_BULK_MAX < aps))
+      {
+        printf("Usage: ipc bench scan [aps 1..%lu] [reps 1..1000]\n", (unsigned long)IPC_WIFI_SCAN_BULK_MAX);
+        return;
+      }
+    }
+    if (argc >= 5)
+    {
+      reps = strtoul(argv[4], &end_ptr, 10);
+      if ((end_ptr == argv[4]) || ('\0' != *end_ptr) || (0UL == reps) || (1000UL < reps))
+      {
+        printf("Usage: ipc bench scan [aps 1..%lu] [reps 1..1000]\n", (unsigned long)IPC_WIFI_SCAN_BULK_MAX);
+        return;
+      }
+    }
+    printf("IPC bench scan: %lu x %lu-AP bulk transfers CM33 -> CM55...\n", reps, aps);
+    if (!cm33_ipc_run_scan_benchmark((uint32_t)aps, (uint32_t)reps, &result))
+    {
+      printf("IPC bench scan failed after %lu transfers (busy or no ack from CM55).\n",
+             (unsigned long)result.transfers);
+      return;
+    }
+    printf("IPC bench scan: %lu transfers of %lu bytes, %lu crc errors in %lu ms\n",
+           (unsigned long)result.transfers, (unsigned long)result.bytes_per_transfer,
+           (unsigned long)result.crc_errors, (unsigned long)result.elapsed_ms);
+    printf("IPC bench scan: scan-to-UI latency avg %lu us\n", (unsigned long)result.avg_latency_us);
+    return;
+  }
+  if (strcmp(argv[1], "bench") == 0)
+  {
+    cm33_ipc_bench_result_t result;
+    unsigned long count = 1000UL;
+    unsigned long size = 0UL;
+    char *end_ptr = NULL;
+
+    if (argc >= 3)
+    {
+      count = strtoul(argv[2], &end_ptr, 10);
+      if ((end_ptr == argv[2]) || ('\0' != *end_ptr) || (0UL == count) || (100000UL < count))
+      {
+        printf("Usage: ipc bench [count 1..100000] [size 0..%lu]\n", (unsigned long)IPC_DATA_MAX_LEN);
+        return;
+      }
+    }
+    if (argc >= 4)
+    {
+      size = strtoul(argv[3], &end_ptr, 10);
+      if ((end_ptr == argv[3]) || ('\0' != *end_ptr) || (IPC_DATA_MAX_LEN < size))
+      {
+        printf("Usage: ipc bench [count 1..100000] [size 0..%lu]\n", (unsigned long)IPC_DATA_MAX_LEN);
+        return;
+      }
+    }
+    printf("IPC bench: %lu frames of %lu bytes CM33 -> CM55...\n", count, size);
+    if (!cm33_ipc_run_benchmark((uint32_t)count, (uint32_t)size, &result))
+    {
+      printf("IPC bench failed (busy, queue stalled or no report from CM55).\n");
+      return;
+    }
+    printf("IPC bench: %lu frames, %lu bytes, %lu lost in %lu ms\n",
+           (unsigned long)result.frames, (unsigned long)result.bytes,
+           (unsigned long)result.lost, (unsigned long)result.elapsed_ms);
+    printf("IPC bench: %lu msgs/s, %lu bytes/s\n",
+           (unsigned long)result.msgs_per_sec, (unsigned long)result.bytes_per_sec);
+    return;
+  }
+  if ((strcmp(argv[1], "recv") == 0) && (argc >= 3) && (strcmp(argv[2], "policy") == 0))
+  {
+    cm33_ipc_recv_stats_t stats;
+    uint32_t policy = 0U;
+    unsigned long limit = 0UL;
+    char *end_ptr = NULL;
+
+    if ((argc >= 5) && cm33_ipc_get_recv_stats(IPC_LANE_BULK, &stats))
+    {
+      while ((policy < CM33_CLI_RECV_POLICY_COUNT) && (strcmp(argv[4], s_recv_policy_names[policy]) != 0))
+      {
+        policy++;
+      }
+      limit = stats.limit;
+      if (argc >= 6)
+      {
+        limit = strtoul(argv[5], &end_ptr, 10);
+        if ((end_ptr == argv[5]) || ('\0' != *end_ptr))
+        {
+          limit = 0UL;
+        }
+      }
+    }
+    if ((argc < 5) || (strcmp(argv[3], "bulk") != 0) || (policy >= CM33_CLI_RECV_POLICY_COUNT) ||
+        !cm33_ipc_set_recv_policy(IPC_LANE_BULK, (cm33_ipc_recv_policy_t)policy, (uint32_t)limit))
+    {
+      printf("Usage: ipc recv policy bulk block|newest|oldest [limit 1..%lu] (control always blocks)\n",
+             (unsigned long)IPC_RING_CREDITS);
+      return;
+    }
+    printf("IPC recv: bulk policy %s, limit %lu\n", s_recv_policy_names[policy], limit);
     return;
   }
   if (strcmp(argv[1], "recv") == 0)
   {
+    cm33_ipc_recv_stats_t stats;
+
+    if ((argc >= 3) && (strcmp(argv[2], "reset") == 0))
+    {
+      cm33_ipc_reset_recv_stats();
+      printf("IPC recv: drop counts and high-water marks cleared.\n");
+      return;
+    }
     printf("IPC recv: pending %lu, total %lu\n",
            (unsigned long)cm33_ipc_get_recv_pending(),
            (unsigned long)cm33_ipc_get_recv_total());
+    for (uint32_t lane = 0U; lane < (uint32_t)IPC_LANE_COUNT; lane++)
+    {
+      if (cm33_ipc_get_recv_stats((ipc_lane_t)lane, &stats))
+      {
+        printf("IPC recv %-7s: policy %s, limit %lu, queued %lu, peak %lu, dropped %lu\n",
+               ipc_lane_name((ipc_lane_t)lane), s_recv_policy_names[stats.policy], (unsigned long)stats.limit,
+               (unsigned long)stats.queued, (unsigned long)stats.peak, (unsigned long)stats.dropped);
+      }
+    }
     return;
   }
   if (strcmp(argv[1], "ping") == 0)
@@ -244,10 +464,24 @@ static void cm33_cli_cmd_ipc(int argc, char *argv[])
   }
   if (strcmp(argv[1], "status") == 0)
   {
-    printf("IPC pipe: CM33 -> CM55 (running).\n");
+    ipc_liveness_status_t peer;
+    ipc_liveness_state_t state;
+    uint32_t counter;
+
+    if (!cm33_ipc_get_liveness(&peer, &counter, &state))
+    {
+      printf("IPC status: CM33 %s, %lu beats; CM55 not seen yet.\n", ipc_liveness_state_name(state),
+             (unsigned long)counter);
+      return;
+    }
+    printf("IPC status: CM33 %s, %lu beats; CM55 %s, %lu beats%s\n", ipc_liveness_state_name(state),
+           (unsigned long)counter, ipc_liveness_state_name(peer.state), (unsigned long)peer.counter,
+           peer.stalled ? " (STALLED)" : "");
+    printf("IPC status: CM55 owed beat missing %lu ms, late %lu, stalls %lu\n", (unsigned long)peer.silent_ms,
+           (unsigned long)peer.late, (unsigned long)peer.stalls);
     return;
   }
-  printf("Unknown ipc subcommand '%s'. Use: ping|send|status|recv\n", argv[1]);
+  printf("Unknown ipc subcommand '%s'. Use: ping|send|status|recv|lanes|stats|bench\n", argv[1]);
 }
 
 static void cm33_cli_cmd_time(int argc, char *argv[])
@@ -981,6 +1215,7 @@ static void cm33_cli_cmd_touch(int argc, char *argv[])
 {
 #ifdef COMPONENT_BSXLITE
   sensor_hub_fusion_status_t status;
+  ipc_lane_stats_t lane_stats;
   if ((argc < 2) || (0 == strcmp(argv[1], "help")))
   {
     (void)printf("[CM33.Touch] Usage: touch status|stream status|on|off|ipc status\n");
@@ -1070,9 +1305,15 @@ static void cm33_cli_cmd_touch(int argc, char *argv[])
                    (unsigned long)status.touch_send_ok,
                    (unsigned long)status.touch_send_fail);
     }
-    (void)printf("[CM33.Touch.IPC] queue used=%lu/%lu\n",
+    (void)printf("[CM33.Touch.IPC] send buffer used=%lu/%lu bytes\n",
                  (unsigned long)cm33_ipc_get_send_queue_used(),
                  (unsigned long)cm33_ipc_get_send_queue_capacity());
+    if (cm33_ipc_get_lane_stats(IPC_LANE_CONTROL, &lane_stats))
+    {
+      (void)printf("[CM33.Touch.IPC] control lane p99=%lu us max=%lu us dropped=%lu\n",
+                   (unsigned long)ipc_stats_hist_percentile(&lane_stats.delay, 99U),
+                   (unsigned long)lane_stats.delay.max_us, (unsigned long)lane_stats.dropped);
+    }
     return;
   }
   (void)printf("[CM33.Touch] Usage: touch status|stream status|on|off|ipc status\n");
@@ -1134,7 +1375,7 @@ static void cm33_cli_cmd_wifi(int argc, char *argv[])
   {
     ipc_wifi_scan_request_t req = { 0 };
     req.use_filter = false;
-    if (wifi_manager_request_scan(&req))
+    if (wifi_manager_request_scan(&req, WIFI_MANAGER_CALL_NONE))
     {
       printf("Scan requested.\n");
     }
@@ -1159,7 +1400,7 @@ static void cm33_cli_cmd_wifi(int argc, char *argv[])
       (void)strncpy(req.password, argv[3], (size_t)(sizeof(req.password) - 1U));
       req.password[sizeof(req.password) - 1U] = '\0';
     }
-    if (wifi_manager_request_connect(&req))
+    if (wifi_manager_request_connect(&req, WIFI_MANAGER_CALL_NONE))
     {
       printf("Connect requested.\n");
     }
@@ -1171,7 +1412,7 @@ static void cm33_cli_cmd_wifi(int argc, char *argv[])
   }
   if (strcmp(argv[1], "disconnect") == 0)
   {
-    if (wifi_manager_request_disconnect())
+    if (wifi_manager_request_disconnect(WIFI_MANAGER_CALL_NONE))
     {
       printf("Disconnect requested.\n");
     }
@@ -1183,7 +1424,7 @@ static void cm33_cli_cmd_wifi(int argc, char *argv[])
   }
   if (strcmp(argv[1], "status") == 0)
   {
-    if (wifi_manager_request_status())
+    if (wifi_manager_request_status(WIFI_MANAGER_CALL_NONE))
     {
       printf("Status requested.\n");
     }
@@ -11,6 +11,7 @@
  *******************************************************************************/
 
 #include "error_handler.h"
+#include "cm33_ipc_pipe.h"
 #include "cy_pdl.h"
 #include "cybsp.h"
 #include "ipc_log.h"
@@ -20,6 +21,9 @@
  * Centrally handles application errors.
  */
 void handle_error(const char *message) {
+  /* CM55 sees the fault in the shared liveness record without waiting for a timeout. */
+  cm33_ipc_set_fault();
+
   /* Log the error first so it is visible before UART may stop (interrupts off).
    * When printf is redirected to IPC log, ipc_log_flush() drains the queue so
    * the transport task sends the message to CM55 before we disable interrupts.
@@ -2,6 +2,11 @@
  * File Name        : event_bus.c
  *
  * Description      : Multi-instance pub/sub event bus implementation.
+ *                    Subscribers of each event ID live in an immutable array
+ *                    that subscribe and unsubscribe replace as a whole, so
+ *                    publishers call callbacks without holding the mutex.
+ *                    Asynchronous subscribers get a copy of each event in
+ *                    their own queue, run by their own worker task.
  *
  * Author           : Asst.Prof.Santi Nuratch, Ph.D
  *                    Thailand Embedded Systems Association (TESA)
@@ -12,27 +17,321 @@
 
 #include "event_bus.h"
 #include "FreeRTOS.h"
+#include "queue.h"
 #include "semphr.h"
+#include "task.h"
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 
 /**
- * Subscriber node for the linked list.
+ * Asynchronous subscriber. refs counts the snapshots that list it; when the
+ * last one is freed, the worker is told to stop and frees the subscriber.
  */
-typedef struct subscriber_node
+typedef struct
 {
   event_callback_t callback;
-  struct subscriber_node *next;
-} subscriber_node_t;
+  QueueHandle_t queue;
+  TaskHandle_t worker;
+  uint32_t refs;
+  volatile bool stopping;
+  event_bus_overflow_t overflow;
+  TickType_t wait_ticks;
+  uint32_t data_size;
+  event_bus_async_stats_t stats;    /* Updated in critical sections. */
+  uint8_t *item;                    /* Worker's receive buffer. */
+  uint8_t *discard;                 /* Oldest item dropped by DROP_OLDEST; contents unused. */
+} async_subscriber_t;
 
-/** Internal event bus context; holds per-event subscriber lists and mutex. */
+/**
+ * Queue item of an asynchronous subscriber; only the first data_size bytes
+ * of data are queued.
+ */
+typedef struct
+{
+  uint32_t event_id;
+  uint32_t has_data;
+  uint8_t data[EVENT_BUS_ASYNC_DATA_MAX];
+} async_item_t;
+
+#define ASYNC_ITEM_SIZE(data_size) (offsetof(async_item_t, data) + (data_size))
+
+/**
+ * One subscriber: async is NULL for callbacks run by the publisher.
+ */
+typedef struct
+{
+  event_callback_t callback;
+  async_subscriber_t *async;
+} subscriber_entry_t;
+
+/**
+ * Subscriber snapshot of one event ID. Never modified once published; refs
+ * counts the bus (while it is current) and every publisher walking it, and
+ * whoever drops the last reference frees it.
+ */
+typedef struct
+{
+  uint32_t refs;
+  uint32_t count;
+  subscriber_entry_t entries[];
+} subscriber_list_t;
+
+/**
+ * Event published from an ISR, waiting for the worker task.
+ */
+typedef struct
+{
+  uint32_t event_id;
+  uint32_t size;
+  uint8_t data[EVENT_BUS_ISR_DATA_MAX];
+} isr_event_t;
+
+/**
+ * Bridge settings of one event ID.
+ */
+typedef struct
+{
+  bool remote;
+  uint32_t payload_size;            /* Bytes of event_data the bridge copies. */
+} event_remote_t;
+
+/** Internal event bus context; holds per-event subscriber snapshots and mutex. */
 struct event_bus_context
 {
-  subscriber_node_t **subscribers;  /* Per-event-ID head of linked list. */
+  subscriber_list_t **subscribers;  /* Per-event-ID snapshot; NULL if none. Swapped in a critical section. */
   uint32_t max_events;              /* Maximum event ID (exclusive). */
-  SemaphoreHandle_t mutex;          /* Protects subscribe/unsubscribe/publish. */
+  SemaphoreHandle_t mutex;          /* Serializes subscribe/unsubscribe/set_remote; publish does not take it. */
+  event_remote_t *remote;           /* Per-event-ID bridge settings; NULL until the first set_remote. */
+  const event_bus_bridge_t *bridge; /* NULL if no bridge is attached. */
+  QueueHandle_t isr_queue;          /* Events from event_bus_publish_from_isr(); NULL until the worker starts. */
+  TaskHandle_t isr_worker;          /* Woken by a notification per queued event. */
+  SemaphoreHandle_t isr_done;       /* Given by the worker as it exits. */
+  volatile bool isr_stopping;       /* Set by event_bus_destroy(). */
+  uint32_t isr_dropped;             /* ISR events lost to a full isr_queue; updated in critical sections. */
 };
 
+/**
+ * Number of subscribers of event_id. Called with the mutex held.
+ */
+static uint32_t count_subscribers(const struct event_bus_context *bus, uint32_t event_id) {
+  return (bus->subscribers[event_id] != NULL) ? bus->subscribers[event_id]->count : 0;
+}
+
+/**
+ * Tells the worker of an asynchronous subscriber to free it and exit.
+ * Events still queued are discarded.
+ */
+static void stop_async(async_subscriber_t *async) {
+  async->stopping = true;
+  xTaskNotifyGive(async->worker);
+}
+
+/**
+ * Drops one reference to list and frees it if that was the last one.
+ */
+static void release_list(subscriber_list_t *list) {
+  if (list == NULL) {
+    return;
+  }
+
+  taskENTER_CRITICAL();
+  bool last = (--list->refs == 0);
+  for (uint32_t i = 0; last && i < list->count; i++) {
+    async_subscriber_t *async = list->entries[i].async;
+    if (async != NULL && --async->refs == 0) {
+      list->entries[i].callback = NULL; /* Marks it for stop_async() below. */
+    }
+  }
+  taskEXIT_CRITICAL();
+
+  if (last) {
+    for (uint32_t i = 0; i < list->count; i++) {
+      if (list->entries[i].async != NULL && list->entries[i].callback == NULL) {
+        stop_async(list->entries[i].async);
+      }
+    }
+    vPortFree(list);
+  }
+}
+
+/**
+ * Makes list the snapshot of event_id and releases the previous one.
+ * Called with the mutex held.
+ */
+static void swap_list(struct event_bus_context *bus, uint32_t event_id, subscriber_list_t *list) {
+  taskENTER_CRITICAL();
+  subscriber_list_t *old = bus->subscribers[event_id];
+  bus->subscribers[event_id] = list;
+  taskEXIT_CRITICAL();
+
+  release_list(old);
+}
+
+/**
+ * Copy of the snapshot of event_id with add appended (or the callback remove
+ * left out), or NULL if it would be empty. *failed is set if memory ran out.
+ * Called with the mutex held.
+ */
+static subscriber_list_t *copy_list(const subscriber_list_t *old, const subscriber_entry_t *add,
+                                    event_callback_t remove, bool *failed) {
+  uint32_t old_count = (old != NULL) ? old->count : 0;
+  uint32_t count = old_count + ((add != NULL) ? 1 : 0) - ((remove != NULL) ? 1 : 0);
+
+  *failed = false;
+  if (count == 0) {
+    return NULL;
+  }
+
+  subscriber_list_t *list = pvPortMalloc(sizeof(subscriber_list_t) + (sizeof(subscriber_entry_t) * count));
+  if (list == NULL) {
+    *failed = true;
+    return NULL;
+  }
+
+  list->refs = 1;
+  list->count = 0;
+  for (uint32_t i = 0; i < old_count; i++) {
+    if (old->entries[i].callback != remove) {
+      list->entries[list->count++] = old->entries[i];
+    }
+  }
+  if (add != NULL) {
+    list->entries[list->count++] = *add;
+  }
+
+  /* Publishers release snapshots in critical sections, so count references in one too. */
+  taskENTER_CRITICAL();
+  for (uint32_t i = 0; i < list->count; i++) {
+    if (list->entries[i].async != NULL) {
+      list->entries[i].async->refs++;
+    }
+  }
+  taskEXIT_CRITICAL();
+  return list;
+}
+
+/**
+ * Runs the events queued for one asynchronous subscriber.
+ */
+static void async_worker_task(void *arg) {
+  async_subscriber_t *async = (async_subscriber_t *)arg;
+  const async_item_t *item = (const async_item_t *)async->item;
+
+  for (;;) {
+    (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    while (!async->stopping && xQueueReceive(async->queue, async->item, 0) == pdTRUE) {
+      async->callback(item->event_id, (item->has_data != 0) ? (void *)item->data : NULL);
+      taskENTER_CRITICAL();
+      async->stats.delivered++;
+      taskEXIT_CRITICAL();
+    }
+    if (async->stopping) {
+      vQueueDelete(async->queue);
+      vPortFree(async);
+      vTaskDelete(NULL);
+    }
+  }
+}
+
+/**
+ * Creates an asynchronous subscriber and its worker. Called with the mutex
+ * held; returns NULL on invalid config or out of memory.
+ */
+static async_subscriber_t *create_async(event_callback_t callback, const event_bus_async_config_t *config) {
+  if (config->queue_length == 0 || config->data_size > EVENT_BUS_ASYNC_DATA_MAX ||
+      config->overflow > EVENT_BUS_OVERFLOW_WAIT) {
+    return NULL;
+  }
+
+  /* Subscriber and both item buffers in one block; items stay 4-byte aligned. */
+  uint32_t item_size = (ASYNC_ITEM_SIZE(config->data_size) + 3U) & ~3U;
+  async_subscriber_t *async = pvPortMalloc(sizeof(async_subscriber_t) + (2U * item_size));
+  if (async == NULL) {
+    return NULL;
+  }
+
+  memset(async, 0, sizeof(async_subscriber_t));
+  async->callback = callback;
+  async->overflow = config->overflow;
+  async->wait_ticks = (config->overflow == EVENT_BUS_OVERFLOW_WAIT) ? config->wait_ticks : 0;
+  async->data_size = config->data_size;
+  async->stats.queue_length = config->queue_length;
+  async->item = (uint8_t *)(async + 1);
+  async->discard = async->item + item_size;
+
+  async->queue = xQueueCreate(config->queue_length, ASYNC_ITEM_SIZE(config->data_size));
+  if (async->queue == NULL) {
+    vPortFree(async);
+    return NULL;
+  }
+  if (xTaskCreate(async_worker_task, "EvtSub", (configSTACK_DEPTH_TYPE)config->stack_words, async,
+                  (UBaseType_t)config->priority, &async->worker) != pdPASS) {
+    vQueueDelete(async->queue);
+    vPortFree(async);
+    return NULL;
+  }
+  return async;
+}
+
+/**
+ * Copies an event into the queue of an asynchronous subscriber, applying its
+ * overflow policy. Only size bytes of event_data are read; the rest of the
+ * subscriber's data_size is zeroed. Never blocks longer than the subscriber's
+ * wait_ticks.
+ */
+static void enqueue_async(async_subscriber_t *async, uint32_t event_id, const void *event_data, uint32_t size) {
+  async_item_t item;
+  bool displaced = false;
+
+  item.event_id = event_id;
+  item.has_data = (event_data != NULL && async->data_size > 0) ? 1U : 0U;
+  if (item.has_data != 0) {
+    uint32_t copied = (size < async->data_size) ? size : async->data_size;
+    memcpy(item.data, event_data, copied);
+    memset(&item.data[copied], 0, async->data_size - copied);
+  }
+
+  BaseType_t sent = xQueueSend(async->queue, &item, async->wait_ticks);
+  if (sent != pdTRUE && async->overflow == EVENT_BUS_OVERFLOW_DROP_OLDEST) {
+    displaced = (xQueueReceive(async->queue, async->discard, 0) == pdTRUE);
+    sent = xQueueSend(async->queue, &item, 0);
+  }
+  uint32_t depth = (uint32_t)uxQueueMessagesWaiting(async->queue);
+
+  taskENTER_CRITICAL();
+  async->stats.dropped += (displaced ? 1U : 0U) + ((sent != pdTRUE) ? 1U : 0U);
+  async->stats.queued += (sent == pdTRUE) ? 1U : 0U;
+  if (depth > async->stats.high_water) {
+    async->stats.high_water = depth;
+  }
+  taskEXIT_CRITICAL();
+
+  if (sent == pdTRUE) {
+    xTaskNotifyGive(async->worker);
+  }
+}
+
+/**
+ * Bridge to tell about a subscriber change of event_id, or NULL if the event
+ * is local. Called with the mutex held or in a critical section.
+ */
+static const event_bus_bridge_t *remote_bridge(const struct event_bus_context *bus, uint32_t event_id) {
+  if (bus->bridge == NULL || bus->remote == NULL || !bus->remote[event_id].remote) {
+    return NULL;
+  }
+  return bus->bridge;
+}
+
+/**
+ * Reports a subscriber count to the bridge, after the mutex is released.
+ */
+static void notify_bridge(const event_bus_bridge_t *bridge, uint32_t event_id, uint32_t subscriber_count) {
+  if (bridge != NULL && bridge->subscribers_changed != NULL) {
+    bridge->subscribers_changed(event_id, subscriber_count);
+  }
+}
+
 /**
  * Creates a new event bus instance.
  */
@@ -46,7 +345,7 @@ event_bus_t event_bus_create(uint32_t max_event_ids) {
     return NULL;
   }
 
-  bus->subscribers = pvPortMalloc(sizeof(subscriber_node_t *) * max_event_ids);
+  bus->subscribers = pvPortMalloc(sizeof(subscriber_list_t *) * max_event_ids);
   if (bus->subscribers == NULL) {
     vPortFree(bus);
     return NULL;
@@ -59,8 +358,15 @@ event_bus_t event_bus_create(uint32_t max_event_ids) {
     return NULL;
   }
 
-  memset(bus->subscribers, 0, sizeof(subscriber_node_t *) * max_event_ids);
+  memset(bus->subscribers, 0, sizeof(subscriber_list_t *) * max_event_ids);
   bus->max_events = max_event_ids;
+  bus->remote = NULL;
+  bus->bridge = NULL;
+  bus->isr_queue = NULL;
+  bus->isr_worker = NULL;
+  bus->isr_done = NULL;
+  bus->isr_stopping = false;
+  bus->isr_dropped = 0;
 
   return (event_bus_t)bus;
 }
@@ -74,17 +380,23 @@ void event_bus_destroy(event_bus_t bus_handle) {
     return;
   }
 
-  /* Take mutex to ensure no one is using it while we destroy */
+  /* The ISR worker may be inside a publish holding a snapshot; it exits before its next one.
+     Its callbacks may subscribe, so the mutex is not held meanwhile. */
+  if (bus->isr_worker != NULL) {
+    bus->isr_stopping = true;
+    xTaskNotifyGive(bus->isr_worker);
+    (void)xSemaphoreTake(bus->isr_done, portMAX_DELAY);
+    vSemaphoreDelete(bus->isr_done);
+    vQueueDelete(bus->isr_queue);
+  }
+
+  /* Publishers must have stopped; the mutex only keeps out subscribe and unsubscribe. */
   if (xSemaphoreTake(bus->mutex, portMAX_DELAY) == pdTRUE) {
     for (uint32_t i = 0; i < bus->max_events; i++) {
-      subscriber_node_t *current = bus->subscribers[i];
-      while (current != NULL) {
-        subscriber_node_t *next = current->next;
-        vPortFree(current);
-        current = next;
-      }
+      swap_list(bus, i, NULL);
     }
     vPortFree(bus->subscribers);
+    vPortFree(bus->remote);
     xSemaphoreGive(bus->mutex);
   }
 
@@ -93,44 +405,77 @@ void event_bus_destroy(event_bus_t bus_handle) {
 }
 
 /**
- * Subscribes a callback to a specific event ID.
+ * Subscribes callback to event_id, run by the publisher (config NULL) or by a
+ * worker of its own.
  */
-bool event_bus_subscribe(event_bus_t bus_handle, uint32_t event_id, event_callback_t callback) {
-  struct event_bus_context *bus = (struct event_bus_context *)bus_handle;
-  if (bus == NULL || event_id >= bus->max_events || callback == NULL) {
-    return false;
-  }
-
+static bool add_subscriber(struct event_bus_context *bus, uint32_t event_id, event_callback_t callback,
+                           const event_bus_async_config_t *config) {
   if (xSemaphoreTake(bus->mutex, portMAX_DELAY) != pdTRUE)
   {
     return false;
   }
 
   /* Check if already subscribed to avoid duplicates. */
-  subscriber_node_t *current = bus->subscribers[event_id];
-  while (current != NULL) {
-    if (current->callback == callback) {
+  const subscriber_list_t *old = bus->subscribers[event_id];
+  for (uint32_t i = 0; old != NULL && i < old->count; i++) {
+    if (old->entries[i].callback == callback) {
       xSemaphoreGive(bus->mutex);
       return true;
     }
-    current = current->next;
   }
 
-  /* Create new subscriber node and prepend to list. */
-  subscriber_node_t *new_node = pvPortMalloc(sizeof(subscriber_node_t));
-  if (new_node == NULL) {
+  subscriber_entry_t entry = { callback, NULL };
+  if (config != NULL) {
+    entry.async = create_async(callback, config);
+    if (entry.async == NULL) {
+      xSemaphoreGive(bus->mutex);
+      return false;
+    }
+  }
+
+  /* Publish a copy with the callback appended; publishers still walking the old one finish it. */
+  bool failed;
+  subscriber_list_t *list = copy_list(old, &entry, NULL, &failed);
+  if (failed) {
+    if (entry.async != NULL) {
+      stop_async(entry.async);
+    }
     xSemaphoreGive(bus->mutex);
     return false;
   }
+  swap_list(bus, event_id, list);
 
-  new_node->callback = callback;
-  new_node->next = bus->subscribers[event_id];
-  bus->subscribers[event_id] = new_node;
+  const event_bus_bridge_t *bridge = remote_bridge(bus, event_id);
+  uint32_t subscriber_count = count_subscribers(bus, event_id);
 
   xSemaphoreGive(bus->mutex);
+  notify_bridge(bridge, event_id, subscriber_count);
   return true;
 }
 
+/**
+ * Subscribes a callback to a specific event ID.
+ */
+bool event_bus_subscribe(event_bus_t bus_handle, uint32_t event_id, event_callback_t callback) {
+  struct event_bus_context *bus = (struct event_bus_context *)bus_handle;
+  if (bus == NULL || event_id >= bus->max_events || callback == NULL) {
+    return false;
+  }
+  return add_subscriber(bus, event_id, callback, NULL);
+}
+
+/**
+ * Subscribes a callback run by its own worker task.
+ */
+bool event_bus_subscribe_async(event_bus_t bus_handle, uint32_t event_id, event_callback_t callback,
+                               const event_bus_async_config_t *config) {
+  struct event_bus_context *bus = (struct event_bus_context *)bus_handle;
+  if (bus == NULL || event_id >= bus->max_events || callback == NULL || config == NULL) {
+    return false;
+  }
+  return add_subscriber(bus, event_id, callback, config);
+}
+
 /**
  * Unsubscribes a callback from a specific event ID.
  */
@@ -144,22 +489,24 @@ bool event_bus_unsubscribe(event_bus_t bus_handle, uint32_t event_id, event_call
     return false;
   }
 
-  subscriber_node_t *current = bus->subscribers[event_id];
-  subscriber_node_t *prev = NULL;
-
-  while (current != NULL) {
-    if (current->callback == callback) {
-      if (prev == NULL) {
-        bus->subscribers[event_id] = current->next;
-      } else {
-        prev->next = current->next;
+  const subscriber_list_t *old = bus->subscribers[event_id];
+  for (uint32_t i = 0; old != NULL && i < old->count; i++) {
+    if (old->entries[i].callback == callback) {
+      bool failed;
+      subscriber_list_t *list = copy_list(old, NULL, callback, &failed);
+      if (failed) {
+        xSemaphoreGive(bus->mutex);
+        return false;
       }
-      vPortFree(current);
+      swap_list(bus, event_id, list);
+
+      const event_bus_bridge_t *bridge = remote_bridge(bus, event_id);
+      uint32_t subscriber_count = count_subscribers(bus, event_id);
+
       xSemaphoreGive(bus->mutex);
+      notify_bridge(bridge, event_id, subscriber_count);
       return true;
     }
-    prev = current;
-    current = current->next;
   }
 
   xSemaphoreGive(bus->mutex);
@@ -167,9 +514,114 @@ bool event_bus_unsubscribe(event_bus_t bus_handle, uint32_t event_id, event_call
 }
 
 /**
- * Publishes an event to all subscribers.
+ * Publishes an event to all subscribers. size bounds what asynchronous
+ * subscribers and the bridge copy out of event_data.
+ */
+bool event_bus_publish_sized(event_bus_t bus_handle, uint32_t event_id, void *event_data, uint32_t size) {
+  struct event_bus_context *bus = (struct event_bus_context *)bus_handle;
+  if (bus == NULL || event_id >= bus->max_events) {
+    return false;
+  }
+
+  /* Pin the current snapshot; subscribe and unsubscribe swap in a new one meanwhile. */
+  taskENTER_CRITICAL();
+  subscriber_list_t *list = bus->subscribers[event_id];
+  if (list != NULL) {
+    list->refs++;
+  }
+  const event_bus_bridge_t *bridge = remote_bridge(bus, event_id);
+  uint32_t payload_size = (bridge != NULL) ? bus->remote[event_id].payload_size : 0;
+  taskEXIT_CRITICAL();
+
+  for (uint32_t i = 0; list != NULL && i < list->count; i++) {
+    if (list->entries[i].async != NULL) {
+      enqueue_async(list->entries[i].async, event_id, event_data, size);
+    } else {
+      list->entries[i].callback(event_id, event_data);
+    }
+  }
+  release_list(list);
+
+  /* Forwarded whether or not this core has subscribers. */
+  if (bridge != NULL && (event_data != NULL || payload_size == 0)) {
+    (void)bridge->forward(event_id, event_data, (size < payload_size) ? size : payload_size);
+  }
+  return true;
+}
+
+/**
+ * Publishes an event whose payload is as large as every subscriber expects.
  */
 bool event_bus_publish(event_bus_t bus_handle, uint32_t event_id, void *event_data) {
+  return event_bus_publish_sized(bus_handle, event_id, event_data, UINT32_MAX);
+}
+
+/**
+ * Copies the counters of an asynchronous subscriber.
+ */
+bool event_bus_get_async_stats(event_bus_t bus_handle, uint32_t event_id, event_callback_t callback,
+                               event_bus_async_stats_t *stats) {
+  struct event_bus_context *bus = (struct event_bus_context *)bus_handle;
+  if (bus == NULL || event_id >= bus->max_events || callback == NULL || stats == NULL) {
+    return false;
+  }
+
+  if (xSemaphoreTake(bus->mutex, portMAX_DELAY) != pdTRUE) {
+    return false;
+  }
+
+  bool found = false;
+  const subscriber_list_t *list = bus->subscribers[event_id];
+  for (uint32_t i = 0; list != NULL && i < list->count; i++) {
+    if (list->entries[i].callback == callback && list->entries[i].async != NULL) {
+      taskENTER_CRITICAL();
+      *stats = list->entries[i].async->stats;
+      taskEXIT_CRITICAL();
+      found = true;
+      break;
+    }
+  }
+
+  xSemaphoreGive(bus->mutex);
+  return found;
+}
+
+/**
+ * Attaches or detaches the bridge.
+ */
+bool event_bus_set_bridge(event_bus_t bus_handle, const event_bus_bridge_t *bridge) {
+  struct event_bus_context *bus = (struct event_bus_context *)bus_handle;
+  if (bus == NULL || (bridge != NULL && bridge->forward == NULL)) {
+    return false;
+  }
+
+  if (xSemaphoreTake(bus->mutex, portMAX_DELAY) != pdTRUE) {
+    return false;
+  }
+  taskENTER_CRITICAL();
+  bus->bridge = bridge;
+  taskEXIT_CRITICAL();
+  xSemaphoreGive(bus->mutex);
+
+  /* Announce remote events that already have subscribers. */
+  for (uint32_t i = 0; bridge != NULL && bus->remote != NULL && i < bus->max_events; i++) {
+    if (xSemaphoreTake(bus->mutex, portMAX_DELAY) != pdTRUE) {
+      return false;
+    }
+    uint32_t subscriber_count = bus->remote[i].remote ? count_subscribers(bus, i) : 0;
+    xSemaphoreGive(bus->mutex);
+
+    if (subscriber_count > 0) {
+      notify_bridge(bridge, i, subscriber_count);
+    }
+  }
+  return true;
+}
+
+/**
+ * Marks an event ID remote or local.
+ */
+bool event_bus_set_remote(event_bus_t bus_handle, uint32_t event_id, bool remote, uint32_t payload_size) {
   struct event_bus_context *bus = (struct event_bus_context *)bus_handle;
   if (bus == NULL || event_id >= bus->max_events) {
     return false;
@@ -179,12 +631,141 @@ bool event_bus_publish(event_bus_t bus_handle, uint32_t event_id, void *event_da
     return false;
   }
 
-  subscriber_node_t *current = bus->subscribers[event_id];
-  while (current != NULL) {
-    current->callback(event_id, event_data);
-    current = current->next;
+  if (bus->remote == NULL) {
+    event_remote_t *table = pvPortMalloc(sizeof(event_remote_t) * bus->max_events);
+    if (table == NULL) {
+      xSemaphoreGive(bus->mutex);
+      return false;
+    }
+    memset(table, 0, sizeof(event_remote_t) * bus->max_events);
+    taskENTER_CRITICAL();
+    bus->remote = table;
+    taskEXIT_CRITICAL();
+  }
+
+  /* Publishers read both fields together in their critical section. */
+  bool changed = (bus->remote[event_id].remote != remote);
+  taskENTER_CRITICAL();
+  bus->remote[event_id].remote = remote;
+  bus->remote[event_id].payload_size = payload_size;
+  taskEXIT_CRITICAL();
+
+  const event_bus_bridge_t *bridge = bus->bridge;
+  uint32_t subscriber_count = count_subscribers(bus, event_id);
+
+  xSemaphoreGive(bus->mutex);
+
+  if (changed && subscriber_count > 0) {
+    notify_bridge(bridge, event_id, remote ? subscriber_count : 0);
+  }
+  return true;
+}
+
+/**
+ * Publishes the events queued by event_bus_publish_from_isr(). Stops between
+ * publishes once event_bus_destroy() asks; events still queued are discarded.
+ */
+static void isr_worker_task(void *arg) {
+  struct event_bus_context *bus = (struct event_bus_context *)arg;
+  isr_event_t event;
+
+  for (;;) {
+    (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    while (!bus->isr_stopping && xQueueReceive(bus->isr_queue, &event, 0) == pdTRUE) {
+      (void)event_bus_publish_sized((event_bus_t)bus, event.event_id, (event.size > 0) ? event.data : NULL,
+                                    event.size);
+    }
+    if (bus->isr_stopping) {
+      /* The bus may be freed as soon as done is given. */
+      SemaphoreHandle_t done = bus->isr_done;
+      xSemaphoreGive(done);
+      vTaskDelete(NULL);
+    }
+  }
+}
+
+/**
+ * Starts the worker that publishes events from ISRs.
+ */
+bool event_bus_start_isr_worker(event_bus_t bus_handle, uint32_t queue_length, uint32_t stack_words,
+                                uint32_t priority) {
+  struct event_bus_context *bus = (struct event_bus_context *)bus_handle;
+  if (bus == NULL || queue_length == 0) {
+    return false;
+  }
+
+  if (xSemaphoreTake(bus->mutex, portMAX_DELAY) != pdTRUE) {
+    return false;
+  }
+  if (bus->isr_worker != NULL) {
+    xSemaphoreGive(bus->mutex);
+    return true;
+  }
+
+  QueueHandle_t queue = xQueueCreate(queue_length, sizeof(isr_event_t));
+  SemaphoreHandle_t done = xSemaphoreCreateBinary();
+  if (queue == NULL || done == NULL) {
+    if (queue != NULL) {
+      vQueueDelete(queue);
+    }
+    if (done != NULL) {
+      vSemaphoreDelete(done);
+    }
+    xSemaphoreGive(bus->mutex);
+    return false;
+  }
+
+  /* The worker only reads the queue once notified, and ISRs only notify it once they see the queue. */
+  bus->isr_done = done;
+  if (xTaskCreate(isr_worker_task, "EventBus", (configSTACK_DEPTH_TYPE)stack_words, bus, (UBaseType_t)priority,
+                  &bus->isr_worker) != pdPASS) {
+    bus->isr_worker = NULL;
+    bus->isr_done = NULL;
+    vQueueDelete(queue);
+    vSemaphoreDelete(done);
+    xSemaphoreGive(bus->mutex);
+    return false;
   }
+  taskENTER_CRITICAL();
+  bus->isr_queue = queue;
+  taskEXIT_CRITICAL();
 
   xSemaphoreGive(bus->mutex);
   return true;
 }
+
+/**
+ * Queues an event for the worker to publish. ISR only.
+ */
+bool event_bus_publish_from_isr(event_bus_t bus_handle, uint32_t event_id, const void *event_data, uint32_t size,
+                                BaseType_t *higher_priority_task_woken) {
+  struct event_bus_context *bus = (struct event_bus_context *)bus_handle;
+  if (bus == NULL || event_id >= bus->max_events || size > EVENT_BUS_ISR_DATA_MAX ||
+      (size > 0 && event_data == NULL) || bus->isr_queue == NULL) {
+    return false;
+  }
+
+  isr_event_t event;
+  event.event_id = event_id;
+  event.size = size;
+  if (size > 0) {
+    memcpy(event.data, event_data, size);
+  }
+
+  if (xQueueSendFromISR(bus->isr_queue, &event, higher_priority_task_woken) != pdTRUE) {
+    UBaseType_t state = taskENTER_CRITICAL_FROM_ISR();
+    bus->isr_dropped++;
+    taskEXIT_CRITICAL_FROM_ISR(state);
+    return false;
+  }
+  vTaskNotifyGiveFromISR(bus->isr_worker, higher_priority_task_woken);
+  return true;
+}
+
+/**
+ * Number of ISR events dropped because the worker queue was full.
+ */
+uint32_t event_bus_get_isr_dropped(event_bus_t bus_handle) {
+  struct event_bus_context *bus = (struct event_bus_context *)bus_handle;
+  return (bus != NULL) ? bus->isr_dropped : 0;
+}
@@ -13,9 +13,20 @@
 #ifndef EVENT_BUS_H
 #define EVENT_BUS_H
 
+#include "FreeRTOS.h"
 #include <stdbool.h>
 #include <stdint.h>
 
+/**
+ * Largest payload event_bus_publish_from_isr() copies for the worker.
+ */
+#define EVENT_BUS_ISR_DATA_MAX (16U)
+
+/**
+ * Largest payload an asynchronous subscriber can have copied per event.
+ */
+#define EVENT_BUS_ASYNC_DATA_MAX (64U)
+
 /**
  * Handle for an event bus instance.
  */
@@ -27,6 +38,56 @@ typedef struct event_bus_context *event_bus_t;
  */
 typedef void (*event_callback_t)(uint32_t event_id, void *event_data);
 
+/**
+ * Hooks that carry remote events to another core (see ipc_event_bridge.h).
+ * forward receives every publish on a remote event ID with its payload size;
+ * subscribers_changed, which may be NULL, hears the subscriber count of a
+ * remote event ID whenever it changes.
+ */
+typedef struct
+{
+  bool (*forward)(uint32_t event_id, const void *event_data, uint32_t size);
+  void (*subscribers_changed)(uint32_t event_id, uint32_t subscriber_count);
+} event_bus_bridge_t;
+
+/**
+ * What publishing does when an asynchronous subscriber's queue is full.
+ */
+typedef enum
+{
+  EVENT_BUS_OVERFLOW_DROP_NEWEST = 0, /* Drop the event being published. */
+  EVENT_BUS_OVERFLOW_DROP_OLDEST,     /* Drop the oldest queued event to make room. */
+  EVENT_BUS_OVERFLOW_WAIT             /* Wait up to wait_ticks for room, then drop the new event. */
+} event_bus_overflow_t;
+
+/**
+ * Asynchronous subscriber settings. Each published event is copied into a
+ * queue of queue_length items, data_size bytes of payload each (at most
+ * EVENT_BUS_ASYNC_DATA_MAX, 0 to pass NULL), and the callback runs in a
+ * worker task of its own at priority.
+ */
+typedef struct
+{
+  uint32_t queue_length;
+  uint32_t data_size;
+  uint32_t priority;
+  uint32_t stack_words;
+  event_bus_overflow_t overflow;
+  TickType_t wait_ticks; /* Used by EVENT_BUS_OVERFLOW_WAIT only. */
+} event_bus_async_config_t;
+
+/**
+ * Counters of an asynchronous subscriber.
+ */
+typedef struct
+{
+  uint32_t queued;       /* Events put in the queue. */
+  uint32_t dropped;      /* Events lost to the overflow policy. */
+  uint32_t delivered;    /* Callbacks run by the worker. */
+  uint32_t high_water;   /* Deepest the queue has been. */
+  uint32_t queue_length;
+} event_bus_async_stats_t;
+
 /**
  * Creates a new event bus instance supporting event IDs in [0, max_event_ids-1].
  * Returns handle or NULL on failure.
@@ -34,27 +95,93 @@ typedef void (*event_callback_t)(uint32_t event_id, void *event_data);
 event_bus_t event_bus_create(uint32_t max_event_ids);
 
 /**
- * Destroys an event bus instance and frees all associated memory.
- * No effect if bus is NULL.
+ * Destroys an event bus instance and frees all associated memory. Publishers
+ * must have stopped; an ISR worker is stopped after the publish it is running,
+ * and events still in its queue are discarded. No effect if bus is NULL.
  */
 void event_bus_destroy(event_bus_t bus);
 
 /**
  * Subscribes a callback to a specific event ID. Idempotent if already subscribed.
- * Returns true on success, false on invalid args or mutex failure.
+ * Publishes already in progress do not call it. Returns true on success, false
+ * on invalid args, mutex failure or out of memory.
  */
 bool event_bus_subscribe(event_bus_t bus, uint32_t event_id, event_callback_t callback);
 
 /**
- * Unsubscribes a callback from a specific event ID.
- * Returns true if removed, false if not found or invalid args.
+ * Subscribes a callback that runs in a worker task of its own, so a slow
+ * callback only delays itself: publishing copies the event into its queue and
+ * returns, waiting at most config->wait_ticks when the queue is full.
+ * Idempotent if already subscribed. Unsubscribing stops the worker and
+ * discards events still queued. Returns false on invalid args or config,
+ * mutex failure or out of memory.
+ */
+bool event_bus_subscribe_async(event_bus_t bus, uint32_t event_id, event_callback_t callback,
+                               const event_bus_async_config_t *config);
+
+/**
+ * Copies the counters of an asynchronous subscriber. Returns false if
+ * callback is not subscribed to event_id asynchronously.
+ */
+bool event_bus_get_async_stats(event_bus_t bus, uint32_t event_id, event_callback_t callback,
+                               event_bus_async_stats_t *stats);
+
+/**
+ * Unsubscribes a callback from a specific event ID, synchronous or
+ * asynchronous. Publishes already in progress may still call it once. Returns true if removed, false if not found,
+ * invalid args or out of memory.
  */
 bool event_bus_unsubscribe(event_bus_t bus, uint32_t event_id, event_callback_t callback);
 
 /**
  * Publishes an event to all subscribers of the given event ID.
- * Callbacks run in caller context. Returns true on success.
+ * Callbacks run in caller context, without the bus mutex held, so a slow
+ * callback does not block other publishers; asynchronous subscribers only get
+ * the event queued. Task context only.
+ * Returns true on success.
  */
 bool event_bus_publish(event_bus_t bus, uint32_t event_id, void *event_data);
 
+/**
+ * Same as event_bus_publish() for a payload of size bytes: asynchronous
+ * subscribers get at most size bytes copied, the rest of their data_size
+ * zeroed, and a remote event ID forwards at most size bytes. Synchronous
+ * callbacks still get event_data itself. Task context only.
+ */
+bool event_bus_publish_sized(event_bus_t bus, uint32_t event_id, void *event_data, uint32_t size);
+
+/**
+ * Starts the task that publishes events queued by event_bus_publish_from_isr(),
+ * with a queue of queue_length events. Callbacks of those events run in it.
+ * Returns true if started or already running.
+ */
+bool event_bus_start_isr_worker(event_bus_t bus, uint32_t queue_length, uint32_t stack_words, uint32_t priority);
+
+/**
+ * Publishes from an ISR: copies size bytes of event_data (at most
+ * EVENT_BUS_ISR_DATA_MAX) and queues the event for the worker. Subscribers get
+ * a pointer to the copy. Returns false on invalid args, if the worker is not
+ * started or if its queue is full.
+ */
+bool event_bus_publish_from_isr(event_bus_t bus, uint32_t event_id, const void *event_data, uint32_t size,
+                                BaseType_t *higher_priority_task_woken);
+
+/**
+ * Number of events event_bus_publish_from_isr() dropped for a full queue.
+ */
+uint32_t event_bus_get_isr_dropped(event_bus_t bus);
+
+/**
+ * Attaches a bridge (NULL detaches it). Remote event IDs that already have
+ * subscribers are announced to it. Returns false on invalid args.
+ */
+bool event_bus_set_bridge(event_bus_t bus, const event_bus_bridge_t *bridge);
+
+/**
+ * Marks event_id remote: its publishes are also handed to the bridge, which
+ * copies payload_size bytes of event_data. Turning it off reports 0
+ * subscribers to the bridge. Returns false on invalid args or out of memory.
+ */
+bool event_bus_set_remote(event_bus_t bus, uint32_t event_id, bool remote, uint32_t payload_size);
+
 #endif /* EVENT_BUS_H */
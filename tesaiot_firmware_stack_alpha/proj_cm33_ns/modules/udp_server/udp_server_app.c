@@ -36,6 +36,7 @@ static udp_server_callbacks_t s_udp_callbacks;
 static bool s_udp_initialized = false;
 static bool s_udp_server_started = false;
 static bool s_led_state_on = false;
+static udp_server_app_rx_notify_t s_rx_notify = NULL;
 
 /**
  * Prints IPv4 address in dotted decimal (ipv4 in host byte order).
@@ -85,6 +86,22 @@ static void on_udp_data(udp_server_t *server, const uint8_t *data, size_t length
   }
 }
 
+/**
+ * Socket context: a packet was queued; wakes whoever drains the queue.
+ */
+static void on_udp_rx_queued(udp_server_t *server, void *user_ctx)
+{
+  udp_server_app_rx_notify_t notify = s_rx_notify;
+
+  (void)server;
+  (void)user_ctx;
+
+  if (NULL != notify)
+  {
+    notify();
+  }
+}
+
 /**
  * Initializes UDP server config and lib. Call before start/process/send. Returns true on success.
  */
@@ -108,6 +125,7 @@ bool udp_server_app_init(void)
   s_udp_callbacks.on_peer_added = NULL;
   s_udp_callbacks.on_peer_evicted = NULL;
   s_udp_callbacks.on_error = NULL;
+  s_udp_callbacks.on_rx_queued = on_udp_rx_queued;
   s_udp_callbacks.user_ctx = NULL;
 
   if (CY_RSLT_SUCCESS != udp_server_lib_init(&s_udp_server, &s_udp_config, &s_udp_callbacks))
@@ -173,16 +191,26 @@ void udp_server_app_stop(void)
 }
 
 /**
- * Processes RX queue; invoke from main loop. No-op if not initialized.
+ * Sets the RX wake-up function. May be called before or after init.
  */
-void udp_server_app_process(void)
+void udp_server_app_set_rx_notify(udp_server_app_rx_notify_t notify)
+{
+  s_rx_notify = notify;
+}
+
+/**
+ * Processes up to UDP_SERVER_APP_PROCESS_MAX_PACKETS queued packets. Returns true if that many were
+ * processed (more may be queued). No-op returning false if not initialized.
+ */
+bool udp_server_app_process(void)
 {
   if (!s_udp_initialized)
   {
-    return;
+    return false;
   }
 
-  (void)udp_server_process(&s_udp_server, UDP_SERVER_APP_PROCESS_MAX_PACKETS);
+  return (UDP_SERVER_APP_PROCESS_MAX_PACKETS <=
+          udp_server_process(&s_udp_server, UDP_SERVER_APP_PROCESS_MAX_PACKETS));
 }
 
 /**
@@ -29,8 +29,17 @@ void udp_server_app_start(void);
 /** Stops server socket and clears peers. */
 void udp_server_app_stop(void);
 
-/** Processes RX queue; invoke from main loop. */
-void udp_server_app_process(void);
+/** Called from the socket receive context whenever a packet is queued for udp_server_app_process(). */
+typedef void (*udp_server_app_rx_notify_t)(void);
+
+/** Sets the function that wakes the task calling udp_server_app_process(). NULL clears it. */
+void udp_server_app_set_rx_notify(udp_server_app_rx_notify_t notify);
+
+/**
+ * Processes up to a fixed batch of queued RX packets. Returns true if the batch was used up, so more
+ * packets may still be queued and the caller should call again without waiting for a notify.
+ */
+bool udp_server_app_process(void);
 
 /** Sends data to last peer; no-op if no peer. */
 void udp_server_app_send(const uint8_t *data, size_t length);
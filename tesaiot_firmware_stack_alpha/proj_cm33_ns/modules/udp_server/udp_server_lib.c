@@ -191,6 +191,10 @@ static cy_rslt_t udp_server_recv_callback(cy_socket_t socket_handle, void *arg)
         server->callbacks.on_error(server, CY_RSLT_TYPE_ERROR, server->callbacks.user_ctx);
       }
     }
+    else if (server->callbacks.on_rx_queued != NULL)
+    {
+      server->callbacks.on_rx_queued(server, server->callbacks.user_ctx);
+    }
   }
 
   return result;
@@ -58,12 +58,15 @@ typedef void (*udp_server_on_peer_t)(udp_server_t *server, uint16_t peer_index,
 
 typedef void (*udp_server_on_error_t)(udp_server_t *server, cy_rslt_t result, void *user_ctx);
 
+typedef void (*udp_server_on_rx_queued_t)(udp_server_t *server, void *user_ctx);
+
 typedef struct
 {
   udp_server_on_data_t on_data;       /* Invoked when RX packet received. */
   udp_server_on_peer_t on_peer_added; /* Invoked when new peer added. */
   udp_server_on_peer_t on_peer_evicted; /* Invoked when LRU peer evicted. */
   udp_server_on_error_t on_error;     /* Invoked on recv or queue error. */
+  udp_server_on_rx_queued_t on_rx_queued; /* Invoked in socket context after a packet is queued; wake the processing task. */
   void *user_ctx;                     /* Passed to all callbacks. */
 } udp_server_callbacks_t;
 
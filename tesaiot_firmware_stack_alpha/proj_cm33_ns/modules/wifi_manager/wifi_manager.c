@@ -42,6 +42,7 @@ typedef enum
 typedef struct
 {
   wifi_manager_cmd_t cmd;
+  uint32_t call_id; /* Echoed in the event that completes the request; WIFI_MANAGER_CALL_NONE if unused. */
   ipc_wifi_scan_request_t scan_request;
   ipc_wifi_connect_request_t connect_request;
 } wifi_manager_msg_t;
@@ -56,6 +57,8 @@ typedef struct
   wifi_manager_event_cb_t callback;  /* Event callback. */
   void *callback_user_data;
   ipc_wifi_status_t status;          /* Current status. */
+  volatile uint32_t scan_call_id;    /* Call answered by the running scan's SCAN_COMPLETE. */
+  uint32_t connect_call_id;          /* Call answered when the pending connect succeeds or fails. */
   bool started;                      /* True if start() succeeded. */
 } wifi_manager_ctx_t;
 
@@ -64,23 +67,42 @@ static wifi_info_t s_last_scan[WIFI_MANAGER_LAST_SCAN_MAX];
 static uint32_t s_last_scan_count = 0U;
 
 /**
- * Invokes the registered event callback with event, data, count and user_data. No-op if no callback.
+ * Invokes the registered event callback with event, data, count, call_id and user_data. No-op if no callback.
  */
-static void wifi_manager_emit(wifi_manager_event_t event, const void *data, uint32_t count)
+static void wifi_manager_emit(wifi_manager_event_t event, const void *data, uint32_t count, uint32_t call_id)
 {
   if (NULL != s_ctx.callback)
   {
-    s_ctx.callback(event, data, count, s_ctx.callback_user_data);
+    s_ctx.callback(event, data, count, call_id, s_ctx.callback_user_data);
   }
 }
 
 /**
- * Updates status reason and emits WIFI_MANAGER_EVENT_STATUS.
+ * Updates status reason and emits WIFI_MANAGER_EVENT_STATUS as the answer to call_id.
  */
-static void wifi_manager_emit_status(ipc_wifi_reason_t reason)
+static void wifi_manager_reply_status(ipc_wifi_reason_t reason, uint32_t call_id)
 {
   s_ctx.status.reason = (uint16_t)reason;
-  wifi_manager_emit(WIFI_MANAGER_EVENT_STATUS, &s_ctx.status, 1U);
+  wifi_manager_emit(WIFI_MANAGER_EVENT_STATUS, &s_ctx.status, 1U, call_id);
+}
+
+/**
+ * Updates status reason and emits WIFI_MANAGER_EVENT_STATUS that answers no call.
+ */
+static void wifi_manager_emit_status(ipc_wifi_reason_t reason)
+{
+  wifi_manager_reply_status(reason, WIFI_MANAGER_CALL_NONE);
+}
+
+/**
+ * Emits status answering the pending connect call (if any) and clears it.
+ */
+static void wifi_manager_finish_connect(ipc_wifi_reason_t reason)
+{
+  uint32_t call_id = s_ctx.connect_call_id;
+
+  s_ctx.connect_call_id = WIFI_MANAGER_CALL_NONE;
+  wifi_manager_reply_status(reason, call_id);
 }
 
 /**
@@ -107,11 +129,14 @@ static void wifi_manager_update_rssi(void)
  */
 static void wifi_manager_scan_complete_cb(void *user_data, const wifi_info_t *results, uint32_t count)
 {
+  uint32_t call_id = s_ctx.scan_call_id;
+
   (void)user_data;
+  s_ctx.scan_call_id = WIFI_MANAGER_CALL_NONE;
 
   if ((NULL != results) && (count > 0U))
   {
-    wifi_manager_emit(WIFI_MANAGER_EVENT_SCAN_RESULT, results, count);
+    wifi_manager_emit(WIFI_MANAGER_EVENT_SCAN_RESULT, results, count, WIFI_MANAGER_CALL_NONE);
     {
       uint32_t copy_count = count;
       if (copy_count > WIFI_MANAGER_LAST_SCAN_MAX)
@@ -130,7 +155,7 @@ static void wifi_manager_scan_complete_cb(void *user_data, const wifi_info_t *re
   ipc_wifi_scan_complete_t scan_complete;
   scan_complete.total_count = (uint16_t)count;
   scan_complete.status = 0U;
-  wifi_manager_emit(WIFI_MANAGER_EVENT_SCAN_COMPLETE, &scan_complete, 1U);
+  wifi_manager_emit(WIFI_MANAGER_EVENT_SCAN_COMPLETE, &scan_complete, 1U, call_id);
 
   s_ctx.status.state = (uint8_t)IPC_WIFI_LINK_DISCONNECTED;
   s_ctx.status.rssi = -127;
@@ -173,9 +198,10 @@ static void wifi_manager_on_disconnected(wifi_connect_t *wifi, void *user_ctx)
 }
 
 /**
- * Lazily creates wifi_connect handle and registers callbacks. Returns true if ready.
+ * Lazily creates wifi_connect handle and registers callbacks. Returns true if ready; on failure
+ * emits CONNECT_FAILED status answering call_id.
  */
-static bool wifi_manager_ensure_connect_handle(void)
+static bool wifi_manager_ensure_connect_handle(uint32_t call_id)
 {
   if (NULL != s_ctx.wifi_connect)
   {
@@ -191,7 +217,7 @@ static bool wifi_manager_ensure_connect_handle(void)
   {
     s_ctx.status.state = (uint8_t)IPC_WIFI_LINK_ERROR;
     s_ctx.status.rssi = -127;
-    wifi_manager_emit_status(IPC_WIFI_REASON_CONNECT_FAILED);
+    wifi_manager_reply_status(IPC_WIFI_REASON_CONNECT_FAILED, call_id);
     return false;
   }
 
@@ -199,13 +225,14 @@ static bool wifi_manager_ensure_connect_handle(void)
 }
 
 /**
- * Handles scan command: starts scanner if disconnected; emits status.
+ * Handles scan command: starts scanner if disconnected; emits status. call_id is answered by
+ * SCAN_COMPLETE, or by the status reporting why the scan did not run.
  */
-static void wifi_manager_handle_scan(const ipc_wifi_scan_request_t *request)
+static void wifi_manager_handle_scan(const ipc_wifi_scan_request_t *request, uint32_t call_id)
 {
   if (IPC_WIFI_LINK_DISCONNECTED != (ipc_wifi_link_state_t)s_ctx.status.state)
   {
-    wifi_manager_emit_status(IPC_WIFI_REASON_SCAN_BLOCKED_CONNECTED);
+    wifi_manager_reply_status(IPC_WIFI_REASON_SCAN_BLOCKED_CONNECTED, call_id);
     return;
   }
 
@@ -218,25 +245,33 @@ static void wifi_manager_handle_scan(const ipc_wifi_scan_request_t *request)
   s_ctx.status.rssi = -127;
   wifi_manager_emit_status(IPC_WIFI_REASON_NONE);
 
+  s_ctx.scan_call_id = call_id;
   if (false == wifi_scanner_scan(request->use_filter ? (wifi_filter_config_t *)&request->filter : NULL))
   {
+    s_ctx.scan_call_id = WIFI_MANAGER_CALL_NONE;
     s_ctx.status.state = (uint8_t)IPC_WIFI_LINK_ERROR;
     s_ctx.status.rssi = -127;
-    wifi_manager_emit_status(IPC_WIFI_REASON_SCAN_FAILED);
+    wifi_manager_reply_status(IPC_WIFI_REASON_SCAN_FAILED, call_id);
   }
 }
 
 /**
- * Handles connect command: ensures connect handle, starts wifi_connect with request params.
+ * Handles connect command: ensures connect handle, starts wifi_connect with request params. A connect
+ * call still pending is answered first with the current (not connected) status.
  */
-static void wifi_manager_handle_connect(const ipc_wifi_connect_request_t *request)
+static void wifi_manager_handle_connect(const ipc_wifi_connect_request_t *request, uint32_t call_id)
 {
   if (NULL == request)
   {
     return;
   }
 
-  if (false == wifi_manager_ensure_connect_handle())
+  if (WIFI_MANAGER_CALL_NONE != s_ctx.connect_call_id)
+  {
+    wifi_manager_finish_connect(IPC_WIFI_REASON_NONE);
+  }
+
+  if (false == wifi_manager_ensure_connect_handle(call_id))
   {
     return;
   }
@@ -260,18 +295,20 @@ static void wifi_manager_handle_connect(const ipc_wifi_connect_request_t *reques
   s_ctx.status.ssid[sizeof(s_ctx.status.ssid) - 1U] = '\0';
   wifi_manager_emit_status(IPC_WIFI_REASON_NONE);
 
+  s_ctx.connect_call_id = call_id;
   if (CY_RSLT_SUCCESS != wifi_connect_start(s_ctx.wifi_connect, &params))
   {
     s_ctx.status.state = (uint8_t)IPC_WIFI_LINK_ERROR;
     s_ctx.status.rssi = -127;
-    wifi_manager_emit_status(IPC_WIFI_REASON_CONNECT_FAILED);
+    wifi_manager_finish_connect(IPC_WIFI_REASON_CONNECT_FAILED);
   }
 }
 
 /**
- * Handles disconnect command: stops wifi_connect and emits DISCONNECTED status.
+ * Handles disconnect command: stops wifi_connect and emits DISCONNECTED status answering call_id
+ * (after answering a pending connect call with it).
  */
-static void wifi_manager_handle_disconnect(void)
+static void wifi_manager_handle_disconnect(uint32_t call_id)
 {
   if (NULL != s_ctx.wifi_connect)
   {
@@ -279,7 +316,11 @@ static void wifi_manager_handle_disconnect(void)
   }
   s_ctx.status.state = (uint8_t)IPC_WIFI_LINK_DISCONNECTED;
   s_ctx.status.rssi = -127;
-  wifi_manager_emit_status(IPC_WIFI_REASON_DISCONNECTED);
+  if (WIFI_MANAGER_CALL_NONE != s_ctx.connect_call_id)
+  {
+    wifi_manager_finish_connect(IPC_WIFI_REASON_DISCONNECTED);
+  }
+  wifi_manager_reply_status(IPC_WIFI_REASON_DISCONNECTED, call_id);
 }
 
 /**
@@ -298,21 +339,21 @@ static void wifi_manager_task(void *arg)
       switch (msg.cmd)
       {
       case WIFI_MANAGER_CMD_SCAN:
-        wifi_manager_handle_scan(&msg.scan_request);
+        wifi_manager_handle_scan(&msg.scan_request, msg.call_id);
         break;
       case WIFI_MANAGER_CMD_CONNECT:
-        wifi_manager_handle_connect(&msg.connect_request);
+        wifi_manager_handle_connect(&msg.connect_request, msg.call_id);
         break;
       case WIFI_MANAGER_CMD_DISCONNECT:
-        wifi_manager_handle_disconnect();
+        wifi_manager_handle_disconnect(msg.call_id);
         break;
       case WIFI_MANAGER_CMD_STATUS:
-        wifi_manager_emit_status(IPC_WIFI_REASON_NONE);
+        wifi_manager_reply_status(IPC_WIFI_REASON_NONE, msg.call_id);
         break;
       case WIFI_MANAGER_CMD_CONNECTED:
         s_ctx.status.state = (uint8_t)IPC_WIFI_LINK_CONNECTED;
         wifi_manager_update_rssi();
-        wifi_manager_emit_status(IPC_WIFI_REASON_NONE);
+        wifi_manager_finish_connect(IPC_WIFI_REASON_NONE);
         break;
       case WIFI_MANAGER_CMD_DISCONNECTED:
         s_ctx.status.state = (uint8_t)IPC_WIFI_LINK_DISCONNECTED;
@@ -395,74 +436,88 @@ bool wifi_manager_set_event_callback(wifi_manager_event_cb_t callback, void *use
   return true;
 }
 
+/**
+ * Queues msg for the manager task. If it cannot be queued and msg->call_id is set, answers the call
+ * with the current status and IPC_WIFI_REASON_BUSY from the caller's context. Returns true if queued.
+ */
+static bool wifi_manager_queue(const wifi_manager_msg_t *msg)
+{
+  if ((NULL != s_ctx.queue) && (pdPASS == xQueueSend(s_ctx.queue, msg, 0U)))
+  {
+    return true;
+  }
+
+  if (WIFI_MANAGER_CALL_NONE != msg->call_id)
+  {
+    ipc_wifi_status_t busy = s_ctx.status;
+    busy.reason = (uint16_t)IPC_WIFI_REASON_BUSY;
+    wifi_manager_emit(WIFI_MANAGER_EVENT_STATUS, &busy, 1U, msg->call_id);
+  }
+  return false;
+}
+
 /**
  * Queues scan request. Fails if queue NULL or request NULL. Returns true if queued.
  */
-bool wifi_manager_request_scan(const ipc_wifi_scan_request_t *request)
+bool wifi_manager_request_scan(const ipc_wifi_scan_request_t *request, uint32_t call_id)
 {
   wifi_manager_msg_t msg;
 
-  if ((NULL == s_ctx.queue) || (NULL == request))
+  if (NULL == request)
   {
     return false;
   }
 
   (void)memset(&msg, 0, sizeof(msg));
   msg.cmd = WIFI_MANAGER_CMD_SCAN;
+  msg.call_id = call_id;
   msg.scan_request = *request;
-  return (pdPASS == xQueueSend(s_ctx.queue, &msg, 0U));
+  return wifi_manager_queue(&msg);
 }
 
 /**
  * Queues connect request. Returns true if queued.
  */
-bool wifi_manager_request_connect(const ipc_wifi_connect_request_t *request)
+bool wifi_manager_request_connect(const ipc_wifi_connect_request_t *request, uint32_t call_id)
 {
   wifi_manager_msg_t msg;
 
-  if ((NULL == s_ctx.queue) || (NULL == request))
+  if (NULL == request)
   {
     return false;
   }
 
   (void)memset(&msg, 0, sizeof(msg));
   msg.cmd = WIFI_MANAGER_CMD_CONNECT;
+  msg.call_id = call_id;
   msg.connect_request = *request;
-  return (pdPASS == xQueueSend(s_ctx.queue, &msg, 0U));
+  return wifi_manager_queue(&msg);
 }
 
 /**
  * Queues disconnect request. Returns true if queued.
  */
-bool wifi_manager_request_disconnect(void)
+bool wifi_manager_request_disconnect(uint32_t call_id)
 {
   wifi_manager_msg_t msg;
 
-  if (NULL == s_ctx.queue)
-  {
-    return false;
-  }
-
   (void)memset(&msg, 0, sizeof(msg));
   msg.cmd = WIFI_MANAGER_CMD_DISCONNECT;
-  return (pdPASS == xQueueSend(s_ctx.queue, &msg, 0U));
+  msg.call_id = call_id;
+  return wifi_manager_queue(&msg);
 }
 
 /**
  * Queues status request; callback will receive current status. Returns true if queued.
  */
-bool wifi_manager_request_status(void)
+bool wifi_manager_request_status(uint32_t call_id)
 {
   wifi_manager_msg_t msg;
 
-  if (NULL == s_ctx.queue)
-  {
-    return false;
-  }
-
   (void)memset(&msg, 0, sizeof(msg));
   msg.cmd = WIFI_MANAGER_CMD_STATUS;
-  return (pdPASS == xQueueSend(s_ctx.queue, &msg, 0U));
+  msg.call_id = call_id;
+  return wifi_manager_queue(&msg);
 }
 
 /**
@@ -26,7 +26,14 @@ typedef enum
   WIFI_MANAGER_EVENT_STATUS = 2U         /* data = ipc_wifi_status_t. */
 } wifi_manager_event_t;
 
-typedef void (*wifi_manager_event_cb_t)(wifi_manager_event_t event, const void *data, uint32_t count, void *user_data);
+#define WIFI_MANAGER_CALL_NONE (IPC_CALL_ID_NONE) /* call_id for requests nobody waits on */
+
+/**
+ * Event callback. call_id is the ID passed with the request this event answers (at most one event
+ * per request: SCAN_COMPLETE for a scan that ran, otherwise STATUS), or WIFI_MANAGER_CALL_NONE.
+ */
+typedef void (*wifi_manager_event_cb_t)(wifi_manager_event_t event, const void *data, uint32_t count, uint32_t call_id,
+                                        void *user_data);
 
 /** Initializes internal state. Call before start. Returns true. */
 bool wifi_manager_init(void);
@@ -37,17 +44,23 @@ bool wifi_manager_start(void);
 /** Registers event callback and user_data. Replaces previous. Returns true. */
 bool wifi_manager_set_event_callback(wifi_manager_event_cb_t callback, void *user_data);
 
-/** Queues scan request. Fails if connected. Returns true if queued. */
-bool wifi_manager_request_scan(const ipc_wifi_scan_request_t *request);
+/*
+ * Request functions take a call_id (WIFI_MANAGER_CALL_NONE if unused). A non-zero call_id is echoed
+ * in the event that completes the request; if the request cannot be queued, a STATUS event with
+ * IPC_WIFI_REASON_BUSY is emitted for it from the caller's context before returning false.
+ */
+
+/** Queues scan request. Completes with SCAN_COMPLETE, or STATUS if refused (not disconnected) or failed. Returns true if queued. */
+bool wifi_manager_request_scan(const ipc_wifi_scan_request_t *request, uint32_t call_id);
 
-/** Queues connect request. Returns true if queued. */
-bool wifi_manager_request_connect(const ipc_wifi_connect_request_t *request);
+/** Queues connect request. Completes with the STATUS that reports CONNECTED or the failure. Returns true if queued. */
+bool wifi_manager_request_connect(const ipc_wifi_connect_request_t *request, uint32_t call_id);
 
-/** Queues disconnect request. Returns true if queued. */
-bool wifi_manager_request_disconnect(void);
+/** Queues disconnect request. Completes with the DISCONNECTED STATUS. Returns true if queued. */
+bool wifi_manager_request_disconnect(uint32_t call_id);
 
 /** Queues status request; callback receives current status. Returns true if queued. */
-bool wifi_manager_request_status(void);
+bool wifi_manager_request_status(uint32_t call_id);
 
 /** Copies last scan results into out (up to max_count). Sets *out_count. Returns true if *out_count > 0. */
 bool wifi_manager_get_last_scan(wifi_info_t *out, uint32_t max_count, uint32_t *out_count);
@@ -12,6 +12,7 @@
  *******************************************************************************/
 
 #include "cm55_fatal_error.h"
+#include "cm55_ipc_pipe.h"
 #include "cy_pdl.h"
 #include "cybsp.h"
 #include <stdarg.h>
@@ -22,14 +23,17 @@
  *******************************************************************************/
 
 /**
- * Fatal error handler: disables IRQ, asserts, prints formatted message to
- * stdout (printf-style), then blinks user LED in an infinite loop. Does not
- * return. format may be NULL for a generic message.
+ * Fatal error handler: marks the CM55 liveness record faulted, prints formatted
+ * message to stdout (printf-style), disables IRQ, then blinks user LED in an
+ * infinite loop. Does not return. format may be NULL for a generic message.
  */
 void cm55_handle_fatal_error(const char *format, ...)
 {
   va_list args;
 
+  /* CM33 sees the fault in the shared liveness record even if the message below never gets out. */
+  cm55_ipc_pipe_set_fault();
+
   /* Print the error first so it is visible before UART may stop (IRQ off). */
   (void)printf("\n[CM55 ERROR] ");
   if (NULL != format)
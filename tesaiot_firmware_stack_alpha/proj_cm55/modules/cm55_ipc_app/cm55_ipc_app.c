@@ -1,9 +1,18 @@
 #include "cm55_ipc_app.h"
 #include "cm55_ipc_pipe.h"
+#include "cm55_stdout_ipc.h"
 
+#include "ipc_blackboard.h"
+#include "ipc_cmd.h"
 #include "ipc_communication.h"
+#include "ipc_crc.h"
+#include "ipc_event_bridge.h"
+#include "ipc_ring.h"
+#include "ipc_stats.h"
 #include "queue.h"
+#include "semphr.h"
 #include "task.h"
+#include "tesa_event_bus.h"
 #include "user_buttons_types.h"
 #if defined(TOUCH_VIA_IPC)
 #include "lv_port_indev.h"
@@ -21,14 +30,43 @@
 #define CM55_IPC_PIPE_WIFI_LIST_MAX (32U)
 #define CM55_WIFI_DEBUG_LINE_MAX (96U)
 #define CM55_WIFI_DEBUG_LINE_COUNT (48U)
+#define CM55_WIFI_ACK_RETRY_MS (10U) /* Retry period of a scan ack the control lane refused */
+#define APP_WORK_WIFI_BULK (0x80U) /* Internal work item: bulk scan list to verify and acknowledge */
+#define APP_WORK_CALL (0x81U)      /* Internal work item: call started, recompute the next call timeout */
+#define APP_WORK_EVENT_BATCH (0x82U)       /* Internal work item: CM33 event batch to deliver, value = buffer */
+#define APP_WORK_EVENT_ACK (0x83U)         /* Internal work item: CM33 released a batch buffer, value = buffer */
+#define APP_WORK_EVENT_SUBSCRIBE (0x84U)   /* Internal work item: CM33 subscribed, value = channel */
+#define APP_WORK_EVENT_UNSUBSCRIBE (0x85U) /* Internal work item: CM33 unsubscribed, value = channel */
 
 typedef struct
 {
   uint8_t event_type;
-  uint8_t reserved;
+  uint8_t cmd; /* IPC command that produced the item, 0 for internal items */
   uint16_t value;
+  uint32_t call_id; /* Call the event answers, IPC_CALL_ID_NONE if unsolicited */
+  uint32_t rx_us;   /* Receive time on the shared timebase, for the dispatch latency */
 } ipc_work_item_t;
 
+typedef enum
+{
+  APP_CALL_FREE = 0U,
+  APP_CALL_PENDING,  /* Request sent, waiting for CM33 */
+  APP_CALL_ANSWERED, /* Answer staged by the ISR, completed by the receiver task after dispatch */
+  APP_CALL_DONE      /* Completed, waiting for cm55_call_wait() */
+} app_call_state_t;
+
+typedef struct
+{
+  volatile app_call_state_t state;
+  uint32_t call_id;
+  TickType_t start;
+  TickType_t timeout;
+  cm55_ipc_call_cb_t cb; /* NULL: answer kept for cm55_call_wait() */
+  void *user_data;
+  SemaphoreHandle_t done; /* Given when a waitable call completes */
+  cm55_ipc_call_reply_t reply;
+} app_call_t;
+
 typedef struct
 {
   char buf[IPC_DATA_MAX_LEN];
@@ -39,16 +77,16 @@ static QueueHandle_t s_log_queue = NULL;
 static bool s_draining_log = false;
 static char s_log_text_buf[IPC_DATA_MAX_LEN];
 
-static wifi_info_t s_wifi_list[CM55_IPC_PIPE_WIFI_LIST_MAX];
+static wifi_info_t s_wifi_lists[2][CM55_IPC_PIPE_WIFI_LIST_MAX];
+static wifi_info_t *volatile s_wifi_list = s_wifi_lists[0];
 static volatile uint32_t s_wifi_list_count = 0U;
+static ipc_wifi_scan_bulk_t s_wifi_bulk;
+static volatile bool s_wifi_bulk_bench = false;
+static ipc_wifi_scan_ack_t s_wifi_ack;     /* Receiver task: ack of the last bulk transfer */
+static bool s_wifi_ack_pending = false;    /* s_wifi_ack still to send; CM33 holds its scan buffer until then */
 static volatile bool s_wifi_list_ready = false;
-static ipc_wifi_status_t s_wifi_status;
-
-static gyro_data_t s_gyro_data;
-static volatile uint32_t s_gyro_sequence = 0U;
-
-static volatile uint32_t s_btn_press_count[BUTTON_ID_MAX];
-static volatile bool s_btn_is_pressed[BUTTON_ID_MAX];
+static ipc_wifi_status_t s_wifi_status; /* Receiver task: blackboard snapshot behind the last status event */
+static ipc_imu_sample_t s_gyro_sample;  /* Receiver task: blackboard snapshot behind the last gyro event */
 static char s_wifi_debug_lines[CM55_WIFI_DEBUG_LINE_COUNT][CM55_WIFI_DEBUG_LINE_MAX];
 static uint32_t s_wifi_debug_head = 0U;
 static uint32_t s_wifi_debug_count = 0U;
@@ -57,6 +95,57 @@ static volatile uint32_t s_wifi_debug_sequence = 0U;
 static ipc_wifi_status_t s_wifi_status_last_printed;
 static bool s_wifi_status_printed_once = false;
 
+static app_call_t s_calls[CM55_IPC_CALL_MAX];
+#if (0 != IPC_EVENT_BRIDGE_ENABLE)
+CY_SECTION_SHAREDMEM CY_ALIGN(IPC_RING_CACHE_LINE) static ipc_event_bridge_buffers_t cm55_bridge_buffers;
+static ipc_event_batch_t s_event_batches[IPC_EVENT_BRIDGE_BUFFERS]; /* Staged by the ISR, by CM33 buffer */
+static ipc_event_batch_ack_t s_event_acks[IPC_EVENT_BRIDGE_BUFFERS];
+#endif
+static uint32_t s_call_last_id = IPC_CALL_ID_NONE;
+
+/**
+ * Status reported before CM33 has published one: link down, no signal.
+ */
+static void app_wifi_status_default(ipc_wifi_status_t *status)
+{
+  (void)memset(status, 0, sizeof(*status));
+  status->state = (uint8_t)IPC_WIFI_LINK_DISCONNECTED;
+  status->rssi = -127;
+  status->reason = (uint16_t)IPC_WIFI_REASON_NONE;
+}
+
+/**
+ * Latest Wi-Fi status from the CM33 blackboard, the default until CM33 has published one. Returns
+ * false only if the slot was being rewritten on every attempt.
+ */
+static bool app_read_wifi_status(ipc_wifi_status_t *status)
+{
+  const ipc_blackboard_t *board = cm55_ipc_pipe_get_blackboard();
+
+  if (0U == ipc_blackboard_version(board, IPC_BLACKBOARD_WIFI_STATUS))
+  {
+    app_wifi_status_default(status);
+    return true;
+  }
+  return ipc_blackboard_read(board, IPC_BLACKBOARD_WIFI_STATUS, status, sizeof(*status), NULL, NULL);
+}
+
+/**
+ * Latest button state from the CM33 blackboard, all released and uncounted until the first button
+ * event. Returns false only if the slot was being rewritten on every attempt.
+ */
+static bool app_read_buttons(ipc_button_state_t *buttons)
+{
+  const ipc_blackboard_t *board = cm55_ipc_pipe_get_blackboard();
+
+  if (0U == ipc_blackboard_version(board, IPC_BLACKBOARD_BUTTONS))
+  {
+    (void)memset(buttons, 0, sizeof(*buttons));
+    return true;
+  }
+  return ipc_blackboard_read(board, IPC_BLACKBOARD_BUTTONS, buttons, sizeof(*buttons), NULL, NULL);
+}
+
 static void app_wifi_debug_append(const char *tag, const char *text)
 {
   char line[CM55_WIFI_DEBUG_LINE_MAX];
@@ -84,16 +173,269 @@ static void app_wifi_debug_append(const char *tag, const char *text)
   s_wifi_debug_sequence++;
 }
 
-static void app_push_work_item_from_isr(uint8_t event_type, uint16_t value, BaseType_t *pxHigherPriorityTaskWoken)
+static void app_push_work_item_from_isr(uint8_t event_type, uint32_t cmd, uint16_t value, uint32_t call_id,
+                                        BaseType_t *pxHigherPriorityTaskWoken)
 {
   if (NULL != s_ipc_work_queue)
   {
     ipc_work_item_t work_item;
     work_item.event_type = event_type;
-    work_item.reserved = 0U;
+    work_item.cmd = (uint8_t)cmd;
     work_item.value = value;
-    (void)xQueueSendFromISR(s_ipc_work_queue, &work_item, pxHigherPriorityTaskWoken);
+    work_item.call_id = call_id;
+    work_item.rx_us = ipc_stats_now_us();
+    if (pdPASS != xQueueSendFromISR(s_ipc_work_queue, &work_item, pxHigherPriorityTaskWoken))
+    {
+      ipc_stats_on_overflow(cmd);
+    }
+  }
+}
+
+static app_call_t *app_call_find(uint32_t call_id, app_call_state_t state)
+{
+  for (uint32_t i = 0U; i < CM55_IPC_CALL_MAX; i++)
+  {
+    if ((state == s_calls[i].state) && (call_id == s_calls[i].call_id))
+    {
+      return &s_calls[i];
+    }
+  }
+  return NULL;
+}
+
+/**
+ * Result of a call answered by event cmd: a scan completion always succeeds; a status answer is
+ * judged against what the request asked for.
+ */
+static cm55_ipc_call_result_t app_call_result(uint32_t request, uint32_t cmd, const ipc_wifi_status_t *status)
+{
+  if (IPC_EVT_WIFI_SCAN_COMPLETE == cmd)
+  {
+    return CM55_IPC_CALL_OK;
+  }
+  if ((uint16_t)IPC_WIFI_REASON_BUSY == status->reason)
+  {
+    return CM55_IPC_CALL_BUSY;
+  }
+  switch (request)
+  {
+  case IPC_CMD_WIFI_SCAN_REQ:
+    return CM55_IPC_CALL_FAILED; /* Answered by status: the scan was refused or failed */
+  case IPC_CMD_WIFI_CONNECT_REQ:
+    return ((uint8_t)IPC_WIFI_LINK_CONNECTED == status->state) ? CM55_IPC_CALL_OK : CM55_IPC_CALL_FAILED;
+  case IPC_CMD_WIFI_DISCONNECT_REQ:
+    return ((uint8_t)IPC_WIFI_LINK_DISCONNECTED == status->state) ? CM55_IPC_CALL_OK : CM55_IPC_CALL_FAILED;
+  default:
+    return CM55_IPC_CALL_OK;
+  }
+}
+
+/**
+ * ISR side of an answer: stages the result and status in the pending call (if it has not timed out
+ * or been cancelled) so a later status event cannot change what this call sees. The receiver task
+ * completes it after dispatching the event, so a scan's list is published first.
+ */
+static void app_call_answer_from_isr(uint32_t call_id, uint32_t cmd, const ipc_wifi_status_t *status)
+{
+  UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+  app_call_t *call = app_call_find(call_id, APP_CALL_PENDING);
+
+  if (NULL != call)
+  {
+    if (NULL != status)
+    {
+      call->reply.status = *status;
+    }
+    call->reply.result = app_call_result(call->reply.request, cmd, &call->reply.status);
+    call->state = APP_CALL_ANSWERED;
+  }
+  taskEXIT_CRITICAL_FROM_ISR(saved);
+}
+
+/**
+ * Hands an ANSWERED call to its owner: frees it and runs the callback, or parks the answer for
+ * cm55_call_wait(). Receiver task only. Does nothing if the call was cancelled meanwhile.
+ */
+static void app_call_deliver(app_call_t *call)
+{
+  cm55_ipc_call_reply_t reply;
+  cm55_ipc_call_cb_t cb;
+  void *user_data;
+  bool owned;
+  char line[CM55_WIFI_DEBUG_LINE_MAX];
+
+  taskENTER_CRITICAL();
+  owned = (APP_CALL_ANSWERED == call->state);
+  reply = call->reply;
+  cb = call->cb;
+  user_data = call->user_data;
+  if (owned)
+  {
+    call->state = (NULL == cb) ? APP_CALL_DONE : APP_CALL_FREE;
+  }
+  taskEXIT_CRITICAL();
+
+  if (!owned)
+  {
+    return;
+  }
+
+  (void)snprintf(line, sizeof(line), "call %lu req=0x%02lX result=%u", (unsigned long)reply.call_id,
+                 (unsigned long)reply.request, (unsigned int)reply.result);
+  app_wifi_debug_append("RPC", line);
+
+  if (NULL != cb)
+  {
+    cb(&reply, user_data);
+  }
+  else
+  {
+    (void)xSemaphoreGive(call->done);
+  }
+}
+
+/**
+ * Completes the call answered by the work item just dispatched. Scan completions carry the list
+ * that was published for them.
+ */
+static void app_call_finish(uint32_t call_id)
+{
+  app_call_t *call = app_call_find(call_id, APP_CALL_ANSWERED);
+
+  if (NULL == call)
+  {
+    return; /* Timed out or cancelled before the answer arrived */
+  }
+  if ((IPC_CMD_WIFI_SCAN_REQ == call->reply.request) && (CM55_IPC_CALL_OK == call->reply.result))
+  {
+    (void)app_read_wifi_status(&call->reply.status);
+    call->reply.list = s_wifi_list;
+    call->reply.count = s_wifi_list_count;
+  }
+  app_call_deliver(call);
+}
+
+/**
+ * Completes pending calls whose timeout has passed with CM55_IPC_CALL_TIMEOUT.
+ */
+static void app_call_expire(void)
+{
+  TickType_t now = xTaskGetTickCount();
+
+  for (uint32_t i = 0U; i < CM55_IPC_CALL_MAX; i++)
+  {
+    app_call_t *call = &s_calls[i];
+    bool expired = false;
+
+    taskENTER_CRITICAL();
+    if ((APP_CALL_PENDING == call->state) && ((TickType_t)(now - call->start) >= call->timeout))
+    {
+      call->state = APP_CALL_ANSWERED;
+      call->reply.result = CM55_IPC_CALL_TIMEOUT;
+      expired = true;
+    }
+    taskEXIT_CRITICAL();
+
+    if (expired)
+    {
+      (void)app_read_wifi_status(&call->reply.status);
+      app_call_deliver(call);
+    }
+  }
+}
+
+/**
+ * Ticks until the earliest pending call times out or a refused scan ack is retried, portMAX_DELAY
+ * if neither is pending.
+ */
+static TickType_t app_call_wait_ticks(void)
+{
+  TickType_t now = xTaskGetTickCount();
+  TickType_t wait = s_wifi_ack_pending ? pdMS_TO_TICKS(CM55_WIFI_ACK_RETRY_MS) : portMAX_DELAY;
+
+  for (uint32_t i = 0U; i < CM55_IPC_CALL_MAX; i++)
+  {
+    if (APP_CALL_PENDING == s_calls[i].state)
+    {
+      TickType_t elapsed = (TickType_t)(now - s_calls[i].start);
+      TickType_t left = (elapsed >= s_calls[i].timeout) ? 0U : (s_calls[i].timeout - elapsed);
+      if (left < wait)
+      {
+        wait = left;
+      }
+    }
   }
+  return wait;
+}
+
+/**
+ * Claims a call, sends request with its ID and wakes the receiver task so it accounts the new
+ * timeout. Returns the call ID or IPC_CALL_ID_NONE.
+ */
+static uint32_t app_call_start(uint32_t request, const void *data, uint32_t data_len, uint32_t timeout_ms,
+                               cm55_ipc_call_cb_t cb, void *user_data)
+{
+  app_call_t *call = NULL;
+  uint32_t call_id = IPC_CALL_ID_NONE;
+  ipc_work_item_t work_item;
+
+  if (NULL == s_ipc_work_queue)
+  {
+    return IPC_CALL_ID_NONE;
+  }
+  if (0U == timeout_ms)
+  {
+    timeout_ms = CM55_IPC_CALL_TIMEOUT_MS_DEFAULT;
+  }
+
+  taskENTER_CRITICAL();
+  for (uint32_t i = 0U; i < CM55_IPC_CALL_MAX; i++)
+  {
+    if (APP_CALL_FREE == s_calls[i].state)
+    {
+      call = &s_calls[i];
+      break;
+    }
+  }
+  if (NULL != call)
+  {
+    s_call_last_id++;
+    if (IPC_CALL_ID_NONE == s_call_last_id)
+    {
+      s_call_last_id++;
+    }
+    call_id = s_call_last_id;
+    call->call_id = call_id;
+    call->start = xTaskGetTickCount();
+    call->timeout = pdMS_TO_TICKS(timeout_ms);
+    call->cb = cb;
+    call->user_data = user_data;
+    (void)memset(&call->reply, 0, sizeof(call->reply));
+    call->reply.call_id = call_id;
+    call->reply.request = request;
+    call->state = APP_CALL_PENDING;
+  }
+  taskEXIT_CRITICAL();
+
+  if (NULL == call)
+  {
+    return IPC_CALL_ID_NONE;
+  }
+  if (false == cm55_ipc_pipe_push_call(request, call_id, data, data_len))
+  {
+    taskENTER_CRITICAL();
+    call->state = APP_CALL_FREE;
+    taskEXIT_CRITICAL();
+    return IPC_CALL_ID_NONE;
+  }
+
+  work_item.event_type = APP_WORK_CALL;
+  work_item.cmd = 0U;
+  work_item.rx_us = 0U;
+  work_item.value = 0U;
+  work_item.call_id = IPC_CALL_ID_NONE;
+  (void)xQueueSend(s_ipc_work_queue, &work_item, 0U);
+  return call_id;
 }
 
 static bool app_log_push_from_isr(const char *data, uint32_t data_len, BaseType_t *pxHigherPriorityTaskWoken)
@@ -113,15 +455,136 @@ static bool app_log_push_from_isr(const char *data, uint32_t data_len, BaseType_
   return (pdPASS == xQueueSendFromISR(s_log_queue, &log_item, pxHigherPriorityTaskWoken));
 }
 
-static bool app_receive_next(cm55_ipc_event_t *event, cm55_ipc_event_payload_t *payload, TickType_t timeout_ticks)
+/**
+ * Sends the pending scan ack (receiver task). If the lane refuses it, it stays pending and the
+ * receiver task retries every CM55_WIFI_ACK_RETRY_MS: CM33 cannot send another list until it arrives.
+ */
+static void app_wifi_ack_send(void)
+{
+  if (s_wifi_ack_pending && cm55_ipc_pipe_push_request(IPC_CMD_WIFI_SCAN_ACK, &s_wifi_ack, sizeof(s_wifi_ack)))
+  {
+    s_wifi_ack_pending = false;
+  }
+}
+
+/**
+ * Receives the bulk scan list announced by CM33: copies it out of the CM33 scan buffer into the
+ * unpublished list buffer, checks the CRC over the copy (so a list torn by a late CM33 overwrite is
+ * caught), then publishes it by swapping buffers and releases the CM33 buffer with an ack. Benchmark
+ * transfers are verified and acknowledged but never published.
+ */
+static void app_wifi_bulk_receive(void)
+{
+  ipc_wifi_scan_bulk_t bulk = s_wifi_bulk;
+  ipc_wifi_scan_ack_t ack;
+  wifi_info_t *staging = (s_wifi_list == s_wifi_lists[0]) ? s_wifi_lists[1] : s_wifi_lists[0];
+  uint32_t bytes = (uint32_t)bulk.count * (uint32_t)sizeof(wifi_info_t);
+
+  ack.transfer_id = bulk.transfer_id;
+  ack.status = IPC_WIFI_SCAN_ACK_CRC_ERROR;
+  if ((NULL != bulk.list) && (bulk.count <= CM55_IPC_PIPE_WIFI_LIST_MAX))
+  {
+    (void)memcpy(staging, bulk.list, bytes);
+    if (ipc_crc32(staging, bytes) == bulk.crc32)
+    {
+      ack.status = IPC_WIFI_SCAN_ACK_OK;
+    }
+  }
+
+  if ((IPC_WIFI_SCAN_ACK_OK == ack.status) && (!s_wifi_bulk_bench))
+  {
+    s_wifi_list_count = 0U;
+    s_wifi_list = staging;
+    s_wifi_list_count = bulk.count;
+  }
+  else if (IPC_WIFI_SCAN_ACK_OK != ack.status)
+  {
+    app_wifi_debug_append("SCAN", "bulk crc error");
+  }
+  s_wifi_ack = ack;
+  s_wifi_ack_pending = true;
+  app_wifi_ack_send();
+}
+
+#if (0 != IPC_EVENT_BRIDGE_ENABLE)
+/**
+ * Event bridge frames must not stall the timer task; the bridge retries what the lane refuses.
+ */
+static bool app_bridge_send(uint32_t cmd, const void *data, uint32_t len)
+{
+  return cm55_ipc_pipe_try_push_request(cmd, data, len);
+}
+
+/**
+ * Posts an event from CM33 on tesa_event_bus (receiver task). A channel with some full queues still
+ * counts as delivered.
+ */
+static bool app_bridge_deliver(uint16_t channel_id, uint32_t event_type, const void *payload, uint32_t len)
+{
+  tesa_event_bus_result_t result = tesa_event_bus_post(channel_id, event_type, payload, len);
+
+  return (TESA_EVENT_BUS_SUCCESS == result) || (TESA_EVENT_BUS_ERROR_PARTIAL_SUCCESS == result);
+}
+
+static bool app_bridge_forward(tesa_event_channel_id_t channel_id, tesa_event_type_t event_type, const void *payload,
+                               size_t payload_size, bool from_isr)
+{
+  return ipc_event_bridge_forward(channel_id, event_type, payload, (uint32_t)payload_size, from_isr);
+}
+
+static void app_bridge_subscribers_changed(tesa_event_channel_id_t channel_id, uint8_t subscriber_count)
+{
+  (void)ipc_event_bridge_set_interest(channel_id, 0U < subscriber_count);
+}
+
+static const tesa_event_bus_bridge_t s_bus_bridge = { app_bridge_forward, app_bridge_subscribers_changed };
+
+/**
+ * Runs a bridge work item staged by the IPC ISR. Returns false if work_item is not one.
+ */
+static bool app_bridge_work(const ipc_work_item_t *work_item)
+{
+  ipc_event_subscribe_t subscribe;
+
+  switch (work_item->event_type)
+  {
+  case APP_WORK_EVENT_BATCH:
+    ipc_event_bridge_receive(&s_event_batches[work_item->value]);
+    return true;
+  case APP_WORK_EVENT_ACK:
+    ipc_event_bridge_on_ack(&s_event_acks[work_item->value]);
+    return true;
+  case APP_WORK_EVENT_SUBSCRIBE:
+  case APP_WORK_EVENT_UNSUBSCRIBE:
+    subscribe.channel_id = work_item->value;
+    subscribe.subscribed = (APP_WORK_EVENT_SUBSCRIBE == work_item->event_type) ? 1U : 0U;
+    subscribe.reserved = 0U;
+    ipc_event_bridge_on_subscribe(&subscribe);
+    return true;
+  default:
+    return false;
+  }
+}
+#else
+static bool app_bridge_work(const ipc_work_item_t *work_item)
+{
+  (void)work_item;
+  return false;
+}
+#endif /* IPC_EVENT_BRIDGE_ENABLE */
+
+static bool app_receive_next(cm55_ipc_event_t *event, cm55_ipc_event_payload_t *payload, uint32_t *call_id,
+                             TickType_t timeout_ticks)
 {
   ipc_work_item_t work_item;
   app_log_msg_t log_item;
+  ipc_button_state_t buttons;
 
-  if ((NULL == event) || (NULL == payload))
+  if ((NULL == event) || (NULL == payload) || (NULL == call_id))
   {
     return false;
   }
+  *call_id = IPC_CALL_ID_NONE;
 
   if (s_draining_log && (NULL != s_log_queue))
   {
@@ -140,6 +603,21 @@ static bool app_receive_next(cm55_ipc_event_t *event, cm55_ipc_event_payload_t *
   {
     return false;
   }
+  *call_id = work_item.call_id;
+  if (0U != work_item.cmd)
+  {
+    ipc_stats_on_dispatch(work_item.cmd, work_item.rx_us);
+  }
+
+  if (APP_WORK_WIFI_BULK == work_item.event_type)
+  {
+    app_wifi_bulk_receive();
+    return false;
+  }
+  if ((APP_WORK_CALL == work_item.event_type) || app_bridge_work(&work_item))
+  {
+    return false;
+  }
 
   switch ((cm55_ipc_event_t)work_item.event_type)
   {
@@ -155,25 +633,39 @@ static bool app_receive_next(cm55_ipc_event_t *event, cm55_ipc_event_payload_t *
     }
     return false;
   case CM55_IPC_EVENT_GYRO:
-    payload->gyro.data = &s_gyro_data;
-    payload->gyro.sequence = s_gyro_sequence;
+    if (!ipc_blackboard_read(cm55_ipc_pipe_get_blackboard(), IPC_BLACKBOARD_IMU, &s_gyro_sample,
+                             sizeof(s_gyro_sample), NULL, NULL))
+    {
+      return false;
+    }
+    payload->gyro.data = &s_gyro_sample.data;
+    payload->gyro.sequence = s_gyro_sample.sequence;
     *event = CM55_IPC_EVENT_GYRO;
     return true;
   case CM55_IPC_EVENT_WIFI_STATUS:
+    if (!app_read_wifi_status(&s_wifi_status))
+    {
+      return false;
+    }
     payload->wifi_status.status = &s_wifi_status;
     *event = CM55_IPC_EVENT_WIFI_STATUS;
     return true;
   case CM55_IPC_EVENT_WIFI_COMPLETE:
+    if (0U == work_item.value)
+    {
+      s_wifi_list_count = 0U;
+    }
+    s_wifi_list_ready = true;
     payload->wifi_complete.list = s_wifi_list;
     payload->wifi_complete.count = s_wifi_list_count;
     *event = CM55_IPC_EVENT_WIFI_COMPLETE;
     return true;
   case CM55_IPC_EVENT_BUTTON:
-    if (work_item.value < BUTTON_ID_MAX)
+    if ((work_item.value < BUTTON_ID_MAX) && app_read_buttons(&buttons))
     {
       payload->button.button_id = work_item.value;
-      payload->button.press_count = s_btn_press_count[work_item.value];
-      payload->button.is_pressed = s_btn_is_pressed[work_item.value];
+      payload->button.press_count = buttons.press_count[work_item.value];
+      payload->button.is_pressed = (0U != (buttons.pressed & (1UL << work_item.value)));
       *event = CM55_IPC_EVENT_BUTTON;
       return true;
     }
@@ -183,67 +675,133 @@ static bool app_receive_next(cm55_ipc_event_t *event, cm55_ipc_event_payload_t *
   }
 }
 
-static void cm55_ipc_app_data_received_cb(uint32_t *msg_data)
+static void app_on_wifi_scan_bulk(const ipc_msg_t *msg, void *arg)
 {
-  BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-  ipc_msg_t *msg;
-
-  if (NULL == msg_data)
-  {
-    return;
-  }
+  (void)memcpy(&s_wifi_bulk, msg->data, sizeof(s_wifi_bulk));
+  s_wifi_bulk_bench = (0U != (msg->value & IPC_WIFI_SCAN_BULK_VALUE_BENCH));
+  app_push_work_item_from_isr(APP_WORK_WIFI_BULK, msg->cmd, s_wifi_bulk.transfer_id, IPC_CALL_ID_NONE,
+                              (BaseType_t *)arg);
+}
 
-  msg = (ipc_msg_t *)msg_data;
+static void app_on_wifi_scan_complete(const ipc_msg_t *msg, void *arg)
+{
+  ipc_wifi_scan_complete_t complete;
 
-  if (IPC_EVT_WIFI_SCAN_RESULT == msg->cmd)
+  (void)memset(&complete, 0, sizeof(complete));
+  (void)memcpy(&complete, msg->data, (msg->len < sizeof(complete)) ? msg->len : sizeof(complete));
+  if (IPC_CALL_ID_NONE != msg->value)
   {
-    uint32_t packed = msg->value;
-    uint32_t total_count = (packed >> IPC_WIFI_SCAN_VALUE_COUNT_SHIFT) & IPC_WIFI_SCAN_VALUE_INDEX_MASK;
-    uint32_t index = packed & IPC_WIFI_SCAN_VALUE_INDEX_MASK;
-    if ((index < CM55_IPC_PIPE_WIFI_LIST_MAX) && (index < total_count))
-    {
-      (void)memcpy(&s_wifi_list[index], msg->data, sizeof(wifi_info_t));
-    }
+    app_call_answer_from_isr(msg->value, msg->cmd, NULL);
   }
-  else if (IPC_EVT_WIFI_SCAN_COMPLETE == msg->cmd)
+  app_push_work_item_from_isr((uint8_t)CM55_IPC_EVENT_WIFI_COMPLETE, msg->cmd, complete.total_count, msg->value,
+                              (BaseType_t *)arg);
+}
+
+/* Latest-value events (status, button, gyro) only notify: the receiver task reads the value from
+ * the CM33 blackboard, which CM33 publishes before sending the event */
+static void app_on_wifi_status(const ipc_msg_t *msg, void *arg)
+{
+  if (IPC_CALL_ID_NONE != msg->value)
   {
-    ipc_wifi_scan_complete_t complete;
-    (void)memset(&complete, 0, sizeof(complete));
-    (void)memcpy(&complete, msg->data, sizeof(complete));
-    s_wifi_list_count = complete.total_count;
-    s_wifi_list_ready = true;
-    app_push_work_item_from_isr((uint8_t)CM55_IPC_EVENT_WIFI_COMPLETE, complete.total_count, &xHigherPriorityTaskWoken);
+    ipc_wifi_status_t status;
+
+    (void)memcpy(&status, msg->data, sizeof(status));
+    app_call_answer_from_isr(msg->value, msg->cmd, &status);
   }
-  else if (IPC_EVT_WIFI_STATUS == msg->cmd)
+  app_push_work_item_from_isr((uint8_t)CM55_IPC_EVENT_WIFI_STATUS, msg->cmd, 0U, msg->value, (BaseType_t *)arg);
+}
+
+static void app_on_button_event(const ipc_msg_t *msg, void *arg)
+{
+  button_event_t evt;
+
+  (void)memcpy(&evt, msg->data, sizeof(evt));
+  if (evt.button_id < BUTTON_ID_MAX)
   {
-    (void)memcpy(&s_wifi_status, msg->data, sizeof(ipc_wifi_status_t));
-    app_push_work_item_from_isr((uint8_t)CM55_IPC_EVENT_WIFI_STATUS, 0U, &xHigherPriorityTaskWoken);
+    app_push_work_item_from_isr((uint8_t)CM55_IPC_EVENT_BUTTON, msg->cmd, (uint16_t)evt.button_id, IPC_CALL_ID_NONE,
+                                (BaseType_t *)arg);
   }
-  else if (IPC_CMD_BUTTON_EVENT == msg->cmd)
+}
+
+static void app_on_gyro(const ipc_msg_t *msg, void *arg)
+{
+  app_push_work_item_from_isr((uint8_t)CM55_IPC_EVENT_GYRO, msg->cmd, 0U, IPC_CALL_ID_NONE, (BaseType_t *)arg);
+}
+
+#if (0 != IPC_EVENT_BRIDGE_ENABLE)
+/* Event bridge frames are staged for the receiver task, which walks batches and posts their events */
+static void app_on_event_batch(const ipc_msg_t *msg, void *arg)
+{
+  ipc_event_batch_t batch;
+
+  (void)memcpy(&batch, msg->data, sizeof(batch));
+  if (batch.buffer < IPC_EVENT_BRIDGE_BUFFERS)
   {
-    button_event_t evt;
-    (void)memcpy(&evt, msg->data, sizeof(evt));
-    if (evt.button_id < BUTTON_ID_MAX)
-    {
-      s_btn_press_count[evt.button_id] = evt.press_count;
-      s_btn_is_pressed[evt.button_id] = evt.is_pressed;
-      app_push_work_item_from_isr((uint8_t)CM55_IPC_EVENT_BUTTON, (uint16_t)evt.button_id, &xHigherPriorityTaskWoken);
-    }
+    s_event_batches[batch.buffer] = batch;
+    app_push_work_item_from_isr(APP_WORK_EVENT_BATCH, msg->cmd, batch.buffer, IPC_CALL_ID_NONE, (BaseType_t *)arg);
   }
-  else if (IPC_CMD_GYRO == msg->cmd)
+}
+
+static void app_on_event_batch_ack(const ipc_msg_t *msg, void *arg)
+{
+  ipc_event_batch_ack_t ack;
+
+  (void)memcpy(&ack, msg->data, sizeof(ack));
+  if (ack.buffer < IPC_EVENT_BRIDGE_BUFFERS)
   {
-    (void)memcpy(&s_gyro_data, msg->data, sizeof(gyro_data_t));
-    s_gyro_sequence = msg->value;
-    app_push_work_item_from_isr((uint8_t)CM55_IPC_EVENT_GYRO, 0U, &xHigherPriorityTaskWoken);
+    s_event_acks[ack.buffer] = ack;
+    app_push_work_item_from_isr(APP_WORK_EVENT_ACK, msg->cmd, ack.buffer, IPC_CALL_ID_NONE, (BaseType_t *)arg);
   }
+}
+
+static void app_on_event_subscribe(const ipc_msg_t *msg, void *arg)
+{
+  ipc_event_subscribe_t subscribe;
+
+  (void)memcpy(&subscribe, msg->data, sizeof(subscribe));
+  app_push_work_item_from_isr((0U != subscribe.subscribed) ? APP_WORK_EVENT_SUBSCRIBE : APP_WORK_EVENT_UNSUBSCRIBE,
+                              msg->cmd, subscribe.channel_id, IPC_CALL_ID_NONE, (BaseType_t *)arg);
+}
+#endif /* IPC_EVENT_BRIDGE_ENABLE */
+
 #if defined(TOUCH_VIA_IPC)
-  else if (IPC_CMD_TOUCH == msg->cmd)
+static void app_on_touch(const ipc_msg_t *msg, void *arg)
+{
+  ipc_touch_event_t evt;
+
+  (void)arg;
+  (void)memcpy(&evt, msg->data, sizeof(ipc_touch_event_t));
+  lv_port_indev_touch_from_ipc_set(evt.x, evt.y, evt.pressed);
+}
+#endif
+
+/* Handlers for CM33 -> CM55 commands, indexed like the registry in ipc_cmd.h (IPC ISR context) */
+static const ipc_cmd_handler_t s_app_handlers[IPC_CMD_ID_SLOTS] = {
+    [IPC_CMD_SLOT(IPC_EVT_WIFI_SCAN_BULK)] = app_on_wifi_scan_bulk,
+    [IPC_CMD_SLOT(IPC_EVT_WIFI_SCAN_COMPLETE)] = app_on_wifi_scan_complete,
+    [IPC_CMD_SLOT(IPC_EVT_WIFI_STATUS)] = app_on_wifi_status,
+    [IPC_CMD_SLOT(IPC_CMD_BUTTON_EVENT)] = app_on_button_event,
+    [IPC_CMD_SLOT(IPC_CMD_GYRO)] = app_on_gyro,
+#if (0 != IPC_EVENT_BRIDGE_ENABLE)
+    [IPC_CMD_SLOT(IPC_CMD_EVENT_BATCH)] = app_on_event_batch,
+    [IPC_CMD_SLOT(IPC_CMD_EVENT_BATCH_ACK)] = app_on_event_batch_ack,
+    [IPC_CMD_SLOT(IPC_CMD_EVENT_SUBSCRIBE)] = app_on_event_subscribe,
+#endif
+#if defined(TOUCH_VIA_IPC)
+    [IPC_CMD_SLOT(IPC_CMD_TOUCH)] = app_on_touch,
+#endif
+};
+
+static void cm55_ipc_app_data_received_cb(uint32_t *msg_data)
+{
+  BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+  if (NULL == msg_data)
   {
-    ipc_touch_event_t evt;
-    (void)memcpy(&evt, msg->data, sizeof(ipc_touch_event_t));
-    lv_port_indev_touch_from_ipc_set(evt.x, evt.y, evt.pressed);
+    return;
   }
-#endif
+
+  (void)ipc_cmd_dispatch(s_app_handlers, (const ipc_msg_t *)msg_data, &xHigherPriorityTaskWoken);
 
   portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
 }
@@ -318,39 +876,87 @@ static void cm55_ipc_app_event_cb(cm55_ipc_event_t event, const cm55_ipc_event_p
   }
 }
 
+/**
+ * Receiver task: dispatches each event, then completes the call it answers (so callbacks see the
+ * published state), and times out calls and retries a refused scan ack while idle.
+ */
 static void cm55_ipc_app_receiver_task(void *arg)
 {
   cm55_ipc_event_t event;
   cm55_ipc_event_payload_t payload;
+  uint32_t call_id;
 
   (void)arg;
 
   while (true)
   {
-    if (app_receive_next(&event, &payload, portMAX_DELAY))
+    if (app_receive_next(&event, &payload, &call_id, app_call_wait_ticks()))
     {
       cm55_ipc_app_event_cb(event, &payload, NULL);
     }
+    if (IPC_CALL_ID_NONE != call_id)
+    {
+      app_call_finish(call_id);
+    }
+    app_call_expire();
+    app_wifi_ack_send();
   }
 }
 
 bool cm55_get_button_state(uint32_t button_id, uint32_t *press_count, bool *is_pressed)
 {
+  ipc_button_state_t buttons;
+
   if (button_id >= BUTTON_ID_MAX)
   {
     return false;
   }
+  if (!app_read_buttons(&buttons))
+  {
+    return false;
+  }
   if (NULL != press_count)
   {
-    *press_count = s_btn_press_count[button_id];
+    *press_count = buttons.press_count[button_id];
   }
   if (NULL != is_pressed)
   {
-    *is_pressed = s_btn_is_pressed[button_id];
+    *is_pressed = (0U != (buttons.pressed & (1UL << button_id)));
+  }
+  return true;
+}
+
+bool cm55_get_gyro(gyro_data_t *out_data, uint32_t *sequence)
+{
+  ipc_imu_sample_t sample;
+
+  if (NULL == out_data)
+  {
+    return false;
+  }
+  if (!ipc_blackboard_read(cm55_ipc_pipe_get_blackboard(), IPC_BLACKBOARD_IMU, &sample, sizeof(sample), NULL,
+                           NULL))
+  {
+    return false;
+  }
+  *out_data = sample.data;
+  if (NULL != sequence)
+  {
+    *sequence = sample.sequence;
   }
   return true;
 }
 
+bool cm55_get_orientation(ipc_orientation_t *out_orientation, uint32_t *version)
+{
+  if (NULL == out_orientation)
+  {
+    return false;
+  }
+  return ipc_blackboard_read(cm55_ipc_pipe_get_blackboard(), IPC_BLACKBOARD_ORIENTATION, out_orientation,
+                             sizeof(*out_orientation), version, NULL);
+}
+
 bool cm55_get_wifi_list(wifi_info_t *out_list, uint32_t max_count, uint32_t *out_count)
 {
   if ((NULL == out_list) || (NULL == out_count))
@@ -383,8 +989,7 @@ bool cm55_get_wifi_status(ipc_wifi_status_t *out_status)
   {
     return false;
   }
-  (void)memcpy(out_status, &s_wifi_status, sizeof(ipc_wifi_status_t));
-  return true;
+  return app_read_wifi_status(out_status);
 }
 
 bool cm55_get_wifi_debug_text(char *out_text, uint32_t out_size)
@@ -493,13 +1098,137 @@ void cm55_trigger_status_request(void)
   (void)cm55_ipc_pipe_push_request(IPC_CMD_WIFI_STATUS_REQ, NULL, 0U);
 }
 
+uint32_t cm55_call_scan(const char *ssid, uint32_t timeout_ms, cm55_ipc_call_cb_t cb, void *user_data)
+{
+  ipc_wifi_scan_request_t request;
+  (void)memset(&request, 0, sizeof(request));
+  if (NULL != ssid)
+  {
+    request.use_filter = true;
+    request.filter.mode = WIFI_FILTER_MODE_SSID;
+    (void)strncpy((char *)request.filter.ssid, ssid, WIFI_SSID_MAX_LEN - 1U);
+    request.filter.ssid[WIFI_SSID_MAX_LEN - 1U] = '\0';
+  }
+  return app_call_start(IPC_CMD_WIFI_SCAN_REQ, &request, sizeof(request), timeout_ms, cb, user_data);
+}
+
+uint32_t cm55_call_connect(const char *ssid, const char *password, uint32_t security, uint32_t timeout_ms,
+                           cm55_ipc_call_cb_t cb, void *user_data)
+{
+  ipc_wifi_connect_request_t request;
+  (void)memset(&request, 0, sizeof(request));
+  if (NULL != ssid)
+  {
+    (void)strncpy(request.ssid, ssid, sizeof(request.ssid) - 1U);
+  }
+  if (NULL != password)
+  {
+    (void)strncpy(request.password, password, sizeof(request.password) - 1U);
+  }
+  request.security = security;
+  return app_call_start(IPC_CMD_WIFI_CONNECT_REQ, &request, sizeof(request), timeout_ms, cb, user_data);
+}
+
+uint32_t cm55_call_disconnect(uint32_t timeout_ms, cm55_ipc_call_cb_t cb, void *user_data)
+{
+  return app_call_start(IPC_CMD_WIFI_DISCONNECT_REQ, NULL, 0U, timeout_ms, cb, user_data);
+}
+
+uint32_t cm55_call_status(uint32_t timeout_ms, cm55_ipc_call_cb_t cb, void *user_data)
+{
+  return app_call_start(IPC_CMD_WIFI_STATUS_REQ, NULL, 0U, timeout_ms, cb, user_data);
+}
+
+cm55_ipc_call_result_t cm55_call_wait(uint32_t call_id, cm55_ipc_call_reply_t *reply)
+{
+  app_call_t *call = NULL;
+  cm55_ipc_call_result_t result;
+
+  taskENTER_CRITICAL();
+  for (uint32_t i = 0U; i < CM55_IPC_CALL_MAX; i++)
+  {
+    if ((APP_CALL_FREE != s_calls[i].state) && (call_id == s_calls[i].call_id) && (NULL == s_calls[i].cb))
+    {
+      call = &s_calls[i];
+      break;
+    }
+  }
+  taskEXIT_CRITICAL();
+
+  if ((IPC_CALL_ID_NONE == call_id) || (NULL == call))
+  {
+    return CM55_IPC_CALL_INVALID;
+  }
+
+  (void)xSemaphoreTake(call->done, portMAX_DELAY);
+  result = call->reply.result;
+  if (NULL != reply)
+  {
+    *reply = call->reply;
+  }
+  taskENTER_CRITICAL();
+  call->state = APP_CALL_FREE;
+  taskEXIT_CRITICAL();
+  return result;
+}
+
+bool cm55_call_cancel(uint32_t call_id)
+{
+  app_call_t *call = NULL;
+  bool waitable = false;
+
+  if (IPC_CALL_ID_NONE == call_id)
+  {
+    return false;
+  }
+
+  taskENTER_CRITICAL();
+  for (uint32_t i = 0U; i < CM55_IPC_CALL_MAX; i++)
+  {
+    if (((APP_CALL_PENDING == s_calls[i].state) || (APP_CALL_ANSWERED == s_calls[i].state)) &&
+        (call_id == s_calls[i].call_id))
+    {
+      call = &s_calls[i];
+      waitable = (NULL == call->cb);
+      call->reply.result = CM55_IPC_CALL_CANCELLED;
+      call->state = waitable ? APP_CALL_DONE : APP_CALL_FREE;
+      break;
+    }
+  }
+  taskEXIT_CRITICAL();
+
+  if (waitable)
+  {
+    (void)xSemaphoreGive(call->done);
+  }
+  return (NULL != call);
+}
+
+/**
+ * Resets the call table and creates one completion semaphore per call. Returns false on failure.
+ */
+static bool app_calls_create(void)
+{
+  for (uint32_t i = 0U; i < CM55_IPC_CALL_MAX; i++)
+  {
+    s_calls[i].state = APP_CALL_FREE;
+    s_calls[i].call_id = IPC_CALL_ID_NONE;
+    if (NULL == s_calls[i].done)
+    {
+      s_calls[i].done = xSemaphoreCreateBinary();
+      if (NULL == s_calls[i].done)
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
 bool cm55_ipc_app_init(void)
 {
   s_draining_log = false;
-  (void)memset(&s_wifi_status, 0, sizeof(s_wifi_status));
-  s_wifi_status.state = (uint8_t)IPC_WIFI_LINK_DISCONNECTED;
-  s_wifi_status.rssi = -127;
-  s_wifi_status.reason = (uint16_t)IPC_WIFI_REASON_NONE;
+  app_wifi_status_default(&s_wifi_status);
   s_wifi_status_printed_once = false;
   s_wifi_debug_head = 0U;
   s_wifi_debug_count = 0U;
@@ -507,6 +1236,11 @@ bool cm55_ipc_app_init(void)
 
   cm55_ipc_pipe_init(&CM55_GET_CONFIG_DEFAULT());
 
+  if (false == app_calls_create())
+  {
+    return false;
+  }
+
   s_log_queue = xQueueCreate(CM55_LOG_QUEUE_LENGTH, sizeof(app_log_msg_t));
   if (NULL == s_log_queue)
   {
@@ -530,6 +1264,18 @@ bool cm55_ipc_app_init(void)
     return false;
   }
 
+  if (false == cm55_stdout_ipc_init())
+  {
+    return false;
+  }
+
+#if (0 != IPC_EVENT_BRIDGE_ENABLE)
+  if (false == ipc_event_bridge_init(&cm55_bridge_buffers, app_bridge_send, app_bridge_deliver))
+  {
+    return false;
+  }
+#endif
+
   if (pdPASS != xTaskCreate(cm55_ipc_app_receiver_task, "IPC Receiver", IPC_RECEIVER_TASK_STACK, NULL,
                             IPC_RECEIVER_TASK_PRIO, NULL))
   {
@@ -538,3 +1284,22 @@ bool cm55_ipc_app_init(void)
 
   return true;
 }
+
+bool cm55_ipc_app_bridge_start(void)
+{
+#if (0 != IPC_EVENT_BRIDGE_ENABLE)
+  return TESA_EVENT_BUS_SUCCESS == tesa_event_bus_set_bridge(&s_bus_bridge);
+#else
+  return false;
+#endif
+}
+
+bool cm55_ipc_app_get_bridge_stats(ipc_event_bridge_stats_t *stats)
+{
+#if (0 != IPC_EVENT_BRIDGE_ENABLE)
+  return ipc_event_bridge_get_stats(stats);
+#else
+  (void)stats;
+  return false;
+#endif
+}
@@ -12,12 +12,17 @@
 #ifndef CM55_IPC_APP_H
 #define CM55_IPC_APP_H
 
+#include "ipc_blackboard.h"
 #include "ipc_communication.h"
+#include "ipc_event_bridge.h"
 #include "wifi_scanner_types.h"
 
 #include <stdbool.h>
 #include <stdint.h>
 
+#define CM55_IPC_CALL_MAX (8U)                    /* Wi-Fi calls that can be outstanding at once. */
+#define CM55_IPC_CALL_TIMEOUT_MS_DEFAULT (15000U) /* Used when a call is started with timeout_ms 0. */
+
 /** IPC event types: delivered from CM33 to CM55 and dispatched by app receiver task to cm55_ipc_event_cb_t. */
 typedef enum
 {
@@ -74,12 +79,50 @@ typedef union
 /** Callback invoked for each typed event by the app receiver task; user_data is optional. */
 typedef void (*cm55_ipc_event_cb_t)(cm55_ipc_event_t event, const cm55_ipc_event_payload_t *payload, void *user_data);
 
+/** Outcome of a Wi-Fi call. */
+typedef enum
+{
+  CM55_IPC_CALL_OK = 0,    /* Scan ran / status read / link connected / link disconnected. */
+  CM55_IPC_CALL_FAILED,    /* CM33 answered, but the request did not succeed (see status.reason). */
+  CM55_IPC_CALL_BUSY,      /* CM33 could not queue the request. */
+  CM55_IPC_CALL_TIMEOUT,   /* No answer within the call timeout. */
+  CM55_IPC_CALL_CANCELLED, /* Cancelled with cm55_call_cancel(). */
+  CM55_IPC_CALL_INVALID,   /* cm55_call_wait(): unknown call ID, already collected, or started with a callback. */
+} cm55_ipc_call_result_t;
+
+/** Answer to a Wi-Fi call, passed to its callback or returned by cm55_call_wait(). */
+typedef struct
+{
+  uint32_t call_id;              /* ID returned when the call was started. */
+  uint32_t request;              /* IPC_CMD_WIFI_*_REQ that was sent. */
+  cm55_ipc_call_result_t result; /* Outcome. */
+  ipc_wifi_status_t status;      /* Status that answered the call (latest known status for scans and timeouts). */
+  const wifi_info_t *list;       /* Scan calls that ran: published result list, else NULL. In a callback valid until
+                                    it returns; after cm55_call_wait() valid until the next scan list arrives. */
+  uint32_t count;                /* Entries in list. */
+} cm55_ipc_call_reply_t;
+
+/** Completion callback of a Wi-Fi call. Runs in the app receiver task; must not block or wait on a call. */
+typedef void (*cm55_ipc_call_cb_t)(const cm55_ipc_call_reply_t *reply, void *user_data);
+
 /**
  * One-time init: starts pipe (if not already), creates receiver task and work queue. Call before
  * trigger/get API. Returns false on failure.
  */
 bool cm55_ipc_app_init(void);
 
+/**
+ * Connects tesa_event_bus to the cross-core event bridge (see ipc_event_bridge.h): channels marked
+ * with tesa_event_bus_set_channel_remote() travel to CM33 while it subscribes to them, and events
+ * from CM33 are posted by the app receiver task. Call after cm55_ipc_app_init() and
+ * tesa_event_bus_init(). Returns false on failure, or if the image is built without
+ * IPC_EVENT_BRIDGE_ENABLE.
+ */
+bool cm55_ipc_app_bridge_start(void);
+
+/** Event bridge counters of CM55; false without IPC_EVENT_BRIDGE_ENABLE. */
+bool cm55_ipc_app_get_bridge_stats(ipc_event_bridge_stats_t *stats);
+
 /**
  * Request full Wi-Fi scan on CM33 (no SSID filter). Sends request via pipe; results arrive as
  * CM55_IPC_EVENT_WIFI_COMPLETE.
@@ -95,17 +138,74 @@ void cm55_trigger_connect(const char *ssid, const char *password, uint32_t secur
 void cm55_trigger_disconnect(void);
 void cm55_trigger_status_request(void);
 
+/*
+ * Wi-Fi calls: each sends its request with a fresh call ID and completes exactly once, with the
+ * CM33 event that answers it (matched by ID, so several calls may be outstanding), with
+ * CM55_IPC_CALL_TIMEOUT after timeout_ms (0: CM55_IPC_CALL_TIMEOUT_MS_DEFAULT), or when cancelled.
+ * With cb set, cb(reply, user_data) runs in the app receiver task; to wake a task instead, notify
+ * it from cb. With cb NULL the answer is kept until the caller collects it with cm55_call_wait().
+ * The regular events (CM55_IPC_EVENT_WIFI_STATUS, CM55_IPC_EVENT_WIFI_COMPLETE) are still
+ * dispatched for answers. Return the call ID, or IPC_CALL_ID_NONE if all CM55_IPC_CALL_MAX calls
+ * are in use or the request could not be queued. Task context only.
+ */
+
+/** Scan (ssid NULL: all networks, else filtered by SSID). OK once the result list is published. */
+uint32_t cm55_call_scan(const char *ssid, uint32_t timeout_ms, cm55_ipc_call_cb_t cb, void *user_data);
+
+/** Connect. OK when the link is up; FAILED if it failed or was superseded by another connect or disconnect. */
+uint32_t cm55_call_connect(const char *ssid, const char *password, uint32_t security, uint32_t timeout_ms,
+                           cm55_ipc_call_cb_t cb, void *user_data);
+
+/** Disconnect. OK when the link is down. */
+uint32_t cm55_call_disconnect(uint32_t timeout_ms, cm55_ipc_call_cb_t cb, void *user_data);
+
+/** Status read. OK with the current CM33 status. */
+uint32_t cm55_call_status(uint32_t timeout_ms, cm55_ipc_call_cb_t cb, void *user_data);
+
+/**
+ * Blocks until a call started with cb NULL completes, copies its answer into reply (may be NULL)
+ * and releases the call. Never blocks past the call timeout. Not from the app receiver task
+ * (call callbacks included). Returns the result, or CM55_IPC_CALL_INVALID.
+ */
+cm55_ipc_call_result_t cm55_call_wait(uint32_t call_id, cm55_ipc_call_reply_t *reply);
+
 /**
- * Read current button state; press_count and is_pressed may be NULL. Returns false if button_id
- * invalid.
+ * Cancels an outstanding call: a callback call is dropped without running cb; a waiting call
+ * completes with CM55_IPC_CALL_CANCELLED (still collect it with cm55_call_wait()). A late CM33
+ * answer is then handled as a regular event only. Returns false if call_id is not outstanding.
+ */
+bool cm55_call_cancel(uint32_t call_id);
+
+/*
+ * Latest-value getters read consistent snapshots of the CM33 blackboard (see ipc_blackboard.h):
+ * no IPC frame, no interrupt, any task. Events for the same state still arrive through the
+ * callback; their payload is the snapshot read when the event was dispatched.
+ */
+
+/**
+ * Read current button state; press_count and is_pressed may be NULL (released and 0 before the first
+ * button event). Returns false if button_id invalid.
  */
 bool cm55_get_button_state(uint32_t button_id, uint32_t *press_count, bool *is_pressed);
 
+/**
+ * Latest gyro sample and its CM33 sequence number (sequence may be NULL). Returns false until CM33
+ * has published one.
+ */
+bool cm55_get_gyro(gyro_data_t *out_data, uint32_t *sequence);
+
+/**
+ * Latest BSXlite fusion output (quaternion plus the accel/gyro inputs of that step); version (may be
+ * NULL) counts publishes, so pollers can skip unchanged samples. Returns false until fusion has run.
+ */
+bool cm55_get_orientation(ipc_orientation_t *out_orientation, uint32_t *version);
+
 /**
  * Copy up to max_count scan results into out_list and set out_count. Clears ready flag. Returns false if scan not
- * ready or args invalid.
+ * ready or args invalid. Prefer cm55_call_scan() to polling this.
  */
 bool cm55_get_wifi_list(wifi_info_t *out_list, uint32_t max_count, uint32_t *out_count);
+/** Latest link status (disconnected until CM33 reports one). */
 bool cm55_get_wifi_status(ipc_wifi_status_t *out_status);
 bool cm55_get_wifi_debug_text(char *out_text, uint32_t out_size);
 uint32_t cm55_get_wifi_debug_sequence(void);
@@ -1,8 +1,12 @@
 /*******************************************************************************
  * File Name        : cm55_ipc_pipe.c
  *
- * Description      : CM55 IPC pipe: send queue, sender task, pipe init/start
- *                    and callback registration; pushes requests to CM33.
+ * Description      : CM55 IPC pipe: send buffer, sender task, pipe init/start
+ *                    and callback registration; pushes variable-length
+ *                    requests to CM33 through a shared-memory ring, paced by
+ *                    the credits CM33 returns, with the control lane served
+ *                    ahead of the bulk lane; drains the CM33 ring on each
+ *                    doorbell interrupt.
  *
  * Author           : Asst.Prof.Santi Nuratch, Ph.D
  *                    Thailand Embedded Systems Association (TESA)
@@ -16,82 +20,566 @@
 
 #include "cy_syslib.h"
 #include "ipc_communication.h"
+#include "ipc_lane.h"
+#include "ipc_liveness.h"
+#include "ipc_ring.h"
+#include "ipc_stats.h"
 
-#include <queue.h>
+#include <message_buffer.h>
+#include <semphr.h>
 #include <stdbool.h>
 #include <string.h>
 
 #define RESET_VAL (0U)
+#define IPC_RETRY_TICKS (1U)
+#define CM55_IPC_PIPE_SEND_LOCK_TIMEOUT_MS (5U)
+#define CM55_IPC_PIPE_CONTROL_BLOCK_MS (5U)
+
+typedef struct
+{
+  MessageBufferHandle_t buf;
+  SemaphoreHandle_t lock; /* Message buffers allow one writer at a time */
+  ipc_lane_stats_t stats;
+} cm55_ipc_lane_t;
 
 static TaskHandle_t cm55_ipc_sender_task_handle;
-static QueueHandle_t s_ipc_send_queue = NULL;
+static cm55_ipc_lane_t s_lanes[IPC_LANE_COUNT];
+static ipc_lane_config_t s_lane_config[IPC_LANE_COUNT] = {
+    [IPC_LANE_CONTROL] = { 0U, IPC_LANE_POLICY_BLOCK, CM55_IPC_PIPE_CONTROL_BLOCK_MS },
+    [IPC_LANE_BULK] = { 0U, IPC_LANE_POLICY_DROP_NEWEST, 0U },
+};
 static cm55_ipc_data_received_cb_t s_data_received_cb = NULL;
-CY_SECTION_SHAREDMEM static ipc_msg_t cm55_msg_data;
+CY_SECTION_SHAREDMEM static ipc_doorbell_t cm55_doorbell;
+CY_SECTION_SHAREDMEM CY_ALIGN(IPC_RING_CACHE_LINE) static ipc_ring_t cm55_tx_ring;
+static const ipc_blackboard_t *volatile s_peer_board = NULL; /* CM33 blackboard, learned from its doorbell */
+CY_SECTION_SHAREDMEM CY_ALIGN(IPC_RING_CACHE_LINE) static ipc_liveness_t cm55_liveness;
+static ipc_liveness_monitor_t s_peer_live; /* CM33 record; checked by the sender task only */
+static ipc_liveness_config_t s_live_config; /* Set by cm55_ipc_pipe_set_liveness_config(), applied by the sender task */
+static volatile bool s_live_config_pending = false;
+static bool s_doorbell_pending = false;
+static uint32_t s_tx_sent = 0U;
+static volatile uint32_t s_credit_stalls = 0U;
+static volatile uint32_t s_bulk_throttles = 0U;
+static ipc_bench_report_t s_bench_rx;
+static ipc_bench_report_t s_bench_report;
+static volatile bool s_bench_report_pending = false;
+static volatile bool s_sync_pending = false;
+static volatile TickType_t s_sync_tick = 0U; /* When the last sync request was sent */
 static cm55_ipc_pipe_config_t s_config = {
     .task_stack = CM55_IPC_PIPE_TASK_STACK_DEFAULT,
     .task_prio = CM55_IPC_PIPE_TASK_PRIO_DEFAULT,
     .send_queue_len = CM55_IPC_PIPE_SEND_QUEUE_LEN_DEFAULT,
+    .control_queue_len = CM55_IPC_PIPE_CONTROL_QUEUE_LEN_DEFAULT,
     .startup_delay_ms = CM55_IPC_PIPE_STARTUP_DELAY_MS_DEFAULT,
 };
 
 /**
- * FreeRTOS task that reads messages from send queue and sends via IPC pipe to CM33.
+ * Publishes the benchmark report latched by the doorbell ISR. The sender task is the only ring
+ * producer, so the report is written here rather than from the ISR. Returns true once written.
+ */
+static bool cm55_ipc_tx_bench_report(void)
+{
+  ipc_msg_t *slot = ipc_ring_claim(&cm55_tx_ring, IPC_MSG_FRAME_LEN(sizeof(ipc_bench_report_t)));
+
+  if (NULL == slot)
+  {
+    return false;
+  }
+  s_tx_sent++;
+  slot->cmd = IPC_CMD_BENCH_REPORT;
+  slot->value = RESET_VAL;
+  slot->len = (uint16_t)sizeof(ipc_bench_report_t);
+  slot->reserved = 0U;
+  slot->sent_us = ipc_stats_now_us();
+  (void)memcpy(slot->data, &s_bench_report, sizeof(ipc_bench_report_t));
+  ipc_ring_commit(&cm55_tx_ring, IPC_MSG_FRAME_LEN(sizeof(ipc_bench_report_t)));
+  ipc_stats_on_send(IPC_CMD_BENCH_REPORT, 0U);
+  s_bench_report_pending = false;
+  return true;
+}
+
+/**
+ * Publishes a time sync request. Written by the sender task straight into the ring, so sent_us is
+ * taken right before CM33 can see it and no lane wait inflates the measured round trip. Returns true
+ * once written.
+ */
+static bool cm55_ipc_tx_time_sync(void)
+{
+  ipc_msg_t *slot = ipc_ring_claim(&cm55_tx_ring, IPC_MSG_FRAME_LEN(0U));
+
+  if (NULL == slot)
+  {
+    return false;
+  }
+  s_tx_sent++;
+  slot->cmd = IPC_CMD_TIME_SYNC;
+  slot->value = RESET_VAL;
+  slot->len = 0U;
+  slot->reserved = 0U;
+  slot->sent_us = ipc_stats_now_us();
+  ipc_ring_commit(&cm55_tx_ring, IPC_MSG_FRAME_LEN(0U));
+  ipc_stats_on_send(IPC_CMD_TIME_SYNC, 0U);
+  s_sync_tick = xTaskGetTickCount();
+  s_sync_pending = false;
+  return true;
+}
+
+/**
+ * True once the last sync request is IPC_STATS_SYNC_MAX_AGE_MS old. There is no sync timer: a due
+ * sync rides along with the next frames sent or is asked for by cm55_ipc_pipe_get_time_sync(), so an
+ * idle link wakes neither core.
+ */
+static bool cm55_ipc_sync_due(void)
+{
+  return (xTaskGetTickCount() - s_sync_tick) >= pdMS_TO_TICKS(IPC_STATS_SYNC_MAX_AGE_MS);
+}
+
+/**
+ * Takes one CM33 credit for the next frame of the given lane; the bulk lane leaves
+ * IPC_LANE_CONTROL_RESERVE_CREDITS of the window to the control lane, and holds back while CM33
+ * reports a receive backlog of IPC_RING_BACKLOG_THROTTLE frames or more. Out of credits or
+ * throttled, flags the wait in the ring so that CM33 rings back once it has drained its receive
+ * queues, and returns false.
+ */
+static bool cm55_ipc_tx_credit(ipc_lane_t lane)
+{
+  uint32_t window = (IPC_LANE_BULK == lane) ? (IPC_RING_CREDITS - IPC_LANE_CONTROL_RESERVE_CREDITS) : IPC_RING_CREDITS;
+
+  if ((IPC_LANE_BULK == lane) && !ipc_ring_backlog_below(&cm55_tx_ring, IPC_RING_BACKLOG_THROTTLE))
+  {
+    s_bulk_throttles++;
+    return false;
+  }
+
+  if (ipc_ring_credit_acquire(&cm55_tx_ring, s_tx_sent, window))
+  {
+    return true;
+  }
+  s_credit_stalls++;
+  return false;
+}
+
+/**
+ * Moves the oldest frame of one lane into the shared ring, copying only its used bytes, stamps its
+ * send time and accounts its queueing delay. Returns false when the lane is empty, out of credits or the frame does not fit
+ * (then *ring_full is set).
+ */
+static bool cm55_ipc_tx_move(ipc_lane_t lane, bool *ring_full)
+{
+  cm55_ipc_lane_t *l = &s_lanes[lane];
+  ipc_lane_entry_t entry;
+  size_t entry_len = xMessageBufferNextLengthBytes(l->buf);
+  uint32_t frame_len;
+  uint32_t queue_us;
+  ipc_msg_t *slot;
+
+  if ((0U == entry_len) || !cm55_ipc_tx_credit(lane))
+  {
+    return false;
+  }
+  frame_len = (uint32_t)(entry_len - offsetof(ipc_lane_entry_t, msg));
+  slot = ipc_ring_claim(&cm55_tx_ring, frame_len);
+  if (NULL == slot)
+  {
+    *ring_full = true;
+    return false;
+  }
+  (void)xMessageBufferReceive(l->buf, &entry, entry_len, 0U);
+  (void)memcpy(slot, &entry.msg, frame_len);
+  slot->sent_us = ipc_stats_now_us();
+  ipc_ring_commit(&cm55_tx_ring, frame_len);
+  s_tx_sent++;
+  queue_us = ipc_lane_elapsed_us(entry.enqueue_stamp);
+  ipc_stats_hist_record(&l->stats.delay, queue_us);
+  ipc_stats_on_send(entry.msg.cmd, queue_us);
+  return true;
+}
+
+/**
+ * Moves queued frames into the shared ring with strict priority while CM33 has credits left: the
+ * benchmark report, a due time sync request and the control lane go first, and the control lane is re-checked before every
+ * bulk frame. Never blocks; sets *ring_full when the next frame does not fit (only possible if the
+ * window outgrows the ring). Out of credits it just stops: the credit doorbell resumes it. Returns
+ * the number of frames published.
+ */
+static uint32_t cm55_ipc_tx_pump(bool *ring_full)
+{
+  uint32_t moved = 0U;
+
+  *ring_full = false;
+  if (!s_sync_pending && cm55_ipc_sync_due() &&
+      (s_bench_report_pending || !xMessageBufferIsEmpty(s_lanes[IPC_LANE_CONTROL].buf) ||
+       !xMessageBufferIsEmpty(s_lanes[IPC_LANE_BULK].buf)))
+  {
+    s_sync_pending = true; /* The doorbell goes out anyway; refresh the offset with it */
+  }
+  if (s_bench_report_pending)
+  {
+    if (!cm55_ipc_tx_credit(IPC_LANE_CONTROL))
+    {
+      return moved;
+    }
+    if (!cm55_ipc_tx_bench_report())
+    {
+      *ring_full = true;
+      return moved;
+    }
+    moved++;
+  }
+  if (s_sync_pending)
+  {
+    if (!cm55_ipc_tx_credit(IPC_LANE_CONTROL))
+    {
+      return moved;
+    }
+    if (!cm55_ipc_tx_time_sync())
+    {
+      *ring_full = true;
+      return moved;
+    }
+    moved++;
+  }
+
+  while (!*ring_full)
+  {
+    if (!cm55_ipc_tx_move(IPC_LANE_CONTROL, ring_full) &&
+        (*ring_full || !cm55_ipc_tx_move(IPC_LANE_BULK, ring_full)))
+    {
+      break;
+    }
+    moved++;
+  }
+
+  return moved;
+}
+
+/**
+ * Rings CM33 once for everything published so far; a busy channel is retried by the sender task
+ * until it succeeds or CM33 has drained the ring on an earlier doorbell.
+ */
+static void cm55_ipc_tx_doorbell(void)
+{
+  if (ipc_ring_is_empty(&cm55_tx_ring))
+  {
+    s_doorbell_pending = false;
+    return;
+  }
+
+  s_doorbell_pending = (CY_IPC_PIPE_SUCCESS != Cy_IPC_Pipe_SendMessage(CM33_IPC_PIPE_EP_ADDR, CM55_IPC_PIPE_EP_ADDR,
+                                                                        (void *)&cm55_doorbell, NULL));
+}
+
+/**
+ * Local milliseconds for the liveness monitor.
+ */
+static uint32_t cm55_ipc_now_ms(void)
+{
+  return (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS);
+}
+
+/**
+ * FreeRTOS task that batches frames from the send buffer into the shared ring and rings CM33 once
+ * per batch. Producers wake it with a task notification and so does the doorbell ISR when CM33
+ * returns credits, so it sleeps indefinitely both when idle and when out of credits; it only polls
+ * per tick while a doorbell is still owed or the ring is full. It never blocks on the message buffer
+ * itself, which keeps the buffer's internal use of the notification out of the way. Each pass beats
+ * cm55_liveness and checks the CM33 record, which owes a beat while CM33 is busy, has not drained
+ * frames of an earlier pass or has credits to return; while one is owed the task also wakes for the
+ * next liveness threshold.
  */
 static void cm55_ipc_sender_task(void *arg)
 {
+  TickType_t wait_ticks = portMAX_DELAY;
+  TickType_t check_ticks;
+  bool ring_full = false;
+  bool busy;
+  uint32_t moved;
+
   (void)arg;
-  ipc_msg_t send_msg;
-  cy_en_ipc_pipe_status_t status;
-  int retries;
   while (true)
   {
-    if (xQueueReceive(s_ipc_send_queue, &send_msg, portMAX_DELAY) == pdPASS)
+    (void)ulTaskNotifyTake(pdTRUE, wait_ticks);
+    ipc_liveness_beat(&cm55_liveness, IPC_LIVENESS_BUSY);
+    if (s_live_config_pending)
+    {
+      taskENTER_CRITICAL();
+      ipc_liveness_monitor_configure(&s_peer_live, &s_live_config);
+      s_live_config_pending = false;
+      taskEXIT_CRITICAL();
+    }
+    (void)ipc_liveness_check(&s_peer_live, cm55_ipc_now_ms(),
+                             !ipc_ring_is_empty(&cm55_tx_ring) || ipc_ring_credit_waiting(&cm55_tx_ring));
+
+    moved = cm55_ipc_tx_pump(&ring_full);
+    if ((0U < moved) || s_doorbell_pending)
     {
-      cm55_msg_data.client_id = CM33_IPC_PIPE_CLIENT_ID;
-      cm55_msg_data.intr_mask = CY_IPC_CYPIPE_INTR_MASK_EP2;
-      cm55_msg_data.cmd = send_msg.cmd;
-      cm55_msg_data.value = send_msg.value;
-      (void)memcpy(cm55_msg_data.data, send_msg.data, IPC_DATA_MAX_LEN);
-
-      retries = 5;
-      do
-      {
-        status =
-            Cy_IPC_Pipe_SendMessage(CM33_IPC_PIPE_EP_ADDR, CM55_IPC_PIPE_EP_ADDR, (void *)&cm55_msg_data, RESET_VAL);
-        if (CY_IPC_PIPE_SUCCESS == status)
-        {
-          break;
-        }
-        vTaskDelay(pdMS_TO_TICKS(5U));
-      } while (--retries > 0);
-
-      vTaskDelay(pdMS_TO_TICKS(10U));
+      cm55_ipc_tx_doorbell();
     }
+
+    busy = s_doorbell_pending || ring_full;
+    wait_ticks = busy ? IPC_RETRY_TICKS : portMAX_DELAY;
+    check_ticks = pdMS_TO_TICKS(ipc_liveness_next_check_ms(&s_peer_live, cm55_ipc_now_ms()));
+    if ((0U < check_ticks) && (check_ticks < wait_ticks))
+    {
+      wait_ticks = check_ticks;
+    }
+    ipc_liveness_beat(&cm55_liveness, busy ? IPC_LIVENESS_BUSY : IPC_LIVENESS_IDLE);
   }
 }
 
 /**
- * Queues an IPC request (cmd + optional data) for the sender task to send. data may be NULL when
- * data_len 0; data_len capped to IPC_DATA_MAX_LEN. Returns false if send queue not initialized.
+ * Counts IPC_CMD_BENCH frames in ISR context; on the end marker latches the report and wakes the
+ * sender task to publish it.
  */
+static void cm55_ipc_bench_account(const ipc_msg_t *msg, BaseType_t *woken)
+{
+  if (0U == (msg->value & IPC_BENCH_VALUE_END))
+  {
+    if (0U == msg->value)
+    {
+      (void)memset(&s_bench_rx, 0, sizeof(s_bench_rx));
+    }
+    s_bench_rx.frames++;
+    s_bench_rx.bytes += msg->len;
+    return;
+  }
+
+  {
+    uint32_t expected = msg->value & ~IPC_BENCH_VALUE_END;
+    s_bench_rx.lost = (expected > s_bench_rx.frames) ? (expected - s_bench_rx.frames) : 0U;
+  }
+  (void)memcpy(&s_bench_report, &s_bench_rx, sizeof(s_bench_report));
+  s_bench_report_pending = true;
+  vTaskNotifyGiveFromISR(cm55_ipc_sender_task_handle, woken);
+  (void)memset(&s_bench_rx, 0, sizeof(s_bench_rx));
+}
+
+/**
+ * Doorbell from CM33 (ISR context): drains every message queued in the CM33 ring, accounting its
+ * transit time, and hands each to the registered data-received callback. Time sync replies and
+ * benchmark frames are consumed here. Wakes the sender task if it is waiting for credits. Also
+ * records the CM33 blackboard address, so it is known from the first doorbell on.
+ */
+static void cm55_ipc_doorbell_cb(uint32_t *msg_data)
+{
+  const ipc_doorbell_t *doorbell = (const ipc_doorbell_t *)msg_data;
+  ipc_ring_t *ring;
+  const ipc_msg_t *msg;
+  uint32_t rx_us;
+  BaseType_t woken = pdFALSE;
+
+  if ((NULL == doorbell) || (NULL == doorbell->ring))
+  {
+    return;
+  }
+
+  if (NULL != doorbell->board)
+  {
+    s_peer_board = doorbell->board;
+  }
+  ipc_liveness_monitor_attach(&s_peer_live, doorbell->live);
+  ring = doorbell->ring;
+  while (NULL != (msg = ipc_ring_peek(ring)))
+  {
+    rx_us = ipc_stats_on_receive(msg->cmd, msg->sent_us, msg->len);
+    if ((IPC_CMD_TIME_SYNC == msg->cmd) && (sizeof(ipc_time_sync_t) <= msg->len))
+    {
+      ipc_time_sync_t sync;
+      (void)memcpy(&sync, msg->data, sizeof(sync));
+      ipc_stats_sync_sample(sync.t0_us, sync.t1_us, msg->sent_us, rx_us);
+    }
+    else if (IPC_CMD_BENCH == msg->cmd)
+    {
+      cm55_ipc_bench_account(msg, &woken);
+    }
+    else if (NULL != s_data_received_cb)
+    {
+      s_data_received_cb((uint32_t *)msg);
+    }
+    ipc_ring_release(ring);
+  }
+
+  if (ipc_ring_credit_waiting(&cm55_tx_ring) && (NULL != cm55_ipc_sender_task_handle))
+  {
+    vTaskNotifyGiveFromISR(cm55_ipc_sender_task_handle, &woken);
+  }
+
+  portYIELD_FROM_ISR(woken);
+}
+
+/**
+ * Queues an IPC request (cmd + optional data) on its command's lane for the sender task to send.
+ * data may be NULL when data_len 0; data_len capped to IPC_DATA_MAX_LEN. Only the header and
+ * data_len bytes are copied, with the enqueue stamp. Task context only; writers are serialized per
+ * lane because message buffers allow a single writer. With wait, a busy lane is waited for up to
+ * CM55_IPC_PIPE_SEND_LOCK_TIMEOUT_MS and a full control lane up to CM55_IPC_PIPE_CONTROL_BLOCK_MS; a
+ * full bulk lane drops the request. Without wait, neither is waited for. Returns false if the lane is
+ * not initialized, busy or full.
+ */
+static bool cm55_ipc_pipe_enqueue(uint32_t cmd, uint32_t call_id, const void *data, uint32_t data_len, bool wait)
+{
+  ipc_lane_t lane = ipc_lane_of(cmd);
+  cm55_ipc_lane_t *l = &s_lanes[lane];
+  ipc_lane_entry_t entry;
+  ipc_msg_t *msg = &entry.msg;
+  size_t entry_len;
+  TickType_t wait_ticks = 0U;
+  bool sent;
+
+  if (NULL == l->buf)
+  {
+    return false;
+  }
+
+  if (NULL == data)
+  {
+    data_len = 0U;
+  }
+  else if (data_len > IPC_DATA_MAX_LEN)
+  {
+    data_len = IPC_DATA_MAX_LEN;
+  }
+  msg->cmd = cmd;
+  msg->value = call_id;
+  msg->len = (uint16_t)data_len;
+  msg->reserved = 0U;
+  if (0U < data_len)
+  {
+    (void)memcpy(msg->data, data, data_len);
+  }
+  entry_len = IPC_LANE_ENTRY_LEN(data_len);
+  if (wait && (IPC_LANE_POLICY_BLOCK == s_lane_config[lane].policy))
+  {
+    wait_ticks = pdMS_TO_TICKS(s_lane_config[lane].block_ms);
+  }
+
+  if (pdPASS != xSemaphoreTake(l->lock, wait ? pdMS_TO_TICKS(CM55_IPC_PIPE_SEND_LOCK_TIMEOUT_MS) : 0U))
+  {
+    l->stats.dropped++;
+    ipc_stats_on_drop(cmd);
+    return false;
+  }
+  entry.enqueue_stamp = ipc_lane_stamp();
+  sent = (entry_len == xMessageBufferSend(l->buf, &entry, entry_len, wait_ticks));
+  if (!sent)
+  {
+    l->stats.dropped++;
+    ipc_stats_on_drop(cmd);
+  }
+  (void)xSemaphoreGive(l->lock);
+
+  if (sent && (NULL != cm55_ipc_sender_task_handle))
+  {
+    (void)xTaskNotifyGive(cm55_ipc_sender_task_handle);
+  }
+  return sent;
+}
+
 bool cm55_ipc_pipe_push_request(uint32_t cmd, const void *data, uint32_t data_len)
 {
-  ipc_msg_t msg;
+  return cm55_ipc_pipe_enqueue(cmd, IPC_CALL_ID_NONE, data, data_len, true);
+}
+
+bool cm55_ipc_pipe_push_call(uint32_t cmd, uint32_t call_id, const void *data, uint32_t data_len)
+{
+  return cm55_ipc_pipe_enqueue(cmd, call_id, data, data_len, true);
+}
+
+bool cm55_ipc_pipe_try_push_request(uint32_t cmd, const void *data, uint32_t data_len)
+{
+  return cm55_ipc_pipe_enqueue(cmd, IPC_CALL_ID_NONE, data, data_len, false);
+}
+
+uint32_t cm55_ipc_pipe_get_credit_stalls(void)
+{
+  return s_credit_stalls;
+}
+
+uint32_t cm55_ipc_pipe_get_bulk_throttles(void)
+{
+  return s_bulk_throttles;
+}
+
+bool cm55_ipc_pipe_get_peer_backlog(uint32_t *backlog, uint32_t *peak)
+{
+  if (NULL == backlog)
+  {
+    return false;
+  }
+  *backlog = ipc_ring_backlog(&cm55_tx_ring, peak);
+  return true;
+}
 
-  if (NULL == s_ipc_send_queue)
+bool cm55_ipc_pipe_get_lane_stats(ipc_lane_t lane, ipc_lane_stats_t *stats)
+{
+  if ((IPC_LANE_COUNT <= lane) || (NULL == stats))
   {
     return false;
   }
+  (void)memcpy(stats, &s_lanes[lane].stats, sizeof(*stats));
+  return true;
+}
+
+bool cm55_ipc_pipe_get_cmd_stats(uint32_t cmd, ipc_stats_cmd_t *stats)
+{
+  return ipc_stats_get(cmd, stats);
+}
+
+void cm55_ipc_pipe_reset_cmd_stats(void)
+{
+  ipc_stats_reset();
+}
+
+bool cm55_ipc_pipe_get_time_sync(ipc_stats_sync_t *sync)
+{
+  if ((NULL != sync) && (NULL != cm55_ipc_sender_task_handle) && !s_sync_pending && cm55_ipc_sync_due())
+  {
+    s_sync_pending = true;
+    (void)xTaskNotifyGive(cm55_ipc_sender_task_handle);
+  }
+  return ipc_stats_get_sync(sync);
+}
+
+const ipc_blackboard_t *cm55_ipc_pipe_get_blackboard(void)
+{
+  return s_peer_board;
+}
+
+void cm55_ipc_pipe_set_liveness_config(const ipc_liveness_config_t *config)
+{
+  ipc_liveness_config_t applied = { 0U, 0U, NULL, NULL };
+
+  if (NULL != config)
+  {
+    applied = *config;
+  }
+  taskENTER_CRITICAL();
+  s_live_config = applied;
+  s_live_config_pending = true;
+  taskEXIT_CRITICAL();
+  if (NULL != cm55_ipc_sender_task_handle)
+  {
+    (void)xTaskNotifyGive(cm55_ipc_sender_task_handle);
+  }
+}
 
-  (void)memset(&msg, 0, sizeof(msg));
-  msg.cmd = cmd;
-  msg.value = RESET_VAL;
-  if ((NULL != data) && (data_len > 0U))
+bool cm55_ipc_pipe_get_peer_liveness(ipc_liveness_status_t *status)
+{
+  if (!ipc_liveness_get_status(&s_peer_live, status)) /* Written by the sender task; a snapshot, not atomic */
   {
-    uint32_t copy_len = (data_len > IPC_DATA_MAX_LEN) ? IPC_DATA_MAX_LEN : data_len;
-    (void)memcpy(msg.data, data, copy_len);
+    return false;
   }
-  return (xQueueSend(s_ipc_send_queue, &msg, 0U) == pdPASS);
+  return status->attached;
+}
+
+uint32_t cm55_ipc_pipe_get_liveness_counter(void)
+{
+  return cm55_liveness.counter;
+}
+
+void cm55_ipc_pipe_set_fault(void)
+{
+  ipc_liveness_fault(&cm55_liveness);
 }
 
 /**
@@ -103,7 +591,7 @@ static void cm55_ipc_data_received_noop(uint32_t *msg_data)
 }
 
 /**
- * Applies pipe configuration (task stack, prio, queue length, startup delay). config NULL leaves
+ * Applies pipe configuration (task stack, prio, lane queue lengths, startup delay). config NULL leaves
  * defaults unchanged.
  */
 void cm55_ipc_pipe_init(const cm55_ipc_pipe_config_t *config)
@@ -113,6 +601,7 @@ void cm55_ipc_pipe_init(const cm55_ipc_pipe_config_t *config)
     s_config.task_stack = config->task_stack;
     s_config.task_prio = config->task_prio;
     s_config.send_queue_len = config->send_queue_len;
+    s_config.control_queue_len = config->control_queue_len;
     s_config.startup_delay_ms = config->startup_delay_ms;
   }
 }
@@ -127,9 +616,49 @@ void cm55_ipc_pipe_set_data_received_callback(cm55_ipc_data_received_cb_t cb)
 }
 
 /**
- * Start pipe and RX path: creates send queue, runs communication setup, waits startup_delay_ms,
- * registers callback, creates sender task. On failure may call cm55_handle_fatal_error. cb NULL uses set
- * callback or noop. Returns false on queue or register or task create failure.
+ * Creates one send buffer and writer lock per lane, sized from the configured queue lengths.
+ */
+static bool cm55_ipc_lanes_create(void)
+{
+  s_lane_config[IPC_LANE_CONTROL].bytes = s_config.control_queue_len * CM55_IPC_PIPE_SEND_BYTES_PER_SLOT;
+  s_lane_config[IPC_LANE_BULK].bytes = s_config.send_queue_len * CM55_IPC_PIPE_SEND_BYTES_PER_SLOT;
+
+  for (uint32_t i = 0U; i < IPC_LANE_COUNT; i++)
+  {
+    s_lanes[i].lock = xSemaphoreCreateMutex();
+    s_lanes[i].buf = xMessageBufferCreate(s_lane_config[i].bytes);
+    if ((NULL == s_lanes[i].lock) || (NULL == s_lanes[i].buf))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Releases whatever cm55_ipc_lanes_create() managed to allocate.
+ */
+static void cm55_ipc_lanes_delete(void)
+{
+  for (uint32_t i = 0U; i < IPC_LANE_COUNT; i++)
+  {
+    if (NULL != s_lanes[i].buf)
+    {
+      vMessageBufferDelete(s_lanes[i].buf);
+      s_lanes[i].buf = NULL;
+    }
+    if (NULL != s_lanes[i].lock)
+    {
+      vSemaphoreDelete(s_lanes[i].lock);
+      s_lanes[i].lock = NULL;
+    }
+  }
+}
+
+/**
+ * Start pipe and RX path: creates the lane send buffers and TX ring, runs communication setup, waits
+ * startup_delay_ms, registers the doorbell handler (which feeds cb), creates sender task. On failure may call cm55_handle_fatal_error. cb NULL uses set
+ * callback or noop. Returns false on buffer or register or task create failure.
  */
 bool cm55_ipc_pipe_start(cm55_ipc_data_received_cb_t cb)
 {
@@ -139,22 +668,32 @@ bool cm55_ipc_pipe_start(cm55_ipc_data_received_cb_t cb)
     reg_cb = cm55_ipc_data_received_noop;
   }
 
-  s_ipc_send_queue = xQueueCreate(s_config.send_queue_len, sizeof(ipc_msg_t));
-  if (NULL == s_ipc_send_queue)
+  s_data_received_cb = reg_cb;
+  if (!cm55_ipc_lanes_create())
   {
+    cm55_ipc_lanes_delete();
     return false;
   }
+  ipc_lane_timebase_init();
+
+  ipc_ring_init(&cm55_tx_ring);
+  ipc_liveness_init(&cm55_liveness);
+  ipc_liveness_monitor_init(&s_peer_live, NULL);
+  cm55_doorbell.client_id = CM33_IPC_PIPE_CLIENT_ID;
+  cm55_doorbell.intr_mask = CY_IPC_CYPIPE_INTR_MASK_EP2;
+  cm55_doorbell.ring = &cm55_tx_ring;
+  cm55_doorbell.board = NULL;
+  cm55_doorbell.live = &cm55_liveness;
 
   cm55_ipc_communication_setup();
 
   Cy_SysLib_Delay(s_config.startup_delay_ms);
 
   cy_en_ipc_pipe_status_t pipe_status =
-      Cy_IPC_Pipe_RegisterCallback(CM55_IPC_PIPE_EP_ADDR, reg_cb, (uint32_t)CM55_IPC_PIPE_CLIENT_ID);
+      Cy_IPC_Pipe_RegisterCallback(CM55_IPC_PIPE_EP_ADDR, cm55_ipc_doorbell_cb, (uint32_t)CM55_IPC_PIPE_CLIENT_ID);
   if (CY_IPC_PIPE_SUCCESS != pipe_status)
   {
-    vQueueDelete(s_ipc_send_queue);
-    s_ipc_send_queue = NULL;
+    cm55_ipc_lanes_delete();
     cm55_handle_fatal_error("IPC pipe callback registration failed: %d", pipe_status);
     return false;
   }
@@ -162,11 +701,13 @@ bool cm55_ipc_pipe_start(cm55_ipc_data_received_cb_t cb)
   if (pdPASS != xTaskCreate(cm55_ipc_sender_task, "IPC Sender", s_config.task_stack, NULL,
                             s_config.task_prio, &cm55_ipc_sender_task_handle))
   {
-    vQueueDelete(s_ipc_send_queue);
-    s_ipc_send_queue = NULL;
+    cm55_ipc_lanes_delete();
     cm55_handle_fatal_error("IPC sender task create failed");
     return false;
   }
 
+  s_sync_pending = true; /* First sync right away, then on demand (cm55_ipc_sync_due()) */
+  (void)xTaskNotifyGive(cm55_ipc_sender_task_handle);
+
   return true;
 }
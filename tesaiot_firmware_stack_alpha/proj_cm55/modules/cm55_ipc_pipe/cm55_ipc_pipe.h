@@ -13,43 +13,56 @@
 #define CM55_IPC_PIPE_H
 
 #include "FreeRTOS.h"
+#include "ipc_blackboard.h"
 #include "ipc_communication.h"
+#include "ipc_lane.h"
+#include "ipc_liveness.h"
+#include "ipc_stats.h"
 #include "task.h"
 
 #include <stdbool.h>
 #include <stdint.h>
 
-/* Wi-Fi list and packed value encoding for IPC messages. */
+/* Wi-Fi list size for IPC scan transfers. */
 #define CM55_IPC_PIPE_WIFI_LIST_MAX (32U)        /* Max number of Wi-Fi entries in a scan list (payload and local array size). */
-#define CM55_IPC_PIPE_VALUE_INDEX_MASK (0xFFFFU) /* Mask for lower 16 bits of packed value (index) or count after shift. */
-#define CM55_IPC_PIPE_VALUE_COUNT_SHIFT (16U)    /* Shift to get total count from upper 16 bits of packed value (packed >> shift). */
 
 /* Default pipe task and queue tuning. */
 #define CM55_IPC_PIPE_TASK_STACK_DEFAULT (1024U)     /* Default stack size in words for the IPC pipe task. */
 #define CM55_IPC_PIPE_TASK_PRIO_DEFAULT (2U)         /* Default FreeRTOS priority for the pipe task. */
-#define CM55_IPC_PIPE_SEND_QUEUE_LEN_DEFAULT (10U)   /* Default length of the send queue to CM33. */
+#define CM55_IPC_PIPE_SEND_QUEUE_LEN_DEFAULT (10U)   /* Default bulk lane capacity to CM33, in full-size frames. */
+#define CM55_IPC_PIPE_CONTROL_QUEUE_LEN_DEFAULT (4U) /* Default control lane capacity to CM33, in full-size frames. */
 #define CM55_IPC_PIPE_STARTUP_DELAY_MS_DEFAULT (50U) /* Default ms delay after pipe setup, before callback registration. */
 
+/* Lane buffer bytes per queue length unit: one full entry (enqueue stamp and frame) plus the message
+ * buffer length word. Shorter frames pack proportionally more requests into the same buffer. */
+#define CM55_IPC_PIPE_SEND_BYTES_PER_SLOT (sizeof(ipc_lane_entry_t) + sizeof(size_t))
+
 /** Run-time configuration for the CM55 IPC pipe task and send queue. */
 typedef struct
 {
-  uint32_t task_stack;     /* Stack size in words for the IPC pipe FreeRTOS task. */
-  uint32_t task_prio;      /* FreeRTOS priority of the pipe task. */
-  uint32_t send_queue_len; /* Length of the send queue (outgoing requests to CM33). */
+  uint32_t task_stack;        /* Stack size in words for the IPC pipe FreeRTOS task. */
+  uint32_t task_prio;         /* FreeRTOS priority of the pipe task. */
+  uint32_t send_queue_len;    /* Bulk lane capacity in full-size frames (prints, logs, CLI text to CM33). */
+  uint32_t control_queue_len; /* Control lane capacity in full-size frames (Wi-Fi requests, acks). */
   uint32_t
       startup_delay_ms; /* Startup delay in ms after pipe setup, before registering callback (lets CM33/IPC settle). */
 } cm55_ipc_pipe_config_t;
 
-/** Initializer for default pipe config (stack, prio, queue length, startup delay). */
-#define CM55_GET_CONFIG_DEFAULT()                                 \
-  ((cm55_ipc_pipe_config_t){                                      \
-      .task_stack = CM55_IPC_PIPE_TASK_STACK_DEFAULT,             \
-      .task_prio = CM55_IPC_PIPE_TASK_PRIO_DEFAULT,               \
-      .send_queue_len = CM55_IPC_PIPE_SEND_QUEUE_LEN_DEFAULT,     \
-      .startup_delay_ms = CM55_IPC_PIPE_STARTUP_DELAY_MS_DEFAULT, \
+/** Initializer for default pipe config (stack, prio, lane queue lengths, startup delay). */
+#define CM55_GET_CONFIG_DEFAULT()                                     \
+  ((cm55_ipc_pipe_config_t){                                          \
+      .task_stack = CM55_IPC_PIPE_TASK_STACK_DEFAULT,                 \
+      .task_prio = CM55_IPC_PIPE_TASK_PRIO_DEFAULT,                   \
+      .send_queue_len = CM55_IPC_PIPE_SEND_QUEUE_LEN_DEFAULT,         \
+      .control_queue_len = CM55_IPC_PIPE_CONTROL_QUEUE_LEN_DEFAULT,   \
+      .startup_delay_ms = CM55_IPC_PIPE_STARTUP_DELAY_MS_DEFAULT,     \
   })
 
-/** Callback invoked when raw IPC message data is received (msg_data from ipc_msg_t). */
+/**
+ * Callback invoked once per received message (msg_data points to an ipc_msg_t frame in the CM33
+ * ring). Only IPC_MSG_HDR_LEN + len bytes are valid, so check len before reading a payload struct.
+ * Runs in IPC ISR context; the frame is only valid until the callback returns.
+ */
 typedef void (*cm55_ipc_data_received_cb_t)(uint32_t *msg_data);
 
 /**
@@ -63,16 +76,106 @@ void cm55_ipc_pipe_init(const cm55_ipc_pipe_config_t *config);
 void cm55_ipc_pipe_set_data_received_callback(cm55_ipc_data_received_cb_t cb);
 
 /**
- * Start pipe and RX path: creates send queue, runs communication setup, waits startup_delay_ms,
- * registers callback, creates sender task. On failure caller must treat as error and disable
- * interrupts. Returns false on queue or register or task create failure.
+ * Start pipe and RX path: creates send buffer and TX ring, runs communication setup, waits
+ * startup_delay_ms, registers the doorbell handler (which feeds cb), creates sender task. On failure caller must treat as error and disable
+ * interrupts. Returns false on buffer or register or task create failure.
  */
 bool cm55_ipc_pipe_start(cm55_ipc_data_received_cb_t cb);
 
 /**
- * Enqueue a request to CM33 (cmd from ipc_communication.h, data/data_len). Returns false if queue
- * full or not initialized.
+ * Enqueue a request to CM33 (cmd from ipc_communication.h, data/data_len). Only data_len bytes are
+ * copied. Task context only. Returns false if the send buffer is full or not initialized.
  */
 bool cm55_ipc_pipe_push_request(uint32_t cmd, const void *data, uint32_t data_len);
 
+/**
+ * Like cm55_ipc_pipe_push_request, but sends call_id in the frame's value field. CM33 echoes a
+ * non-zero call_id in the event that answers a Wi-Fi request (see IPC_CALL_ID_NONE in
+ * ipc_communication.h); cm55_ipc_app matches replies to pending calls with it.
+ */
+bool cm55_ipc_pipe_push_call(uint32_t cmd, uint32_t call_id, const void *data, uint32_t data_len);
+
+/**
+ * Like cm55_ipc_pipe_push_request, but never waits: returns false at once if another writer holds
+ * the lane or the lane is full, whatever its drop policy. For senders that must not stall, such as
+ * the event bridge flush in the timer task.
+ */
+bool cm55_ipc_pipe_try_push_request(uint32_t cmd, const void *data, uint32_t data_len);
+
+/**
+ * Number of times the sender task ran out of CM33 credits and had to wait for CM33 to drain its
+ * receive ring. Grows under sustained floods; flat in normal operation.
+ */
+uint32_t cm55_ipc_pipe_get_credit_stalls(void);
+
+/**
+ * Number of times the bulk lane held back because CM33 reported a receive backlog of
+ * IPC_RING_BACKLOG_THROTTLE frames or more. Control frames are never throttled.
+ */
+uint32_t cm55_ipc_pipe_get_bulk_throttles(void);
+
+/**
+ * Frames CM33 has taken out of the ring but not yet dispatched, and (peak may be NULL) the highest
+ * such count since CM33 last reset its receive statistics. Read straight from shared memory; any
+ * context. Returns false for NULL backlog.
+ */
+bool cm55_ipc_pipe_get_peer_backlog(uint32_t *backlog, uint32_t *peak);
+
+/**
+ * Copies the counters and enqueue-to-ring latency histogram of one send lane (see ipc_lane.h).
+ * Returns false for an invalid lane or NULL stats.
+ */
+bool cm55_ipc_pipe_get_lane_stats(ipc_lane_t lane, ipc_lane_stats_t *stats);
+
+/**
+ * Copies the CM55 counters of one command: frames sent, dropped at enqueue, received and lost to a
+ * full dispatch queue, plus enqueue-to-send, transit and receive-to-dispatch latency histograms (see
+ * ipc_stats.h). Returns false for NULL stats.
+ */
+bool cm55_ipc_pipe_get_cmd_stats(uint32_t cmd, ipc_stats_cmd_t *stats);
+
+/**
+ * Clears the per-command counters of cm55_ipc_pipe_get_cmd_stats().
+ */
+void cm55_ipc_pipe_reset_cmd_stats(void);
+
+/**
+ * Copies the state of the timebase shared with CM33: the offset of the CM55 clock and the round trip
+ * of the last accepted sync exchange. If the last sync is IPC_STATS_SYNC_MAX_AGE_MS old, also asks
+ * the sender task for a new one, which a later call reports. Returns false for NULL sync.
+ */
+bool cm55_ipc_pipe_get_time_sync(ipc_stats_sync_t *sync);
+
+/**
+ * CM33 blackboard (see ipc_blackboard.h), or NULL until the first CM33 doorbell after start. Read
+ * its slots with ipc_blackboard_read(); any context.
+ */
+const ipc_blackboard_t *cm55_ipc_pipe_get_blackboard(void);
+
+/**
+ * Sets the thresholds and callback of the CM33 liveness check (see ipc_liveness.h); config NULL
+ * restores the defaults (no callback). The sender task beats the CM55 record on every pass and
+ * checks the CM33 record when it runs anyway; CM33 owes a beat while busy, while frames of an earlier
+ * pass are still in the ring or while CM55 waits for credits. The callback runs in the sender task
+ * and must not push requests. Any task.
+ */
+void cm55_ipc_pipe_set_liveness_config(const ipc_liveness_config_t *config);
+
+/**
+ * CM33 liveness at the last check. Returns false for NULL status or until CM33 has rung with its
+ * record.
+ */
+bool cm55_ipc_pipe_get_peer_liveness(ipc_liveness_status_t *status);
+
+/**
+ * Beats of the CM55 record so far.
+ */
+uint32_t cm55_ipc_pipe_get_liveness_counter(void);
+
+/**
+ * Marks the CM55 record IPC_LIVENESS_FAULT for good, so CM33 reports the fault without waiting for a
+ * timeout. Called by cm55_handle_fatal_error(); safe with interrupts disabled.
+ */
+void cm55_ipc_pipe_set_fault(void);
+
 #endif /* CM55_IPC_PIPE_H */
@@ -29,6 +29,7 @@
 #define PASSWORD "111122134"
 
 #define STARTUP_WIFI_DELAY_MS (3000U)
+#define STARTUP_WIFI_CONNECT_TIMEOUT_MS (30000U)
 #define STARTUP_WIFI_TASK_STACK (256U)
 
 static void display_tick_cb(const system_tick_hook_params_t *params)
@@ -39,10 +40,15 @@ static void display_tick_cb(const system_tick_hook_params_t *params)
 
 static void startup_wifi_task(void *arg)
 {
+  uint32_t call_id;
+
   (void)arg;
   vTaskDelay(pdMS_TO_TICKS(STARTUP_WIFI_DELAY_MS));
-  cm55_trigger_connect(SSID, PASSWORD, 0U);
-  cm55_trigger_status_request();
+  call_id = cm55_call_connect(SSID, PASSWORD, 0U, STARTUP_WIFI_CONNECT_TIMEOUT_MS, NULL, NULL);
+  if (IPC_CALL_ID_NONE != call_id)
+  {
+    (void)cm55_call_wait(call_id, NULL);
+  }
   vTaskDelete(NULL);
 }
 
@@ -118,7 +118,8 @@ static void example_1_subscriber_task(void *pvParameters) {
   tesa_event_t *event = NULL;
 
   for (;;) {
-    if (pdTRUE == xQueueReceive(queue, &event, pdMS_TO_TICKS(1000U))) {
+    if (pdTRUE ==
+        tesa_event_bus_receive(queue, &event, pdMS_TO_TICKS(1000U))) {
       if (NULL != event) {
         switch (event->event_type) {
         case EXAMPLE_1_EVENT_HELLO:
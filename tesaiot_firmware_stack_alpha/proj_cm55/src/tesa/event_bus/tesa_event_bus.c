@@ -3,32 +3,203 @@
 #include "portmacro.h"
 #include <string.h>
 
+#if (0 != TESA_EVENT_BUS_TRACE_ENABLE)
+#include TESA_EVENT_BUS_TRACE_CLOCK_HEADER
+#endif
+
+/* A pool block: the event, its free-list link and the number of subscriber
+ * queues still holding it, then the payload area (the class size, rounded up)
+ * at TESA_EVENT_BUS_BLOCK_HEADER_SIZE. The event is the first member, so a
+ * tesa_event_t pointer is the block address. Tracing adds the post time and
+ * the registry index of the channel.
+ */
+typedef struct tesa_event_block {
+  tesa_event_t event;
+  struct tesa_event_block *next;
+  uint8_t references;
+#if (0 != TESA_EVENT_BUS_TRACE_ENABLE)
+  uint8_t trace_channel;
+  uint32_t post_us;
+#endif
+} tesa_event_block_t;
+
+#define TESA_EVENT_BUS_BLOCK_ALIGN 8U
+#define TESA_EVENT_BUS_ALIGN_UP(size)                                          \
+  ((((size_t)(size)) + (TESA_EVENT_BUS_BLOCK_ALIGN - 1U)) &                     \
+   ~((size_t)TESA_EVENT_BUS_BLOCK_ALIGN - 1U))
+#define TESA_EVENT_BUS_BLOCK_HEADER_SIZE                                       \
+  TESA_EVENT_BUS_ALIGN_UP(sizeof(tesa_event_block_t))
+#define TESA_EVENT_BUS_BLOCK_STRIDE(payload_size)                              \
+  (TESA_EVENT_BUS_BLOCK_HEADER_SIZE + TESA_EVENT_BUS_ALIGN_UP(payload_size))
+#define TESA_EVENT_BUS_POOL_WORDS(payload_size, count)                         \
+  ((TESA_EVENT_BUS_BLOCK_STRIDE(payload_size) * (size_t)(count)) /             \
+   sizeof(uint64_t))
+
+typedef struct {
+  uint8_t *storage;
+  size_t stride;
+  tesa_event_block_t *free_list;
+  tesa_event_bus_pool_stats_t stats;
+} tesa_event_pool_t;
+
 static tesa_event_channel_t channel_registry[TESA_EVENT_BUS_MAX_CHANNELS];
-static tesa_event_t event_pool[TESA_EVENT_BUS_EVENT_POOL_SIZE];
-static bool event_pool_used[TESA_EVENT_BUS_EVENT_POOL_SIZE];
-static uint8_t payload_buffers[TESA_EVENT_BUS_EVENT_POOL_SIZE]
-                              [TESA_EVENT_BUS_PAYLOAD_BUFFER_SIZE];
-static bool payload_buffer_used[TESA_EVENT_BUS_EVENT_POOL_SIZE];
+static uint64_t small_pool_storage[TESA_EVENT_BUS_POOL_WORDS(
+    TESA_EVENT_BUS_POOL_SMALL_SIZE, TESA_EVENT_BUS_POOL_SMALL_COUNT)];
+static uint64_t medium_pool_storage[TESA_EVENT_BUS_POOL_WORDS(
+    TESA_EVENT_BUS_POOL_MEDIUM_SIZE, TESA_EVENT_BUS_POOL_MEDIUM_COUNT)];
+static uint64_t large_pool_storage[TESA_EVENT_BUS_POOL_WORDS(
+    TESA_EVENT_BUS_POOL_LARGE_SIZE, TESA_EVENT_BUS_POOL_LARGE_COUNT)];
+static tesa_event_pool_t event_pools[TESA_EVENT_BUS_POOL_CLASS_COUNT] = {
+    [TESA_EVENT_BUS_POOL_CLASS_SMALL] =
+        {.storage = (uint8_t *)small_pool_storage,
+         .stride = TESA_EVENT_BUS_BLOCK_STRIDE(TESA_EVENT_BUS_POOL_SMALL_SIZE),
+         .stats = {.payload_size = TESA_EVENT_BUS_POOL_SMALL_SIZE,
+                   .block_count = TESA_EVENT_BUS_POOL_SMALL_COUNT}},
+    [TESA_EVENT_BUS_POOL_CLASS_MEDIUM] =
+        {.storage = (uint8_t *)medium_pool_storage,
+         .stride = TESA_EVENT_BUS_BLOCK_STRIDE(TESA_EVENT_BUS_POOL_MEDIUM_SIZE),
+         .stats = {.payload_size = TESA_EVENT_BUS_POOL_MEDIUM_SIZE,
+                   .block_count = TESA_EVENT_BUS_POOL_MEDIUM_COUNT}},
+    [TESA_EVENT_BUS_POOL_CLASS_LARGE] =
+        {.storage = (uint8_t *)large_pool_storage,
+         .stride = TESA_EVENT_BUS_BLOCK_STRIDE(TESA_EVENT_BUS_POOL_LARGE_SIZE),
+         .stats = {.payload_size = TESA_EVENT_BUS_POOL_LARGE_SIZE,
+                   .block_count = TESA_EVENT_BUS_POOL_LARGE_COUNT}}};
 static bool event_bus_initialized = false;
 static uint8_t registered_channel_count = 0;
-
-static tesa_event_t
-    *post_events_buffer[TESA_EVENT_BUS_MAX_SUBSCRIBERS_PER_CHANNEL];
-static void *post_payloads_buffer[TESA_EVENT_BUS_MAX_SUBSCRIBERS_PER_CHANNEL];
-
-static tesa_event_t *allocate_event(void);
-static void free_event(tesa_event_t *event);
-static void *allocate_payload(size_t size);
-static void *allocate_payload_from_isr(size_t size);
-static void free_payload(void *payload);
+static const tesa_event_bus_bridge_t *event_bus_bridge = NULL;
+
+/* Open-addressed (linear probing) index of channel_registry by channel ID.
+ * A slot holds the registry index + 1; 0 is empty. */
+static uint8_t channel_hash[TESA_EVENT_BUS_CHANNEL_HASH_SIZE];
+#define TESA_EVENT_BUS_CHANNEL_HASH(channel_id)                                \
+  ((((uint32_t)(channel_id) * 0x9E3779B1UL) >> 16) &                           \
+   ((uint32_t)TESA_EVENT_BUS_CHANNEL_HASH_SIZE - 1U))
+
+/* A latest-value subscriber's slot. event is what its queue receives as the
+ * notification (payload stays NULL); the value itself is read with
+ * tesa_event_bus_read_latest(). pending is set when a notification is queued
+ * and cleared by the read. */
+typedef struct {
+  tesa_event_t event;
+  QueueHandle_t queue;
+  uint32_t sequence;
+  bool in_use;
+  bool pending;
+#if (0 != TESA_EVENT_BUS_TRACE_ENABLE)
+  uint32_t post_us;
+#endif
+  uint64_t payload[(TESA_EVENT_BUS_LATEST_PAYLOAD_SIZE + 7U) / 8U];
+} tesa_event_latest_slot_t;
+
+static tesa_event_latest_slot_t latest_slots[TESA_EVENT_BUS_LATEST_SLOT_COUNT];
+
+/* One subscriber as a post sees it: queue, filter callback and latest-value
+ * slot (index + 1, 0 for none) copied from the channel, and what happened at
+ * the queue. */
+typedef struct {
+  QueueHandle_t queue;
+  tesa_event_bus_filter_fn_t accept;
+  void *context;
+  uint8_t slot;
+  uint8_t dropped;
+  bool delivered;
+  bool filtered;
+#if (0 != TESA_EVENT_BUS_TRACE_ENABLE)
+  uint16_t depth;
+#endif
+} tesa_event_post_target_t;
+
+/* One post in flight: the channel's subscribers and config, copied under one
+ * short critical section, and what happened at each queue. It lives on the
+ * poster's stack, so posts from several tasks and ISRs share no state and the
+ * fan-out runs without a lock while others subscribe, unsubscribe or post.
+ */
+typedef struct {
+  tesa_event_channel_t *channel;
+  tesa_event_channel_id_t channel_id;
+  tesa_event_post_target_t targets[TESA_EVENT_BUS_MAX_SUBSCRIBERS_PER_CHANNEL];
+  uint8_t subscriber_count;
+  tesa_event_bus_queue_policy_t policy;
+  TickType_t timeout;
+  const tesa_event_bus_bridge_t *bridge;
+#if (0 != TESA_EVENT_BUS_TRACE_ENABLE)
+  uint32_t post_us;
+#endif
+} tesa_event_post_t;
+
+#if (0 != TESA_EVENT_BUS_TRACE_ENABLE)
+typedef struct {
+  TaskHandle_t task;
+  char name[TESA_EVENT_BUS_TRACE_NAME_LENGTH];
+  uint32_t posts;
+} tesa_event_trace_producer_t;
+
+/* Trace of one channel_registry entry; subscriber entries follow the
+ * channel's subscriber order. depth is the most events a subscriber queue
+ * held right after a post. blocks_in_use counts pool blocks posted on the
+ * channel and not yet freed. */
+typedef struct {
+  tesa_event_bus_latency_hist_t latency;
+  tesa_event_bus_latency_hist_t
+      subscriber_latency[TESA_EVENT_BUS_MAX_SUBSCRIBERS_PER_CHANNEL];
+  uint16_t subscriber_peak_depth[TESA_EVENT_BUS_MAX_SUBSCRIBERS_PER_CHANNEL];
+  tesa_event_trace_producer_t producers[TESA_EVENT_BUS_TRACE_PRODUCERS];
+  uint8_t producer_count;
+  uint32_t other_producer_posts;
+  uint32_t allocations;
+  uint16_t blocks_in_use;
+  uint16_t blocks_high_water;
+} tesa_event_channel_trace_t;
+
+static tesa_event_channel_trace_t channel_trace[TESA_EVENT_BUS_MAX_CHANNELS];
+#endif
+
+static void init_event_pools(void);
+static tesa_event_t *allocate_event(size_t payload_size, bool from_isr);
+static void set_event_references(tesa_event_t *event, uint8_t references);
+static void release_event(tesa_event_t *event, bool from_isr);
+static BaseType_t send_drop_oldest(QueueHandle_t queue, tesa_event_t *event,
+                                   bool from_isr, bool *displaced,
+                                   BaseType_t *higher_priority_task_woken);
+static bool snapshot_channel(tesa_event_channel_id_t channel_id,
+                             tesa_event_type_t event_type,
+                             tesa_event_post_t *post, bool from_isr);
+static void notify_subscribers_changed(tesa_event_channel_id_t channel_id,
+                                       uint8_t subscriber_count,
+                                       const tesa_event_bus_bridge_t *bridge);
+static uint8_t apply_filters(tesa_event_post_t *post,
+                             tesa_event_type_t event_type, const void *payload,
+                             size_t payload_size);
+static bool fan_out(tesa_event_post_t *post, tesa_event_t *event,
+                    bool from_isr, BaseType_t *higher_priority_task_woken);
+static uint8_t acquire_latest_slot(tesa_event_channel_id_t channel_id,
+                                   QueueHandle_t queue_handle);
+static bool conflate(tesa_event_post_t *post, const tesa_event_t *header,
+                     const void *payload, bool from_isr,
+                     BaseType_t *higher_priority_task_woken);
+static void commit_post_stats(const tesa_event_post_t *post,
+                              uint32_t timestamp_ms, bool from_isr);
 static tesa_event_channel_t *find_channel(tesa_event_channel_id_t channel_id);
+static void index_channel(uint8_t registry_index);
+static void rebuild_channel_hash(void);
 static uint32_t get_system_time_ms(void);
 static uint32_t get_system_time_ms_from_isr(void);
-static void update_subscriber_stats(tesa_event_channel_t *channel,
-                                    uint8_t index, bool success);
 static void update_subscriber_stats_with_time(tesa_event_channel_t *channel,
                                               uint8_t index, bool success,
                                               uint32_t timestamp_ms);
+#if (0 != TESA_EVENT_BUS_TRACE_ENABLE)
+static void trace_block_acquired(const tesa_event_post_t *post,
+                                 tesa_event_t *event, bool from_isr);
+static void trace_count_producer(tesa_event_channel_trace_t *trace,
+                                 bool from_isr);
+static void trace_receive(QueueHandle_t queue_handle,
+                          const tesa_event_t *event);
+static void trace_put_u16(uint8_t **cursor, uint16_t value);
+static void trace_put_u32(uint8_t **cursor, uint32_t value);
+static void trace_put_hist(uint8_t **cursor,
+                           const tesa_event_bus_latency_hist_t *hist);
+#endif
 
 tesa_event_bus_result_t tesa_event_bus_init(void) {
   if (false != event_bus_initialized) {
@@ -39,29 +210,43 @@ tesa_event_bus_result_t tesa_event_bus_init(void) {
     channel_registry[i].channel_id = 0U;
     channel_registry[i].channel_name = NULL;
     channel_registry[i].registered = false;
+    channel_registry[i].remote = false;
     channel_registry[i].subscriber_count = 0U;
     channel_registry[i].config.queue_policy = TESA_EVENT_BUS_QUEUE_DROP_NEWEST;
     channel_registry[i].config.queue_timeout_ticks =
         pdMS_TO_TICKS(TESA_EVENT_BUS_DEFAULT_QUEUE_TIMEOUT_MS);
     for (uint8_t j = 0U; j < TESA_EVENT_BUS_MAX_SUBSCRIBERS_PER_CHANNEL; j++) {
       channel_registry[i].subscribers[j] = NULL;
+      channel_registry[i].subscriber_filters[j].type_mask =
+          TESA_EVENT_BUS_FILTER_ALL_TYPES;
+      channel_registry[i].subscriber_filters[j].accept = NULL;
+      channel_registry[i].subscriber_filters[j].context = NULL;
+      channel_registry[i].subscriber_slots[j] = 0U;
       channel_registry[i].subscriber_stats[j].posts_successful = 0U;
       channel_registry[i].subscriber_stats[j].posts_dropped = 0U;
+      channel_registry[i].subscriber_stats[j].posts_filtered = 0U;
       channel_registry[i].subscriber_stats[j].last_drop_timestamp_ms = 0U;
     }
   }
 
-  for (uint8_t i = 0U; i < TESA_EVENT_BUS_MAX_SUBSCRIBERS_PER_CHANNEL; i++) {
-    post_events_buffer[i] = NULL;
-    post_payloads_buffer[i] = NULL;
+  for (uint16_t i = 0U; i < TESA_EVENT_BUS_CHANNEL_HASH_SIZE; i++) {
+    channel_hash[i] = 0U;
   }
 
-  for (uint8_t i = 0U; i < TESA_EVENT_BUS_EVENT_POOL_SIZE; i++) {
-    event_pool_used[i] = false;
-    payload_buffer_used[i] = false;
+  for (uint8_t i = 0U; i < TESA_EVENT_BUS_LATEST_SLOT_COUNT; i++) {
+    latest_slots[i].in_use = false;
+    latest_slots[i].pending = false;
+    latest_slots[i].queue = NULL;
   }
 
+  init_event_pools();
+
+#if (0 != TESA_EVENT_BUS_TRACE_ENABLE)
+  (void)memset(channel_trace, 0, sizeof(channel_trace));
+#endif
+
   registered_channel_count = 0U;
+  event_bus_bridge = NULL;
   event_bus_initialized = true;
 
   return TESA_EVENT_BUS_SUCCESS;
@@ -113,14 +298,20 @@ tesa_event_bus_result_t tesa_event_bus_register_channel_with_config(
       channel_registry[i].channel_id = channel_id;
       channel_registry[i].channel_name = channel_name;
       channel_registry[i].registered = true;
+      channel_registry[i].remote = false;
       channel_registry[i].subscriber_count = 0U;
       channel_registry[i].config = *config;
       for (uint8_t j = 0U; j < TESA_EVENT_BUS_MAX_SUBSCRIBERS_PER_CHANNEL;
            j++) {
         channel_registry[i].subscriber_stats[j].posts_successful = 0;
         channel_registry[i].subscriber_stats[j].posts_dropped = 0;
+        channel_registry[i].subscriber_stats[j].posts_filtered = 0;
         channel_registry[i].subscriber_stats[j].last_drop_timestamp_ms = 0;
       }
+#if (0 != TESA_EVENT_BUS_TRACE_ENABLE)
+      (void)memset(&channel_trace[i], 0, sizeof(channel_trace[i]));
+#endif
+      index_channel(i);
       registered_channel_count++;
       taskEXIT_CRITICAL();
       return TESA_EVENT_BUS_SUCCESS;
@@ -152,26 +343,107 @@ tesa_event_bus_unregister_channel(tesa_event_channel_id_t channel_id) {
   }
 
   channel->registered = false;
+  channel->remote = false;
   channel->channel_id = 0U;
   channel->channel_name = NULL;
   channel->subscriber_count = 0U;
   if (0U < registered_channel_count) {
     registered_channel_count--;
   }
+  rebuild_channel_hash();
+
+  taskEXIT_CRITICAL();
+  return TESA_EVENT_BUS_SUCCESS;
+}
+
+tesa_event_bus_result_t
+tesa_event_bus_set_bridge(const tesa_event_bus_bridge_t *bridge) {
+  if ((false == event_bus_initialized) ||
+      ((NULL != bridge) && (NULL == bridge->forward))) {
+    return TESA_EVENT_BUS_ERROR_INVALID_PARAM;
+  }
+
+  taskENTER_CRITICAL();
+  event_bus_bridge = bridge;
+  taskEXIT_CRITICAL();
+
+  /* Remote channels that already have subscribers are announced to it */
+  for (uint8_t i = 0U; (NULL != bridge) && (i < TESA_EVENT_BUS_MAX_CHANNELS);
+       i++) {
+    taskENTER_CRITICAL();
+    tesa_event_channel_t *channel = &channel_registry[i];
+    bool announce = (false != channel->registered) &&
+                    (false != channel->remote) &&
+                    (0U < channel->subscriber_count);
+    tesa_event_channel_id_t channel_id = channel->channel_id;
+    uint8_t subscriber_count = channel->subscriber_count;
+    taskEXIT_CRITICAL();
+
+    if (false != announce) {
+      notify_subscribers_changed(channel_id, subscriber_count, bridge);
+    }
+  }
+  return TESA_EVENT_BUS_SUCCESS;
+}
+
+/* A remote channel's posts are also handed to the bridge, and the bridge hears
+ * when its subscriber count changes; turning remote off reports 0. */
+tesa_event_bus_result_t
+tesa_event_bus_set_channel_remote(tesa_event_channel_id_t channel_id,
+                                  bool remote) {
+  const tesa_event_bus_bridge_t *bridge = NULL;
+  uint8_t subscriber_count = 0U;
+  bool changed = false;
+
+  if ((false == event_bus_initialized) || (0U == channel_id)) {
+    return TESA_EVENT_BUS_ERROR_INVALID_PARAM;
+  }
+
+  taskENTER_CRITICAL();
+
+  tesa_event_channel_t *channel = find_channel(channel_id);
+  if ((NULL == channel) || (false == channel->registered)) {
+    taskEXIT_CRITICAL();
+    return TESA_EVENT_BUS_ERROR_CHANNEL_NOT_FOUND;
+  }
+
+  changed = (remote != channel->remote) && (0U < channel->subscriber_count);
+  channel->remote = remote;
+  subscriber_count = (false != remote) ? channel->subscriber_count : 0U;
+  bridge = event_bus_bridge;
 
   taskEXIT_CRITICAL();
+
+  if (false != changed) {
+    notify_subscribers_changed(channel_id, subscriber_count, bridge);
+  }
   return TESA_EVENT_BUS_SUCCESS;
 }
 
 tesa_event_bus_result_t
 tesa_event_bus_subscribe(tesa_event_channel_id_t channel_id,
                          QueueHandle_t queue_handle) {
+  return tesa_event_bus_subscribe_with_filter(channel_id, queue_handle, NULL);
+}
+
+tesa_event_bus_result_t
+tesa_event_bus_subscribe_with_filter(tesa_event_channel_id_t channel_id,
+                                     QueueHandle_t queue_handle,
+                                     const tesa_event_bus_filter_t *filter) {
 
   if ((false == event_bus_initialized) || (0U == channel_id) ||
       (NULL == queue_handle)) {
     return TESA_EVENT_BUS_ERROR_INVALID_PARAM;
   }
 
+  tesa_event_bus_filter_t accept_all = {
+      .type_mask = TESA_EVENT_BUS_FILTER_ALL_TYPES,
+      .accept = NULL,
+      .context = NULL};
+  if (NULL == filter) {
+    filter = &accept_all;
+  }
+
   taskENTER_CRITICAL();
 
   tesa_event_channel_t *channel = find_channel(channel_id);
@@ -180,8 +452,10 @@ tesa_event_bus_subscribe(tesa_event_channel_id_t channel_id,
     return TESA_EVENT_BUS_ERROR_CHANNEL_NOT_FOUND;
   }
 
+  /* Subscribing again replaces the filter */
   for (uint8_t i = 0U; i < channel->subscriber_count; i++) {
     if (queue_handle == channel->subscribers[i]) {
+      channel->subscriber_filters[i] = *filter;
       taskEXIT_CRITICAL();
       return TESA_EVENT_BUS_SUCCESS;
     }
@@ -192,10 +466,39 @@ tesa_event_bus_subscribe(tesa_event_channel_id_t channel_id,
     return TESA_EVENT_BUS_ERROR_SUBSCRIBER_FULL;
   }
 
-  channel->subscribers[channel->subscriber_count] = queue_handle;
+  uint8_t index = channel->subscriber_count;
+  uint8_t slot = 0U;
+  if (TESA_EVENT_BUS_QUEUE_LATEST_VALUE == channel->config.queue_policy) {
+    slot = acquire_latest_slot(channel_id, queue_handle);
+    if (0U == slot) {
+      taskEXIT_CRITICAL();
+      return TESA_EVENT_BUS_ERROR_MEMORY;
+    }
+  }
+
+  channel->subscribers[index] = queue_handle;
+  channel->subscriber_filters[index] = *filter;
+  channel->subscriber_slots[index] = slot;
+  channel->subscriber_stats[index].posts_successful = 0U;
+  channel->subscriber_stats[index].posts_dropped = 0U;
+  channel->subscriber_stats[index].posts_filtered = 0U;
+  channel->subscriber_stats[index].last_drop_timestamp_ms = 0U;
+#if (0 != TESA_EVENT_BUS_TRACE_ENABLE)
+  tesa_event_channel_trace_t *trace =
+      &channel_trace[channel - channel_registry];
+  (void)memset(&trace->subscriber_latency[index], 0,
+               sizeof(trace->subscriber_latency[index]));
+  trace->subscriber_peak_depth[index] = 0U;
+#endif
   channel->subscriber_count++;
 
+  const tesa_event_bus_bridge_t *bridge =
+      (false != channel->remote) ? event_bus_bridge : NULL;
+  uint8_t subscriber_count = channel->subscriber_count;
+
   taskEXIT_CRITICAL();
+
+  notify_subscribers_changed(channel_id, subscriber_count, bridge);
   return TESA_EVENT_BUS_SUCCESS;
 }
 
@@ -218,12 +521,33 @@ tesa_event_bus_unsubscribe(tesa_event_channel_id_t channel_id,
 
   for (uint8_t i = 0U; i < channel->subscriber_count; i++) {
     if (queue_handle == channel->subscribers[i]) {
+      if (0U != channel->subscriber_slots[i]) {
+        latest_slots[channel->subscriber_slots[i] - 1U].in_use = false;
+        latest_slots[channel->subscriber_slots[i] - 1U].queue = NULL;
+      }
       for (uint8_t j = i; j < (channel->subscriber_count - 1U); j++) {
         channel->subscribers[j] = channel->subscribers[j + 1];
+        channel->subscriber_filters[j] = channel->subscriber_filters[j + 1];
+        channel->subscriber_slots[j] = channel->subscriber_slots[j + 1];
+        channel->subscriber_stats[j] = channel->subscriber_stats[j + 1];
+#if (0 != TESA_EVENT_BUS_TRACE_ENABLE)
+        tesa_event_channel_trace_t *trace =
+            &channel_trace[channel - channel_registry];
+        trace->subscriber_latency[j] = trace->subscriber_latency[j + 1];
+        trace->subscriber_peak_depth[j] = trace->subscriber_peak_depth[j + 1];
+#endif
       }
       channel->subscribers[channel->subscriber_count - 1] = NULL;
+      channel->subscriber_slots[channel->subscriber_count - 1] = 0U;
       channel->subscriber_count--;
+
+      const tesa_event_bus_bridge_t *bridge =
+          (false != channel->remote) ? event_bus_bridge : NULL;
+      uint8_t subscriber_count = channel->subscriber_count;
+
       taskEXIT_CRITICAL();
+
+      notify_subscribers_changed(channel_id, subscriber_count, bridge);
       return TESA_EVENT_BUS_SUCCESS;
     }
   }
@@ -236,6 +560,8 @@ tesa_event_bus_result_t tesa_event_bus_post(tesa_event_channel_id_t channel_id,
                                             tesa_event_type_t event_type,
                                             const void *payload,
                                             size_t payload_size) {
+  tesa_event_post_t post;
+  bool all_queues_ok = true;
 
   if ((false == event_bus_initialized) || (0U == channel_id)) {
     return TESA_EVENT_BUS_ERROR_INVALID_PARAM;
@@ -249,127 +575,57 @@ tesa_event_bus_result_t tesa_event_bus_post(tesa_event_channel_id_t channel_id,
     return TESA_EVENT_BUS_ERROR_INVALID_PARAM;
   }
 
-  taskENTER_CRITICAL();
-
-  tesa_event_channel_t *channel = find_channel(channel_id);
-  if ((NULL == channel) || (false == channel->registered)) {
-    taskEXIT_CRITICAL();
+  if (false == snapshot_channel(channel_id, event_type, &post, false)) {
     return TESA_EVENT_BUS_ERROR_CHANNEL_NOT_FOUND;
   }
 
-  if (0U == channel->subscriber_count) {
-    taskEXIT_CRITICAL();
-    return TESA_EVENT_BUS_SUCCESS;
+  if ((TESA_EVENT_BUS_QUEUE_LATEST_VALUE == post.policy) &&
+      (TESA_EVENT_BUS_LATEST_PAYLOAD_SIZE < payload_size)) {
+    return TESA_EVENT_BUS_ERROR_PAYLOAD_TOO_LARGE;
   }
 
-  uint32_t timestamp_ms = get_system_time_ms();
-  TaskHandle_t source_task = xTaskGetCurrentTaskHandle();
-  uint8_t subscriber_count = channel->subscriber_count;
-  tesa_event_bus_queue_policy_t policy = channel->config.queue_policy;
-  TickType_t timeout = channel->config.queue_timeout_ticks;
-
-  taskEXIT_CRITICAL();
-
-  for (uint8_t i = 0U; i < subscriber_count; i++) {
-    post_events_buffer[i] = allocate_event();
-    if (NULL == post_events_buffer[i]) {
-      for (uint8_t j = 0U; j < i; j++) {
-        free_event(post_events_buffer[j]);
-        post_events_buffer[j] = NULL;
-      }
-      return TESA_EVENT_BUS_ERROR_MEMORY;
-    }
-
-    post_events_buffer[i]->channel_id = channel_id;
-    post_events_buffer[i]->event_type = event_type;
-    post_events_buffer[i]->payload_size = payload_size;
-    post_events_buffer[i]->timestamp_ms = timestamp_ms;
-    post_events_buffer[i]->source_task = source_task;
-    post_events_buffer[i]->from_isr = false;
-
-    if ((NULL != payload) && (0U < payload_size)) {
-      post_payloads_buffer[i] = allocate_payload(payload_size);
-      if (NULL == post_payloads_buffer[i]) {
-        for (uint8_t j = 0U; j <= i; j++) {
-          free_event(post_events_buffer[j]);
-          post_events_buffer[j] = NULL;
-        }
-        for (uint8_t j = 0U; j < i; j++) {
-          free_payload(post_payloads_buffer[j]);
-          post_payloads_buffer[j] = NULL;
-        }
-        return TESA_EVENT_BUS_ERROR_MEMORY;
-      }
-      (void)memcpy(post_payloads_buffer[i], payload, payload_size);
-      post_events_buffer[i]->payload = post_payloads_buffer[i];
-    } else {
-      post_payloads_buffer[i] = NULL;
-      post_events_buffer[i]->payload = NULL;
-    }
+  /* Handed over whether or not any local subscriber takes the event */
+  if (NULL != post.bridge) {
+    (void)post.bridge->forward(channel_id, event_type, payload, payload_size,
+                               false);
   }
 
-  BaseType_t all_queues_ok = pdTRUE;
-  BaseType_t any_queues_ok = pdFALSE;
-  for (uint8_t i = 0U; i < subscriber_count; i++) {
-    BaseType_t queue_result = pdFALSE;
+  if (0U == apply_filters(&post, event_type, payload, payload_size)) {
+    commit_post_stats(&post, get_system_time_ms(), false);
+    return TESA_EVENT_BUS_SUCCESS;
+  }
 
-    if (NULL == channel->subscribers[i]) {
-      all_queues_ok = pdFALSE;
-      taskENTER_CRITICAL();
-      update_subscriber_stats(channel, i, false);
-      taskEXIT_CRITICAL();
-      free_payload(post_events_buffer[i]->payload);
-      free_event(post_events_buffer[i]);
-      post_events_buffer[i] = NULL;
-      continue;
-    }
+  tesa_event_t header = {.channel_id = channel_id,
+                         .event_type = event_type,
+                         .payload = NULL,
+                         .payload_size = payload_size,
+                         .timestamp_ms = get_system_time_ms(),
+                         .source_task = xTaskGetCurrentTaskHandle(),
+                         .from_isr = false};
 
-    switch (policy) {
-    case TESA_EVENT_BUS_QUEUE_DROP_NEWEST:
-      queue_result =
-          xQueueSend(channel->subscribers[i], &post_events_buffer[i], 0);
-      break;
-    case TESA_EVENT_BUS_QUEUE_DROP_OLDEST:
-      queue_result =
-          xQueueOverwrite(channel->subscribers[i], &post_events_buffer[i]);
-      break;
-    case TESA_EVENT_BUS_QUEUE_NO_DROP:
-      queue_result =
-          xQueueSend(channel->subscribers[i], &post_events_buffer[i], timeout);
-      break;
-    case TESA_EVENT_BUS_QUEUE_WAIT:
-      queue_result =
-          xQueueSend(channel->subscribers[i], &post_events_buffer[i], timeout);
-      break;
-    default:
-      queue_result = pdFALSE;
-      break;
+  if (TESA_EVENT_BUS_QUEUE_LATEST_VALUE == post.policy) {
+    all_queues_ok = conflate(&post, &header, payload, false, NULL);
+  } else {
+    tesa_event_t *event = allocate_event(payload_size, false);
+    if (NULL == event) {
+      return TESA_EVENT_BUS_ERROR_MEMORY;
     }
 
-    if (pdTRUE != queue_result) {
-      all_queues_ok = pdFALSE;
-      taskENTER_CRITICAL();
-      update_subscriber_stats(channel, i, false);
-      taskEXIT_CRITICAL();
-      free_payload(post_events_buffer[i]->payload);
-      free_event(post_events_buffer[i]);
-      post_events_buffer[i] = NULL;
-    } else {
-      any_queues_ok = pdTRUE;
-      taskENTER_CRITICAL();
-      update_subscriber_stats(channel, i, true);
-      taskEXIT_CRITICAL();
+    header.payload = event->payload;
+    *event = header;
+    if (NULL != event->payload) {
+      (void)memcpy(event->payload, payload, payload_size);
     }
-  }
 
-  for (uint8_t i = 0U; i < subscriber_count; i++) {
-    post_events_buffer[i] = NULL;
-    post_payloads_buffer[i] = NULL;
+    all_queues_ok = fan_out(&post, event, false, NULL);
   }
+  commit_post_stats(&post, get_system_time_ms(), false);
 
-  if (pdTRUE != all_queues_ok) {
-    if (pdTRUE == any_queues_ok) {
-      return TESA_EVENT_BUS_ERROR_PARTIAL_SUCCESS;
+  if (false == all_queues_ok) {
+    for (uint8_t i = 0U; i < post.subscriber_count; i++) {
+      if (false != post.targets[i].delivered) {
+        return TESA_EVENT_BUS_ERROR_PARTIAL_SUCCESS;
+      }
     }
     return TESA_EVENT_BUS_ERROR_QUEUE_FULL;
   }
@@ -382,136 +638,72 @@ BaseType_t tesa_event_bus_post_from_isr(tesa_event_channel_id_t channel_id,
                                         const void *payload,
                                         size_t payload_size,
                                         BaseType_t *pxHigherPriorityTaskWoken) {
+  tesa_event_post_t post;
+  bool all_queues_ok = true;
 
   if ((false == event_bus_initialized) || (0U == channel_id) ||
       (NULL == pxHigherPriorityTaskWoken)) {
     return pdFALSE;
   }
 
-  BaseType_t xYieldRequired = pdFALSE;
-  BaseType_t xReturn = pdTRUE;
+  if ((TESA_EVENT_BUS_MAX_PAYLOAD_SIZE < payload_size) ||
+      ((0U < payload_size) && (NULL == payload))) {
+    return pdFALSE;
+  }
 
-  UBaseType_t saved_ux_saved_interrupt_status = taskENTER_CRITICAL_FROM_ISR();
+  if (false == snapshot_channel(channel_id, event_type, &post, true)) {
+    return pdFALSE;
+  }
 
-  tesa_event_channel_t *channel = find_channel(channel_id);
-  if ((NULL == channel) || (false == channel->registered)) {
-    taskEXIT_CRITICAL_FROM_ISR(saved_ux_saved_interrupt_status);
+  if ((TESA_EVENT_BUS_QUEUE_LATEST_VALUE == post.policy) &&
+      (TESA_EVENT_BUS_LATEST_PAYLOAD_SIZE < payload_size)) {
     return pdFALSE;
   }
 
-  if (0U == channel->subscriber_count) {
-    taskEXIT_CRITICAL_FROM_ISR(saved_ux_saved_interrupt_status);
+  if (NULL != post.bridge) {
+    (void)post.bridge->forward(channel_id, event_type, payload, payload_size,
+                               true);
+  }
+
+  if (0U == apply_filters(&post, event_type, payload, payload_size)) {
+    commit_post_stats(&post, get_system_time_ms_from_isr(), true);
     return pdTRUE;
   }
 
   uint32_t timestamp_ms = get_system_time_ms_from_isr();
-  uint8_t subscriber_count = channel->subscriber_count;
-  tesa_event_bus_queue_policy_t policy = channel->config.queue_policy;
-
-  for (uint8_t i = 0U; i < subscriber_count; i++) {
-    post_events_buffer[i] = allocate_event();
-    if (NULL == post_events_buffer[i]) {
-      for (uint8_t j = 0U; j < i; j++) {
-        free_event(post_events_buffer[j]);
-        post_events_buffer[j] = NULL;
-      }
-      taskEXIT_CRITICAL_FROM_ISR(saved_ux_saved_interrupt_status);
+  tesa_event_t header = {.channel_id = channel_id,
+                         .event_type = event_type,
+                         .payload = NULL,
+                         .payload_size = payload_size,
+                         .timestamp_ms = timestamp_ms,
+                         .source_task = NULL,
+                         .from_isr = true};
+  BaseType_t xHigherPriorityTaskWokenLocal = pdFALSE;
+
+  if (TESA_EVENT_BUS_QUEUE_LATEST_VALUE == post.policy) {
+    all_queues_ok = conflate(&post, &header, payload, true,
+                             &xHigherPriorityTaskWokenLocal);
+  } else {
+    tesa_event_t *event = allocate_event(payload_size, true);
+    if (NULL == event) {
       return pdFALSE;
     }
 
-    post_events_buffer[i]->channel_id = channel_id;
-    post_events_buffer[i]->event_type = event_type;
-    post_events_buffer[i]->payload_size = payload_size;
-    post_events_buffer[i]->timestamp_ms = timestamp_ms;
-    post_events_buffer[i]->source_task = NULL;
-    post_events_buffer[i]->from_isr = true;
-
-    if ((NULL != payload) && (0U < payload_size)) {
-      post_payloads_buffer[i] = allocate_payload_from_isr(payload_size);
-      if (NULL == post_payloads_buffer[i]) {
-        for (uint8_t j = 0U; j <= i; j++) {
-          free_event(post_events_buffer[j]);
-          post_events_buffer[j] = NULL;
-        }
-        for (uint8_t j = 0U; j < i; j++) {
-          free_payload(post_payloads_buffer[j]);
-          post_payloads_buffer[j] = NULL;
-        }
-        taskEXIT_CRITICAL_FROM_ISR(saved_ux_saved_interrupt_status);
-        return pdFALSE;
-      }
-      (void)memcpy(post_payloads_buffer[i], payload, payload_size);
-      post_events_buffer[i]->payload = post_payloads_buffer[i];
-    } else {
-      post_payloads_buffer[i] = NULL;
-      post_events_buffer[i]->payload = NULL;
-    }
-  }
-
-  taskEXIT_CRITICAL_FROM_ISR(saved_ux_saved_interrupt_status);
-
-  for (uint8_t i = 0U; i < subscriber_count; i++) {
-    BaseType_t xHigherPriorityTaskWokenLocal = pdFALSE;
-    BaseType_t queue_result = pdFALSE;
-
-    if (NULL == channel->subscribers[i]) {
-      xReturn = pdFALSE;
-      UBaseType_t saved_int_status = taskENTER_CRITICAL_FROM_ISR();
-      update_subscriber_stats_with_time(channel, i, false, timestamp_ms);
-      taskEXIT_CRITICAL_FROM_ISR(saved_int_status);
-      free_payload(post_events_buffer[i]->payload);
-      free_event(post_events_buffer[i]);
-      post_events_buffer[i] = NULL;
-      continue;
-    }
-
-    switch (policy) {
-    case TESA_EVENT_BUS_QUEUE_DROP_NEWEST:
-    case TESA_EVENT_BUS_QUEUE_NO_DROP:
-    case TESA_EVENT_BUS_QUEUE_WAIT:
-      queue_result =
-          xQueueSendFromISR(channel->subscribers[i], &post_events_buffer[i],
-                            &xHigherPriorityTaskWokenLocal);
-      break;
-    case TESA_EVENT_BUS_QUEUE_DROP_OLDEST:
-      queue_result = xQueueOverwriteFromISR(channel->subscribers[i],
-                                            &post_events_buffer[i],
-                                            &xHigherPriorityTaskWokenLocal);
-      break;
-    default:
-      queue_result = pdFALSE;
-      break;
+    header.payload = event->payload;
+    *event = header;
+    if (NULL != event->payload) {
+      (void)memcpy(event->payload, payload, payload_size);
     }
 
-    if (pdTRUE != queue_result) {
-      xReturn = pdFALSE;
-      UBaseType_t saved_int_status = taskENTER_CRITICAL_FROM_ISR();
-      update_subscriber_stats_with_time(channel, i, false, timestamp_ms);
-      taskEXIT_CRITICAL_FROM_ISR(saved_int_status);
-      free_payload(post_events_buffer[i]->payload);
-      free_event(post_events_buffer[i]);
-      post_events_buffer[i] = NULL;
-    } else {
-      UBaseType_t saved_int_status = taskENTER_CRITICAL_FROM_ISR();
-      update_subscriber_stats_with_time(channel, i, true, timestamp_ms);
-      taskEXIT_CRITICAL_FROM_ISR(saved_int_status);
-    }
-
-    if (pdTRUE == xHigherPriorityTaskWokenLocal) {
-      xYieldRequired = pdTRUE;
-    }
-  }
-
-  for (uint8_t i = 0U; i < subscriber_count; i++) {
-    post_events_buffer[i] = NULL;
-    post_payloads_buffer[i] = NULL;
+    all_queues_ok = fan_out(&post, event, true, &xHigherPriorityTaskWokenLocal);
   }
+  commit_post_stats(&post, timestamp_ms, true);
 
-  if (pdTRUE == xYieldRequired) {
+  if (pdTRUE == xHigherPriorityTaskWokenLocal) {
     *pxHigherPriorityTaskWoken = pdTRUE;
   }
 
-  return xReturn;
+  return (false != all_queues_ok) ? pdTRUE : pdFALSE;
 }
 
 uint32_t tesa_event_bus_get_timestamp_ms(void) { return get_system_time_ms(); }
@@ -521,8 +713,55 @@ void tesa_event_bus_free_event(tesa_event_t *event) {
     return;
   }
 
-  free_payload(event->payload);
-  free_event(event);
+  release_event(event, false);
+}
+
+tesa_event_bus_result_t
+tesa_event_bus_read_latest(tesa_event_channel_id_t channel_id,
+                           QueueHandle_t queue_handle, tesa_event_t *event,
+                           void *payload_buffer, size_t buffer_size,
+                           uint32_t *sequence) {
+
+  if ((false == event_bus_initialized) || (0U == channel_id) ||
+      (NULL == queue_handle) || (NULL == event) || (NULL == sequence) ||
+      ((0U < buffer_size) && (NULL == payload_buffer))) {
+    return TESA_EVENT_BUS_ERROR_INVALID_PARAM;
+  }
+
+  taskENTER_CRITICAL();
+
+  tesa_event_channel_t *channel = find_channel(channel_id);
+  if ((NULL == channel) || (false == channel->registered)) {
+    taskEXIT_CRITICAL();
+    return TESA_EVENT_BUS_ERROR_CHANNEL_NOT_FOUND;
+  }
+
+  for (uint8_t i = 0U; i < channel->subscriber_count; i++) {
+    if ((queue_handle == channel->subscribers[i]) &&
+        (0U != channel->subscriber_slots[i])) {
+      tesa_event_latest_slot_t *slot =
+          &latest_slots[channel->subscriber_slots[i] - 1U];
+
+      if (buffer_size < slot->event.payload_size) {
+        taskEXIT_CRITICAL();
+        return TESA_EVENT_BUS_ERROR_PAYLOAD_TOO_LARGE;
+      }
+
+      *event = slot->event;
+      event->payload = NULL;
+      if (0U < slot->event.payload_size) {
+        (void)memcpy(payload_buffer, slot->payload, slot->event.payload_size);
+        event->payload = payload_buffer;
+      }
+      *sequence = slot->sequence;
+      slot->pending = false;
+      taskEXIT_CRITICAL();
+      return TESA_EVENT_BUS_SUCCESS;
+    }
+  }
+
+  taskEXIT_CRITICAL();
+  return TESA_EVENT_BUS_ERROR_INVALID_QUEUE;
 }
 
 tesa_event_bus_result_t
@@ -575,6 +814,7 @@ tesa_event_bus_get_channel_stats(tesa_event_channel_id_t channel_id,
 
   total_stats->posts_successful = 0U;
   total_stats->posts_dropped = 0U;
+  total_stats->posts_filtered = 0U;
   total_stats->last_drop_timestamp_ms = 0U;
 
   for (uint8_t i = 0U; i < channel->subscriber_count; i++) {
@@ -583,6 +823,8 @@ tesa_event_bus_get_channel_stats(tesa_event_channel_id_t channel_id,
         channel->subscriber_stats[i].posts_successful;
     total_stats->posts_dropped =
         total_stats->posts_dropped + channel->subscriber_stats[i].posts_dropped;
+    total_stats->posts_filtered = total_stats->posts_filtered +
+                                  channel->subscriber_stats[i].posts_filtered;
     if (channel->subscriber_stats[i].last_drop_timestamp_ms >
         total_stats->last_drop_timestamp_ms) {
       total_stats->last_drop_timestamp_ms =
@@ -596,10 +838,212 @@ tesa_event_bus_get_channel_stats(tesa_event_channel_id_t channel_id,
   return TESA_EVENT_BUS_SUCCESS;
 }
 
-static void update_subscriber_stats(tesa_event_channel_t *channel,
-                                    uint8_t index, bool success) {
-  uint32_t timestamp = get_system_time_ms();
-  update_subscriber_stats_with_time(channel, index, success, timestamp);
+tesa_event_bus_result_t
+tesa_event_bus_get_pool_stats(uint8_t pool_class,
+                              tesa_event_bus_pool_stats_t *stats) {
+
+  if ((false == event_bus_initialized) ||
+      (TESA_EVENT_BUS_POOL_CLASS_COUNT <= pool_class) || (NULL == stats)) {
+    return TESA_EVENT_BUS_ERROR_INVALID_PARAM;
+  }
+
+  taskENTER_CRITICAL();
+  *stats = event_pools[pool_class].stats;
+  taskEXIT_CRITICAL();
+  return TESA_EVENT_BUS_SUCCESS;
+}
+
+tesa_event_bus_result_t tesa_event_bus_reset_pool_stats(void) {
+
+  if (false == event_bus_initialized) {
+    return TESA_EVENT_BUS_ERROR_INVALID_PARAM;
+  }
+
+  taskENTER_CRITICAL();
+  for (uint8_t c = 0U; c < TESA_EVENT_BUS_POOL_CLASS_COUNT; c++) {
+    event_pools[c].stats.high_water = event_pools[c].stats.blocks_in_use;
+    event_pools[c].stats.allocations = 0U;
+    event_pools[c].stats.allocation_failures = 0U;
+  }
+  taskEXIT_CRITICAL();
+  return TESA_EVENT_BUS_SUCCESS;
+}
+
+BaseType_t tesa_event_bus_receive(QueueHandle_t queue_handle,
+                                  tesa_event_t **event,
+                                  TickType_t ticks_to_wait) {
+  if ((NULL == queue_handle) || (NULL == event)) {
+    return pdFALSE;
+  }
+
+  BaseType_t result = xQueueReceive(queue_handle, event, ticks_to_wait);
+
+#if (0 != TESA_EVENT_BUS_TRACE_ENABLE)
+  if ((pdTRUE == result) && (NULL != *event) &&
+      (false != event_bus_initialized)) {
+    trace_receive(queue_handle, *event);
+  }
+#endif
+
+  return result;
+}
+
+tesa_event_bus_result_t
+tesa_event_bus_get_latency(tesa_event_channel_id_t channel_id,
+                           QueueHandle_t queue_handle,
+                           tesa_event_bus_latency_hist_t *latency) {
+#if (0 != TESA_EVENT_BUS_TRACE_ENABLE)
+  if ((false == event_bus_initialized) || (0U == channel_id) ||
+      (NULL == latency)) {
+    return TESA_EVENT_BUS_ERROR_INVALID_PARAM;
+  }
+
+  taskENTER_CRITICAL();
+
+  tesa_event_channel_t *channel = find_channel(channel_id);
+  if ((NULL == channel) || (false == channel->registered)) {
+    taskEXIT_CRITICAL();
+    return TESA_EVENT_BUS_ERROR_CHANNEL_NOT_FOUND;
+  }
+
+  tesa_event_channel_trace_t *trace =
+      &channel_trace[channel - channel_registry];
+  if (NULL == queue_handle) {
+    *latency = trace->latency;
+    taskEXIT_CRITICAL();
+    return TESA_EVENT_BUS_SUCCESS;
+  }
+  for (uint8_t i = 0U; i < channel->subscriber_count; i++) {
+    if (queue_handle == channel->subscribers[i]) {
+      *latency = trace->subscriber_latency[i];
+      taskEXIT_CRITICAL();
+      return TESA_EVENT_BUS_SUCCESS;
+    }
+  }
+
+  taskEXIT_CRITICAL();
+  return TESA_EVENT_BUS_ERROR_INVALID_QUEUE;
+#else
+  (void)channel_id;
+  (void)queue_handle;
+  (void)latency;
+  return TESA_EVENT_BUS_ERROR_INVALID_PARAM;
+#endif
+}
+
+/* Layout in docs/event_bus_tracing.md. Each channel record is written under
+ * one critical section; a channel that does not fit ends the dump, and the
+ * header counts only the channels written. */
+tesa_event_bus_result_t tesa_event_bus_trace_dump(uint8_t *buffer,
+                                                  size_t buffer_size,
+                                                  size_t *written) {
+#if (0 != TESA_EVENT_BUS_TRACE_ENABLE)
+  uint8_t *cursor = buffer;
+  uint8_t channels_written = 0U;
+  tesa_event_bus_result_t result = TESA_EVENT_BUS_SUCCESS;
+  const size_t hist_size =
+      8U + (4U * (size_t)TESA_EVENT_BUS_TRACE_HIST_BUCKETS);
+
+  if ((false == event_bus_initialized) || (NULL == buffer) ||
+      (NULL == written)) {
+    return TESA_EVENT_BUS_ERROR_INVALID_PARAM;
+  }
+  *written = 0U;
+  if (buffer_size < TESA_EVENT_BUS_TRACE_DUMP_HEADER_SIZE) {
+    return TESA_EVENT_BUS_ERROR_MEMORY;
+  }
+
+  trace_put_u32(&cursor, TESA_EVENT_BUS_TRACE_DUMP_MAGIC);
+  *cursor++ = TESA_EVENT_BUS_TRACE_DUMP_VERSION;
+  *cursor++ = (uint8_t)TESA_EVENT_BUS_TRACE_HIST_BUCKETS;
+  *cursor++ = (uint8_t)TESA_EVENT_BUS_POOL_CLASS_COUNT;
+  *cursor++ = 0U; /* Channel count, filled in at the end */
+  trace_put_u32(&cursor, TESA_EVENT_BUS_TRACE_NOW_US());
+
+  taskENTER_CRITICAL();
+  for (uint8_t c = 0U; c < TESA_EVENT_BUS_POOL_CLASS_COUNT; c++) {
+    const tesa_event_bus_pool_stats_t *stats = &event_pools[c].stats;
+
+    trace_put_u16(&cursor, (uint16_t)stats->payload_size);
+    trace_put_u16(&cursor, stats->block_count);
+    trace_put_u16(&cursor, stats->blocks_in_use);
+    trace_put_u16(&cursor, stats->high_water);
+    trace_put_u32(&cursor, stats->allocation_failures);
+  }
+  taskEXIT_CRITICAL();
+
+  for (uint8_t i = 0U; i < TESA_EVENT_BUS_MAX_CHANNELS; i++) {
+    const tesa_event_channel_t *channel = &channel_registry[i];
+    const tesa_event_channel_trace_t *trace = &channel_trace[i];
+
+    taskENTER_CRITICAL();
+    if (false == channel->registered) {
+      taskEXIT_CRITICAL();
+      continue;
+    }
+
+    size_t record_size =
+        16U + hist_size + ((size_t)trace->producer_count * 12U) +
+        ((size_t)channel->subscriber_count * (2U + hist_size));
+    if ((buffer_size - (size_t)(cursor - buffer)) < record_size) {
+      taskEXIT_CRITICAL();
+      result = TESA_EVENT_BUS_ERROR_MEMORY;
+      break;
+    }
+
+    trace_put_u16(&cursor, channel->channel_id);
+    *cursor++ = channel->subscriber_count;
+    *cursor++ = trace->producer_count;
+    trace_put_u32(&cursor, trace->allocations);
+    trace_put_u16(&cursor, trace->blocks_in_use);
+    trace_put_u16(&cursor, trace->blocks_high_water);
+    trace_put_u32(&cursor, trace->other_producer_posts);
+    trace_put_hist(&cursor, &trace->latency);
+    for (uint8_t p = 0U; p < trace->producer_count; p++) {
+      (void)memcpy(cursor, trace->producers[p].name,
+                   TESA_EVENT_BUS_TRACE_NAME_LENGTH);
+      cursor += TESA_EVENT_BUS_TRACE_NAME_LENGTH;
+      trace_put_u32(&cursor, trace->producers[p].posts);
+    }
+    for (uint8_t s = 0U; s < channel->subscriber_count; s++) {
+      trace_put_u16(&cursor, trace->subscriber_peak_depth[s]);
+      trace_put_hist(&cursor, &trace->subscriber_latency[s]);
+    }
+    taskEXIT_CRITICAL();
+    channels_written++;
+  }
+
+  buffer[7] = channels_written;
+  *written = (size_t)(cursor - buffer);
+  return result;
+#else
+  (void)buffer;
+  (void)buffer_size;
+  (void)written;
+  return TESA_EVENT_BUS_ERROR_INVALID_PARAM;
+#endif
+}
+
+tesa_event_bus_result_t tesa_event_bus_trace_reset(void) {
+#if (0 != TESA_EVENT_BUS_TRACE_ENABLE)
+  if (false == event_bus_initialized) {
+    return TESA_EVENT_BUS_ERROR_INVALID_PARAM;
+  }
+
+  taskENTER_CRITICAL();
+  for (uint8_t i = 0U; i < TESA_EVENT_BUS_MAX_CHANNELS; i++) {
+    tesa_event_channel_trace_t *trace = &channel_trace[i];
+    uint16_t blocks_in_use = trace->blocks_in_use;
+
+    (void)memset(trace, 0, sizeof(*trace));
+    trace->blocks_in_use = blocks_in_use;
+    trace->blocks_high_water = blocks_in_use;
+  }
+  taskEXIT_CRITICAL();
+  return TESA_EVENT_BUS_SUCCESS;
+#else
+  return TESA_EVENT_BUS_ERROR_INVALID_PARAM;
+#endif
 }
 
 static void update_subscriber_stats_with_time(tesa_event_channel_t *channel,
@@ -625,92 +1069,759 @@ static void update_subscriber_stats_with_time(tesa_event_channel_t *channel,
   }
 }
 
-static tesa_event_t *allocate_event(void) {
-  for (uint8_t i = 0U; i < TESA_EVENT_BUS_EVENT_POOL_SIZE; i++) {
-    if (false == event_pool_used[i]) {
-      event_pool_used[i] = true;
-      return &event_pool[i];
+static void init_event_pools(void) {
+  for (uint8_t c = 0U; c < TESA_EVENT_BUS_POOL_CLASS_COUNT; c++) {
+    tesa_event_pool_t *pool = &event_pools[c];
+
+    pool->free_list = NULL;
+    for (uint16_t i = pool->stats.block_count; 0U < i; i--) {
+      tesa_event_block_t *block =
+          (tesa_event_block_t *)(pool->storage +
+                                 ((size_t)(i - 1U) * pool->stride));
+      block->next = pool->free_list;
+      pool->free_list = block;
+    }
+    pool->stats.blocks_in_use = 0U;
+    pool->stats.high_water = 0U;
+    pool->stats.allocations = 0U;
+    pool->stats.allocation_failures = 0U;
+  }
+}
+
+static uint8_t pool_class_for_size(size_t payload_size) {
+  for (uint8_t c = 0U; c < TESA_EVENT_BUS_POOL_CLASS_COUNT; c++) {
+    if (payload_size <= event_pools[c].stats.payload_size) {
+      return c;
+    }
+  }
+  return TESA_EVENT_BUS_POOL_CLASS_COUNT;
+}
+
+/* Pops a block of the smallest class that fits payload_size. The event's
+ * payload points at the block's payload area, or is NULL for no payload. */
+static tesa_event_t *allocate_event(size_t payload_size, bool from_isr) {
+  uint8_t pool_class = pool_class_for_size(payload_size);
+  UBaseType_t saved_interrupt_status = 0U;
+  tesa_event_block_t *block = NULL;
+
+  if (TESA_EVENT_BUS_POOL_CLASS_COUNT <= pool_class) {
+    return NULL;
+  }
+
+  tesa_event_pool_t *pool = &event_pools[pool_class];
+
+  if (false != from_isr) {
+    saved_interrupt_status = taskENTER_CRITICAL_FROM_ISR();
+  } else {
+    taskENTER_CRITICAL();
+  }
+
+  block = pool->free_list;
+  if (NULL != block) {
+    pool->free_list = block->next;
+    block->next = NULL;
+    block->references = 1U;
+    pool->stats.blocks_in_use++;
+    if (pool->stats.high_water < pool->stats.blocks_in_use) {
+      pool->stats.high_water = pool->stats.blocks_in_use;
+    }
+    if (TESA_EVENT_BUS_STATS_MAX_VALUE > pool->stats.allocations) {
+      pool->stats.allocations++;
+    }
+  } else if (TESA_EVENT_BUS_STATS_MAX_VALUE >
+             pool->stats.allocation_failures) {
+    pool->stats.allocation_failures++;
+  }
+
+  if (false != from_isr) {
+    taskEXIT_CRITICAL_FROM_ISR(saved_interrupt_status);
+  } else {
+    taskEXIT_CRITICAL();
+  }
+
+  if (NULL == block) {
+    return NULL;
+  }
+
+  block->event.payload =
+      (0U < payload_size)
+          ? (void *)((uint8_t *)block + TESA_EVENT_BUS_BLOCK_HEADER_SIZE)
+          : NULL;
+  block->event.payload_size = payload_size;
+  return &block->event;
+}
+
+/* Pool that owns event, or NULL if it is not the start of a pool block. */
+static tesa_event_pool_t *pool_of_event(const tesa_event_t *event) {
+  uintptr_t address = (uintptr_t)event;
+
+  for (uint8_t c = 0U; c < TESA_EVENT_BUS_POOL_CLASS_COUNT; c++) {
+    tesa_event_pool_t *pool = &event_pools[c];
+    uintptr_t start = (uintptr_t)pool->storage;
+    size_t bytes = (size_t)pool->stats.block_count * pool->stride;
+
+    if ((start <= address) && ((address - start) < bytes)) {
+      return (0U == ((address - start) % pool->stride)) ? pool : NULL;
     }
   }
   return NULL;
 }
 
-static void free_event(tesa_event_t *event) {
+/* Sets how many subscriber queues will hold the event. Called before the
+ * event is sent anywhere, so no other context can see it yet. */
+static void set_event_references(tesa_event_t *event, uint8_t references) {
+  ((tesa_event_block_t *)event)->references = references;
+}
+
+/* Drops one reference; the last one pushes the block back on its class free
+ * list. Pointers that are not pool blocks, and blocks without references
+ * (a second free), are ignored. */
+static void release_event(tesa_event_t *event, bool from_isr) {
+  UBaseType_t saved_interrupt_status = 0U;
+
   if (NULL == event) {
     return;
   }
 
-  for (uint8_t i = 0U; i < TESA_EVENT_BUS_EVENT_POOL_SIZE; i++) {
-    if (event == &event_pool[i]) {
-      event_pool_used[i] = false;
+  tesa_event_pool_t *pool = pool_of_event(event);
+  if (NULL == pool) {
+    return;
+  }
+
+  tesa_event_block_t *block = (tesa_event_block_t *)event;
+  if (false != from_isr) {
+    saved_interrupt_status = taskENTER_CRITICAL_FROM_ISR();
+  } else {
+    taskENTER_CRITICAL();
+  }
+  if (0U < block->references) {
+    block->references--;
+    if (0U == block->references) {
       event->payload = NULL;
       event->payload_size = 0U;
-      break;
+      block->next = pool->free_list;
+      pool->free_list = block;
+      if (0U < pool->stats.blocks_in_use) {
+        pool->stats.blocks_in_use--;
+      }
+#if (0 != TESA_EVENT_BUS_TRACE_ENABLE)
+      if (0U < channel_trace[block->trace_channel].blocks_in_use) {
+        channel_trace[block->trace_channel].blocks_in_use--;
+      }
+#endif
     }
   }
+  if (false != from_isr) {
+    taskEXIT_CRITICAL_FROM_ISR(saved_interrupt_status);
+  } else {
+    taskEXIT_CRITICAL();
+  }
 }
 
-static void *allocate_payload(size_t size) {
-  if (0U == size) {
-    return NULL;
+/* DROP_OLDEST for a queue of any length: if the queue is full, releases the
+ * oldest queued event and sends again. *displaced tells whether an event was
+ * released. */
+static BaseType_t send_drop_oldest(QueueHandle_t queue, tesa_event_t *event,
+                                   bool from_isr, bool *displaced,
+                                   BaseType_t *higher_priority_task_woken) {
+  tesa_event_t *oldest = NULL;
+  BaseType_t result = pdFALSE;
+
+  *displaced = false;
+  if (false != from_isr) {
+    result = xQueueSendFromISR(queue, &event, higher_priority_task_woken);
+    if ((pdTRUE != result) &&
+        (pdTRUE ==
+         xQueueReceiveFromISR(queue, &oldest, higher_priority_task_woken))) {
+      release_event(oldest, true);
+      *displaced = true;
+      result = xQueueSendFromISR(queue, &event, higher_priority_task_woken);
+    }
+  } else {
+    result = xQueueSend(queue, &event, 0);
+    if ((pdTRUE != result) && (pdTRUE == xQueueReceive(queue, &oldest, 0))) {
+      release_event(oldest, false);
+      *displaced = true;
+      result = xQueueSend(queue, &event, 0);
+    }
   }
+  return result;
+}
 
-  if (TESA_EVENT_BUS_MAX_PAYLOAD_SIZE < size) {
-    return NULL;
+/* Copies what a post needs from its channel under one short critical section
+ * and marks the subscribers whose type mask rejects event_type as filtered.
+ * Returns false if the channel is not registered. */
+static bool snapshot_channel(tesa_event_channel_id_t channel_id,
+                             tesa_event_type_t event_type,
+                             tesa_event_post_t *post, bool from_isr) {
+  UBaseType_t saved_interrupt_status = 0U;
+  bool found = false;
+
+  if (false != from_isr) {
+    saved_interrupt_status = taskENTER_CRITICAL_FROM_ISR();
+  } else {
+    taskENTER_CRITICAL();
   }
 
-  for (uint8_t i = 0U; i < TESA_EVENT_BUS_EVENT_POOL_SIZE; i++) {
-    if (false == payload_buffer_used[i]) {
-      payload_buffer_used[i] = true;
-      return payload_buffers[i];
+  tesa_event_channel_t *channel = find_channel(channel_id);
+  if ((NULL != channel) && (false != channel->registered)) {
+    post->channel = channel;
+    post->channel_id = channel_id;
+    post->subscriber_count = channel->subscriber_count;
+    post->policy = channel->config.queue_policy;
+    post->timeout = channel->config.queue_timeout_ticks;
+    post->bridge = (false != channel->remote) ? event_bus_bridge : NULL;
+    for (uint8_t i = 0U; i < post->subscriber_count; i++) {
+      const tesa_event_bus_filter_t *filter = &channel->subscriber_filters[i];
+      tesa_event_post_target_t *target = &post->targets[i];
+
+      target->queue = channel->subscribers[i];
+      target->slot = channel->subscriber_slots[i];
+      target->accept = filter->accept;
+      target->context = filter->context;
+      if (TESA_EVENT_BUS_FILTER_ALL_TYPES == filter->type_mask) {
+        target->filtered = false;
+      } else if (32U <= event_type) {
+        target->filtered = true;
+      } else {
+        target->filtered =
+            (0U == (filter->type_mask & TESA_EVENT_BUS_TYPE_BIT(event_type)));
+      }
     }
+    found = true;
   }
 
-  return NULL;
+  if (false != from_isr) {
+    taskEXIT_CRITICAL_FROM_ISR(saved_interrupt_status);
+  } else {
+    taskEXIT_CRITICAL();
+  }
+
+  if (false != found) {
+    for (uint8_t i = 0U; i < post->subscriber_count; i++) {
+      post->targets[i].delivered = false;
+      post->targets[i].dropped = 0U;
+#if (0 != TESA_EVENT_BUS_TRACE_ENABLE)
+      post->targets[i].depth = 0U;
+#endif
+    }
+#if (0 != TESA_EVENT_BUS_TRACE_ENABLE)
+    post->post_us = TESA_EVENT_BUS_TRACE_NOW_US();
+#endif
+  }
+  return found;
 }
 
-static void *allocate_payload_from_isr(size_t size) {
-  if (0U == size) {
-    return NULL;
+/* Tells the bridge, outside any critical section, that a remote channel's
+ * subscriber count changed. bridge is NULL for local channels. */
+static void notify_subscribers_changed(tesa_event_channel_id_t channel_id,
+                                       uint8_t subscriber_count,
+                                       const tesa_event_bus_bridge_t *bridge) {
+  if ((NULL != bridge) && (NULL != bridge->subscribers_changed)) {
+    bridge->subscribers_changed(channel_id, subscriber_count);
   }
+}
 
-  if (TESA_EVENT_BUS_PAYLOAD_BUFFER_SIZE < size) {
-    return NULL;
+/* Runs the filter callbacks of the subscribers the type mask let through,
+ * outside any critical section. Returns how many subscribers take the event. */
+static uint8_t apply_filters(tesa_event_post_t *post,
+                             tesa_event_type_t event_type, const void *payload,
+                             size_t payload_size) {
+  uint8_t accepted = 0U;
+
+  for (uint8_t i = 0U; i < post->subscriber_count; i++) {
+    tesa_event_post_target_t *target = &post->targets[i];
+
+    if ((false == target->filtered) && (NULL != target->accept) &&
+        (false == target->accept(event_type, payload, payload_size,
+                                 target->context))) {
+      target->filtered = true;
+    }
+    if (false == target->filtered) {
+      accepted++;
+    }
   }
+  return accepted;
+}
 
-  for (uint8_t i = 0U; i < TESA_EVENT_BUS_EVENT_POOL_SIZE; i++) {
-    if (false == payload_buffer_used[i]) {
-      payload_buffer_used[i] = true;
-      return payload_buffers[i];
+/* Sends event to every subscriber of the snapshot that was not filtered out,
+ * one reference each, and records the outcome per queue. A queue that
+ * refuses the event drops its reference. Returns true if every such queue
+ * took the event. */
+static bool fan_out(tesa_event_post_t *post, tesa_event_t *event,
+                    bool from_isr, BaseType_t *higher_priority_task_woken) {
+  bool all_queues_ok = true;
+  uint8_t references = 0U;
+
+  for (uint8_t i = 0U; i < post->subscriber_count; i++) {
+    if (false == post->targets[i].filtered) {
+      references++;
     }
   }
 
-  return NULL;
+  /* Every accepting subscriber queue gets the same event; each holds one
+   * reference */
+  set_event_references(event, references);
+#if (0 != TESA_EVENT_BUS_TRACE_ENABLE)
+  trace_block_acquired(post, event, from_isr);
+#endif
+
+  for (uint8_t i = 0U; i < post->subscriber_count; i++) {
+    tesa_event_post_target_t *target = &post->targets[i];
+    BaseType_t woken = pdFALSE;
+    BaseType_t queue_result = pdFALSE;
+    bool displaced = false;
+    QueueHandle_t queue = target->queue;
+
+    if (false != target->filtered) {
+      continue;
+    }
+
+    if (NULL == queue) {
+      queue_result = pdFALSE;
+    } else if (TESA_EVENT_BUS_QUEUE_DROP_OLDEST == post->policy) {
+      queue_result = send_drop_oldest(queue, event, from_isr, &displaced,
+                                      (false != from_isr) ? &woken : NULL);
+    } else if (false != from_isr) {
+      queue_result = xQueueSendFromISR(queue, &event, &woken);
+    } else {
+      switch (post->policy) {
+      case TESA_EVENT_BUS_QUEUE_DROP_NEWEST:
+        queue_result = xQueueSend(queue, &event, 0);
+        break;
+      case TESA_EVENT_BUS_QUEUE_NO_DROP:
+      case TESA_EVENT_BUS_QUEUE_WAIT:
+        queue_result = xQueueSend(queue, &event, post->timeout);
+        break;
+      default:
+        queue_result = pdFALSE;
+        break;
+      }
+    }
+
+    if (false != displaced) {
+      target->dropped++;
+    }
+
+    if (pdTRUE != queue_result) {
+      all_queues_ok = false;
+      target->dropped++;
+      release_event(event, from_isr);
+    } else {
+      target->delivered = true;
+#if (0 != TESA_EVENT_BUS_TRACE_ENABLE)
+      target->depth = (uint16_t)((false != from_isr)
+                                     ? uxQueueMessagesWaitingFromISR(queue)
+                                     : uxQueueMessagesWaiting(queue));
+#endif
+    }
+
+    if ((pdTRUE == woken) && (NULL != higher_priority_task_woken)) {
+      *higher_priority_task_woken = pdTRUE;
+    }
+  }
+  return all_queues_ok;
 }
 
-static void free_payload(void *payload) {
-  if (NULL == payload) {
-    return;
+/* Takes a free latest-value slot for queue_handle; returns its index + 1, or
+ * 0 if none is free. Callers hold the critical section. */
+static uint8_t acquire_latest_slot(tesa_event_channel_id_t channel_id,
+                                   QueueHandle_t queue_handle) {
+  for (uint8_t i = 0U; i < TESA_EVENT_BUS_LATEST_SLOT_COUNT; i++) {
+    tesa_event_latest_slot_t *slot = &latest_slots[i];
+
+    if (false == slot->in_use) {
+      slot->in_use = true;
+      slot->pending = false;
+      slot->sequence = 0U;
+      slot->queue = queue_handle;
+      slot->event.channel_id = channel_id;
+      slot->event.event_type = 0U;
+      slot->event.payload = NULL;
+      slot->event.payload_size = 0U;
+      slot->event.timestamp_ms = 0U;
+      slot->event.source_task = NULL;
+      slot->event.from_isr = false;
+      return (uint8_t)(i + 1U);
+    }
   }
+  return 0U;
+}
+
+/* TESA_EVENT_BUS_QUEUE_LATEST_VALUE: overwrites the slot of every accepting
+ * subscriber in place and bumps its sequence number. The slot's event is
+ * queued as a notification only if the subscriber has read since the last
+ * one; an overwrite of a value it has not read yet counts as a drop. No pool
+ * block is used. Returns true if every accepting subscriber's slot was
+ * written. */
+static bool conflate(tesa_event_post_t *post, const tesa_event_t *header,
+                     const void *payload, bool from_isr,
+                     BaseType_t *higher_priority_task_woken) {
+  bool all_slots_ok = true;
+
+  for (uint8_t i = 0U; i < post->subscriber_count; i++) {
+    tesa_event_post_target_t *target = &post->targets[i];
+    UBaseType_t saved_interrupt_status = 0U;
+    bool notify = false;
+
+    if (false != target->filtered) {
+      continue;
+    }
+    if (0U == target->slot) {
+      all_slots_ok = false;
+      target->dropped++;
+      continue;
+    }
+
+    tesa_event_latest_slot_t *slot = &latest_slots[target->slot - 1U];
+
+    if (false != from_isr) {
+      saved_interrupt_status = taskENTER_CRITICAL_FROM_ISR();
+    } else {
+      taskENTER_CRITICAL();
+    }
+    /* The subscriber may have gone, and the slot been reused, since the
+     * snapshot */
+    if ((false != slot->in_use) && (target->queue == slot->queue)) {
+      slot->event.event_type = header->event_type;
+      slot->event.payload_size = header->payload_size;
+      slot->event.timestamp_ms = header->timestamp_ms;
+      slot->event.source_task = header->source_task;
+      slot->event.from_isr = header->from_isr;
+      if (0U < header->payload_size) {
+        (void)memcpy(slot->payload, payload, header->payload_size);
+      }
+      slot->sequence++;
+      if (false != slot->pending) {
+        target->dropped++;
+      } else {
+        slot->pending = true;
+        notify = true;
+#if (0 != TESA_EVENT_BUS_TRACE_ENABLE)
+        slot->post_us = post->post_us;
+#endif
+      }
+      target->delivered = true;
+    }
+    if (false != from_isr) {
+      taskEXIT_CRITICAL_FROM_ISR(saved_interrupt_status);
+    } else {
+      taskEXIT_CRITICAL();
+    }
+
+    if (false == target->delivered) {
+      all_slots_ok = false;
+      target->dropped++;
+      continue;
+    }
+
+    if (false != notify) {
+      tesa_event_t *notification = &slot->event;
+      BaseType_t woken = pdFALSE;
+      BaseType_t queue_result =
+          (false != from_isr)
+              ? xQueueSendFromISR(target->queue, &notification, &woken)
+              : xQueueSend(target->queue, &notification, 0);
+
+      if (pdTRUE != queue_result) {
+        /* The value stays in the slot; the next post notifies again */
+        if (false != from_isr) {
+          saved_interrupt_status = taskENTER_CRITICAL_FROM_ISR();
+          slot->pending = false;
+          taskEXIT_CRITICAL_FROM_ISR(saved_interrupt_status);
+        } else {
+          taskENTER_CRITICAL();
+          slot->pending = false;
+          taskEXIT_CRITICAL();
+        }
+      }
+#if (0 != TESA_EVENT_BUS_TRACE_ENABLE)
+      if (pdTRUE == queue_result) {
+        target->depth =
+            (uint16_t)((false != from_isr)
+                           ? uxQueueMessagesWaitingFromISR(target->queue)
+                           : uxQueueMessagesWaiting(target->queue));
+      }
+#endif
+      if ((pdTRUE == woken) && (NULL != higher_priority_task_woken)) {
+        *higher_priority_task_woken = pdTRUE;
+      }
+    }
+  }
+  return all_slots_ok;
+}
+
+/* Adds a post's outcomes to the subscriber statistics in one short critical
+ * section. Subscribers are matched by queue, since others may have
+ * subscribed or unsubscribed during the fan-out; queues that are gone, or a
+ * channel unregistered meanwhile, are skipped. */
+static void commit_post_stats(const tesa_event_post_t *post,
+                              uint32_t timestamp_ms, bool from_isr) {
+  UBaseType_t saved_interrupt_status = 0U;
+  tesa_event_channel_t *channel = post->channel;
+
+  if (false != from_isr) {
+    saved_interrupt_status = taskENTER_CRITICAL_FROM_ISR();
+  } else {
+    taskENTER_CRITICAL();
+  }
+
+  if ((false != channel->registered) &&
+      (post->channel_id == channel->channel_id)) {
+#if (0 != TESA_EVENT_BUS_TRACE_ENABLE)
+    tesa_event_channel_trace_t *trace =
+        &channel_trace[channel - channel_registry];
+    trace_count_producer(trace, from_isr);
+#endif
+    for (uint8_t i = 0U; i < post->subscriber_count; i++) {
+      const tesa_event_post_target_t *target = &post->targets[i];
+      uint8_t index = i;
+
+      if ((channel->subscriber_count <= index) ||
+          (target->queue != channel->subscribers[index])) {
+        for (index = 0U; index < channel->subscriber_count; index++) {
+          if (target->queue == channel->subscribers[index]) {
+            break;
+          }
+        }
+      }
+      if (channel->subscriber_count <= index) {
+        continue;
+      }
+
+      if (false != target->filtered) {
+        if (TESA_EVENT_BUS_STATS_MAX_VALUE >
+            channel->subscriber_stats[index].posts_filtered) {
+          channel->subscriber_stats[index].posts_filtered++;
+        }
+        continue;
+      }
+      for (uint8_t d = 0U; d < target->dropped; d++) {
+        update_subscriber_stats_with_time(channel, index, false, timestamp_ms);
+      }
+      if (false != target->delivered) {
+        update_subscriber_stats_with_time(channel, index, true, timestamp_ms);
+      }
+#if (0 != TESA_EVENT_BUS_TRACE_ENABLE)
+      if (trace->subscriber_peak_depth[index] < target->depth) {
+        trace->subscriber_peak_depth[index] = target->depth;
+      }
+#endif
+    }
+  }
+
+  if (false != from_isr) {
+    taskEXIT_CRITICAL_FROM_ISR(saved_interrupt_status);
+  } else {
+    taskEXIT_CRITICAL();
+  }
+}
+
+#if (0 != TESA_EVENT_BUS_TRACE_ENABLE)
+static void trace_hist_record(tesa_event_bus_latency_hist_t *hist,
+                              uint32_t latency_us) {
+  uint32_t bucket = 0U;
+
+  while ((bucket < 32U) && (0U != (latency_us >> bucket))) {
+    bucket++;
+  }
+  if (TESA_EVENT_BUS_TRACE_HIST_BUCKETS <= bucket) {
+    bucket = TESA_EVENT_BUS_TRACE_HIST_BUCKETS - 1U;
+  }
+
+  if (TESA_EVENT_BUS_STATS_MAX_VALUE > hist->count) {
+    hist->hist[bucket]++;
+    hist->count++;
+  }
+  if (hist->max_us < latency_us) {
+    hist->max_us = latency_us;
+  }
+}
+
+/* Stamps a freshly allocated block with the post time and its channel, and
+ * counts it against the channel's pool use. */
+static void trace_block_acquired(const tesa_event_post_t *post,
+                                 tesa_event_t *event, bool from_isr) {
+  UBaseType_t saved_interrupt_status = 0U;
+  tesa_event_block_t *block = (tesa_event_block_t *)event;
+  uint8_t registry_index = (uint8_t)(post->channel - channel_registry);
+  tesa_event_channel_trace_t *trace = &channel_trace[registry_index];
 
-  for (uint8_t i = 0U; i < TESA_EVENT_BUS_EVENT_POOL_SIZE; i++) {
-    if (payload == payload_buffers[i]) {
-      payload_buffer_used[i] = false;
+  block->post_us = post->post_us;
+  block->trace_channel = registry_index;
+
+  if (false != from_isr) {
+    saved_interrupt_status = taskENTER_CRITICAL_FROM_ISR();
+  } else {
+    taskENTER_CRITICAL();
+  }
+  if (TESA_EVENT_BUS_STATS_MAX_VALUE > trace->allocations) {
+    trace->allocations++;
+  }
+  if (UINT16_MAX > trace->blocks_in_use) {
+    trace->blocks_in_use++;
+  }
+  if (trace->blocks_high_water < trace->blocks_in_use) {
+    trace->blocks_high_water = trace->blocks_in_use;
+  }
+  if (false != from_isr) {
+    taskEXIT_CRITICAL_FROM_ISR(saved_interrupt_status);
+  } else {
+    taskEXIT_CRITICAL();
+  }
+}
+
+/* Counts a post against its producer: the posting task, or one shared entry
+ * for ISRs. Callers hold the critical section. */
+static void trace_count_producer(tesa_event_channel_trace_t *trace,
+                                 bool from_isr) {
+  TaskHandle_t task = (false != from_isr) ? NULL : xTaskGetCurrentTaskHandle();
+
+  for (uint8_t i = 0U; i < trace->producer_count; i++) {
+    if (task == trace->producers[i].task) {
+      if (TESA_EVENT_BUS_STATS_MAX_VALUE > trace->producers[i].posts) {
+        trace->producers[i].posts++;
+      }
       return;
     }
   }
+
+  if (TESA_EVENT_BUS_TRACE_PRODUCERS <= trace->producer_count) {
+    if (TESA_EVENT_BUS_STATS_MAX_VALUE > trace->other_producer_posts) {
+      trace->other_producer_posts++;
+    }
+    return;
+  }
+
+  /* The name is copied now, so the dump does not depend on the task still
+   * existing */
+  tesa_event_trace_producer_t *producer =
+      &trace->producers[trace->producer_count];
+  const char *name = (NULL != task) ? pcTaskGetName(task) : "ISR";
+
+  producer->task = task;
+  producer->posts = 1U;
+  (void)memset(producer->name, 0, sizeof(producer->name));
+  if (NULL != name) {
+    (void)strncpy(producer->name, name, sizeof(producer->name));
+  }
+  trace->producer_count++;
+}
+
+/* Post time of a received event: from its pool block, or from the
+ * latest-value slot whose notification it is. */
+static bool trace_post_time(const tesa_event_t *event, uint32_t *post_us) {
+  if (NULL != pool_of_event(event)) {
+    *post_us = ((const tesa_event_block_t *)event)->post_us;
+    return true;
+  }
+  for (uint8_t i = 0U; i < TESA_EVENT_BUS_LATEST_SLOT_COUNT; i++) {
+    if (event == &latest_slots[i].event) {
+      *post_us = latest_slots[i].post_us;
+      return true;
+    }
+  }
+  return false;
 }
 
+static void trace_receive(QueueHandle_t queue_handle,
+                          const tesa_event_t *event) {
+  uint32_t now_us = TESA_EVENT_BUS_TRACE_NOW_US();
+  uint32_t post_us = 0U;
+
+  if (false == trace_post_time(event, &post_us)) {
+    return;
+  }
+
+  taskENTER_CRITICAL();
+  tesa_event_channel_t *channel = find_channel(event->channel_id);
+  if ((NULL != channel) && (false != channel->registered)) {
+    tesa_event_channel_trace_t *trace =
+        &channel_trace[channel - channel_registry];
+
+    trace_hist_record(&trace->latency, now_us - post_us);
+    for (uint8_t i = 0U; i < channel->subscriber_count; i++) {
+      if (queue_handle == channel->subscribers[i]) {
+        trace_hist_record(&trace->subscriber_latency[i], now_us - post_us);
+        break;
+      }
+    }
+  }
+  taskEXIT_CRITICAL();
+}
+
+static void trace_put_u16(uint8_t **cursor, uint16_t value) {
+  (*cursor)[0] = (uint8_t)(value & 0xFFU);
+  (*cursor)[1] = (uint8_t)(value >> 8);
+  *cursor += 2;
+}
+
+static void trace_put_u32(uint8_t **cursor, uint32_t value) {
+  (*cursor)[0] = (uint8_t)(value & 0xFFU);
+  (*cursor)[1] = (uint8_t)((value >> 8) & 0xFFU);
+  (*cursor)[2] = (uint8_t)((value >> 16) & 0xFFU);
+  (*cursor)[3] = (uint8_t)(value >> 24);
+  *cursor += 4;
+}
+
+static void trace_put_hist(uint8_t **cursor,
+                           const tesa_event_bus_latency_hist_t *hist) {
+  trace_put_u32(cursor, hist->count);
+  trace_put_u32(cursor, hist->max_us);
+  for (uint8_t b = 0U; b < TESA_EVENT_BUS_TRACE_HIST_BUCKETS; b++) {
+    trace_put_u32(cursor, hist->hist[b]);
+  }
+}
+#endif
+
+/* O(1) on average: hashes channel_id and probes until the channel or an empty
+ * slot. Callers hold the critical section. */
 static tesa_event_channel_t *find_channel(tesa_event_channel_id_t channel_id) {
-  for (uint8_t i = 0U; i < TESA_EVENT_BUS_MAX_CHANNELS; i++) {
-    if ((false != channel_registry[i].registered) &&
-        (channel_id == channel_registry[i].channel_id)) {
-      return &channel_registry[i];
+  uint32_t slot = TESA_EVENT_BUS_CHANNEL_HASH(channel_id);
+
+  for (uint16_t probe = 0U; probe < TESA_EVENT_BUS_CHANNEL_HASH_SIZE;
+       probe++) {
+    uint8_t entry = channel_hash[slot];
+
+    if (0U == entry) {
+      return NULL;
+    }
+
+    tesa_event_channel_t *channel = &channel_registry[entry - 1U];
+    if ((false != channel->registered) &&
+        (channel_id == channel->channel_id)) {
+      return channel;
     }
+    slot = (slot + 1U) & ((uint32_t)TESA_EVENT_BUS_CHANNEL_HASH_SIZE - 1U);
   }
   return NULL;
 }
 
+/* Adds a registered channel to the hash table. The table is larger than the
+ * registry, so a free slot always exists. */
+static void index_channel(uint8_t registry_index) {
+  uint32_t slot =
+      TESA_EVENT_BUS_CHANNEL_HASH(channel_registry[registry_index].channel_id);
+
+  while (0U != channel_hash[slot]) {
+    slot = (slot + 1U) & ((uint32_t)TESA_EVENT_BUS_CHANNEL_HASH_SIZE - 1U);
+  }
+  channel_hash[slot] = (uint8_t)(registry_index + 1U);
+}
+
+/* Linear probing cannot just empty a slot, so unregistering rebuilds the
+ * table from the registry (at most TESA_EVENT_BUS_MAX_CHANNELS inserts). */
+static void rebuild_channel_hash(void) {
+  for (uint16_t i = 0U; i < TESA_EVENT_BUS_CHANNEL_HASH_SIZE; i++) {
+    channel_hash[i] = 0U;
+  }
+  for (uint8_t i = 0U; i < TESA_EVENT_BUS_MAX_CHANNELS; i++) {
+    if (false != channel_registry[i].registered) {
+      index_channel(i);
+    }
+  }
+}
+
 static uint32_t get_system_time_ms(void) {
   TickType_t tick_count = xTaskGetTickCount();
   return (uint32_t)((uint32_t)tick_count * (uint32_t)portTICK_PERIOD_MS);
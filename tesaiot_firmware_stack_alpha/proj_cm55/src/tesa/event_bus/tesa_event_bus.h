@@ -8,17 +8,41 @@
 #include <stddef.h>
 #include <stdint.h>
 
-#define TESA_EVENT_BUS_MAX_CHANNELS 16
-#define TESA_EVENT_BUS_MAX_SUBSCRIBERS_PER_CHANNEL 8
-#define TESA_EVENT_BUS_EVENT_POOL_SIZE 32
-#define TESA_EVENT_BUS_PAYLOAD_BUFFER_SIZE 256
-#define TESA_EVENT_BUS_DEFAULT_QUEUE_TIMEOUT_MS 100
+#include "tesa_event_bus_config.h"
+
+#define TESA_EVENT_BUS_POOL_CLASS_SMALL 0U
+#define TESA_EVENT_BUS_POOL_CLASS_MEDIUM 1U
+#define TESA_EVENT_BUS_POOL_CLASS_LARGE 2U
+#define TESA_EVENT_BUS_POOL_CLASS_COUNT 3U
+
+#define TESA_EVENT_BUS_EVENT_POOL_SIZE                                         \
+  (TESA_EVENT_BUS_POOL_SMALL_COUNT + TESA_EVENT_BUS_POOL_MEDIUM_COUNT +        \
+   TESA_EVENT_BUS_POOL_LARGE_COUNT)
+#define TESA_EVENT_BUS_PAYLOAD_BUFFER_SIZE TESA_EVENT_BUS_POOL_LARGE_SIZE
 
 #define TESA_EVENT_BUS_MAX_PAYLOAD_SIZE \
   TESA_EVENT_BUS_PAYLOAD_BUFFER_SIZE
 #define TESA_EVENT_BUS_STATS_MAX_VALUE UINT32_MAX
 #define TESA_EVENT_BUS_TIMESTAMP_ROLLOVER_MS (4294967295UL)
 
+#define TESA_EVENT_BUS_FILTER_ALL_TYPES UINT32_MAX
+#define TESA_EVENT_BUS_TYPE_BIT(event_type) (1UL << (event_type))
+
+#define TESA_EVENT_BUS_TRACE_DUMP_MAGIC 0x54424554UL
+#define TESA_EVENT_BUS_TRACE_DUMP_VERSION 1U
+#define TESA_EVENT_BUS_TRACE_HIST_RECORD_SIZE                                  \
+  (8U + (4U * (size_t)TESA_EVENT_BUS_TRACE_HIST_BUCKETS))
+#define TESA_EVENT_BUS_TRACE_DUMP_HEADER_SIZE                                  \
+  (12U + (12U * (size_t)TESA_EVENT_BUS_POOL_CLASS_COUNT))
+#define TESA_EVENT_BUS_TRACE_DUMP_MAX_SIZE                                     \
+  (TESA_EVENT_BUS_TRACE_DUMP_HEADER_SIZE +                                     \
+   ((size_t)TESA_EVENT_BUS_MAX_CHANNELS *                                      \
+    (16U + TESA_EVENT_BUS_TRACE_HIST_RECORD_SIZE +                             \
+     ((size_t)TESA_EVENT_BUS_TRACE_PRODUCERS *                                 \
+      (TESA_EVENT_BUS_TRACE_NAME_LENGTH + 4U)) +                               \
+     ((size_t)TESA_EVENT_BUS_MAX_SUBSCRIBERS_PER_CHANNEL *                     \
+      (2U + TESA_EVENT_BUS_TRACE_HIST_RECORD_SIZE)))))
+
 typedef uint16_t tesa_event_channel_id_t;
 typedef uint32_t tesa_event_type_t;
 
@@ -41,7 +65,8 @@ typedef enum {
   TESA_EVENT_BUS_QUEUE_DROP_NEWEST = 0,
   TESA_EVENT_BUS_QUEUE_DROP_OLDEST,
   TESA_EVENT_BUS_QUEUE_NO_DROP,
-  TESA_EVENT_BUS_QUEUE_WAIT
+  TESA_EVENT_BUS_QUEUE_WAIT,
+  TESA_EVENT_BUS_QUEUE_LATEST_VALUE
 } tesa_event_bus_queue_policy_t;
 
 typedef struct {
@@ -59,17 +84,55 @@ typedef struct {
   TickType_t queue_timeout_ticks;
 } tesa_event_bus_channel_config_t;
 
+typedef bool (*tesa_event_bus_filter_fn_t)(tesa_event_type_t event_type,
+                                           const void *payload,
+                                           size_t payload_size, void *context);
+
+typedef struct {
+  uint32_t type_mask;
+  tesa_event_bus_filter_fn_t accept;
+  void *context;
+} tesa_event_bus_filter_t;
+
 typedef struct {
   uint32_t posts_successful;
   uint32_t posts_dropped;
+  uint32_t posts_filtered;
   uint32_t last_drop_timestamp_ms;
 } tesa_event_bus_subscriber_stats_t;
 
+typedef struct {
+  size_t payload_size;
+  uint16_t block_count;
+  uint16_t blocks_in_use;
+  uint16_t high_water;
+  uint32_t allocations;
+  uint32_t allocation_failures;
+} tesa_event_bus_pool_stats_t;
+
+typedef struct {
+  uint32_t count;
+  uint32_t max_us;
+  uint32_t hist[TESA_EVENT_BUS_TRACE_HIST_BUCKETS];
+} tesa_event_bus_latency_hist_t;
+
+typedef struct {
+  bool (*forward)(tesa_event_channel_id_t channel_id,
+                  tesa_event_type_t event_type, const void *payload,
+                  size_t payload_size, bool from_isr);
+  void (*subscribers_changed)(tesa_event_channel_id_t channel_id,
+                              uint8_t subscriber_count);
+} tesa_event_bus_bridge_t;
+
 typedef struct {
   tesa_event_channel_id_t channel_id;
   const char *channel_name;
   bool registered;
+  bool remote;
   QueueHandle_t subscribers[TESA_EVENT_BUS_MAX_SUBSCRIBERS_PER_CHANNEL];
+  tesa_event_bus_filter_t
+      subscriber_filters[TESA_EVENT_BUS_MAX_SUBSCRIBERS_PER_CHANNEL];
+  uint8_t subscriber_slots[TESA_EVENT_BUS_MAX_SUBSCRIBERS_PER_CHANNEL];
   tesa_event_bus_subscriber_stats_t
       subscriber_stats[TESA_EVENT_BUS_MAX_SUBSCRIBERS_PER_CHANNEL];
   tesa_event_bus_channel_config_t config;
@@ -89,10 +152,22 @@ tesa_event_bus_result_t tesa_event_bus_register_channel_with_config(
 tesa_event_bus_result_t
 tesa_event_bus_unregister_channel(tesa_event_channel_id_t channel_id);
 
+tesa_event_bus_result_t
+tesa_event_bus_set_bridge(const tesa_event_bus_bridge_t *bridge);
+
+tesa_event_bus_result_t
+tesa_event_bus_set_channel_remote(tesa_event_channel_id_t channel_id,
+                                  bool remote);
+
 tesa_event_bus_result_t
 tesa_event_bus_subscribe(tesa_event_channel_id_t channel_id,
                          QueueHandle_t queue_handle);
 
+tesa_event_bus_result_t
+tesa_event_bus_subscribe_with_filter(tesa_event_channel_id_t channel_id,
+                                     QueueHandle_t queue_handle,
+                                     const tesa_event_bus_filter_t *filter);
+
 tesa_event_bus_result_t
 tesa_event_bus_unsubscribe(tesa_event_channel_id_t channel_id,
                            QueueHandle_t queue_handle);
@@ -114,6 +189,12 @@ uint32_t tesa_event_bus_check_timestamp_rollover(uint32_t timestamp_ms);
 
 void tesa_event_bus_free_event(tesa_event_t *event);
 
+tesa_event_bus_result_t
+tesa_event_bus_read_latest(tesa_event_channel_id_t channel_id,
+                           QueueHandle_t queue_handle, tesa_event_t *event,
+                           void *payload_buffer, size_t buffer_size,
+                           uint32_t *sequence);
+
 tesa_event_bus_result_t
 tesa_event_bus_get_subscriber_stats(tesa_event_channel_id_t channel_id,
                                     QueueHandle_t queue_handle,
@@ -124,4 +205,25 @@ tesa_event_bus_get_channel_stats(tesa_event_channel_id_t channel_id,
                                  tesa_event_bus_subscriber_stats_t *total_stats,
                                  uint8_t *subscriber_count);
 
+tesa_event_bus_result_t
+tesa_event_bus_get_pool_stats(uint8_t pool_class,
+                              tesa_event_bus_pool_stats_t *stats);
+
+tesa_event_bus_result_t tesa_event_bus_reset_pool_stats(void);
+
+BaseType_t tesa_event_bus_receive(QueueHandle_t queue_handle,
+                                  tesa_event_t **event,
+                                  TickType_t ticks_to_wait);
+
+tesa_event_bus_result_t
+tesa_event_bus_get_latency(tesa_event_channel_id_t channel_id,
+                           QueueHandle_t queue_handle,
+                           tesa_event_bus_latency_hist_t *latency);
+
+tesa_event_bus_result_t tesa_event_bus_trace_dump(uint8_t *buffer,
+                                                  size_t buffer_size,
+                                                  size_t *written);
+
+tesa_event_bus_result_t tesa_event_bus_trace_reset(void);
+
 #endif
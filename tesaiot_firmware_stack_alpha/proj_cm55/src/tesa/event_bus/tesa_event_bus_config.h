@@ -0,0 +1,133 @@
+#ifndef TESA_EVENT_BUS_CONFIG_H
+#define TESA_EVENT_BUS_CONFIG_H
+
+#ifndef TESA_EVENT_BUS_MAX_CHANNELS
+#define TESA_EVENT_BUS_MAX_CHANNELS 16
+#endif
+
+#ifndef TESA_EVENT_BUS_MAX_SUBSCRIBERS_PER_CHANNEL
+#define TESA_EVENT_BUS_MAX_SUBSCRIBERS_PER_CHANNEL 8
+#endif
+
+/* Slots of the channel ID hash table. A power of two, larger than
+ * TESA_EVENT_BUS_MAX_CHANNELS; at twice the channel count probes stay short.
+ */
+#ifndef TESA_EVENT_BUS_CHANNEL_HASH_SIZE
+#define TESA_EVENT_BUS_CHANNEL_HASH_SIZE 32
+#endif
+
+#ifndef TESA_EVENT_BUS_DEFAULT_QUEUE_TIMEOUT_MS
+#define TESA_EVENT_BUS_DEFAULT_QUEUE_TIMEOUT_MS 100
+#endif
+
+/* Event pool classes. Each block holds one event and a payload of up to the
+ * class size; a post takes a block of the smallest class that fits its
+ * payload (events without payload use the small class). Classes do not
+ * borrow from each other, so a flood of large events (logging) cannot starve
+ * small ones (buttons, touch). Sizes must be ascending.
+ */
+#ifndef TESA_EVENT_BUS_POOL_SMALL_SIZE
+#define TESA_EVENT_BUS_POOL_SMALL_SIZE 16
+#endif
+
+#ifndef TESA_EVENT_BUS_POOL_SMALL_COUNT
+#define TESA_EVENT_BUS_POOL_SMALL_COUNT 32
+#endif
+
+#ifndef TESA_EVENT_BUS_POOL_MEDIUM_SIZE
+#define TESA_EVENT_BUS_POOL_MEDIUM_SIZE 64
+#endif
+
+#ifndef TESA_EVENT_BUS_POOL_MEDIUM_COUNT
+#define TESA_EVENT_BUS_POOL_MEDIUM_COUNT 16
+#endif
+
+#ifndef TESA_EVENT_BUS_POOL_LARGE_SIZE
+#define TESA_EVENT_BUS_POOL_LARGE_SIZE 256
+#endif
+
+/* At least TESA_LOGGING_QUEUE_LENGTH: every queued log line holds a large
+ * block until the logging task prints it (checked in tesa_logging.c). */
+#ifndef TESA_EVENT_BUS_POOL_LARGE_COUNT
+#define TESA_EVENT_BUS_POOL_LARGE_COUNT 32
+#endif
+
+/* Latest-value channels (TESA_EVENT_BUS_QUEUE_LATEST_VALUE) give each
+ * subscriber one slot, taken at subscribe time from this many, that holds a
+ * payload of up to TESA_EVENT_BUS_LATEST_PAYLOAD_SIZE bytes.
+ */
+#ifndef TESA_EVENT_BUS_LATEST_SLOT_COUNT
+#define TESA_EVENT_BUS_LATEST_SLOT_COUNT 8
+#endif
+
+#ifndef TESA_EVENT_BUS_LATEST_PAYLOAD_SIZE
+#define TESA_EVENT_BUS_LATEST_PAYLOAD_SIZE 32
+#endif
+
+/* Tracing. With TESA_EVENT_BUS_TRACE_ENABLE set, posts are timestamped and
+ * tesa_event_bus_receive() records post-to-receive latency per channel and
+ * per subscriber, with peak queue depths, per-channel pool use and producer
+ * tasks; tesa_event_bus_trace_dump() writes it all out in binary. With it
+ * clear (the default) none of this is compiled in. Timestamps come from
+ * TESA_EVENT_BUS_TRACE_NOW_US(), declared in TESA_EVENT_BUS_TRACE_CLOCK_HEADER;
+ * by default the shared IPC timebase.
+ */
+#ifndef TESA_EVENT_BUS_TRACE_ENABLE
+#define TESA_EVENT_BUS_TRACE_ENABLE 0
+#endif
+
+#ifndef TESA_EVENT_BUS_TRACE_CLOCK_HEADER
+#define TESA_EVENT_BUS_TRACE_CLOCK_HEADER "ipc_stats.h"
+#define TESA_EVENT_BUS_TRACE_NOW_US() ipc_stats_now_us()
+#endif
+
+/* Log2 microsecond buckets: bucket 0 is < 1 us, bucket i [2^(i-1), 2^i) us,
+ * the last one open-ended */
+#ifndef TESA_EVENT_BUS_TRACE_HIST_BUCKETS
+#define TESA_EVENT_BUS_TRACE_HIST_BUCKETS 16
+#endif
+
+/* Distinct producers (tasks, or ISR as one) counted per channel; posts from
+ * any more are counted together */
+#ifndef TESA_EVENT_BUS_TRACE_PRODUCERS
+#define TESA_EVENT_BUS_TRACE_PRODUCERS 4
+#endif
+
+#define TESA_EVENT_BUS_TRACE_NAME_LENGTH 8
+
+#if (TESA_EVENT_BUS_CHANNEL_HASH_SIZE <= TESA_EVENT_BUS_MAX_CHANNELS) ||       \
+    (0 != (TESA_EVENT_BUS_CHANNEL_HASH_SIZE &                                  \
+           (TESA_EVENT_BUS_CHANNEL_HASH_SIZE - 1))) ||                         \
+    (255 < TESA_EVENT_BUS_MAX_CHANNELS)
+#error "TESA_EVENT_BUS_CHANNEL_HASH_SIZE must be a power of two above TESA_EVENT_BUS_MAX_CHANNELS (at most 255)"
+#endif
+
+#if (0 == TESA_EVENT_BUS_LATEST_SLOT_COUNT) ||                                 \
+    (255 < TESA_EVENT_BUS_LATEST_SLOT_COUNT) ||                                \
+    (0 == TESA_EVENT_BUS_LATEST_PAYLOAD_SIZE) ||                               \
+    (TESA_EVENT_BUS_POOL_LARGE_SIZE < TESA_EVENT_BUS_LATEST_PAYLOAD_SIZE)
+#error "TESA_EVENT_BUS_LATEST_SLOT_COUNT must be 1..255 and TESA_EVENT_BUS_LATEST_PAYLOAD_SIZE 1..TESA_EVENT_BUS_POOL_LARGE_SIZE"
+#endif
+
+#if (0 == TESA_EVENT_BUS_TRACE_HIST_BUCKETS) ||                                \
+    (32 < TESA_EVENT_BUS_TRACE_HIST_BUCKETS) ||                                \
+    (0 == TESA_EVENT_BUS_TRACE_PRODUCERS) ||                                   \
+    (255 < TESA_EVENT_BUS_TRACE_PRODUCERS)
+#error "TESA_EVENT_BUS_TRACE_HIST_BUCKETS must be 1..32 and TESA_EVENT_BUS_TRACE_PRODUCERS 1..255"
+#endif
+
+#if (TESA_EVENT_BUS_POOL_SMALL_SIZE >= TESA_EVENT_BUS_POOL_MEDIUM_SIZE) ||     \
+    (TESA_EVENT_BUS_POOL_MEDIUM_SIZE >= TESA_EVENT_BUS_POOL_LARGE_SIZE)
+#error "TESA_EVENT_BUS_POOL_*_SIZE must be ascending"
+#endif
+
+#if (0 == TESA_EVENT_BUS_POOL_SMALL_COUNT) ||                                  \
+    (0 == TESA_EVENT_BUS_POOL_MEDIUM_COUNT) ||                                 \
+    (0 == TESA_EVENT_BUS_POOL_LARGE_COUNT) ||                                  \
+    (65535 < TESA_EVENT_BUS_POOL_SMALL_COUNT) ||                               \
+    (65535 < TESA_EVENT_BUS_POOL_MEDIUM_COUNT) ||                              \
+    (65535 < TESA_EVENT_BUS_POOL_LARGE_COUNT)
+#error "TESA_EVENT_BUS_POOL_*_COUNT must be 1..65535"
+#endif
+
+#endif
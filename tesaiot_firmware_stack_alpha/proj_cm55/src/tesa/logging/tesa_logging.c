@@ -8,20 +8,83 @@
 #include <string.h>
 #include <time.h>
 
+#define TESA_LOG_MESSAGE_SIZE 188U
+
 typedef struct {
   tesa_log_level_t level;
   char owner[32U];
-  char message[188U];
+  char message[TESA_LOG_MESSAGE_SIZE];
 } tesa_log_message_t;
 
+#if (1U != TESA_LOGGING_ENABLE_DEFERRED) &&                                    \
+    (TESA_EVENT_BUS_POOL_LARGE_COUNT < TESA_LOGGING_QUEUE_LENGTH)
+#error "TESA_EVENT_BUS_POOL_LARGE_COUNT must be at least TESA_LOGGING_QUEUE_LENGTH, or a log burst fails before the queue fills"
+#endif
+
+#if (1U == TESA_LOGGING_ENABLE_DEFERRED)
+/* Argument a conversion takes, in the type va_arg() reads it with */
+typedef enum {
+  TESA_LOG_ARG_NONE = 0U, /* %% or an unknown conversion */
+  TESA_LOG_ARG_SKIP,      /* %n or %ls: pointer read and dropped */
+  TESA_LOG_ARG_INT,
+  TESA_LOG_ARG_LONG,
+  TESA_LOG_ARG_LLONG,
+  TESA_LOG_ARG_SIZE,
+  TESA_LOG_ARG_INTMAX,
+  TESA_LOG_ARG_PTRDIFF,
+  TESA_LOG_ARG_DOUBLE,
+  TESA_LOG_ARG_LDOUBLE,
+  TESA_LOG_ARG_STRING,
+  TESA_LOG_ARG_POINTER
+} tesa_log_arg_type_t;
+
+typedef struct {
+  const char *start; /* The '%' */
+  const char *end;   /* Past the conversion character */
+  uint8_t stars;     /* '*' width and precision, int arguments each */
+  tesa_log_arg_type_t type;
+} tesa_log_conversion_t;
+
+/* Ring record: header, then the stored arguments of its first conversions in
+ * format order, each star as an int before its value and strings
+ * NUL-terminated. size covers both and is a multiple of 4. */
+typedef struct {
+  uint16_t size;
+  uint8_t level;
+  uint8_t conversions;
+  uint32_t timestamp_ms;
+  const char *owner;
+  const char *format;
+} tesa_log_record_t;
+
+typedef struct {
+  tesa_log_record_t header;
+  uint8_t args[TESA_LOGGING_DEFERRED_ARGS_SIZE];
+} tesa_log_record_buffer_t;
+#endif
+
 static const char *level_prefixes[TESA_LOG_LEVEL_COUNT] = {
     [TESA_LOG_VERBOSE] = "VERBOSE", [TESA_LOG_DEBUG] = "DEBUG",
     [TESA_LOG_INFO] = "INFO",       [TESA_LOG_WARNING] = "WARN",
     [TESA_LOG_ERROR] = "ERROR",     [TESA_LOG_CRITICAL] = "CRITICAL"};
 
+volatile tesa_log_level_t tesa_logging_min_level = TESA_LOG_VERBOSE;
+
+#if (1U != TESA_LOGGING_ENABLE_DEFERRED)
 static QueueHandle_t logging_queue = NULL;
+#endif
 static tesa_logging_config_t logging_config;
 static bool logging_initialized = false;
+static uint32_t logging_dropped = 0U;
+
+#if (1U == TESA_LOGGING_ENABLE_DEFERRED)
+/* Producers append records and move head in critical sections; the logging
+ * task alone reads them and moves tail. Both run freely and wrap. */
+static uint8_t deferred_ring[TESA_LOGGING_DEFERRED_RING_SIZE];
+static uint32_t deferred_head = 0U;
+static uint32_t deferred_tail = 0U;
+static TaskHandle_t logging_task_handle = NULL;
+#endif
 
 static void logging_task(void *pvParameters);
 
@@ -142,12 +205,9 @@ static void parse_timestamp(const char *timestamp_str,
   }
 }
 
-static void logging_task(void *pvParameters) {
-  QueueHandle_t queue = (QueueHandle_t)pvParameters;
-  tesa_event_t *event = NULL;
-  tesa_log_message_t *log_msg = NULL;
+static void write_line(tesa_log_level_t level, uint32_t timestamp_ms,
+                       const char *owner, const char *message) {
   const char *level_prefix = NULL;
-  uint32_t timestamp_ms = 0U;
   char timestamp_buffer[40U];
   char date_buffer[16U];
   char time_buffer[16U];
@@ -155,42 +215,467 @@ static void logging_task(void *pvParameters) {
   bool timestamp_enabled = true;
   tesa_log_timestamp_format_t timestamp_format = TESA_LOG_TIMESTAMP_MS;
 
+  taskENTER_CRITICAL();
+  timestamp_enabled = logging_config.enable_timestamp;
+  timestamp_format = logging_config.timestamp_format;
+  taskEXIT_CRITICAL();
+
+  level_prefix = level_prefixes[level];
+
+  date_buffer[0] = '\0';
+  time_buffer[0] = '\0';
+
+  if (timestamp_enabled) {
+    if (0 < format_timestamp(timestamp_format, timestamp_ms, timestamp_buffer,
+                             sizeof(timestamp_buffer))) {
+      parse_timestamp(timestamp_buffer, timestamp_format, date_buffer,
+                      sizeof(date_buffer), time_buffer, sizeof(time_buffer));
+    }
+  }
+
+  (void)snprintf(output_buffer, sizeof(output_buffer),
+                 "[logging|%s|%s|%s|%s|%s]\r\n", level_prefix, date_buffer,
+                 time_buffer, owner, message);
+  (void)printf("%s", output_buffer);
+  (void)fflush(stdout);
+}
+
+#if (1U == TESA_LOGGING_ENABLE_DEFERRED)
+/* Finds the first conversion in format; false if there is none. Walks the
+ * same way at the call site and in the logging task, so both agree on what
+ * each conversion stores. */
+static bool next_conversion(const char *format,
+                            tesa_log_conversion_t *conversion) {
+  const char *cursor = strchr(format, '%');
+  char length = '\0';
+
+  if (NULL == cursor) {
+    return false;
+  }
+
+  conversion->start = cursor;
+  conversion->stars = 0U;
+  conversion->type = TESA_LOG_ARG_NONE;
+  cursor++;
+
+  while (('\0' != *cursor) && (NULL != strchr("-+ #0", *cursor))) {
+    cursor++;
+  }
+  if ('*' == *cursor) {
+    conversion->stars++;
+    cursor++;
+  }
+  while (('0' <= *cursor) && ('9' >= *cursor)) {
+    cursor++;
+  }
+  if ('.' == *cursor) {
+    cursor++;
+    if ('*' == *cursor) {
+      conversion->stars++;
+      cursor++;
+    }
+    while (('0' <= *cursor) && ('9' >= *cursor)) {
+      cursor++;
+    }
+  }
+
+  if ('h' == *cursor) {
+    length = 'h';
+    cursor += ('h' == cursor[1]) ? 2 : 1;
+  } else if ('l' == *cursor) {
+    length = ('l' == cursor[1]) ? 'q' : 'l';
+    cursor += ('l' == cursor[1]) ? 2 : 1;
+  } else if (('\0' != *cursor) && (NULL != strchr("zjtL", *cursor))) {
+    length = *cursor;
+    cursor++;
+  }
+
+  if ('\0' == *cursor) {
+    conversion->end = cursor;
+    conversion->stars = 0U;
+    return true;
+  }
+  conversion->end = cursor + 1;
+
+  switch (*cursor) {
+  case 'd':
+  case 'i':
+  case 'u':
+  case 'o':
+  case 'x':
+  case 'X':
+    conversion->type = ('l' == length)   ? TESA_LOG_ARG_LONG
+                       : ('q' == length) ? TESA_LOG_ARG_LLONG
+                       : ('L' == length) ? TESA_LOG_ARG_LLONG
+                       : ('z' == length) ? TESA_LOG_ARG_SIZE
+                       : ('j' == length) ? TESA_LOG_ARG_INTMAX
+                       : ('t' == length) ? TESA_LOG_ARG_PTRDIFF
+                                         : TESA_LOG_ARG_INT;
+    break;
+
+  case 'c':
+    conversion->type = TESA_LOG_ARG_INT;
+    break;
+
+  case 'f':
+  case 'F':
+  case 'e':
+  case 'E':
+  case 'g':
+  case 'G':
+  case 'a':
+  case 'A':
+    conversion->type =
+        ('L' == length) ? TESA_LOG_ARG_LDOUBLE : TESA_LOG_ARG_DOUBLE;
+    break;
+
+  case 's':
+    conversion->type =
+        ('l' == length) ? TESA_LOG_ARG_SKIP : TESA_LOG_ARG_STRING;
+    break;
+
+  case 'p':
+    conversion->type = TESA_LOG_ARG_POINTER;
+    break;
+
+  case 'n':
+    conversion->type = TESA_LOG_ARG_SKIP;
+    break;
+
+  default:
+    conversion->stars = 0U;
+    break;
+  }
+
+  return true;
+}
+
+/* Copies the arguments of format into args, as many conversions as fit;
+ * returns the bytes used and sets conversions to how many were stored. */
+static size_t encode_args(const char *format, va_list args, uint8_t *buffer,
+                          uint8_t *conversions) {
+  tesa_log_conversion_t conversion;
+  size_t used = 0U;
+  size_t room = TESA_LOGGING_DEFERRED_ARGS_SIZE;
+
+  *conversions = 0U;
+
+  while ((UINT8_MAX > *conversions) && next_conversion(format, &conversion)) {
+    size_t needed = (size_t)conversion.stars * sizeof(int);
+    const char *string = NULL;
+    size_t string_length = 0U;
+    union {
+      int i;
+      long l;
+      long long ll;
+      size_t z;
+      intmax_t j;
+      ptrdiff_t t;
+      double d;
+      long double ld;
+      void *p;
+    } value;
+    size_t value_size = 0U;
+    int stars[2U];
+
+    for (uint8_t i = 0U; i < conversion.stars; i++) {
+      stars[i] = va_arg(args, int);
+    }
+
+    switch (conversion.type) {
+    case TESA_LOG_ARG_SKIP:
+      (void)va_arg(args, void *);
+      break;
+    case TESA_LOG_ARG_INT:
+      value.i = va_arg(args, int);
+      value_size = sizeof(value.i);
+      break;
+    case TESA_LOG_ARG_LONG:
+      value.l = va_arg(args, long);
+      value_size = sizeof(value.l);
+      break;
+    case TESA_LOG_ARG_LLONG:
+      value.ll = va_arg(args, long long);
+      value_size = sizeof(value.ll);
+      break;
+    case TESA_LOG_ARG_SIZE:
+      value.z = va_arg(args, size_t);
+      value_size = sizeof(value.z);
+      break;
+    case TESA_LOG_ARG_INTMAX:
+      value.j = va_arg(args, intmax_t);
+      value_size = sizeof(value.j);
+      break;
+    case TESA_LOG_ARG_PTRDIFF:
+      value.t = va_arg(args, ptrdiff_t);
+      value_size = sizeof(value.t);
+      break;
+    case TESA_LOG_ARG_DOUBLE:
+      value.d = va_arg(args, double);
+      value_size = sizeof(value.d);
+      break;
+    case TESA_LOG_ARG_LDOUBLE:
+      value.ld = va_arg(args, long double);
+      value_size = sizeof(value.ld);
+      break;
+    case TESA_LOG_ARG_POINTER:
+      value.p = va_arg(args, void *);
+      value_size = sizeof(value.p);
+      break;
+    case TESA_LOG_ARG_STRING:
+      string = va_arg(args, const char *);
+      if (NULL == string) {
+        string = "(null)";
+      }
+      string_length = strnlen(string, TESA_LOGGING_DEFERRED_STRING_MAX);
+      value_size = string_length + 1U;
+      break;
+    default:
+      break;
+    }
+
+    needed += value_size;
+    if (needed > room) {
+      break;
+    }
+
+    (void)memcpy(&buffer[used], stars, (size_t)conversion.stars * sizeof(int));
+    used += (size_t)conversion.stars * sizeof(int);
+    if (NULL != string) {
+      (void)memcpy(&buffer[used], string, string_length);
+      buffer[used + string_length] = '\0';
+    } else if (0U < value_size) {
+      (void)memcpy(&buffer[used], &value, value_size);
+    }
+    used += value_size;
+    room -= needed;
+    (*conversions)++;
+    format = conversion.end;
+  }
+
+  return used;
+}
+
+static void append_text(char *message, size_t message_size, size_t *length,
+                        const char *text, size_t text_length) {
+  size_t room = message_size - 1U - *length;
+
+  if (text_length > room) {
+    text_length = room;
+  }
+  (void)memcpy(&message[*length], text, text_length);
+  *length += text_length;
+  message[*length] = '\0';
+}
+
+/* Formats a record into message, one conversion at a time, with the
+ * arguments it stored. */
+static void format_record(const tesa_log_record_buffer_t *record,
+                          char *message, size_t message_size) {
+  const char *format = record->header.format;
+  const uint8_t *arg = record->args;
+  tesa_log_conversion_t conversion;
+  size_t length = 0U;
+  uint8_t done = 0U;
+
+  message[0] = '\0';
+
+  while (next_conversion(format, &conversion)) {
+    char spec[24U];
+    size_t spec_length = 0U;
+    size_t room;
+    int written = 0;
+
+    append_text(message, message_size, &length, format,
+                (size_t)(conversion.start - format));
+    if (done == record->header.conversions) {
+      return;
+    }
+    done++;
+    format = conversion.end;
+
+    /* Copy the conversion with each star replaced by the value it stored */
+    for (const char *cursor = conversion.start; cursor < conversion.end;
+         cursor++) {
+      if ('*' == *cursor) {
+        int star;
+        (void)memcpy(&star, arg, sizeof(star));
+        arg += sizeof(star);
+        spec_length += (size_t)snprintf(&spec[spec_length],
+                                        sizeof(spec) - spec_length, "%d", star);
+      } else {
+        spec[spec_length] = *cursor;
+        spec_length++;
+      }
+      if ((sizeof(spec) - 1U) <= spec_length) {
+        return;
+      }
+    }
+    spec[spec_length] = '\0';
+
+    room = message_size - length;
+    switch (conversion.type) {
+    case TESA_LOG_ARG_NONE:
+      if ('%' == conversion.end[-1]) {
+        append_text(message, message_size, &length, "%", 1U);
+      } else {
+        append_text(message, message_size, &length, spec, spec_length);
+      }
+      break;
+    case TESA_LOG_ARG_INT: {
+      int value;
+      (void)memcpy(&value, arg, sizeof(value));
+      arg += sizeof(value);
+      written = snprintf(&message[length], room, spec, value);
+      break;
+    }
+    case TESA_LOG_ARG_LONG: {
+      long value;
+      (void)memcpy(&value, arg, sizeof(value));
+      arg += sizeof(value);
+      written = snprintf(&message[length], room, spec, value);
+      break;
+    }
+    case TESA_LOG_ARG_LLONG: {
+      long long value;
+      (void)memcpy(&value, arg, sizeof(value));
+      arg += sizeof(value);
+      written = snprintf(&message[length], room, spec, value);
+      break;
+    }
+    case TESA_LOG_ARG_SIZE: {
+      size_t value;
+      (void)memcpy(&value, arg, sizeof(value));
+      arg += sizeof(value);
+      written = snprintf(&message[length], room, spec, value);
+      break;
+    }
+    case TESA_LOG_ARG_INTMAX: {
+      intmax_t value;
+      (void)memcpy(&value, arg, sizeof(value));
+      arg += sizeof(value);
+      written = snprintf(&message[length], room, spec, value);
+      break;
+    }
+    case TESA_LOG_ARG_PTRDIFF: {
+      ptrdiff_t value;
+      (void)memcpy(&value, arg, sizeof(value));
+      arg += sizeof(value);
+      written = snprintf(&message[length], room, spec, value);
+      break;
+    }
+    case TESA_LOG_ARG_DOUBLE: {
+      double value;
+      (void)memcpy(&value, arg, sizeof(value));
+      arg += sizeof(value);
+      written = snprintf(&message[length], room, spec, value);
+      break;
+    }
+    case TESA_LOG_ARG_LDOUBLE: {
+      long double value;
+      (void)memcpy(&value, arg, sizeof(value));
+      arg += sizeof(value);
+      written = snprintf(&message[length], room, spec, value);
+      break;
+    }
+    case TESA_LOG_ARG_POINTER: {
+      void *value;
+      (void)memcpy(&value, arg, sizeof(value));
+      arg += sizeof(value);
+      written = snprintf(&message[length], room, spec, value);
+      break;
+    }
+    case TESA_LOG_ARG_STRING:
+      written = snprintf(&message[length], room, spec, (const char *)arg);
+      arg += strlen((const char *)arg) + 1U;
+      break;
+    default:
+      break;
+    }
+
+    if (0 < written) {
+      length += ((size_t)written < room) ? (size_t)written : (room - 1U);
+    }
+  }
+
+  append_text(message, message_size, &length, format, strlen(format));
+}
+
+static void ring_write(uint32_t position, const void *data, size_t size) {
+  uint32_t offset = position & (TESA_LOGGING_DEFERRED_RING_SIZE - 1U);
+  size_t first = TESA_LOGGING_DEFERRED_RING_SIZE - offset;
+
+  if (first > size) {
+    first = size;
+  }
+  (void)memcpy(&deferred_ring[offset], data, first);
+  (void)memcpy(deferred_ring, (const uint8_t *)data + first, size - first);
+}
+
+static void ring_read(uint32_t position, void *data, size_t size) {
+  uint32_t offset = position & (TESA_LOGGING_DEFERRED_RING_SIZE - 1U);
+  size_t first = TESA_LOGGING_DEFERRED_RING_SIZE - offset;
+
+  if (first > size) {
+    first = size;
+  }
+  (void)memcpy(data, &deferred_ring[offset], first);
+  (void)memcpy((uint8_t *)data + first, deferred_ring, size - first);
+}
+
+/* Formats and writes every record in the ring */
+static void drain_deferred(void) {
+  tesa_log_record_buffer_t record;
+  char message[TESA_LOG_MESSAGE_SIZE];
+  uint32_t head;
+
+  for (;;) {
+    taskENTER_CRITICAL();
+    head = deferred_head;
+    taskEXIT_CRITICAL();
+
+    if (head == deferred_tail) {
+      return;
+    }
+
+    ring_read(deferred_tail, &record.header, sizeof(record.header));
+    ring_read(deferred_tail + sizeof(record.header), record.args,
+              record.header.size - sizeof(record.header));
+
+    taskENTER_CRITICAL();
+    deferred_tail += record.header.size;
+    taskEXIT_CRITICAL();
+
+    format_record(&record, message, sizeof(message));
+    write_line((tesa_log_level_t)record.header.level,
+               record.header.timestamp_ms, record.header.owner, message);
+  }
+}
+#endif
+
+static void logging_task(void *pvParameters) {
+#if (1U == TESA_LOGGING_ENABLE_DEFERRED)
   (void)pvParameters;
 
   for (;;) {
-    if (pdTRUE == xQueueReceive(queue, &event, pdMS_TO_TICKS(1000U))) {
+    drain_deferred();
+    (void)ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(1000U));
+  }
+#else
+  QueueHandle_t queue = (QueueHandle_t)pvParameters;
+  tesa_event_t *event = NULL;
+  tesa_log_message_t *log_msg = NULL;
+
+  for (;;) {
+    if (pdTRUE ==
+        tesa_event_bus_receive(queue, &event, pdMS_TO_TICKS(1000U))) {
       if ((NULL != event) && (NULL != event->payload) &&
           (sizeof(tesa_log_message_t) == event->payload_size)) {
         log_msg = (tesa_log_message_t *)event->payload;
 
         if (TESA_LOG_LEVEL_COUNT > log_msg->level) {
-          taskENTER_CRITICAL();
-          timestamp_enabled = logging_config.enable_timestamp;
-          timestamp_format = logging_config.timestamp_format;
-          taskEXIT_CRITICAL();
-
-          level_prefix = level_prefixes[log_msg->level];
-
-          date_buffer[0] = '\0';
-          time_buffer[0] = '\0';
-
-          if (timestamp_enabled) {
-            timestamp_ms = event->timestamp_ms;
-            if (0 < format_timestamp(timestamp_format, timestamp_ms,
-                                     timestamp_buffer,
-                                     sizeof(timestamp_buffer))) {
-              parse_timestamp(timestamp_buffer, timestamp_format, date_buffer,
-                              sizeof(date_buffer), time_buffer,
-                              sizeof(time_buffer));
-            }
-          }
-
-          (void)snprintf(output_buffer, sizeof(output_buffer),
-                         "[logging|%s|%s|%s|%s|%s]\r\n", level_prefix,
-                         date_buffer, time_buffer, log_msg->owner,
-                         log_msg->message);
-          (void)printf("%s", output_buffer);
-          (void)fflush(stdout);
+          write_line(log_msg->level, event->timestamp_ms, log_msg->owner,
+                     log_msg->message);
         }
 
         tesa_event_bus_free_event(event);
@@ -198,6 +683,7 @@ static void logging_task(void *pvParameters) {
       }
     }
   }
+#endif
 }
 
 tesa_event_bus_result_t tesa_logging_init(void) {
@@ -254,6 +740,10 @@ tesa_logging_init_with_config(const tesa_logging_config_t *config) {
     return TESA_EVENT_BUS_SUCCESS;
   }
 
+#if (1U == TESA_LOGGING_ENABLE_DEFERRED)
+  /* Records go through the ring; no channel or queue */
+  (void)result;
+#else
   result = tesa_event_bus_register_channel(TESA_LOGGING_CHANNEL_ID, "Logging");
   if (TESA_EVENT_BUS_SUCCESS != result) {
     (void)printf(
@@ -279,12 +769,21 @@ tesa_logging_init_with_config(const tesa_logging_config_t *config) {
     logging_queue = NULL;
     return result;
   }
+#endif
 
   logging_config.min_level = config->min_level;
   logging_config.enable_colors = config->enable_colors;
   logging_config.enable_timestamp = config->enable_timestamp;
   logging_config.timestamp_format = config->timestamp_format;
 
+#if (1U == TESA_LOGGING_ENABLE_DEFERRED)
+  task_result = xTaskCreate(logging_task, TESA_LOGGING_TASK_NAME,
+                            TESA_LOGGING_TASK_STACK_SIZE, NULL,
+                            TESA_LOGGING_TASK_PRIORITY, &logging_task_handle);
+  if (pdPASS != task_result) {
+    return TESA_EVENT_BUS_ERROR_MEMORY;
+  }
+#else
   task_result = xTaskCreate(logging_task, TESA_LOGGING_TASK_NAME,
                             TESA_LOGGING_TASK_STACK_SIZE, logging_queue,
                             TESA_LOGGING_TASK_PRIORITY, NULL);
@@ -293,8 +792,10 @@ tesa_logging_init_with_config(const tesa_logging_config_t *config) {
     logging_queue = NULL;
     return TESA_EVENT_BUS_ERROR_MEMORY;
   }
+#endif
 
   logging_initialized = true;
+  tesa_logging_min_level = config->min_level;
 
   (void)printf("[LOGGING] Logging system initialized successfully\r\n");
   (void)fflush(stdout);
@@ -306,9 +807,14 @@ static tesa_event_bus_result_t tesa_log_internal(tesa_log_level_t level,
                                                  const char *owner,
                                                  const char *format,
                                                  va_list args) {
+#if (1U == TESA_LOGGING_ENABLE_DEFERRED)
+  tesa_log_record_buffer_t record;
+  size_t record_size;
+  bool was_empty = false;
+#else
   tesa_log_message_t log_msg;
+#endif
   tesa_event_bus_result_t result;
-  tesa_log_level_t current_min_level;
 
   if ((NULL == owner) || (NULL == format)) {
     return TESA_EVENT_BUS_ERROR_INVALID_PARAM;
@@ -322,14 +828,42 @@ static tesa_event_bus_result_t tesa_log_internal(tesa_log_level_t level,
     return TESA_EVENT_BUS_ERROR_CHANNEL_NOT_FOUND;
   }
 
+  if (level < tesa_logging_min_level) {
+    return TESA_EVENT_BUS_SUCCESS;
+  }
+
+#if (1U == TESA_LOGGING_ENABLE_DEFERRED)
+  /* Record the call; the logging task formats it */
+  record.header.level = (uint8_t)level;
+  record.header.timestamp_ms =
+      (uint32_t)((uint32_t)xTaskGetTickCount() * (uint32_t)portTICK_PERIOD_MS);
+  record.header.owner = owner;
+  record.header.format = format;
+  record_size = sizeof(record.header) +
+                encode_args(format, args, record.args,
+                            &record.header.conversions);
+  record_size = (record_size + 3U) & ~(size_t)3U;
+  record.header.size = (uint16_t)record_size;
+
+  result = TESA_EVENT_BUS_ERROR_QUEUE_FULL;
   taskENTER_CRITICAL();
-  current_min_level = logging_config.min_level;
+  if ((TESA_LOGGING_DEFERRED_RING_SIZE - (deferred_head - deferred_tail)) >=
+      record_size) {
+    ring_write(deferred_head, &record, record_size);
+    was_empty = (deferred_head == deferred_tail);
+    deferred_head += (uint32_t)record_size;
+    result = TESA_EVENT_BUS_SUCCESS;
+  } else {
+    logging_dropped++;
+  }
   taskEXIT_CRITICAL();
 
-  if (level < current_min_level) {
-    return TESA_EVENT_BUS_SUCCESS;
+  /* The logging task drains the ring until it is empty, so only a record
+   * that finds it empty needs to wake it */
+  if (was_empty) {
+    (void)xTaskNotifyGive(logging_task_handle);
   }
-
+#else
   log_msg.level = level;
   (void)strncpy(log_msg.owner, owner, sizeof(log_msg.owner) - 1U);
   log_msg.owner[sizeof(log_msg.owner) - 1U] = '\0';
@@ -340,9 +874,13 @@ static tesa_event_bus_result_t tesa_log_internal(tesa_log_level_t level,
                                &log_msg, sizeof(tesa_log_message_t));
 
   if (TESA_EVENT_BUS_SUCCESS != result) {
+    taskENTER_CRITICAL();
+    logging_dropped++;
+    taskEXIT_CRITICAL();
     (void)printf("[LOG_ERROR] Failed to post log message: %d\r\n", result);
     (void)fflush(stdout);
   }
+#endif
 
   return result;
 }
@@ -431,6 +969,7 @@ tesa_event_bus_result_t tesa_logging_set_level(tesa_log_level_t min_level) {
   taskENTER_CRITICAL();
   logging_config.min_level = min_level;
   taskEXIT_CRITICAL();
+  tesa_logging_min_level = min_level;
 
   return TESA_EVENT_BUS_SUCCESS;
 }
@@ -530,4 +1069,14 @@ tesa_log_timestamp_format_t tesa_logging_get_timestamp_format(void) {
   taskEXIT_CRITICAL();
 
   return format;
+}
+
+uint32_t tesa_logging_get_dropped(void) {
+  uint32_t dropped;
+
+  taskENTER_CRITICAL();
+  dropped = logging_dropped;
+  taskEXIT_CRITICAL();
+
+  return dropped;
 }
\ No newline at end of file
@@ -33,6 +33,11 @@ typedef struct {
   tesa_log_timestamp_format_t timestamp_format;
 } tesa_logging_config_t;
 
+/* Lowest level that is logged, read by the TESA_LOG_* macros so that calls
+ * below it skip the call and their arguments. Set through
+ * tesa_logging_set_level(). */
+extern volatile tesa_log_level_t tesa_logging_min_level;
+
 tesa_event_bus_result_t tesa_logging_init(void);
 
 tesa_event_bus_result_t
@@ -55,6 +60,10 @@ tesa_logging_set_timestamp_format(tesa_log_timestamp_format_t format);
 
 tesa_log_timestamp_format_t tesa_logging_get_timestamp_format(void);
 
+/* Messages lost because the event pool (or, in deferred mode, the ring) was
+ * full. */
+uint32_t tesa_logging_get_dropped(void);
+
 tesa_event_bus_result_t tesa_log_verbose(const char *owner, const char *format,
                                          ...);
 
@@ -73,11 +82,25 @@ tesa_event_bus_result_t tesa_log_error(const char *owner, const char *format,
 tesa_event_bus_result_t tesa_log_critical(const char *owner, const char *format,
                                           ...);
 
-#define TESA_LOG_VERBOSE(owner, ...) tesa_log_verbose(owner, __VA_ARGS__)
-#define TESA_LOG_DEBUG(owner, ...) tesa_log_debug(owner, __VA_ARGS__)
-#define TESA_LOG_INFO(owner, ...) tesa_log_info(owner, __VA_ARGS__)
-#define TESA_LOG_WARNING(owner, ...) tesa_log_warning(owner, __VA_ARGS__)
-#define TESA_LOG_ERROR(owner, ...) tesa_log_error(owner, __VA_ARGS__)
-#define TESA_LOG_CRITICAL(owner, ...) tesa_log_critical(owner, __VA_ARGS__)
+#define TESA_LOG_ENABLED(level) ((level) >= tesa_logging_min_level)
+
+#define TESA_LOG_VERBOSE(owner, ...)                                           \
+  (TESA_LOG_ENABLED(TESA_LOG_VERBOSE) ? tesa_log_verbose(owner, __VA_ARGS__)   \
+                                      : TESA_EVENT_BUS_SUCCESS)
+#define TESA_LOG_DEBUG(owner, ...)                                             \
+  (TESA_LOG_ENABLED(TESA_LOG_DEBUG) ? tesa_log_debug(owner, __VA_ARGS__)       \
+                                    : TESA_EVENT_BUS_SUCCESS)
+#define TESA_LOG_INFO(owner, ...)                                              \
+  (TESA_LOG_ENABLED(TESA_LOG_INFO) ? tesa_log_info(owner, __VA_ARGS__)         \
+                                   : TESA_EVENT_BUS_SUCCESS)
+#define TESA_LOG_WARNING(owner, ...)                                           \
+  (TESA_LOG_ENABLED(TESA_LOG_WARNING) ? tesa_log_warning(owner, __VA_ARGS__)   \
+                                      : TESA_EVENT_BUS_SUCCESS)
+#define TESA_LOG_ERROR(owner, ...)                                             \
+  (TESA_LOG_ENABLED(TESA_LOG_ERROR) ? tesa_log_error(owner, __VA_ARGS__)       \
+                                    : TESA_EVENT_BUS_SUCCESS)
+#define TESA_LOG_CRITICAL(owner, ...)                                          \
+  (TESA_LOG_ENABLED(TESA_LOG_CRITICAL) ? tesa_log_critical(owner, __VA_ARGS__) \
+                                       : TESA_EVENT_BUS_SUCCESS)
 
 #endif
\ No newline at end of file
@@ -54,4 +54,37 @@
 #define TESA_LOGGING_TASK_NAME "LoggingTask"
 #endif
 
+/* Deferred mode. With TESA_LOGGING_ENABLE_DEFERRED set, tesa_log_*() do not
+ * format: they copy the level, a timestamp, the owner and format pointers and
+ * the raw arguments into a binary ring of TESA_LOGGING_DEFERRED_RING_SIZE
+ * bytes (a power of two), and the logging task formats them. Owner and format
+ * must then be string literals or otherwise outlive the record. %s arguments
+ * are copied, at most TESA_LOGGING_DEFERRED_STRING_MAX characters each, and
+ * a record keeps at most TESA_LOGGING_DEFERRED_ARGS_SIZE bytes of arguments;
+ * conversions past that are left out of the message.
+ */
+#ifndef TESA_LOGGING_ENABLE_DEFERRED
+#define TESA_LOGGING_ENABLE_DEFERRED 0U
+#endif
+
+#ifndef TESA_LOGGING_DEFERRED_RING_SIZE
+#define TESA_LOGGING_DEFERRED_RING_SIZE 2048U
+#endif
+
+#ifndef TESA_LOGGING_DEFERRED_ARGS_SIZE
+#define TESA_LOGGING_DEFERRED_ARGS_SIZE 64U
+#endif
+
+#ifndef TESA_LOGGING_DEFERRED_STRING_MAX
+#define TESA_LOGGING_DEFERRED_STRING_MAX 31U
+#endif
+
+#if (0U != (TESA_LOGGING_DEFERRED_RING_SIZE &                                  \
+            (TESA_LOGGING_DEFERRED_RING_SIZE - 1U))) ||                        \
+    (TESA_LOGGING_DEFERRED_RING_SIZE <                                         \
+     (TESA_LOGGING_DEFERRED_ARGS_SIZE + 32U)) ||                               \
+    (TESA_LOGGING_DEFERRED_ARGS_SIZE <= TESA_LOGGING_DEFERRED_STRING_MAX)
+#error "TESA_LOGGING_DEFERRED_RING_SIZE must be a power of two that holds a full record and TESA_LOGGING_DEFERRED_ARGS_SIZE above TESA_LOGGING_DEFERRED_STRING_MAX"
+#endif
+
 #endif
\ No newline at end of file
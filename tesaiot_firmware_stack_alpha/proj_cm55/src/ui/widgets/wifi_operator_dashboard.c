@@ -15,6 +15,9 @@
 #define WIFI_UI_SCAN_LIST_MAX (16U)
 #define WIFI_UI_DEBUG_TEXT_MAX (1800U)
 #define WIFI_UI_REFRESH_DEFAULT_MS (500U)
+#define WIFI_UI_SCAN_TIMEOUT_MS (20000U)
+#define WIFI_UI_CONNECT_TIMEOUT_MS (30000U)
+#define WIFI_UI_CALL_TIMEOUT_MS (5000U)
 
 typedef struct
 {
@@ -29,6 +32,14 @@ typedef struct
   bool debug_dirty;
 } wifi_ui_store_t;
 
+/* Scan list handed from a call callback (IPC receiver task) to the refresh timer (LVGL task). */
+typedef struct
+{
+  volatile bool ready; /* Set by the callback once filled, cleared by the timer once copied */
+  wifi_info_t scan_list[WIFI_UI_SCAN_LIST_MAX];
+  uint32_t scan_count;
+} wifi_ui_scan_reply_t;
+
 typedef struct
 {
   lv_timer_t *refresh_timer;
@@ -46,6 +57,7 @@ typedef struct
   lv_obj_t *refresh_dd;
   uint32_t refresh_ms;
   wifi_ui_store_t store;
+  wifi_ui_scan_reply_t scan_reply;
 } wifi_dashboard_ctx_t;
 
 static wifi_dashboard_ctx_t s_ctx;
@@ -97,6 +109,10 @@ static const char *wifi_reason_to_text(uint16_t reason)
   {
     return "DISCONNECTED";
   }
+  if ((uint16_t)IPC_WIFI_REASON_BUSY == reason)
+  {
+    return "BUSY";
+  }
   return "UNKNOWN";
 }
 
@@ -168,11 +184,36 @@ static void dashboard_store_init(wifi_dashboard_ctx_t *ctx)
   ctx->store.debug_dirty = true;
 }
 
+/**
+ * Completion of every dashboard Wi-Fi call (runs in the IPC receiver task). Status changes reach the
+ * store through cm55_get_wifi_status(); a scan call that ran hands its list to the refresh timer.
+ */
+static void dashboard_call_done_cb(const cm55_ipc_call_reply_t *reply, void *user_data)
+{
+  wifi_dashboard_ctx_t *ctx = (wifi_dashboard_ctx_t *)user_data;
+  uint32_t count;
+
+  if ((NULL == ctx) || (NULL == reply) || (IPC_CMD_WIFI_SCAN_REQ != reply->request))
+  {
+    return;
+  }
+  if ((CM55_IPC_CALL_OK != reply->result) || (NULL == reply->list) || ctx->scan_reply.ready)
+  {
+    return;
+  }
+
+  count = (reply->count > WIFI_UI_SCAN_LIST_MAX) ? WIFI_UI_SCAN_LIST_MAX : reply->count;
+  if (count > 0U)
+  {
+    (void)memcpy(ctx->scan_reply.scan_list, reply->list, sizeof(wifi_info_t) * count);
+  }
+  ctx->scan_reply.scan_count = count;
+  ctx->scan_reply.ready = true;
+}
+
 static void dashboard_store_poll(wifi_dashboard_ctx_t *ctx)
 {
   ipc_wifi_status_t new_status;
-  wifi_info_t new_list[WIFI_UI_SCAN_LIST_MAX];
-  uint32_t new_count;
   uint32_t debug_seq;
 
   if (NULL == ctx)
@@ -197,20 +238,16 @@ static void dashboard_store_poll(wifi_dashboard_ctx_t *ctx)
     ctx->store.debug_dirty = true;
   }
 
-  new_count = 0U;
-  if (cm55_get_wifi_list(new_list, WIFI_UI_SCAN_LIST_MAX, &new_count))
+  if (ctx->scan_reply.ready)
   {
     (void)memset(ctx->store.scan_list, 0, sizeof(ctx->store.scan_list));
-    if (new_count > WIFI_UI_SCAN_LIST_MAX)
-    {
-      new_count = WIFI_UI_SCAN_LIST_MAX;
-    }
-    if (new_count > 0U)
+    if (ctx->scan_reply.scan_count > 0U)
     {
-      (void)memcpy(ctx->store.scan_list, new_list, sizeof(wifi_info_t) * new_count);
+      (void)memcpy(ctx->store.scan_list, ctx->scan_reply.scan_list, sizeof(wifi_info_t) * ctx->scan_reply.scan_count);
     }
-    ctx->store.scan_count = new_count;
+    ctx->store.scan_count = ctx->scan_reply.scan_count;
     ctx->store.scan_dirty = true;
+    ctx->scan_reply.ready = false;
   }
 }
 
@@ -278,15 +315,13 @@ static void dashboard_connect_cb(lv_event_t *e)
   }
   ssid = lv_textarea_get_text(ctx->ssid_ta);
   pass = lv_textarea_get_text(ctx->pass_ta);
-  cm55_trigger_connect(ssid, pass, 0U);
-  cm55_trigger_status_request();
+  (void)cm55_call_connect(ssid, pass, 0U, WIFI_UI_CONNECT_TIMEOUT_MS, dashboard_call_done_cb, ctx);
 }
 
 static void dashboard_disconnect_cb(lv_event_t *e)
 {
-  (void)e;
-  cm55_trigger_disconnect();
-  cm55_trigger_status_request();
+  wifi_dashboard_ctx_t *ctx = (wifi_dashboard_ctx_t *)lv_event_get_user_data(e);
+  (void)cm55_call_disconnect(WIFI_UI_CALL_TIMEOUT_MS, dashboard_call_done_cb, ctx);
 }
 
 static void dashboard_scan_cb(lv_event_t *e)
@@ -297,14 +332,13 @@ static void dashboard_scan_cb(lv_event_t *e)
     ctx->store.scan_requested = true;
     ctx->store.scan_dirty = true;
   }
-  cm55_trigger_scan_all();
-  cm55_trigger_status_request();
+  (void)cm55_call_scan(NULL, WIFI_UI_SCAN_TIMEOUT_MS, dashboard_call_done_cb, ctx);
 }
 
 static void dashboard_status_cb(lv_event_t *e)
 {
-  (void)e;
-  cm55_trigger_status_request();
+  wifi_dashboard_ctx_t *ctx = (wifi_dashboard_ctx_t *)lv_event_get_user_data(e);
+  (void)cm55_call_status(WIFI_UI_CALL_TIMEOUT_MS, dashboard_call_done_cb, ctx);
 }
 
 static lv_obj_t *dashboard_action_button(lv_obj_t *parent, const char *text, lv_event_cb_t cb, void *user_data, bool primary)
@@ -422,7 +456,7 @@ static void dashboard_render_scan(wifi_dashboard_ctx_t *ctx)
     if ((NULL != ctx->ssid_ta) && (ctx->store.scan_list[i].ssid[0] != '\0'))
     {
       lv_obj_add_flag(row, LV_OBJ_FLAG_CLICKABLE);
-      lv_obj_add_event_cb(row, dashboard_status_cb, LV_EVENT_CLICKED, NULL);
+      lv_obj_add_event_cb(row, dashboard_status_cb, LV_EVENT_CLICKED, ctx);
     }
   }
 }
@@ -758,6 +792,6 @@ void wifi_operator_dashboard_create(lv_obj_t *screen)
   s_ctx.refresh_timer = lv_timer_create(dashboard_refresh_cb, s_ctx.refresh_ms, &s_ctx);
   lv_obj_add_event_cb(screen, dashboard_delete_cb, LV_EVENT_DELETE, &s_ctx);
 
-  cm55_trigger_status_request();
+  (void)cm55_call_status(WIFI_UI_CALL_TIMEOUT_MS, dashboard_call_done_cb, &s_ctx);
   dashboard_refresh_cb(s_ctx.refresh_timer);
 }
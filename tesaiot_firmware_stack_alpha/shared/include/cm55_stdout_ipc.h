@@ -0,0 +1,59 @@
+/*******************************************************************************
+ * File Name        : cm55_stdout_ipc.h
+ *
+ * Description      : Buffered CM55 stdout/stderr transport. _write() copies
+ *                    output into a ring and returns; the FreeRTOS timer
+ *                    task sends it to CM33 as full IPC_CMD_PRINT frames on
+ *                    newline, when a frame's worth is buffered, or after a
+ *                    short idle delay. Tasks and ISRs may write; output
+ *                    that does not fit is dropped, never waited for.
+ *
+ * Author           : Asst.Prof.Santi Nuratch, Ph.D
+ *                    Thailand Embedded Systems Association (TESA)
+ *
+ *******************************************************************************/
+
+#ifndef CM55_STDOUT_IPC_H
+#define CM55_STDOUT_IPC_H
+
+/*******************************************************************************
+ * Header Files
+ *******************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define CM55_STDOUT_IPC_BUF_SIZE (8192U)     /* Pending output bytes; a power of two. Holds a full Wi-Fi scan dump */
+#define CM55_STDOUT_IPC_FLUSH_MS (10U)       /* Longest a partial line waits before it is sent */
+#define CM55_STDOUT_IPC_LINE_FLUSH_TICKS (1U) /* Delay after a newline, so back-to-back lines share frames */
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+
+typedef struct
+{
+  uint32_t written; /* Bytes accepted by _write() */
+  uint32_t dropped; /* Bytes discarded because the ring was full */
+  uint32_t frames;  /* IPC_CMD_PRINT frames sent */
+  uint32_t retries; /* Flushes deferred because the IPC bulk lane was full */
+} cm55_stdout_ipc_stats_t;
+
+/*******************************************************************************
+ * Function prototypes
+ *******************************************************************************/
+
+/**
+ * Creates the flush timer and sends anything written so far. Call once after cm55_ipc_pipe_start();
+ * until then output is only buffered. Returns false if the timer cannot be created.
+ */
+bool cm55_stdout_ipc_init(void);
+
+/**
+ * Copies the transport counters. Returns false for NULL stats.
+ */
+bool cm55_stdout_ipc_get_stats(cm55_stdout_ipc_stats_t *stats);
+
+#endif /* CM55_STDOUT_IPC_H */
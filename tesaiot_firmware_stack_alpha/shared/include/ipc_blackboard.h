@@ -0,0 +1,126 @@
+/*******************************************************************************
+ * File Name        : ipc_blackboard.h
+ *
+ * Description      : Shared-memory blackboard for state where only the latest
+ *                    value matters (IMU sample, fusion orientation, Wi-Fi link
+ *                    status, button state). CM33 owns the board and publishes
+ *                    into versioned slots; CM55 reads consistent snapshots
+ *                    straight from shared memory, without an interrupt or a
+ *                    frame through the pipe. Each slot is a seqlock: the
+ *                    writer makes the sequence odd while it copies, and a
+ *                    reader retries when the sequence was odd or changed.
+ *
+ * Author           : Asst.Prof.Santi Nuratch, Ph.D
+ *                    Thailand Embedded Systems Association (TESA)
+ *
+ *******************************************************************************/
+
+#ifndef IPC_BLACKBOARD_H
+#define IPC_BLACKBOARD_H
+
+/*******************************************************************************
+ * Header Files
+ *******************************************************************************/
+#include "ipc_communication.h"
+#include "user_buttons_types.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define IPC_BLACKBOARD_SLOT_BYTES (64U) /* Per slot, sequence included; a multiple of the cache line */
+#define IPC_BLACKBOARD_DATA_MAX (IPC_BLACKBOARD_SLOT_BYTES - (2U * sizeof(uint32_t))) /* Largest value */
+#define IPC_BLACKBOARD_READ_RETRIES (8U) /* Reads attempted before a slot under constant rewrite is reported busy */
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+
+typedef enum
+{
+  IPC_BLACKBOARD_IMU = 0U,         /* ipc_imu_sample_t, from gyro_task */
+  IPC_BLACKBOARD_ORIENTATION = 1U, /* ipc_orientation_t, from the BSXlite fusion task */
+  IPC_BLACKBOARD_WIFI_STATUS = 2U, /* ipc_wifi_status_t, from the Wi-Fi manager */
+  IPC_BLACKBOARD_BUTTONS = 3U,     /* ipc_button_state_t, from the user button handler */
+  IPC_BLACKBOARD_SLOT_COUNT
+} ipc_blackboard_slot_t;
+
+typedef struct
+{
+  gyro_data_t data;  /* Latest sample */
+  uint32_t sequence; /* Sample counter of the producer */
+} ipc_imu_sample_t;
+
+typedef struct
+{
+  float qw; /* Rotation vector quaternion */
+  float qx;
+  float qy;
+  float qz;
+  float ax; /* Accelerometer input of the fusion step */
+  float ay;
+  float az;
+  float gx; /* Gyroscope input of the fusion step */
+  float gy;
+  float gz;
+} ipc_orientation_t;
+
+typedef struct
+{
+  uint32_t pressed;                    /* Bit n set while button n is held */
+  uint32_t press_count[BUTTON_ID_MAX]; /* Presses since boot, per button */
+} ipc_button_state_t;
+
+/**
+ * One slot. seq is 0 until the first publish, odd while a write is in progress and even otherwise;
+ * seq / 2 is the number of publishes. Written by one core only.
+ */
+typedef struct
+{
+  volatile uint32_t seq;                 /* Sequence; see above */
+  volatile uint32_t stamp_us;            /* ipc_stats_now_us() of the publish (shared timebase) */
+  uint8_t data[IPC_BLACKBOARD_DATA_MAX]; /* Value, valid only between two equal even seq reads */
+} ipc_blackboard_entry_t;
+
+/**
+ * The board. Instances must be placed in shared memory and aligned to IPC_RING_CACHE_LINE; slots
+ * never share a cache line. The owning core passes its address in the doorbell.
+ */
+typedef struct
+{
+  ipc_blackboard_entry_t slots[IPC_BLACKBOARD_SLOT_COUNT];
+} ipc_blackboard_t;
+
+/*******************************************************************************
+ * Function prototypes
+ *******************************************************************************/
+
+/**
+ * Marks every slot as never published. Call once on the owning core before its address is shared.
+ */
+void ipc_blackboard_init(ipc_blackboard_t *board);
+
+/**
+ * Owner: copies len bytes of value into slot and stamps it. len must be the slot's value size. Runs
+ * in a short critical section so a reader on the other core never waits on a preempted writer.
+ * Returns false for an invalid slot or len.
+ */
+bool ipc_blackboard_publish(ipc_blackboard_t *board, ipc_blackboard_slot_t slot, const void *value, uint32_t len);
+
+/**
+ * Any core: copies a consistent snapshot of slot into out (len must be the slot's value size).
+ * version (may be NULL) receives the publish count, so a poller can tell whether the value changed,
+ * and stamp_us (may be NULL) the publish time on the shared timebase. Returns false if the slot was
+ * never published, was being rewritten on every one of IPC_BLACKBOARD_READ_RETRIES attempts, or the
+ * arguments are invalid; out is then undefined. Never blocks; safe in ISR context.
+ */
+bool ipc_blackboard_read(const ipc_blackboard_t *board, ipc_blackboard_slot_t slot, void *out, uint32_t len,
+                         uint32_t *version, uint32_t *stamp_us);
+
+/**
+ * Any core: publish count of slot (0: never published) without copying the value.
+ */
+uint32_t ipc_blackboard_version(const ipc_blackboard_t *board, ipc_blackboard_slot_t slot);
+
+#endif /* IPC_BLACKBOARD_H */
@@ -0,0 +1,121 @@
+/*******************************************************************************
+ * File Name        : ipc_cmd.h
+ *
+ * Description      : IPC command registry shared by CM33 and CM55. One table
+ *                    lists every command with its name, payload size, the
+ *                    shortest payload a receiver accepts and its send lane.
+ *                    It is checked at compile time and indexed in O(1) by
+ *                    command ID; each core binds its receive handlers to the
+ *                    same index and dispatches through ipc_cmd_dispatch().
+ *
+ * Author           : Asst.Prof.Santi Nuratch, Ph.D
+ *                    Thailand Embedded Systems Association (TESA)
+ *
+ *******************************************************************************/
+
+#ifndef IPC_CMD_H
+#define IPC_CMD_H
+
+/*******************************************************************************
+ * Header Files
+ *******************************************************************************/
+#include "ipc_communication.h"
+#include "ipc_lane.h"
+#include "user_buttons_types.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define IPC_CMD_ID_SLOTS ((IPC_CMD_ID_LAST - IPC_CMD_ID_FIRST) + 1U) /* Registry and handler table size */
+
+/** Registry index of a command ID known to be in IPC_CMD_ID_FIRST..IPC_CMD_ID_LAST (compile-time use). */
+#define IPC_CMD_SLOT(cmd) ((uint32_t)(cmd) - (uint32_t)IPC_CMD_ID_FIRST)
+
+/*
+ * Command registry: X(cmd, name, payload_len, min_len, lane)
+ *   payload_len  Largest payload the receiver reads: its struct size, IPC_DATA_MAX_LEN for text.
+ *   min_len      Shortest payload accepted. ipc_cmd_dispatch() drops shorter frames before the
+ *                handler runs, so a handler may read min_len bytes of data[] without checking len.
+ *                Requests whose receiver zero-fills a short struct use 0.
+ *   lane         Send lane (see ipc_lane.h). Commands whose relative order matters share a lane.
+ * A new command only needs its ID in ipc_communication.h and a line here; the static asserts in
+ * ipc_cmd.c reject IDs outside the registry range, duplicate IDs and payloads over IPC_DATA_MAX_LEN.
+ */
+#define IPC_CMD_TABLE(X)                                                                                          \
+  X(IPC_CMD_LOG, "LOG", IPC_DATA_MAX_LEN, 0U, IPC_LANE_BULK)                                                      \
+  X(IPC_CMD_GYRO, "GYRO", sizeof(gyro_data_t), sizeof(gyro_data_t), IPC_LANE_BULK)                                \
+  X(IPC_CMD_BUTTON_EVENT, "BUTTON", sizeof(button_event_t), sizeof(button_event_t), IPC_LANE_CONTROL)             \
+  X(IPC_CMD_CLI_MSG, "CLI_MSG", IPC_DATA_MAX_LEN, 0U, IPC_LANE_BULK)                                              \
+  X(IPC_CMD_TOUCH, "TOUCH", sizeof(ipc_touch_event_t), sizeof(ipc_touch_event_t), IPC_LANE_CONTROL)               \
+  X(IPC_CMD_PRINT, "PRINT", IPC_DATA_MAX_LEN, 0U, IPC_LANE_BULK)                                                  \
+  X(IPC_CMD_BENCH, "BENCH", IPC_DATA_MAX_LEN, 0U, IPC_LANE_BULK)                                                  \
+  X(IPC_CMD_BENCH_REPORT, "BENCH_REPORT", sizeof(ipc_bench_report_t), sizeof(ipc_bench_report_t),                 \
+    IPC_LANE_CONTROL)                                                                                             \
+  X(IPC_CMD_TIME_SYNC, "TIME_SYNC", sizeof(ipc_time_sync_t), 0U, IPC_LANE_CONTROL)                                \
+  X(IPC_CMD_PING, "PING", 0U, 0U, IPC_LANE_CONTROL)                                                               \
+  X(IPC_CMD_WIFI_SCAN_REQ, "WIFI_SCAN_REQ", sizeof(ipc_wifi_scan_request_t), 0U, IPC_LANE_CONTROL)                \
+  X(IPC_CMD_WIFI_CONNECT_REQ, "WIFI_CONNECT_REQ", sizeof(ipc_wifi_connect_request_t), 0U, IPC_LANE_CONTROL)       \
+  X(IPC_CMD_WIFI_DISCONNECT_REQ, "WIFI_DISCONNECT_REQ", 0U, 0U, IPC_LANE_CONTROL)                                 \
+  X(IPC_CMD_WIFI_STATUS_REQ, "WIFI_STATUS_REQ", 0U, 0U, IPC_LANE_CONTROL)                                         \
+  X(IPC_CMD_WIFI_SCAN_ACK, "WIFI_SCAN_ACK", sizeof(ipc_wifi_scan_ack_t), sizeof(ipc_wifi_scan_ack_t),             \
+    IPC_LANE_CONTROL)                                                                                             \
+  X(IPC_EVT_WIFI_SCAN_COMPLETE, "WIFI_SCAN_COMPLETE", sizeof(ipc_wifi_scan_complete_t), 0U, IPC_LANE_BULK)        \
+  X(IPC_EVT_WIFI_STATUS, "WIFI_STATUS", sizeof(ipc_wifi_status_t), sizeof(ipc_wifi_status_t), IPC_LANE_CONTROL)   \
+  X(IPC_EVT_WIFI_SCAN_BULK, "WIFI_SCAN_BULK", sizeof(ipc_wifi_scan_bulk_t), sizeof(ipc_wifi_scan_bulk_t),         \
+    IPC_LANE_BULK)                                                                                                \
+  X(IPC_CMD_EVENT_BATCH, "EVENT_BATCH", sizeof(ipc_event_batch_t), sizeof(ipc_event_batch_t), IPC_LANE_BULK)      \
+  X(IPC_CMD_EVENT_BATCH_ACK, "EVENT_BATCH_ACK", sizeof(ipc_event_batch_ack_t), sizeof(ipc_event_batch_ack_t),     \
+    IPC_LANE_CONTROL)                                                                                             \
+  X(IPC_CMD_EVENT_SUBSCRIBE, "EVENT_SUBSCRIBE", sizeof(ipc_event_subscribe_t), sizeof(ipc_event_subscribe_t),     \
+    IPC_LANE_CONTROL)
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+
+/** Registry entry of one command. name is NULL for IDs in the range that are not registered. */
+typedef struct
+{
+  const char *name;     /* Short name for logs and the CLI */
+  uint16_t payload_len; /* Largest payload the receiver reads */
+  uint16_t min_len;     /* Shortest payload accepted */
+  ipc_lane_t lane;      /* Send lane */
+} ipc_cmd_info_t;
+
+/**
+ * Receive handler. msg is valid for the call only and carries at least the registered min_len
+ * payload bytes. arg is whatever the core passes to ipc_cmd_dispatch() (receive time, ISR wake flag).
+ */
+typedef void (*ipc_cmd_handler_t)(const ipc_msg_t *msg, void *arg);
+
+typedef enum
+{
+  IPC_CMD_DISPATCHED = 0U, /* Handler ran */
+  IPC_CMD_UNHANDLED = 1U,  /* Unregistered command or no handler on this core */
+  IPC_CMD_BAD_LEN = 2U     /* Payload shorter than min_len or longer than IPC_DATA_MAX_LEN */
+} ipc_cmd_result_t;
+
+/*******************************************************************************
+ * Function prototypes
+ *******************************************************************************/
+
+/**
+ * Registry entry of cmd, or NULL if cmd is not registered. O(1).
+ */
+const ipc_cmd_info_t *ipc_cmd_info(uint32_t cmd);
+
+/**
+ * Runs the handler bound to msg->cmd in handlers, a table of IPC_CMD_ID_SLOTS entries indexed by
+ * IPC_CMD_SLOT(cmd) (NULL entries are unhandled), after checking msg->len against the registry.
+ * Safe in ISR context if the handlers are.
+ */
+ipc_cmd_result_t ipc_cmd_dispatch(const ipc_cmd_handler_t *handlers, const ipc_msg_t *msg, void *arg);
+
+/**
+ * Short command name ("GYRO", "WIFI_STATUS", ...), "?" if not registered.
+ */
+const char *ipc_cmd_name(uint32_t cmd);
+
+#endif /* IPC_CMD_H */
@@ -19,6 +19,7 @@
 #include "cybsp.h"
 #include "wifi_scanner_types.h"
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 /*******************************************************************************
@@ -61,32 +62,71 @@
 #define IPC_CMD_TOUCH (0x95)
 #define IPC_CMD_PING (0x9F)
 #define IPC_CMD_PRINT (0x96)
+#define IPC_CMD_BENCH (0x98)        /* Throughput benchmark frame, CM33 -> CM55 */
+#define IPC_CMD_BENCH_REPORT (0x99) /* Benchmark result (ipc_bench_report_t), CM55 -> CM33 */
+#define IPC_CMD_TIME_SYNC (0x9A)    /* Shared timebase exchange (ipc_time_sync_t), CM55 -> CM33 -> CM55 */
 
 /* Wi-Fi command messages sent from CM55 to CM33 */
 #define IPC_CMD_WIFI_SCAN_REQ (0xA0)
 #define IPC_CMD_WIFI_CONNECT_REQ (0xA1)
 #define IPC_CMD_WIFI_DISCONNECT_REQ (0xA2)
 #define IPC_CMD_WIFI_STATUS_REQ (0xA3)
+#define IPC_CMD_WIFI_SCAN_ACK (0xA4) /* ipc_wifi_scan_ack_t: releases the CM33 scan buffer */
+
+/*
+ * Wi-Fi request calls: a CM55 request may carry a non-zero call ID in ipc_msg_t.value. CM33 echoes
+ * it in the value of exactly one event that answers the request: IPC_EVT_WIFI_SCAN_COMPLETE for a
+ * scan that ran, otherwise IPC_EVT_WIFI_STATUS (status reply, connect/disconnect outcome, scan
+ * refused or failed, IPC_WIFI_REASON_BUSY if CM33 could not queue the request). Events nobody asked
+ * for carry IPC_CALL_ID_NONE.
+ */
+#define IPC_CALL_ID_NONE (0UL)
 
 /* Wi-Fi event messages sent from CM33 to CM55 */
-#define IPC_EVT_WIFI_SCAN_RESULT (0xB0)
 #define IPC_EVT_WIFI_SCAN_COMPLETE (0xB1)
 #define IPC_EVT_WIFI_STATUS (0xB2)
+#define IPC_EVT_WIFI_SCAN_BULK (0xB3) /* ipc_wifi_scan_bulk_t: whole result list in shared memory */
+
+/* Event bridge messages, sent in both directions (see ipc_event_bridge.h) */
+#define IPC_CMD_EVENT_BATCH (0xC0)     /* ipc_event_batch_t: batch of bus events in the sender's shared memory */
+#define IPC_CMD_EVENT_BATCH_ACK (0xC1) /* ipc_event_batch_ack_t: releases the sender's batch buffer */
+#define IPC_CMD_EVENT_SUBSCRIBE (0xC2) /* ipc_event_subscribe_t: first subscriber joined or last one left */
+
+/* Command ID range of the registry in ipc_cmd.h; every command above must fall inside it */
+#define IPC_CMD_ID_FIRST (IPC_CMD_LOG)
+#define IPC_CMD_ID_LAST (IPC_CMD_EVENT_SUBSCRIBE)
+
+#define IPC_WIFI_SCAN_BULK_MAX (32U) /* Max wifi_info_t entries per bulk transfer */
+#define IPC_WIFI_SCAN_BULK_VALUE_BENCH (0x1UL) /* IPC_EVT_WIFI_SCAN_BULK value flag: benchmark data, ack only */
+#define IPC_WIFI_SCAN_ACK_OK (0U) /* List verified and copied; buffer released */
+#define IPC_WIFI_SCAN_ACK_CRC_ERROR (1U) /* CRC mismatch; list discarded, buffer released */
 
-#define IPC_WIFI_SCAN_VALUE_INDEX_MASK (0xFFFFU)
-#define IPC_WIFI_SCAN_VALUE_COUNT_SHIFT (16U)
+#define IPC_EVENT_BATCH_ACK_OK (0U)        /* Every record delivered or refused by the local bus */
+#define IPC_EVENT_BATCH_ACK_MALFORMED (1U) /* A record overran the batch; the rest was skipped */
+
+#define IPC_BENCH_VALUE_END (0x80000000UL) /* IPC_CMD_BENCH value flag: last frame, reply with report */
 
 #define IPC_DATA_MAX_LEN (128UL) /* Max data length in bytes (char elements) */
 
+/**
+ * Variable-length IPC frame. Only the header and the first len bytes of data[] are ever copied
+ * (send buffers, shared rings, receive ring); bytes past len are undefined on the receiving side, so
+ * receivers must check len before reading a payload struct. The pipe driver header (client ID and
+ * release mask) travels in the doorbell, not in every frame.
+ */
 typedef struct
 {
-  uint16_t client_id;          /* Bits 0-7: Client ID */
-  uint16_t intr_mask;          /* Bits 16-31: Release Mask (MANDATORY for Pipe Driver) */
   uint32_t cmd;                /* Command code (e.g. IPC_CMD_LOG, IPC_CMD_GYRO) */
   uint32_t value;              /* Command argument or flags */
-  char data[IPC_DATA_MAX_LEN]; /* Payload buffer, up to IPC_DATA_MAX_LEN bytes */
+  uint16_t len;                /* Bytes of data[] in use, 0..IPC_DATA_MAX_LEN */
+  uint16_t reserved;           /* Keeps data[] 32-bit aligned; write 0 */
+  uint32_t sent_us;            /* ipc_stats_now_us() when published to the ring; set by the sender task */
+  char data[IPC_DATA_MAX_LEN]; /* Payload buffer, only data[0..len-1] is valid */
 } ipc_msg_t;
 
+#define IPC_MSG_HDR_LEN (offsetof(ipc_msg_t, data)) /* Bytes before data[] in every frame */
+#define IPC_MSG_FRAME_LEN(payload_len) (IPC_MSG_HDR_LEN + (payload_len)) /* Frame size for a payload length */
+
 typedef struct
 {
   int16_t x;
@@ -116,7 +156,8 @@ typedef enum
   IPC_WIFI_REASON_SCAN_BLOCKED_CONNECTED = 1U,
   IPC_WIFI_REASON_SCAN_FAILED = 2U,
   IPC_WIFI_REASON_CONNECT_FAILED = 3U,
-  IPC_WIFI_REASON_DISCONNECTED = 4U
+  IPC_WIFI_REASON_DISCONNECTED = 4U,
+  IPC_WIFI_REASON_BUSY = 5U /* Request not queued on CM33 (manager queue full); only sent as a call reply */
 } ipc_wifi_reason_t;
 
 typedef struct
@@ -146,6 +187,76 @@ typedef struct
   uint16_t status;
 } ipc_wifi_scan_complete_t;
 
+/**
+ * Bulk scan handoff. CM33 copies the list into its shared-memory scan buffer and sends this
+ * descriptor; CM55 copies the list out, checks crc32 over its copy and answers
+ * IPC_CMD_WIFI_SCAN_ACK with the same transfer_id, retrying until the ack is sent. CM33 does not
+ * reuse the buffer until then. If no ack arrives within IPC_SCAN_RECLAIM_MS (2 s) it takes the
+ * buffer back under a new transfer_id, so a late ack is ignored and a list CM55 was still copying
+ * fails the CRC.
+ */
+typedef struct
+{
+  uint16_t transfer_id;    /* Incremented per transfer; echoed in the ack */
+  uint16_t count;          /* wifi_info_t entries in list, 0..IPC_WIFI_SCAN_BULK_MAX */
+  uint32_t crc32;          /* ipc_crc32() over count * sizeof(wifi_info_t) bytes of list */
+  const wifi_info_t *list; /* CM33 scan buffer (CY_SECTION_SHAREDMEM) */
+} ipc_wifi_scan_bulk_t;
+
+typedef struct
+{
+  uint16_t transfer_id; /* From ipc_wifi_scan_bulk_t */
+  uint16_t status;      /* IPC_WIFI_SCAN_ACK_OK or IPC_WIFI_SCAN_ACK_CRC_ERROR */
+} ipc_wifi_scan_ack_t;
+
+/**
+ * Event bridge handoff. The sender fills one of its shared-memory batch buffers with
+ * ipc_event_record_t entries and sends this descriptor; the receiver posts each record on its own
+ * bus and answers IPC_CMD_EVENT_BATCH_ACK with the same batch_id and buffer. The sender does not
+ * write the buffer again until then.
+ */
+typedef struct
+{
+  const uint8_t *records; /* Sender's batch buffer (CY_SECTION_SHAREDMEM) */
+  uint16_t bytes;         /* Bytes of records in use */
+  uint16_t count;         /* Records in the batch */
+  uint16_t batch_id;      /* Incremented per batch; echoed in the ack */
+  uint8_t buffer;         /* Index of the buffer, 0..IPC_EVENT_BRIDGE_BUFFERS - 1; echoed in the ack */
+  uint8_t reserved;
+} ipc_event_batch_t;
+
+typedef struct
+{
+  uint16_t batch_id; /* From ipc_event_batch_t */
+  uint8_t buffer;    /* From ipc_event_batch_t */
+  uint8_t status;    /* IPC_EVENT_BATCH_ACK_OK or IPC_EVENT_BATCH_ACK_MALFORMED */
+} ipc_event_batch_ack_t;
+
+typedef struct
+{
+  uint16_t channel_id; /* Remote channel */
+  uint8_t subscribed;  /* 1: the sender has subscribers for it, 0: no longer */
+  uint8_t reserved;
+} ipc_event_subscribe_t;
+
+/**
+ * IPC_CMD_TIME_SYNC payload. CM55 sends the request empty; CM33 answers with t0_us = the request's
+ * sent_us and t1_us = its receive time. With the reply's sent_us and CM55's receive time that gives
+ * the four timestamps of an NTP-style offset estimate (see ipc_stats.h).
+ */
+typedef struct
+{
+  uint32_t t0_us; /* Request sent, CM55 estimate of CM33 time */
+  uint32_t t1_us; /* Request received, CM33 time */
+} ipc_time_sync_t;
+
+typedef struct
+{
+  uint32_t frames; /* IPC_CMD_BENCH frames received (end marker excluded) */
+  uint32_t bytes;  /* Payload bytes received */
+  uint32_t lost;   /* Frames missing from the sequence */
+} ipc_bench_report_t;
+
 /*******************************************************************************
  * Function prototypes
  *******************************************************************************/
@@ -0,0 +1,30 @@
+/*******************************************************************************
+ * File Name        : ipc_crc.h
+ *
+ * Description      : CRC-32 (IEEE 802.3, reflected, init/xorout 0xFFFFFFFF)
+ *                    used to check bulk IPC transfers on both cores.
+ *
+ * Author           : Asst.Prof.Santi Nuratch, Ph.D
+ *                    Thailand Embedded Systems Association (TESA)
+ *
+ *******************************************************************************/
+
+#ifndef IPC_CRC_H
+#define IPC_CRC_H
+
+/*******************************************************************************
+ * Header Files
+ *******************************************************************************/
+#include <stdint.h>
+
+/*******************************************************************************
+ * Function prototypes
+ *******************************************************************************/
+
+/**
+ * CRC-32 of len bytes at data ("123456789" -> 0xCBF43926). Uses a 16-entry
+ * nibble table, so it is small enough for both cores and safe in ISR context.
+ */
+uint32_t ipc_crc32(const void *data, uint32_t len);
+
+#endif /* IPC_CRC_H */
@@ -0,0 +1,152 @@
+/*******************************************************************************
+ * File Name        : ipc_event_bridge.h
+ *
+ * Description      : Cross-core event bridge. Lets a publish/subscribe channel
+ *                    span CM33 and CM55: each core's event bus marks channels
+ *                    remote, and events posted on a remote channel that the
+ *                    other core subscribes to are copied into a batch buffer
+ *                    in shared memory. The timer task hands each batch to the
+ *                    peer with one IPC_CMD_EVENT_BATCH descriptor, and the
+ *                    peer re-posts every record on its own bus, then releases
+ *                    the buffer with IPC_CMD_EVENT_BATCH_ACK. Subscriptions
+ *                    travel as IPC_CMD_EVENT_SUBSCRIBE frames, so a channel
+ *                    nobody on the other core listens to costs one table
+ *                    lookup per post and no IPC traffic.
+ *
+ * Author           : Asst.Prof.Santi Nuratch, Ph.D
+ *                    Thailand Embedded Systems Association (TESA)
+ *
+ *******************************************************************************/
+
+#ifndef IPC_EVENT_BRIDGE_H
+#define IPC_EVENT_BRIDGE_H
+
+/*******************************************************************************
+ * Header Files
+ *******************************************************************************/
+#include "ipc_communication.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+/* Builds the bridge into both IPC pipes. Off by default: no firmware bus is attached to it yet, and
+ * when off the batch buffers, flush timer and bridge command handlers are compiled out. The host
+ * simulator turns it on. */
+#ifndef IPC_EVENT_BRIDGE_ENABLE
+#define IPC_EVENT_BRIDGE_ENABLE 0
+#endif
+
+#define IPC_EVENT_BRIDGE_BUFFERS (2U)          /* Batch buffers per core; one fills while the other is in flight */
+#define IPC_EVENT_BRIDGE_BATCH_BYTES (1024U)   /* Per buffer; a multiple of the cache line */
+#define IPC_EVENT_BRIDGE_PAYLOAD_MAX (IPC_DATA_MAX_LEN) /* Largest forwarded payload */
+#define IPC_EVENT_BRIDGE_CHANNELS (16U)        /* Remote channels tracked per direction */
+#define IPC_EVENT_BRIDGE_FLUSH_TICKS (1U)      /* Longest a partly filled batch waits for more events */
+
+/** Bytes one event takes in a batch: record header plus payload, padded to 4 bytes. */
+#define IPC_EVENT_RECORD_LEN(payload_len) (sizeof(ipc_event_record_t) + ((((uint32_t)(payload_len)) + 3U) & ~3U))
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+
+/** One event in a batch buffer, followed by len payload bytes. */
+typedef struct
+{
+  uint16_t channel_id; /* Channel (CM55) or event ID (CM33) the event was posted on */
+  uint16_t len;        /* Payload bytes, 0..IPC_EVENT_BRIDGE_PAYLOAD_MAX */
+  uint32_t event_type; /* Event type on CM55, 0 from CM33 */
+} ipc_event_record_t;
+
+/**
+ * Batch buffers of one core. Instances must be placed in shared memory and aligned to
+ * IPC_RING_CACHE_LINE; the owning core passes their address to ipc_event_bridge_init().
+ */
+typedef struct
+{
+  uint8_t data[IPC_EVENT_BRIDGE_BUFFERS][IPC_EVENT_BRIDGE_BATCH_BYTES];
+} ipc_event_bridge_buffers_t;
+
+/** Sends one frame to the peer without waiting; false if the lane was busy or full. */
+typedef bool (*ipc_event_bridge_send_t)(uint32_t cmd, const void *data, uint32_t len);
+
+/**
+ * Posts one received event on the local bus. payload is only valid during the call. Returns false if
+ * the local bus refused it (for example, an unknown channel).
+ */
+typedef bool (*ipc_event_bridge_deliver_t)(uint16_t channel_id, uint32_t event_type, const void *payload,
+                                          uint32_t len);
+
+typedef struct
+{
+  uint32_t forwarded;        /* Events copied into a batch for the peer */
+  uint32_t dropped;          /* Events for a subscribed peer lost: no free batch buffer or payload too large */
+  uint32_t batches_sent;     /* IPC_CMD_EVENT_BATCH descriptors sent */
+  uint32_t send_retries;     /* Flushes deferred because a lane was busy or full */
+  uint32_t received;         /* Events from the peer delivered to the local bus */
+  uint32_t undelivered;      /* ... that the local bus refused */
+  uint32_t batches_received; /* Batches walked and acknowledged */
+  uint32_t malformed;        /* Received batches with a bad record; the rest of the batch is skipped */
+  uint8_t peer_channels;     /* Channels the peer has subscribers for */
+  uint8_t local_channels;    /* Remote channels with local subscribers */
+} ipc_event_bridge_stats_t;
+
+/*******************************************************************************
+ * Function prototypes
+ *******************************************************************************/
+
+/**
+ * Sets up the bridge of this core: buffers holds the outgoing batches, send queues frames to the
+ * peer and deliver posts received events locally. Creates the flush timer; call once after the
+ * core's IPC pipe is started. Returns false for NULL arguments or if the timer cannot be created.
+ */
+bool ipc_event_bridge_init(ipc_event_bridge_buffers_t *buffers, ipc_event_bridge_send_t send,
+                           ipc_event_bridge_deliver_t deliver);
+
+/**
+ * Local bus, after a post on a remote channel: copies the event into the filling batch if the peer
+ * subscribes to channel_id. Never blocks; from_isr selects the ISR-safe critical section and timer
+ * calls. Returns false if the peer does not subscribe, the event is the echo of one being delivered
+ * from the peer, or it was dropped (counted).
+ */
+bool ipc_event_bridge_forward(uint16_t channel_id, uint32_t event_type, const void *payload, uint32_t len,
+                              bool from_isr);
+
+/**
+ * Local bus, task context: the remote channel channel_id gained its first local subscriber
+ * (subscribed true) or lost its last. The peer is told on the next flush, and told again until its
+ * control lane takes the frame. Returns false if IPC_EVENT_BRIDGE_CHANNELS channels are already
+ * tracked.
+ */
+bool ipc_event_bridge_set_interest(uint16_t channel_id, bool subscribed);
+
+/**
+ * Task context: sends the filling batch now instead of after IPC_EVENT_BRIDGE_FLUSH_TICKS.
+ */
+void ipc_event_bridge_flush(void);
+
+/**
+ * IPC_CMD_EVENT_BATCH handler, task context: delivers every record of the peer's batch, then
+ * acknowledges it. Records are read straight from the peer's buffer, which it does not reuse before
+ * the ack.
+ */
+void ipc_event_bridge_receive(const ipc_event_batch_t *batch);
+
+/**
+ * IPC_CMD_EVENT_BATCH_ACK handler, task context: frees the acknowledged batch buffer.
+ */
+void ipc_event_bridge_on_ack(const ipc_event_batch_ack_t *ack);
+
+/**
+ * IPC_CMD_EVENT_SUBSCRIBE handler, task context: adds channel_id to, or removes it from, the
+ * channels forwarded to the peer.
+ */
+void ipc_event_bridge_on_subscribe(const ipc_event_subscribe_t *subscribe);
+
+/**
+ * Copies the bridge counters. Returns false for NULL stats.
+ */
+bool ipc_event_bridge_get_stats(ipc_event_bridge_stats_t *stats);
+
+#endif /* IPC_EVENT_BRIDGE_H */
@@ -0,0 +1,109 @@
+/*******************************************************************************
+ * File Name        : ipc_lane.h
+ *
+ * Description      : Priority lanes for the IPC send path. Every command is
+ *                    mapped to a latency-critical control lane or a bulk lane;
+ *                    each core keeps one send buffer per lane and its sender
+ *                    serves them with strict priority. Also provides the
+ *                    cycle-counter timebase and the per-lane counters used
+ *                    to report p50/p99 queueing delay.
+ *
+ * Author           : Asst.Prof.Santi Nuratch, Ph.D
+ *                    Thailand Embedded Systems Association (TESA)
+ *
+ *******************************************************************************/
+
+#ifndef IPC_LANE_H
+#define IPC_LANE_H
+
+/*******************************************************************************
+ * Header Files
+ *******************************************************************************/
+#include "ipc_communication.h"
+#include "ipc_stats.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define IPC_LANE_CONTROL_RESERVE_BYTES (1024U) /* Ring bytes the bulk lane leaves free for control frames */
+#define IPC_LANE_CONTROL_RESERVE_CREDITS (4U)  /* Credits the bulk lane leaves free for control frames */
+
+/** Bytes a lane send buffer entry (enqueue stamp + frame) takes for a payload length. */
+#define IPC_LANE_ENTRY_LEN(payload_len) (offsetof(ipc_lane_entry_t, msg) + IPC_MSG_FRAME_LEN(payload_len))
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+
+typedef enum
+{
+  IPC_LANE_CONTROL = 0U, /* Touch, buttons, Wi-Fi control: served first */
+  IPC_LANE_BULK = 1U,    /* Logs, prints, sensor streams, scan data */
+  IPC_LANE_COUNT
+} ipc_lane_t;
+
+typedef enum
+{
+  IPC_LANE_POLICY_DROP_NEWEST = 0U, /* Full lane: the new message is dropped and counted */
+  IPC_LANE_POLICY_BLOCK = 1U        /* Full lane: the sender waits up to the lane timeout, then drops */
+} ipc_lane_policy_t;
+
+/** Per-lane depth and drop policy. */
+typedef struct
+{
+  uint32_t bytes;           /* Send buffer size in bytes */
+  ipc_lane_policy_t policy; /* What a sender does when the lane is full */
+  uint32_t block_ms;        /* Wait for IPC_LANE_POLICY_BLOCK */
+} ipc_lane_config_t;
+
+/**
+ * One send buffer entry: the frame plus the time it was queued, so the sender can account the
+ * queueing delay when it moves the frame into the shared ring. Only IPC_LANE_ENTRY_LEN(len) bytes
+ * are stored.
+ */
+typedef struct
+{
+  uint32_t enqueue_stamp; /* ipc_lane_stamp() at enqueue */
+  ipc_msg_t msg;
+} ipc_lane_entry_t;
+
+/** Per-lane counters. Written by the lane's sender task (delay) and producers (dropped). */
+typedef struct
+{
+  uint32_t dropped;       /* Frames refused because the lane was full */
+  ipc_stats_hist_t delay; /* Enqueue-to-ring delay; delay.count is the frames moved into the ring */
+} ipc_lane_stats_t;
+
+/*******************************************************************************
+ * Function prototypes
+ *******************************************************************************/
+
+/**
+ * Lane a command is sent on, as registered in IPC_CMD_TABLE (ipc_cmd.h). Unregistered commands go
+ * to the bulk lane.
+ */
+ipc_lane_t ipc_lane_of(uint32_t cmd);
+
+/**
+ * Enables the core's cycle counter. Call once per core before the first ipc_lane_stamp().
+ */
+void ipc_lane_timebase_init(void);
+
+/**
+ * Current cycle count of the calling core (wraps; only differences are meaningful).
+ */
+uint32_t ipc_lane_stamp(void);
+
+/**
+ * Microseconds elapsed since stamp was taken on the same core.
+ */
+uint32_t ipc_lane_elapsed_us(uint32_t stamp);
+
+/**
+ * Short lane name for logs and the CLI ("control", "bulk").
+ */
+const char *ipc_lane_name(ipc_lane_t lane);
+
+#endif /* IPC_LANE_H */
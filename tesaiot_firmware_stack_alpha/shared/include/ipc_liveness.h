@@ -0,0 +1,167 @@
+/*******************************************************************************
+ * File Name        : ipc_liveness.h
+ *
+ * Description      : Shared-memory liveness records. Each core owns one record
+ *                    with a beat counter and a state word, advanced by its IPC
+ *                    task on every pass; the peer learns the address from the
+ *                    doorbell and checks the record only when it is awake
+ *                    anyway. A counter that stands still is a
+ *                    stall only while the owner said it was busy, or while the
+ *                    checking core is waiting on it (frames not drained,
+ *                    credits not returned), so an idle core may sleep as long
+ *                    as it likes without a heartbeat.
+ *
+ * Author           : Asst.Prof.Santi Nuratch, Ph.D
+ *                    Thailand Embedded Systems Association (TESA)
+ *
+ *******************************************************************************/
+
+#ifndef IPC_LIVENESS_H
+#define IPC_LIVENESS_H
+
+/*******************************************************************************
+ * Header Files
+ *******************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define IPC_LIVENESS_RECORD_BYTES (32U)        /* One cache line per record */
+#define IPC_LIVENESS_LATE_MS_DEFAULT (100U)    /* Owed beat missing this long: IPC_LIVENESS_EVENT_LATE */
+#define IPC_LIVENESS_STALL_MS_DEFAULT (1000U)  /* Owed beat missing this long: IPC_LIVENESS_EVENT_STALLED */
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+
+/** State word of a record, written by its owner with every beat. */
+typedef enum
+{
+  IPC_LIVENESS_DOWN = 0U,  /* Not started (record cleared) */
+  IPC_LIVENESS_IDLE = 1U,  /* IPC task blocked with nothing to do; the counter may stand still */
+  IPC_LIVENESS_BUSY = 2U,  /* IPC task has work in hand and owes another beat */
+  IPC_LIVENESS_FAULT = 3U, /* Fatal error handler entered; final */
+} ipc_liveness_state_t;
+
+/**
+ * One core's record. Placed in shared memory, aligned to IPC_RING_CACHE_LINE and written by its
+ * owner only.
+ */
+typedef struct
+{
+  volatile uint32_t counter;  /* Beats since ipc_liveness_init(); only ever incremented (mod 2^32) */
+  volatile uint32_t state;    /* ipc_liveness_state_t */
+  volatile uint32_t stamp_us; /* ipc_stats_now_us() of the last beat (shared timebase) */
+  volatile uint32_t faults;   /* ipc_liveness_fault() calls; diagnostic only */
+  uint8_t pad[IPC_LIVENESS_RECORD_BYTES - (4U * sizeof(uint32_t))];
+} ipc_liveness_t;
+
+typedef enum
+{
+  IPC_LIVENESS_EVENT_LATE = 0U,  /* An owed beat is late_ms overdue */
+  IPC_LIVENESS_EVENT_STALLED,    /* ... stall_ms overdue */
+  IPC_LIVENESS_EVENT_RECOVERED,  /* The peer beat again, or no longer owed one, after LATE or STALLED */
+  IPC_LIVENESS_EVENT_FAULT,      /* The peer reported a fatal error */
+} ipc_liveness_event_t;
+
+/** The checking core's view of its peer. */
+typedef struct
+{
+  ipc_liveness_state_t state; /* Peer state word (IPC_LIVENESS_DOWN until the record is known) */
+  uint32_t counter;           /* Peer beat counter */
+  uint32_t stamp_us;          /* Peer's last beat on the shared timebase */
+  uint32_t silent_ms;         /* How long an owed beat has been missing (0 when none is owed) */
+  uint32_t late;              /* LATE events so far */
+  uint32_t stalls;            /* STALLED events so far */
+  bool attached;              /* Peer record known */
+  bool stalled;               /* Currently between STALLED (or FAULT) and RECOVERED */
+} ipc_liveness_status_t;
+
+/**
+ * Liveness event; runs in the context that called ipc_liveness_check() and must not block.
+ */
+typedef void (*ipc_liveness_cb_t)(ipc_liveness_event_t event, const ipc_liveness_status_t *status, void *user_data);
+
+typedef struct
+{
+  uint32_t late_ms;     /* 0: IPC_LIVENESS_LATE_MS_DEFAULT */
+  uint32_t stall_ms;    /* 0: IPC_LIVENESS_STALL_MS_DEFAULT; raised to late_ms if below it */
+  ipc_liveness_cb_t cb; /* May be NULL: status only */
+  void *user_data;
+} ipc_liveness_config_t;
+
+/** Checking core's local state for one peer record. Not shared. */
+typedef struct
+{
+  const ipc_liveness_t *peer;
+  ipc_liveness_config_t config;
+  uint32_t seen_counter; /* Peer counter at the last check */
+  uint32_t since_ms;     /* Local time since which a beat has been owed */
+  bool owed;             /* A beat was owed at the last check */
+  bool late;             /* LATE reported for the current silence */
+  ipc_liveness_status_t status;
+} ipc_liveness_monitor_t;
+
+/*******************************************************************************
+ * Function prototypes
+ *******************************************************************************/
+
+/**
+ * Owner: clears the record (IPC_LIVENESS_DOWN). Call before its address is shared.
+ */
+void ipc_liveness_init(ipc_liveness_t *self);
+
+/**
+ * Owner: advances the counter and stamps it, and sets the state unless the record is in
+ * IPC_LIVENESS_FAULT. Cheap; safe in ISR context.
+ */
+void ipc_liveness_beat(ipc_liveness_t *self, ipc_liveness_state_t state);
+
+/**
+ * Owner: marks the record IPC_LIVENESS_FAULT for good. Safe from a fatal error handler.
+ */
+void ipc_liveness_fault(ipc_liveness_t *self);
+
+/**
+ * Checker: resets monitor and applies config (NULL: defaults, no callback). The peer record is not
+ * known yet.
+ */
+void ipc_liveness_monitor_init(ipc_liveness_monitor_t *monitor, const ipc_liveness_config_t *config);
+
+/**
+ * Checker: changes thresholds and callback without losing the peer record or the event counts.
+ */
+void ipc_liveness_monitor_configure(ipc_liveness_monitor_t *monitor, const ipc_liveness_config_t *config);
+
+/**
+ * Checker: records the peer's record address (from its doorbell). Safe in ISR context.
+ */
+void ipc_liveness_monitor_attach(ipc_liveness_monitor_t *monitor, const ipc_liveness_t *peer);
+
+/**
+ * Checker: compares the peer record with the previous check. A beat is owed while the peer is
+ * IPC_LIVENESS_BUSY or waiting is true (the caller is waiting on the peer). Calls the callback on
+ * LATE, STALLED, RECOVERED and FAULT transitions. now_ms is any local millisecond clock, the same on
+ * every call. Returns false while the peer is stalled or faulted. Call from one task only.
+ */
+bool ipc_liveness_check(ipc_liveness_monitor_t *monitor, uint32_t now_ms, bool waiting);
+
+/**
+ * Checker: milliseconds until the next threshold of the current silence (0 when none is owed or the
+ * peer is already stalled). A caller that is waiting on the peer may sleep at most this long.
+ */
+uint32_t ipc_liveness_next_check_ms(const ipc_liveness_monitor_t *monitor, uint32_t now_ms);
+
+/**
+ * Copies the status of the last check. Returns false for NULL arguments.
+ */
+bool ipc_liveness_get_status(const ipc_liveness_monitor_t *monitor, ipc_liveness_status_t *status);
+
+/**
+ * Name of a state for logs ("?" if unknown).
+ */
+const char *ipc_liveness_state_name(uint32_t state);
+
+#endif /* IPC_LIVENESS_H */
@@ -0,0 +1,179 @@
+/*******************************************************************************
+ * File Name        : ipc_ring.h
+ *
+ * Description      : Lock-free single-producer/single-consumer frame ring in
+ *                    shared memory, plus the doorbell message that tells the
+ *                    peer core the ring has data. Frames are variable-length
+ *                    ipc_msg_t (header + used payload only). One ring per
+ *                    direction; the producer core owns (allocates) the ring,
+ *                    the consumer core learns its address from the doorbell.
+ *
+ * Author           : Asst.Prof.Santi Nuratch, Ph.D
+ *                    Thailand Embedded Systems Association (TESA)
+ *
+ *******************************************************************************/
+
+#ifndef IPC_RING_H
+#define IPC_RING_H
+
+/*******************************************************************************
+ * Header Files
+ *******************************************************************************/
+#include "ipc_blackboard.h"
+#include "ipc_communication.h"
+#include "ipc_liveness.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define IPC_RING_CACHE_LINE (32U) /* CM55 D-cache line size; head and tail never share a line */
+#define IPC_RING_BYTES (4096U)    /* Frame storage per ring; must be a power of two */
+#define IPC_RING_ALIGN (4U)       /* Frames start on 32-bit boundaries */
+#define IPC_RING_PAD_CMD (0xFFFFFFFFUL) /* cmd of the filler frame written before a wrap */
+#define IPC_RING_CREDITS (16U)    /* Frames a producer may have outstanding at a credit-returning consumer */
+#define IPC_RING_BACKLOG_THROTTLE (IPC_RING_CREDITS / 2U) /* Consumer backlog at which bulk senders hold back */
+
+/** Bytes a frame with the given payload length occupies in the ring. */
+#define IPC_RING_FRAME_SPAN(payload_len) \
+  ((uint32_t)((IPC_MSG_FRAME_LEN(payload_len) + (IPC_RING_ALIGN - 1U)) & ~(IPC_RING_ALIGN - 1U)))
+
+#if ((IPC_RING_BYTES & (IPC_RING_BYTES - 1U)) != 0U)
+#error "IPC_RING_BYTES must be a power of two"
+#endif
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+
+/**
+ * SPSC frame ring. head and tail are free-running byte counters (used = head -
+ * tail) and each sits on its own cache line: head is written only by the
+ * producer core, tail only by the consumer core. A frame never wraps: when it
+ * does not fit before the end of buf[], the producer skips the remainder (with
+ * an IPC_RING_PAD_CMD filler header when there is room for one) and starts the
+ * frame at offset 0. Instances must be placed in shared memory and aligned to
+ * IPC_RING_CACHE_LINE.
+ *
+ * Optional credit flow control: a consumer that buffers frames beyond the ring
+ * returns one credit per frame it has finished with, and the producer keeps at
+ * most a window of frames outstanding. A producer out of credits raises
+ * credit_wait and sleeps; the consumer rings a doorbell when it returns credits
+ * while credit_wait is set. Such a consumer also publishes how many frames it
+ * holds (backlog) and the high-water mark, so the producer can hold back
+ * low-priority frames before the window runs out.
+ */
+typedef struct
+{
+  volatile uint32_t head;        /* Next byte to write; producer only */
+  volatile uint32_t credit_wait; /* Non-zero while the producer waits for credits; producer only */
+  uint8_t head_pad[IPC_RING_CACHE_LINE - (2U * sizeof(uint32_t))];
+  volatile uint32_t tail;         /* Next byte to read; consumer only */
+  volatile uint32_t credits;      /* Frames the consumer has finished with (free-running); consumer only */
+  volatile uint32_t backlog;      /* Frames taken out of buf[] and still queued at the consumer; consumer only */
+  volatile uint32_t backlog_peak; /* High-water mark of backlog; consumer only */
+  uint8_t tail_pad[IPC_RING_CACHE_LINE - (4U * sizeof(uint32_t))];
+  uint8_t buf[IPC_RING_BYTES];
+} ipc_ring_t;
+
+/**
+ * Doorbell sent through Cy_IPC_Pipe_SendMessage(). Carries no payload, only the
+ * producer's ring, blackboard and liveness record; the receiver drains every
+ * queued message per interrupt.
+ */
+typedef struct
+{
+  uint16_t client_id;      /* Bits 0-7: Client ID */
+  uint16_t intr_mask;      /* Bits 16-31: Release Mask (MANDATORY for Pipe Driver) */
+  ipc_ring_t *ring;        /* Producer ring to drain */
+  ipc_blackboard_t *board; /* Producer blackboard (see ipc_blackboard.h), NULL if it has none */
+  ipc_liveness_t *live;    /* Producer liveness record (see ipc_liveness.h) */
+} ipc_doorbell_t;
+
+/*******************************************************************************
+ * Function prototypes
+ *******************************************************************************/
+
+/**
+ * Resets head, tail and the credit counters. Call once on the producer core before the first doorbell.
+ */
+void ipc_ring_init(ipc_ring_t *ring);
+
+/**
+ * Producer: returns contiguous space for a frame of frame_len bytes (header +
+ * payload, at most sizeof(ipc_msg_t)), or NULL when the ring is full. The frame
+ * becomes visible to the consumer only after ipc_ring_commit() with the same
+ * length; its len field must be set by then.
+ */
+ipc_msg_t *ipc_ring_claim(ipc_ring_t *ring, uint32_t frame_len);
+
+/**
+ * Producer: publishes the frame returned by the last ipc_ring_claim().
+ */
+void ipc_ring_commit(ipc_ring_t *ring, uint32_t frame_len);
+
+/**
+ * Consumer: returns the oldest published frame, or NULL when the ring is empty.
+ * Only IPC_MSG_HDR_LEN + len bytes of it are valid. The frame stays owned by the
+ * consumer until ipc_ring_release().
+ */
+const ipc_msg_t *ipc_ring_peek(ipc_ring_t *ring);
+
+/**
+ * Consumer: hands the frame returned by the last ipc_ring_peek() back to the producer.
+ */
+void ipc_ring_release(ipc_ring_t *ring);
+
+/**
+ * True when no published frame is waiting. Safe to call from either core.
+ */
+bool ipc_ring_is_empty(const ipc_ring_t *ring);
+
+/**
+ * Bytes in use (frames, alignment and wrap filler). Safe to call from either core.
+ */
+uint32_t ipc_ring_used(const ipc_ring_t *ring);
+
+/**
+ * Producer: true if one more frame may be published, given sent frames published so far and a
+ * window of frames. When the window is exhausted it raises credit_wait and re-checks, so a credit
+ * returned at the same moment is not missed; on false the producer should sleep until the
+ * consumer's doorbell.
+ */
+bool ipc_ring_credit_acquire(ipc_ring_t *ring, uint32_t sent, uint32_t window);
+
+/**
+ * Consumer: returns count credits. Returns true if the producer is waiting for them and should be
+ * woken with a doorbell.
+ */
+bool ipc_ring_credit_return(ipc_ring_t *ring, uint32_t count);
+
+/**
+ * True while the producer is blocked on credits. Safe to call from either core.
+ */
+bool ipc_ring_credit_waiting(const ipc_ring_t *ring);
+
+/**
+ * Consumer: publishes the number of frames it currently holds outside the ring and raises the
+ * high-water mark if needed.
+ */
+void ipc_ring_set_backlog(ipc_ring_t *ring, uint32_t backlog);
+
+/**
+ * Consumer: restarts the high-water mark from the current backlog.
+ */
+void ipc_ring_reset_backlog_peak(ipc_ring_t *ring);
+
+/**
+ * Consumer backlog; peak (may be NULL) receives the high-water mark. Safe to call from either core.
+ */
+uint32_t ipc_ring_backlog(const ipc_ring_t *ring, uint32_t *peak);
+
+/**
+ * Producer: true if the consumer backlog is below limit. Otherwise raises credit_wait and re-checks,
+ * like ipc_ring_credit_acquire(), so the consumer's next credit doorbell resumes the producer.
+ */
+bool ipc_ring_backlog_below(ipc_ring_t *ring, uint32_t limit);
+
+#endif /* IPC_RING_H */
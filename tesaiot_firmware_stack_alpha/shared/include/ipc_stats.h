@@ -0,0 +1,138 @@
+/*******************************************************************************
+ * File Name        : ipc_stats.h
+ *
+ * Description      : IPC pipe instrumentation shared by both cores: a
+ *                    microsecond timebase common to CM33 and CM55, log2
+ *                    latency histograms, and per-command counters for the
+ *                    four points a frame passes (enqueue, send, receive,
+ *                    dispatch).
+ *
+ * Author           : Asst.Prof.Santi Nuratch, Ph.D
+ *                    Thailand Embedded Systems Association (TESA)
+ *
+ *******************************************************************************/
+
+#ifndef IPC_STATS_H
+#define IPC_STATS_H
+
+/*******************************************************************************
+ * Header Files
+ *******************************************************************************/
+#include "ipc_communication.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define IPC_STATS_HIST_BUCKETS (16U) /* Bucket 0: < 1 us; bucket i: [2^(i-1), 2^i) us; last bucket open-ended */
+#define IPC_STATS_CMD_FIRST (IPC_CMD_ID_FIRST) /* Lowest command with its own counters */
+#define IPC_STATS_CMD_LAST (IPC_CMD_ID_LAST)   /* Highest command with its own counters */
+#define IPC_STATS_CMD_SLOTS ((IPC_STATS_CMD_LAST - IPC_STATS_CMD_FIRST) + 2U) /* Plus one slot for all others */
+#define IPC_STATS_SYNC_MAX_AGE_MS (1000U) /* CM55 re-measures an offset this old with its next frame or query */
+#define IPC_STATS_SYNC_RTT_SLACK_US (20U) /* A sync sample is kept if its round trip is within this of the best */
+#define IPC_STATS_CLOCK_HALF_WRAP (0x80000000ULL) /* Half the cycle counter range, for rounding wraps */
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+
+/** Log2 latency histogram. */
+typedef struct
+{
+  uint32_t count;                        /* Samples recorded */
+  uint32_t max_us;                       /* Largest sample */
+  uint32_t hist[IPC_STATS_HIST_BUCKETS]; /* Samples per log2 us bucket */
+} ipc_stats_hist_t;
+
+/**
+ * Counters of one command on one core. Sent-side fields cover frames this core sends, received-side
+ * fields frames it receives; a command that only travels one way leaves the other side at zero.
+ */
+typedef struct
+{
+  uint32_t sent;             /* Frames published to the peer ring */
+  uint32_t dropped;          /* Sends refused at enqueue (lane full or busy) */
+  uint32_t received;         /* Frames taken out of the peer ring */
+  uint32_t received_bytes;   /* Payload bytes of those frames */
+  uint32_t overflows;        /* Received frames lost because the dispatch queue was full */
+  ipc_stats_hist_t queue;    /* Enqueue -> send (sender's lane wait) */
+  ipc_stats_hist_t transit;  /* Send -> receive interrupt, across cores on the shared timebase */
+  ipc_stats_hist_t dispatch; /* Receive interrupt -> handler run on the receiving core */
+} ipc_stats_cmd_t;
+
+/** State of the shared timebase on this core. */
+typedef struct
+{
+  int32_t offset_us; /* Added to the local clock to get CM33 time (always 0 on CM33) */
+  uint32_t rtt_us;   /* Round trip of the last accepted sync exchange */
+  uint32_t samples;  /* Sync replies received */
+  uint32_t accepted; /* Replies whose round trip was short enough to update the offset */
+} ipc_stats_sync_t;
+
+/*******************************************************************************
+ * Function prototypes
+ *******************************************************************************/
+
+/**
+ * Current time in microseconds on the shared timebase (the CM33 clock; CM55 adds its measured
+ * offset). Wraps every ~71 minutes; only differences are meaningful. Safe in ISR context. Needs
+ * ipc_lane_timebase_init(). Cycle counter wraps between calls are recovered from the RTOS tick count,
+ * so an idle core needs no periodic call.
+ */
+uint32_t ipc_stats_now_us(void);
+
+/**
+ * CM55: folds one IPC_CMD_TIME_SYNC reply into the clock offset. t0/t1 come from the payload, t2 is
+ * the reply's sent_us and t3 ipc_stats_now_us() when it arrived. Keeps the sample only if its round
+ * trip is close to the best seen, so a reply delayed by queueing does not skew the offset.
+ */
+void ipc_stats_sync_sample(uint32_t t0_us, uint32_t t1_us, uint32_t t2_us, uint32_t t3_us);
+
+/**
+ * Copies the timebase state. Returns false for NULL.
+ */
+bool ipc_stats_get_sync(ipc_stats_sync_t *sync);
+
+/**
+ * Accounts one log2-bucketed sample.
+ */
+void ipc_stats_hist_record(ipc_stats_hist_t *hist, uint32_t latency_us);
+
+/**
+ * Upper bound in microseconds of the given percentile (1..100), capped at max_us. Returns 0 when
+ * nothing was recorded.
+ */
+uint32_t ipc_stats_hist_percentile(const ipc_stats_hist_t *hist, uint32_t percent);
+
+/** Sender: a frame of cmd refused at enqueue. */
+void ipc_stats_on_drop(uint32_t cmd);
+
+/** Sender: a frame of cmd published to the ring after waiting queue_us in its lane. */
+void ipc_stats_on_send(uint32_t cmd, uint32_t queue_us);
+
+/**
+ * Receiver (ISR or masked interrupts): a frame with len payload bytes taken out of the peer ring.
+ * Records its transit time from sent_us and returns the receive time to pass to
+ * ipc_stats_on_dispatch().
+ */
+uint32_t ipc_stats_on_receive(uint32_t cmd, uint32_t sent_us, uint32_t len);
+
+/** Receiver: the handler for a frame received at rx_us is about to run. */
+void ipc_stats_on_dispatch(uint32_t cmd, uint32_t rx_us);
+
+/** Receiver: a received frame of cmd was discarded because it could not be queued for dispatch. */
+void ipc_stats_on_overflow(uint32_t cmd);
+
+/**
+ * Copies the counters of cmd. Commands outside IPC_STATS_CMD_FIRST..IPC_STATS_CMD_LAST share one
+ * slot. Returns false for NULL.
+ */
+bool ipc_stats_get(uint32_t cmd, ipc_stats_cmd_t *stats);
+
+/**
+ * Clears every command's counters (the timebase is kept).
+ */
+void ipc_stats_reset(void);
+
+#endif /* IPC_STATS_H */
@@ -1,38 +1,207 @@
 /*******************************************************************************
  * File Name        : cm55_stdout_ipc.c
  *
- * Description      : _write() for CM55 stdout/stderr that sends output via
- *                    IPC_CMD_PRINT to CM33 for display on UART. Chunks data
- *                    to fit IPC_DATA_MAX_LEN. Drops output if pipe not ready.
+ * Description      : _write() for CM55 stdout/stderr. Output is coalesced in
+ *                    a ring and sent to CM33 as IPC_CMD_PRINT frames of up to
+ *                    IPC_DATA_MAX_LEN bytes by the timer task. _write() never
+ *                    waits, from a task or an ISR; output that does not fit
+ *                    is counted and dropped.
  *
  *******************************************************************************/
 
+#include "cm55_stdout_ipc.h"
 #include "cm55_ipc_pipe.h"
 #include "ipc_communication.h"
 #include "task.h"
+#include "timers.h"
 #include <stddef.h>
+#include <string.h>
 
 #define STDOUT_FD (1)
 #define STDERR_FD (2)
-#define CHUNK_SIZE (IPC_DATA_MAX_LEN - 1UL)
-#define PUSH_RETRY_MS (5U)
-#define PUSH_RETRY_COUNT (3U)
+#define CHUNK_SIZE (IPC_DATA_MAX_LEN) /* Frames carry a length, no NUL terminator needed */
+#define BUF_MASK (CM55_STDOUT_IPC_BUF_SIZE - 1U)
+#define FLUSH_NOW_LEVEL (CM55_STDOUT_IPC_BUF_SIZE / 2U) /* Buffered bytes that trigger a flush without delay */
 
-static int push_chunk(const char *data, uint32_t len)
+static char s_buf[CM55_STDOUT_IPC_BUF_SIZE];
+static volatile uint32_t s_head = 0U;      /* Bytes ever buffered; written by _write() in a critical section */
+static volatile uint32_t s_tail = 0U;      /* Bytes ever sent; written by the flush (timer task) only */
+static volatile bool s_flush_due = false;  /* A line or a full frame is waiting; short flush already armed */
+static volatile bool s_flush_now = false;  /* Ring half full; flush already pended to the timer task */
+static TimerHandle_t s_flush_timer = NULL;
+static char s_frame[CHUNK_SIZE];           /* Flush scratch; only the timer task uses it */
+static cm55_stdout_ipc_stats_t s_stats;
+
+/**
+ * Sends buffered output as full frames, the last one partial (timer task). Stops and re-arms the
+ * idle flush if the bulk lane is full, leaving the rest buffered.
+ */
+static void stdout_flush(void)
+{
+  uint32_t tail = s_tail;
+
+  s_flush_due = false;
+  s_flush_now = false;
+  while (tail != s_head)
+  {
+    uint32_t len = s_head - tail;
+    uint32_t offset = tail & BUF_MASK;
+    uint32_t first;
+
+    if (len > CHUNK_SIZE)
+    {
+      len = CHUNK_SIZE;
+    }
+    first = CM55_STDOUT_IPC_BUF_SIZE - offset;
+    if (first > len)
+    {
+      first = len;
+    }
+    (void)memcpy(s_frame, &s_buf[offset], first);
+    (void)memcpy(&s_frame[first], s_buf, len - first);
+
+    if (!cm55_ipc_pipe_push_request((uint32_t)IPC_CMD_PRINT, s_frame, len))
+    {
+      s_stats.retries++;
+      (void)xTimerChangePeriod(s_flush_timer, pdMS_TO_TICKS(CM55_STDOUT_IPC_FLUSH_MS), 0U);
+      break;
+    }
+    tail += len;
+    s_tail = tail;
+    s_stats.frames++;
+  }
+}
+
+static void stdout_flush_timer_cb(TimerHandle_t timer)
+{
+  (void)timer;
+  stdout_flush();
+}
+
+static void stdout_flush_pended(void *param1, uint32_t param2)
+{
+  (void)param1;
+  (void)param2;
+  stdout_flush();
+}
+
+/**
+ * Pends a flush from an ISR unless one is already armed. The timer calls that delay a flush have no
+ * ISR variant, so ISR output is sent on the timer task's next run.
+ */
+static void stdout_schedule_flush_from_isr(void)
 {
-  for (uint32_t r = 0U; r < PUSH_RETRY_COUNT; r++)
+  BaseType_t woken = pdFALSE;
+
+  if (!s_flush_now && !s_flush_due)
+  {
+    s_flush_now = true;
+    if (pdPASS != xTimerPendFunctionCallFromISR(stdout_flush_pended, NULL, 0U, &woken))
+    {
+      s_flush_now = false;
+    }
+    portYIELD_FROM_ISR(woken);
+  }
+}
+
+/**
+ * Arms the flush for what was just buffered: at once when the ring is half full, on the next tick
+ * after a newline or a full frame, otherwise after the idle delay. Never waits; if the timer command
+ * queue is full the next write tries again.
+ */
+static void stdout_schedule_flush(bool line_done, uint32_t used, bool in_isr)
+{
+  if ((NULL == s_flush_timer) || (taskSCHEDULER_RUNNING != xTaskGetSchedulerState()))
+  {
+    return;
+  }
+  if (in_isr)
+  {
+    stdout_schedule_flush_from_isr();
+  }
+  else if (used >= FLUSH_NOW_LEVEL)
   {
-    if (cm55_ipc_pipe_push_request((uint32_t)IPC_CMD_PRINT, data, len))
+    if (!s_flush_now)
     {
-      return 0;
+      s_flush_now = true; /* Before the call: the timer task may run the flush, and clear it, right away */
+      if (pdPASS != xTimerPendFunctionCall(stdout_flush_pended, NULL, 0U, 0U))
+      {
+        s_flush_now = false;
+      }
     }
-    vTaskDelay(pdMS_TO_TICKS(PUSH_RETRY_MS));
   }
-  return -1;
+  else if (line_done || (used >= CHUNK_SIZE))
+  {
+    if (!s_flush_due)
+    {
+      s_flush_due = true;
+      if (pdPASS != xTimerChangePeriod(s_flush_timer, CM55_STDOUT_IPC_LINE_FLUSH_TICKS, 0U))
+      {
+        s_flush_due = false;
+      }
+    }
+  }
+  else if (!s_flush_due && (pdFALSE == xTimerIsTimerActive(s_flush_timer)))
+  {
+    (void)xTimerChangePeriod(s_flush_timer, pdMS_TO_TICKS(CM55_STDOUT_IPC_FLUSH_MS), 0U);
+  }
+}
+
+/**
+ * Copies as much of ptr as fits into the ring and counts the rest as dropped; returns the bytes now
+ * buffered.
+ */
+static uint32_t stdout_put(const char *ptr, uint32_t len, bool in_isr)
+{
+  UBaseType_t state = 0U;
+  uint32_t accepted;
+  uint32_t offset;
+  uint32_t first;
+  uint32_t used;
+
+  if (in_isr)
+  {
+    state = taskENTER_CRITICAL_FROM_ISR();
+  }
+  else
+  {
+    taskENTER_CRITICAL();
+  }
+  accepted = CM55_STDOUT_IPC_BUF_SIZE - (s_head - s_tail);
+  if (accepted > len)
+  {
+    accepted = len;
+  }
+  offset = s_head & BUF_MASK;
+  first = CM55_STDOUT_IPC_BUF_SIZE - offset;
+  if (first > accepted)
+  {
+    first = accepted;
+  }
+  (void)memcpy(&s_buf[offset], ptr, first);
+  (void)memcpy(s_buf, &ptr[first], accepted - first);
+  s_head += accepted;
+  used = s_head - s_tail;
+  s_stats.written += accepted;
+  s_stats.dropped += len - accepted;
+  if (in_isr)
+  {
+    taskEXIT_CRITICAL_FROM_ISR(state);
+  }
+  else
+  {
+    taskEXIT_CRITICAL();
+  }
+
+  return used;
 }
 
 int _write(int fd, const char *ptr, int len)
 {
+  bool in_isr;
+  uint32_t used;
+  bool line_done;
+
   if ((NULL == ptr) || (len < 0))
   {
     return -1;
@@ -46,19 +215,38 @@ int _write(int fd, const char *ptr, int len)
     return -1;
   }
 
-  const char *p = ptr;
-  int remaining = len;
+  in_isr = (pdFALSE != xPortIsInsideInterrupt());
+  line_done = (NULL != memchr(ptr, '\n', (size_t)len));
+  used = stdout_put(ptr, (uint32_t)len, in_isr);
+  stdout_schedule_flush(line_done, used, in_isr);
 
-  while (remaining > 0)
+  /* Dropped bytes are reported as written: stdio would otherwise retry and block */
+  return len;
+}
+
+bool cm55_stdout_ipc_init(void)
+{
+  if (NULL == s_flush_timer)
   {
-    uint32_t chunk_len = (remaining > (int)CHUNK_SIZE) ? CHUNK_SIZE : (uint32_t)remaining;
-    if (0 != push_chunk(p, chunk_len))
+    s_flush_timer = xTimerCreate("Stdout IPC", pdMS_TO_TICKS(CM55_STDOUT_IPC_FLUSH_MS), pdFALSE, NULL,
+                                 stdout_flush_timer_cb);
+    if (NULL == s_flush_timer)
     {
-      break;
+      return false;
     }
-    p += chunk_len;
-    remaining -= (int)chunk_len;
   }
+  /* Output written before init is sent on the first expiry */
+  return (pdPASS == xTimerStart(s_flush_timer, 0U));
+}
 
-  return len;
+bool cm55_stdout_ipc_get_stats(cm55_stdout_ipc_stats_t *stats)
+{
+  if (NULL == stats)
+  {
+    return false;
+  }
+  taskENTER_CRITICAL();
+  (void)memcpy(stats, &s_stats, sizeof(*stats));
+  taskEXIT_CRITICAL();
+  return true;
 }
@@ -0,0 +1,131 @@
+/*******************************************************************************
+ * File Name        : ipc_blackboard.c
+ *
+ * Description      : Seqlock slots of the shared-memory blackboard. Ordering
+ *                    between the sequence and the value is enforced with data
+ *                    memory barriers; readers take no lock and never block
+ *                    the writer.
+ *
+ * Author           : Asst.Prof.Santi Nuratch, Ph.D
+ *                    Thailand Embedded Systems Association (TESA)
+ *
+ *******************************************************************************/
+
+#include "ipc_blackboard.h"
+#include "ipc_ring.h"
+#include "ipc_stats.h"
+
+#include <stddef.h>
+#include <string.h>
+
+_Static_assert((IPC_BLACKBOARD_SLOT_BYTES % IPC_RING_CACHE_LINE) == 0U, "blackboard slots would share cache lines");
+_Static_assert(sizeof(ipc_blackboard_entry_t) == IPC_BLACKBOARD_SLOT_BYTES, "blackboard slot is not SLOT_BYTES");
+_Static_assert(sizeof(ipc_imu_sample_t) <= IPC_BLACKBOARD_DATA_MAX, "ipc_imu_sample_t does not fit a slot");
+_Static_assert(sizeof(ipc_orientation_t) <= IPC_BLACKBOARD_DATA_MAX, "ipc_orientation_t does not fit a slot");
+_Static_assert(sizeof(ipc_wifi_status_t) <= IPC_BLACKBOARD_DATA_MAX, "ipc_wifi_status_t does not fit a slot");
+_Static_assert(sizeof(ipc_button_state_t) <= IPC_BLACKBOARD_DATA_MAX, "ipc_button_state_t does not fit a slot");
+
+static const uint32_t s_slot_len[IPC_BLACKBOARD_SLOT_COUNT] = {
+    [IPC_BLACKBOARD_IMU] = sizeof(ipc_imu_sample_t),
+    [IPC_BLACKBOARD_ORIENTATION] = sizeof(ipc_orientation_t),
+    [IPC_BLACKBOARD_WIFI_STATUS] = sizeof(ipc_wifi_status_t),
+    [IPC_BLACKBOARD_BUTTONS] = sizeof(ipc_button_state_t),
+};
+
+/**
+ * True if slot exists and len is its value size.
+ */
+static bool ipc_blackboard_valid(ipc_blackboard_slot_t slot, uint32_t len)
+{
+  return ((uint32_t)slot < (uint32_t)IPC_BLACKBOARD_SLOT_COUNT) && (len == s_slot_len[slot]);
+}
+
+void ipc_blackboard_init(ipc_blackboard_t *board)
+{
+  if (NULL == board)
+  {
+    return;
+  }
+  (void)memset(board, 0, sizeof(*board));
+  __DMB();
+}
+
+bool ipc_blackboard_publish(ipc_blackboard_t *board, ipc_blackboard_slot_t slot, const void *value, uint32_t len)
+{
+  ipc_blackboard_entry_t *entry;
+  uint32_t stamp_us;
+  uint32_t intr_state;
+  uint32_t seq;
+
+  if ((NULL == board) || (NULL == value) || !ipc_blackboard_valid(slot, len))
+  {
+    return false;
+  }
+  entry = &board->slots[slot];
+  stamp_us = ipc_stats_now_us();
+
+  intr_state = Cy_SysLib_EnterCriticalSection();
+  seq = entry->seq + 1U; /* Odd: readers retry */
+  entry->seq = seq;
+  __DMB();
+  (void)memcpy(entry->data, value, len);
+  entry->stamp_us = stamp_us;
+  __DMB();
+  entry->seq = seq + 1U;
+  Cy_SysLib_ExitCriticalSection(intr_state);
+
+  return true;
+}
+
+bool ipc_blackboard_read(const ipc_blackboard_t *board, ipc_blackboard_slot_t slot, void *out, uint32_t len,
+                         uint32_t *version, uint32_t *stamp_us)
+{
+  const ipc_blackboard_entry_t *entry;
+
+  if ((NULL == board) || (NULL == out) || !ipc_blackboard_valid(slot, len))
+  {
+    return false;
+  }
+  entry = &board->slots[slot];
+
+  for (uint32_t attempt = 0U; attempt < IPC_BLACKBOARD_READ_RETRIES; attempt++)
+  {
+    uint32_t seq = entry->seq;
+    uint32_t stamp;
+
+    if (0U == seq)
+    {
+      return false;
+    }
+    if (0U != (seq & 1U))
+    {
+      continue;
+    }
+    __DMB();
+    (void)memcpy(out, entry->data, len);
+    stamp = entry->stamp_us;
+    __DMB();
+    if (seq == entry->seq)
+    {
+      if (NULL != version)
+      {
+        *version = seq / 2U;
+      }
+      if (NULL != stamp_us)
+      {
+        *stamp_us = stamp;
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
+uint32_t ipc_blackboard_version(const ipc_blackboard_t *board, ipc_blackboard_slot_t slot)
+{
+  if ((NULL == board) || ((uint32_t)slot >= (uint32_t)IPC_BLACKBOARD_SLOT_COUNT))
+  {
+    return 0U;
+  }
+  return board->slots[slot].seq / 2U; /* A write in progress still counts as the previous version */
+}
@@ -0,0 +1,86 @@
+/*******************************************************************************
+ * File Name        : ipc_cmd.c
+ *
+ * Description      : IPC command registry lookup, compile-time checks of the
+ *                    command table and length-checked handler dispatch.
+ *
+ * Author           : Asst.Prof.Santi Nuratch, Ph.D
+ *                    Thailand Embedded Systems Association (TESA)
+ *
+ *******************************************************************************/
+
+#include "ipc_cmd.h"
+
+#include <stddef.h>
+
+/* Compile-time checks, one set per registry line */
+#define IPC_CMD_CHECK(cmd, name, payload_len, min_len, lane)                                                      \
+  _Static_assert(((cmd) >= IPC_CMD_ID_FIRST) && ((cmd) <= IPC_CMD_ID_LAST),                                       \
+                 #cmd " is outside IPC_CMD_ID_FIRST..IPC_CMD_ID_LAST");                                          \
+  _Static_assert((payload_len) <= IPC_DATA_MAX_LEN, #cmd " payload does not fit in IPC_DATA_MAX_LEN");          \
+  _Static_assert((min_len) <= (payload_len), #cmd " min_len is larger than its payload");
+
+IPC_CMD_TABLE(IPC_CMD_CHECK)
+
+/* Every ID sets one bit; the sum only equals the OR if no bit is set twice */
+#define IPC_CMD_BIT_SUM(cmd, name, payload_len, min_len, lane) +(1ULL << IPC_CMD_SLOT(cmd))
+#define IPC_CMD_BIT_OR(cmd, name, payload_len, min_len, lane) | (1ULL << IPC_CMD_SLOT(cmd))
+
+_Static_assert(IPC_CMD_ID_SLOTS <= 64U, "IPC command ID range too wide for the duplicate check");
+_Static_assert((0ULL IPC_CMD_TABLE(IPC_CMD_BIT_SUM)) == (0ULL IPC_CMD_TABLE(IPC_CMD_BIT_OR)),
+               "duplicate command ID in IPC_CMD_TABLE");
+
+#define IPC_CMD_INFO(cmd, name, payload_len, min_len, lane)                                                       \
+  [IPC_CMD_SLOT(cmd)] = {(name), (uint16_t)(payload_len), (uint16_t)(min_len), (lane)},
+
+static const ipc_cmd_info_t s_ipc_cmd_info[IPC_CMD_ID_SLOTS] = {IPC_CMD_TABLE(IPC_CMD_INFO)};
+
+/**
+ * Registry index of cmd, IPC_CMD_ID_SLOTS if it is outside the registry range.
+ */
+static uint32_t ipc_cmd_slot(uint32_t cmd)
+{
+  uint32_t slot = cmd - (uint32_t)IPC_CMD_ID_FIRST; /* Wraps above the range for IDs below it */
+
+  return (slot < IPC_CMD_ID_SLOTS) ? slot : IPC_CMD_ID_SLOTS;
+}
+
+const ipc_cmd_info_t *ipc_cmd_info(uint32_t cmd)
+{
+  uint32_t slot = ipc_cmd_slot(cmd);
+
+  if ((slot >= IPC_CMD_ID_SLOTS) || (NULL == s_ipc_cmd_info[slot].name))
+  {
+    return NULL;
+  }
+  return &s_ipc_cmd_info[slot];
+}
+
+ipc_cmd_result_t ipc_cmd_dispatch(const ipc_cmd_handler_t *handlers, const ipc_msg_t *msg, void *arg)
+{
+  const ipc_cmd_info_t *info;
+
+  if ((NULL == handlers) || (NULL == msg))
+  {
+    return IPC_CMD_UNHANDLED;
+  }
+  info = ipc_cmd_info(msg->cmd);
+  if ((NULL == info) || (NULL == handlers[IPC_CMD_SLOT(msg->cmd)]))
+  {
+    return IPC_CMD_UNHANDLED;
+  }
+  if ((msg->len < info->min_len) || (msg->len > IPC_DATA_MAX_LEN))
+  {
+    return IPC_CMD_BAD_LEN;
+  }
+
+  handlers[IPC_CMD_SLOT(msg->cmd)](msg, arg);
+  return IPC_CMD_DISPATCHED;
+}
+
+const char *ipc_cmd_name(uint32_t cmd)
+{
+  const ipc_cmd_info_t *info = ipc_cmd_info(cmd);
+
+  return (NULL != info) ? info->name : "?";
+}
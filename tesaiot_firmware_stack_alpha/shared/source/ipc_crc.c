@@ -0,0 +1,38 @@
+/*******************************************************************************
+ * File Name        : ipc_crc.c
+ *
+ * Description      : Nibble-table CRC-32 shared by CM33 and CM55.
+ *
+ * Author           : Asst.Prof.Santi Nuratch, Ph.D
+ *                    Thailand Embedded Systems Association (TESA)
+ *
+ *******************************************************************************/
+
+#include "ipc_crc.h"
+
+#include <stddef.h>
+
+static const uint32_t s_crc32_nibble[16] = {
+    0x00000000UL, 0x1DB71064UL, 0x3B6E20C8UL, 0x26D930ACUL, 0x76DC4190UL, 0x6B6B51F4UL, 0x4DB26158UL, 0x5005713CUL,
+    0xEDB88320UL, 0xF00F9344UL, 0xD6D6A3E8UL, 0xCB61B38CUL, 0x9B64C2B0UL, 0x86D3D2D4UL, 0xA00AE278UL, 0xBDBDF21CUL,
+};
+
+uint32_t ipc_crc32(const void *data, uint32_t len)
+{
+  const uint8_t *p = (const uint8_t *)data;
+  uint32_t crc = 0xFFFFFFFFUL;
+
+  if (NULL == p)
+  {
+    return 0U;
+  }
+
+  for (uint32_t i = 0U; i < len; i++)
+  {
+    crc ^= p[i];
+    crc = (crc >> 4) ^ s_crc32_nibble[crc & 0x0FU];
+    crc = (crc >> 4) ^ s_crc32_nibble[crc & 0x0FU];
+  }
+
+  return crc ^ 0xFFFFFFFFUL;
+}
@@ -0,0 +1,615 @@
+/*******************************************************************************
+ * File Name        : ipc_event_bridge.c
+ *
+ * Description      : Batching, subscription registry and delivery of the
+ *                    cross-core event bridge. Posts append records to the
+ *                    filling batch under a short critical section (task or
+ *                    ISR); only the timer task sends batches, so they leave
+ *                    in the order they were filled.
+ *
+ * Author           : Asst.Prof.Santi Nuratch, Ph.D
+ *                    Thailand Embedded Systems Association (TESA)
+ *
+ *******************************************************************************/
+
+#include "ipc_event_bridge.h"
+
+#if (0 != IPC_EVENT_BRIDGE_ENABLE)
+
+#include "ipc_ring.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+#include <stddef.h>
+#include <string.h>
+
+_Static_assert((IPC_EVENT_BRIDGE_BATCH_BYTES % IPC_RING_CACHE_LINE) == 0U, "batch buffers would share cache lines");
+_Static_assert(IPC_EVENT_RECORD_LEN(IPC_EVENT_BRIDGE_PAYLOAD_MAX) <= IPC_EVENT_BRIDGE_BATCH_BYTES,
+               "largest event does not fit a batch");
+_Static_assert(IPC_EVENT_BRIDGE_BATCH_BYTES <= UINT16_MAX, "batch size does not fit ipc_event_batch_t.bytes");
+_Static_assert(IPC_EVENT_BRIDGE_BUFFERS <= 8U, "pending ack mask holds 8 buffers");
+
+typedef enum
+{
+  BRIDGE_BUF_FREE = 0U, /* Acknowledged by the peer */
+  BRIDGE_BUF_FILLING,   /* Taking records; at most one buffer */
+  BRIDGE_BUF_READY,     /* Full, or its send was refused; waiting for the flush */
+  BRIDGE_BUF_SENT       /* Descriptor sent; owned by the peer until the ack */
+} bridge_buf_state_t;
+
+/** One outgoing batch buffer. State changes happen in the critical section. */
+typedef struct
+{
+  bridge_buf_state_t state;
+  uint16_t bytes;
+  uint16_t count;
+  uint16_t batch_id; /* Set when sent */
+  uint32_t order;    /* Fill order; the flush sends the oldest first */
+} bridge_buf_t;
+
+/** A remote channel whose local subscriber state the peer has (announced) or has not yet been told. */
+typedef struct
+{
+  uint16_t channel_id;
+  bool subscribed;
+  bool announced;
+} bridge_interest_t;
+
+static ipc_event_bridge_buffers_t *s_buffers = NULL;
+static ipc_event_bridge_send_t s_send = NULL;
+static ipc_event_bridge_deliver_t s_deliver = NULL;
+static bridge_buf_t s_out[IPC_EVENT_BRIDGE_BUFFERS];
+static uint8_t s_filling = IPC_EVENT_BRIDGE_BUFFERS; /* Index of the FILLING buffer, IPC_EVENT_BRIDGE_BUFFERS if none */
+static uint32_t s_fill_order = 0U;
+static uint16_t s_batch_id = 0U;
+static uint16_t s_peer_channels[IPC_EVENT_BRIDGE_CHANNELS]; /* Channels the peer subscribes to */
+static volatile uint8_t s_peer_count = 0U;
+static bridge_interest_t s_interest[IPC_EVENT_BRIDGE_CHANNELS];
+static uint8_t s_interest_count = 0U;
+static ipc_event_batch_ack_t s_acks[IPC_EVENT_BRIDGE_BUFFERS]; /* Acks the control lane refused, by peer buffer */
+static volatile uint8_t s_acks_pending = 0U;
+static TaskHandle_t volatile s_deliver_task = NULL; /* Task walking a peer batch, and the channel it is posting */
+static volatile uint16_t s_deliver_channel = 0U;
+static TimerHandle_t s_flush_timer = NULL;
+static volatile bool s_flush_armed = false; /* Timer running or about to be; cleared by the flush */
+static ipc_event_bridge_stats_t s_stats;
+
+/**
+ * True if the peer subscribes to channel_id. Called in the critical section.
+ */
+static bool bridge_peer_subscribes(uint16_t channel_id)
+{
+  for (uint8_t i = 0U; i < s_peer_count; i++)
+  {
+    if (channel_id == s_peer_channels[i])
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * The filling buffer if record_len more bytes fit, otherwise the next free buffer, which becomes the
+ * filling one; NULL if none is free. A full filling buffer is handed to the flush and *flush_now set.
+ * Called in the critical section.
+ */
+static bridge_buf_t *bridge_fill_buffer(uint32_t record_len, bool *flush_now)
+{
+  if (s_filling < IPC_EVENT_BRIDGE_BUFFERS)
+  {
+    bridge_buf_t *buf = &s_out[s_filling];
+
+    if (((uint32_t)buf->bytes + record_len) <= IPC_EVENT_BRIDGE_BATCH_BYTES)
+    {
+      return buf;
+    }
+    buf->state = BRIDGE_BUF_READY;
+    s_filling = IPC_EVENT_BRIDGE_BUFFERS;
+    *flush_now = true;
+  }
+  for (uint8_t i = 0U; i < IPC_EVENT_BRIDGE_BUFFERS; i++)
+  {
+    if (BRIDGE_BUF_FREE == s_out[i].state)
+    {
+      s_out[i].state = BRIDGE_BUF_FILLING;
+      s_out[i].bytes = 0U;
+      s_out[i].count = 0U;
+      s_out[i].order = s_fill_order++;
+      s_filling = i;
+      return &s_out[i];
+    }
+  }
+  return NULL;
+}
+
+/**
+ * Timer task: sends the acks the control lane refused earlier. Returns false if one is still refused.
+ */
+static bool bridge_send_acks(void)
+{
+  for (uint8_t i = 0U; i < IPC_EVENT_BRIDGE_BUFFERS; i++)
+  {
+    if (0U == (s_acks_pending & (1U << i)))
+    {
+      continue;
+    }
+    if (!s_send(IPC_CMD_EVENT_BATCH_ACK, &s_acks[i], sizeof(s_acks[i])))
+    {
+      return false;
+    }
+    taskENTER_CRITICAL();
+    s_acks_pending &= (uint8_t)~(1U << i);
+    taskEXIT_CRITICAL();
+  }
+  return true;
+}
+
+/**
+ * Timer task: tells the peer about every changed interest, and forgets channels whose last local
+ * subscriber left once the peer knows. Returns false if the control lane refused a frame.
+ */
+static bool bridge_announce(void)
+{
+  uint8_t i = 0U;
+
+  while (i < s_interest_count)
+  {
+    ipc_event_subscribe_t msg;
+    bool pending;
+
+    taskENTER_CRITICAL();
+    pending = !s_interest[i].announced;
+    msg.channel_id = s_interest[i].channel_id;
+    msg.subscribed = s_interest[i].subscribed ? 1U : 0U;
+    msg.reserved = 0U;
+    taskEXIT_CRITICAL();
+
+    if (pending && !s_send(IPC_CMD_EVENT_SUBSCRIBE, &msg, sizeof(msg)))
+    {
+      return false;
+    }
+
+    taskENTER_CRITICAL();
+    /* set_interest() may have changed the entry while the frame was queued */
+    if ((0U != msg.subscribed) == s_interest[i].subscribed)
+    {
+      s_interest[i].announced = true;
+    }
+    if (s_interest[i].announced && !s_interest[i].subscribed)
+    {
+      s_interest_count--;
+      s_interest[i] = s_interest[s_interest_count];
+    }
+    else
+    {
+      i++;
+    }
+    taskEXIT_CRITICAL();
+  }
+  return true;
+}
+
+/**
+ * Timer task: the oldest buffer waiting to be sent, marked SENT with the next batch ID, or NULL. The
+ * filling buffer is taken too if it holds records.
+ */
+static bridge_buf_t *bridge_take_batch(void)
+{
+  bridge_buf_t *oldest = NULL;
+
+  taskENTER_CRITICAL();
+  for (uint8_t i = 0U; i < IPC_EVENT_BRIDGE_BUFFERS; i++)
+  {
+    bridge_buf_t *buf = &s_out[i];
+    bool waiting = (BRIDGE_BUF_READY == buf->state) || ((BRIDGE_BUF_FILLING == buf->state) && (0U < buf->count));
+
+    if (waiting && ((NULL == oldest) || ((int32_t)(buf->order - oldest->order) < 0)))
+    {
+      oldest = buf;
+    }
+  }
+  if (NULL != oldest)
+  {
+    if (&s_out[s_filling] == oldest)
+    {
+      s_filling = IPC_EVENT_BRIDGE_BUFFERS;
+    }
+    oldest->state = BRIDGE_BUF_SENT;
+    oldest->batch_id = ++s_batch_id;
+  }
+  taskEXIT_CRITICAL();
+  return oldest;
+}
+
+/**
+ * Sends pending acks, subscription changes and every waiting batch (timer task, the only sender). If
+ * a lane refuses a frame the rest waits, and the timer is armed to try again.
+ */
+static void bridge_flush(void)
+{
+  bridge_buf_t *buf;
+  bool done;
+
+  taskENTER_CRITICAL();
+  s_flush_armed = false;
+  taskEXIT_CRITICAL();
+
+  done = bridge_send_acks() && bridge_announce();
+  while (done && (NULL != (buf = bridge_take_batch())))
+  {
+    ipc_event_batch_t batch;
+    uint8_t index = (uint8_t)(buf - s_out);
+
+    batch.records = s_buffers->data[index];
+    batch.bytes = buf->bytes;
+    batch.count = buf->count;
+    batch.batch_id = buf->batch_id;
+    batch.buffer = index;
+    batch.reserved = 0U;
+    __DMB(); /* Records before the descriptor */
+    if (!s_send(IPC_CMD_EVENT_BATCH, &batch, sizeof(batch)))
+    {
+      taskENTER_CRITICAL();
+      buf->state = BRIDGE_BUF_READY;
+      taskEXIT_CRITICAL();
+      done = false;
+      break;
+    }
+    s_stats.batches_sent++;
+  }
+
+  if (!done)
+  {
+    s_stats.send_retries++;
+    s_flush_armed = true;
+    if (pdPASS != xTimerChangePeriod(s_flush_timer, IPC_EVENT_BRIDGE_FLUSH_TICKS, 0U))
+    {
+      s_flush_armed = false;
+    }
+  }
+}
+
+static void bridge_flush_timer_cb(TimerHandle_t timer)
+{
+  (void)timer;
+  bridge_flush();
+}
+
+static void bridge_flush_pended(void *param1, uint32_t param2)
+{
+  (void)param1;
+  (void)param2;
+  bridge_flush();
+}
+
+static void bridge_arm_pended(void *param1, uint32_t param2)
+{
+  (void)param1;
+  (void)param2;
+  if (pdPASS != xTimerChangePeriod(s_flush_timer, IPC_EVENT_BRIDGE_FLUSH_TICKS, 0U))
+  {
+    s_flush_armed = false;
+  }
+}
+
+/**
+ * Runs the flush in the timer task: at once, or after IPC_EVENT_BRIDGE_FLUSH_TICKS so posts of the
+ * same tick share a batch. Never waits; if the timer command queue is full the next post tries again.
+ */
+static void bridge_schedule(bool now, bool arm, bool from_isr)
+{
+  BaseType_t result;
+
+  if (now)
+  {
+    result = from_isr ? xTimerPendFunctionCallFromISR(bridge_flush_pended, NULL, 0U, NULL)
+                      : xTimerPendFunctionCall(bridge_flush_pended, NULL, 0U, 0U);
+  }
+  else if (arm)
+  {
+    result = from_isr ? xTimerPendFunctionCallFromISR(bridge_arm_pended, NULL, 0U, NULL)
+                      : xTimerChangePeriod(s_flush_timer, IPC_EVENT_BRIDGE_FLUSH_TICKS, 0U);
+  }
+  else
+  {
+    return;
+  }
+  if ((pdPASS != result) && arm)
+  {
+    s_flush_armed = false;
+  }
+}
+
+bool ipc_event_bridge_init(ipc_event_bridge_buffers_t *buffers, ipc_event_bridge_send_t send,
+                           ipc_event_bridge_deliver_t deliver)
+{
+  if ((NULL == buffers) || (NULL == send) || (NULL == deliver))
+  {
+    return false;
+  }
+  if (NULL == s_flush_timer)
+  {
+    s_flush_timer = xTimerCreate("Event Bridge", IPC_EVENT_BRIDGE_FLUSH_TICKS, pdFALSE, NULL, bridge_flush_timer_cb);
+    if (NULL == s_flush_timer)
+    {
+      return false;
+    }
+  }
+  (void)memset(s_out, 0, sizeof(s_out));
+  (void)memset(&s_stats, 0, sizeof(s_stats));
+  s_filling = IPC_EVENT_BRIDGE_BUFFERS;
+  s_peer_count = 0U;
+  s_interest_count = 0U;
+  s_acks_pending = 0U;
+  s_deliver = deliver;
+  s_send = send;
+  s_buffers = buffers;
+  return true;
+}
+
+bool ipc_event_bridge_forward(uint16_t channel_id, uint32_t event_type, const void *payload, uint32_t len,
+                              bool from_isr)
+{
+  ipc_event_record_t record;
+  uint32_t record_len = IPC_EVENT_RECORD_LEN(len);
+  UBaseType_t intr_state = 0U;
+  bool queued = false;
+  bool flush_now = false;
+  bool arm = false;
+
+  if ((NULL == s_buffers) || (0U == s_peer_count) || ((0U < len) && (NULL == payload)))
+  {
+    return false;
+  }
+  /* The local post of an event the peer sent is not sent back */
+  if (!from_isr && (channel_id == s_deliver_channel) && (xTaskGetCurrentTaskHandle() == s_deliver_task))
+  {
+    return false;
+  }
+  record.channel_id = channel_id;
+  record.len = (uint16_t)len;
+  record.event_type = event_type;
+
+  if (from_isr)
+  {
+    intr_state = taskENTER_CRITICAL_FROM_ISR();
+  }
+  else
+  {
+    taskENTER_CRITICAL();
+  }
+  if (bridge_peer_subscribes(channel_id))
+  {
+    bridge_buf_t *buf = (len <= IPC_EVENT_BRIDGE_PAYLOAD_MAX) ? bridge_fill_buffer(record_len, &flush_now) : NULL;
+
+    if (NULL != buf)
+    {
+      uint8_t *dst = &s_buffers->data[s_filling][buf->bytes];
+
+      (void)memcpy(dst, &record, sizeof(record));
+      if (0U < len)
+      {
+        (void)memcpy(dst + sizeof(record), payload, len);
+      }
+      buf->bytes = (uint16_t)(buf->bytes + record_len);
+      buf->count++;
+      s_stats.forwarded++;
+      queued = true;
+      arm = !s_flush_armed;
+      s_flush_armed = true;
+    }
+    else
+    {
+      s_stats.dropped++;
+    }
+  }
+  if (from_isr)
+  {
+    taskEXIT_CRITICAL_FROM_ISR(intr_state);
+  }
+  else
+  {
+    taskEXIT_CRITICAL();
+  }
+
+  if (!from_isr && (taskSCHEDULER_RUNNING != xTaskGetSchedulerState()))
+  {
+    return queued;
+  }
+  bridge_schedule(flush_now, arm, from_isr);
+  return queued;
+}
+
+bool ipc_event_bridge_set_interest(uint16_t channel_id, bool subscribed)
+{
+  bool changed = false;
+  bool tracked = false;
+
+  if (NULL == s_send)
+  {
+    return false;
+  }
+  taskENTER_CRITICAL();
+  for (uint8_t i = 0U; i < s_interest_count; i++)
+  {
+    if (channel_id == s_interest[i].channel_id)
+    {
+      tracked = true;
+      if (subscribed != s_interest[i].subscribed)
+      {
+        s_interest[i].subscribed = subscribed;
+        s_interest[i].announced = false;
+        changed = true;
+      }
+      break;
+    }
+  }
+  if (!tracked && subscribed && (s_interest_count < IPC_EVENT_BRIDGE_CHANNELS))
+  {
+    s_interest[s_interest_count].channel_id = channel_id;
+    s_interest[s_interest_count].subscribed = true;
+    s_interest[s_interest_count].announced = false;
+    s_interest_count++;
+    tracked = true;
+    changed = true;
+  }
+  taskEXIT_CRITICAL();
+
+  if (changed)
+  {
+    bridge_schedule(true, false, false);
+  }
+  return tracked || !subscribed;
+}
+
+void ipc_event_bridge_flush(void)
+{
+  if (NULL != s_flush_timer)
+  {
+    bridge_schedule(true, false, false);
+  }
+}
+
+void ipc_event_bridge_receive(const ipc_event_batch_t *batch)
+{
+  ipc_event_batch_ack_t ack;
+  uint32_t offset = 0U;
+
+  if ((NULL == batch) || (NULL == s_send))
+  {
+    return;
+  }
+  ack.batch_id = batch->batch_id;
+  ack.buffer = batch->buffer;
+  ack.status = IPC_EVENT_BATCH_ACK_OK;
+  if ((NULL == batch->records) || (IPC_EVENT_BRIDGE_BATCH_BYTES < batch->bytes))
+  {
+    ack.status = IPC_EVENT_BATCH_ACK_MALFORMED;
+  }
+
+  s_deliver_task = xTaskGetCurrentTaskHandle();
+  for (uint16_t n = 0U; (IPC_EVENT_BATCH_ACK_OK == ack.status) && (n < batch->count); n++)
+  {
+    ipc_event_record_t record;
+    uint32_t record_len;
+
+    if ((offset + sizeof(record)) > batch->bytes)
+    {
+      ack.status = IPC_EVENT_BATCH_ACK_MALFORMED;
+      break;
+    }
+    (void)memcpy(&record, &batch->records[offset], sizeof(record));
+    record_len = IPC_EVENT_RECORD_LEN(record.len);
+    if ((IPC_EVENT_BRIDGE_PAYLOAD_MAX < record.len) || ((offset + record_len) > batch->bytes))
+    {
+      ack.status = IPC_EVENT_BATCH_ACK_MALFORMED;
+      break;
+    }
+    s_deliver_channel = record.channel_id;
+    if (s_deliver(record.channel_id, record.event_type,
+                  (0U < record.len) ? &batch->records[offset + sizeof(record)] : NULL, record.len))
+    {
+      s_stats.received++;
+    }
+    else
+    {
+      s_stats.undelivered++;
+    }
+    offset += record_len;
+  }
+  s_deliver_task = NULL;
+  s_deliver_channel = 0U;
+
+  s_stats.batches_received++;
+  if (IPC_EVENT_BATCH_ACK_OK != ack.status)
+  {
+    s_stats.malformed++;
+  }
+  if (!s_send(IPC_CMD_EVENT_BATCH_ACK, &ack, sizeof(ack)) && (ack.buffer < IPC_EVENT_BRIDGE_BUFFERS))
+  {
+    s_acks[ack.buffer] = ack;
+    taskENTER_CRITICAL();
+    s_acks_pending |= (uint8_t)(1U << ack.buffer);
+    taskEXIT_CRITICAL();
+    bridge_schedule(true, false, false);
+  }
+}
+
+void ipc_event_bridge_on_ack(const ipc_event_batch_ack_t *ack)
+{
+  bool waiting = false;
+
+  if ((NULL == ack) || (IPC_EVENT_BRIDGE_BUFFERS <= ack->buffer))
+  {
+    return;
+  }
+  taskENTER_CRITICAL();
+  if ((BRIDGE_BUF_SENT == s_out[ack->buffer].state) && (ack->batch_id == s_out[ack->buffer].batch_id))
+  {
+    s_out[ack->buffer].state = BRIDGE_BUF_FREE;
+    for (uint8_t i = 0U; i < IPC_EVENT_BRIDGE_BUFFERS; i++)
+    {
+      waiting = waiting || (BRIDGE_BUF_READY == s_out[i].state);
+    }
+  }
+  taskEXIT_CRITICAL();
+
+  /* A full batch was held back while every buffer was in flight */
+  if (waiting)
+  {
+    bridge_schedule(true, false, false);
+  }
+}
+
+void ipc_event_bridge_on_subscribe(const ipc_event_subscribe_t *subscribe)
+{
+  if (NULL == subscribe)
+  {
+    return;
+  }
+  taskENTER_CRITICAL();
+  for (uint8_t i = 0U; i < s_peer_count; i++)
+  {
+    if (subscribe->channel_id == s_peer_channels[i])
+    {
+      if (0U == subscribe->subscribed)
+      {
+        s_peer_count--;
+        s_peer_channels[i] = s_peer_channels[s_peer_count];
+      }
+      taskEXIT_CRITICAL();
+      return;
+    }
+  }
+  if ((0U != subscribe->subscribed) && (s_peer_count < IPC_EVENT_BRIDGE_CHANNELS))
+  {
+    s_peer_channels[s_peer_count] = subscribe->channel_id;
+    s_peer_count++;
+  }
+  taskEXIT_CRITICAL();
+}
+
+bool ipc_event_bridge_get_stats(ipc_event_bridge_stats_t *stats)
+{
+  if (NULL == stats)
+  {
+    return false;
+  }
+  taskENTER_CRITICAL();
+  (void)memcpy(stats, &s_stats, sizeof(*stats));
+  stats->peer_channels = s_peer_count;
+  stats->local_channels = 0U;
+  for (uint8_t i = 0U; i < s_interest_count; i++)
+  {
+    if (s_interest[i].subscribed)
+    {
+      stats->local_channels++;
+    }
+  }
+  taskEXIT_CRITICAL();
+  return true;
+}
+
+#endif /* IPC_EVENT_BRIDGE_ENABLE */
@@ -0,0 +1,47 @@
+/*******************************************************************************
+ * File Name        : ipc_lane.c
+ *
+ * Description      : Command-to-lane mapping, cycle-counter timebase and
+ *                    lane names for the IPC send path.
+ *
+ * Author           : Asst.Prof.Santi Nuratch, Ph.D
+ *                    Thailand Embedded Systems Association (TESA)
+ *
+ *******************************************************************************/
+
+#include "ipc_lane.h"
+#include "ipc_cmd.h"
+
+ipc_lane_t ipc_lane_of(uint32_t cmd)
+{
+  const ipc_cmd_info_t *info = ipc_cmd_info(cmd);
+
+  return (NULL != info) ? info->lane : IPC_LANE_BULK;
+}
+
+void ipc_lane_timebase_init(void)
+{
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+uint32_t ipc_lane_stamp(void)
+{
+  return DWT->CYCCNT;
+}
+
+uint32_t ipc_lane_elapsed_us(uint32_t stamp)
+{
+  uint32_t cycles_per_us = SystemCoreClock / 1000000U;
+
+  if (0U == cycles_per_us)
+  {
+    cycles_per_us = 1U;
+  }
+  return (ipc_lane_stamp() - stamp) / cycles_per_us;
+}
+
+const char *ipc_lane_name(ipc_lane_t lane)
+{
+  return (IPC_LANE_CONTROL == lane) ? "control" : "bulk";
+}
@@ -0,0 +1,251 @@
+/*******************************************************************************
+ * File Name        : ipc_liveness.c
+ *
+ * Description      : Liveness records and the lazy peer monitor. The owner
+ *                    only increments a counter in its own cache line; the
+ *                    checker keeps everything else in local memory.
+ *
+ * Author           : Asst.Prof.Santi Nuratch, Ph.D
+ *                    Thailand Embedded Systems Association (TESA)
+ *
+ *******************************************************************************/
+
+#include "ipc_liveness.h"
+#include "ipc_ring.h"
+#include "ipc_stats.h"
+
+#include <stddef.h>
+#include <string.h>
+
+_Static_assert(sizeof(ipc_liveness_t) == IPC_LIVENESS_RECORD_BYTES, "liveness record is not RECORD_BYTES");
+_Static_assert((IPC_LIVENESS_RECORD_BYTES % IPC_RING_CACHE_LINE) == 0U, "liveness record would share a cache line");
+
+static const char *const s_state_names[] = {
+    [IPC_LIVENESS_DOWN] = "down",
+    [IPC_LIVENESS_IDLE] = "idle",
+    [IPC_LIVENESS_BUSY] = "busy",
+    [IPC_LIVENESS_FAULT] = "fault",
+};
+
+void ipc_liveness_init(ipc_liveness_t *self)
+{
+  if (NULL == self)
+  {
+    return;
+  }
+  (void)memset(self, 0, sizeof(*self));
+  __DMB();
+}
+
+/**
+ * Advances the counter. A fatal error handler may interrupt the task mid-beat, so the update runs
+ * with interrupts masked and never overwrites IPC_LIVENESS_FAULT.
+ */
+static void ipc_liveness_advance(ipc_liveness_t *self, ipc_liveness_state_t state)
+{
+  uint32_t stamp_us = ipc_stats_now_us();
+  uint32_t intr_state = Cy_SysLib_EnterCriticalSection();
+
+  if ((uint32_t)IPC_LIVENESS_FAULT != self->state)
+  {
+    self->state = (uint32_t)state;
+  }
+  self->stamp_us = stamp_us;
+  __DMB();
+  self->counter = self->counter + 1U;
+  Cy_SysLib_ExitCriticalSection(intr_state);
+}
+
+void ipc_liveness_beat(ipc_liveness_t *self, ipc_liveness_state_t state)
+{
+  if (NULL != self)
+  {
+    ipc_liveness_advance(self, state);
+  }
+}
+
+void ipc_liveness_fault(ipc_liveness_t *self)
+{
+  if (NULL == self)
+  {
+    return;
+  }
+  self->faults = self->faults + 1U;
+  self->state = (uint32_t)IPC_LIVENESS_FAULT;
+  __DMB();
+  self->counter = self->counter + 1U;
+}
+
+void ipc_liveness_monitor_init(ipc_liveness_monitor_t *monitor, const ipc_liveness_config_t *config)
+{
+  if (NULL == monitor)
+  {
+    return;
+  }
+  (void)memset(monitor, 0, sizeof(*monitor));
+  ipc_liveness_monitor_configure(monitor, config);
+}
+
+void ipc_liveness_monitor_configure(ipc_liveness_monitor_t *monitor, const ipc_liveness_config_t *config)
+{
+  ipc_liveness_config_t applied = { 0U, 0U, NULL, NULL };
+
+  if (NULL == monitor)
+  {
+    return;
+  }
+  if (NULL != config)
+  {
+    applied = *config;
+  }
+  if (0U == applied.late_ms)
+  {
+    applied.late_ms = IPC_LIVENESS_LATE_MS_DEFAULT;
+  }
+  if (0U == applied.stall_ms)
+  {
+    applied.stall_ms = IPC_LIVENESS_STALL_MS_DEFAULT;
+  }
+  if (applied.stall_ms < applied.late_ms)
+  {
+    applied.stall_ms = applied.late_ms;
+  }
+  monitor->config = applied;
+}
+
+void ipc_liveness_monitor_attach(ipc_liveness_monitor_t *monitor, const ipc_liveness_t *peer)
+{
+  if ((NULL != monitor) && (NULL != peer))
+  {
+    monitor->peer = peer;
+  }
+}
+
+/**
+ * Reports event with the current status.
+ */
+static void ipc_liveness_report(ipc_liveness_monitor_t *monitor, ipc_liveness_event_t event)
+{
+  if (NULL != monitor->config.cb)
+  {
+    monitor->config.cb(event, &monitor->status, monitor->config.user_data);
+  }
+}
+
+/**
+ * Ends a LATE or STALLED episode.
+ */
+static void ipc_liveness_recover(ipc_liveness_monitor_t *monitor)
+{
+  bool report = monitor->late || monitor->status.stalled;
+
+  monitor->late = false;
+  monitor->status.stalled = false;
+  if (report)
+  {
+    ipc_liveness_report(monitor, IPC_LIVENESS_EVENT_RECOVERED);
+  }
+}
+
+bool ipc_liveness_check(ipc_liveness_monitor_t *monitor, uint32_t now_ms, bool waiting)
+{
+  const ipc_liveness_t *peer;
+  uint32_t counter;
+  uint32_t state;
+  bool owed;
+
+  if (NULL == monitor)
+  {
+    return false;
+  }
+  peer = monitor->peer;
+  if (NULL == peer)
+  {
+    return true;
+  }
+
+  counter = peer->counter;
+  __DMB();
+  state = peer->state;
+  monitor->status.attached = true;
+  monitor->status.counter = counter;
+  monitor->status.state = (ipc_liveness_state_t)state;
+  monitor->status.stamp_us = peer->stamp_us;
+
+  if ((uint32_t)IPC_LIVENESS_FAULT == state)
+  {
+    monitor->status.silent_ms = 0U;
+    if (!monitor->status.stalled)
+    {
+      monitor->status.stalled = true;
+      ipc_liveness_report(monitor, IPC_LIVENESS_EVENT_FAULT);
+    }
+    return false;
+  }
+
+  owed = waiting || ((uint32_t)IPC_LIVENESS_BUSY == state);
+  if ((counter != monitor->seen_counter) || !owed)
+  {
+    /* The peer moved on, or owes nothing: a new silence starts now */
+    monitor->seen_counter = counter;
+    monitor->since_ms = now_ms;
+    monitor->owed = owed;
+    monitor->status.silent_ms = 0U;
+    ipc_liveness_recover(monitor);
+    return true;
+  }
+  if (!monitor->owed)
+  {
+    /* Owed from this check on (the peer went busy earlier, or the caller just started waiting) */
+    monitor->owed = true;
+    monitor->since_ms = now_ms;
+  }
+
+  monitor->status.silent_ms = now_ms - monitor->since_ms;
+  if ((monitor->status.silent_ms >= monitor->config.stall_ms) && !monitor->status.stalled)
+  {
+    monitor->status.stalled = true;
+    monitor->status.stalls++;
+    ipc_liveness_report(monitor, IPC_LIVENESS_EVENT_STALLED);
+  }
+  else if ((monitor->status.silent_ms >= monitor->config.late_ms) && !monitor->late)
+  {
+    monitor->late = true;
+    monitor->status.late++;
+    ipc_liveness_report(monitor, IPC_LIVENESS_EVENT_LATE);
+  }
+  return !monitor->status.stalled;
+}
+
+uint32_t ipc_liveness_next_check_ms(const ipc_liveness_monitor_t *monitor, uint32_t now_ms)
+{
+  uint32_t silent_ms;
+  uint32_t threshold;
+
+  if ((NULL == monitor) || !monitor->owed || monitor->status.stalled)
+  {
+    return 0U;
+  }
+  silent_ms = now_ms - monitor->since_ms;
+  threshold = monitor->late ? monitor->config.stall_ms : monitor->config.late_ms;
+  return (silent_ms < threshold) ? (threshold - silent_ms) : 1U;
+}
+
+bool ipc_liveness_get_status(const ipc_liveness_monitor_t *monitor, ipc_liveness_status_t *status)
+{
+  if ((NULL == monitor) || (NULL == status))
+  {
+    return false;
+  }
+  (void)memcpy(status, &monitor->status, sizeof(*status));
+  return true;
+}
+
+const char *ipc_liveness_state_name(uint32_t state)
+{
+  if (state >= (uint32_t)(sizeof(s_state_names) / sizeof(s_state_names[0])))
+  {
+    return "?";
+  }
+  return s_state_names[state];
+}
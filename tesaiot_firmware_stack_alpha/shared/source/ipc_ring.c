@@ -0,0 +1,223 @@
+/*******************************************************************************
+ * File Name        : ipc_ring.c
+ *
+ * Description      : Lock-free SPSC frame ring shared by CM33 and CM55.
+ *                    Ordering between frame contents and the head/tail indices
+ *                    is enforced with data memory barriers; no locks and no
+ *                    IPC semaphores are taken.
+ *
+ * Author           : Asst.Prof.Santi Nuratch, Ph.D
+ *                    Thailand Embedded Systems Association (TESA)
+ *
+ *******************************************************************************/
+
+#include "ipc_ring.h"
+
+#include <stddef.h>
+
+#define IPC_RING_MASK (IPC_RING_BYTES - 1U)
+#define IPC_RING_ROUND_UP(n) (((n) + (IPC_RING_ALIGN - 1U)) & ~(IPC_RING_ALIGN - 1U))
+
+void ipc_ring_init(ipc_ring_t *ring)
+{
+  if (NULL == ring)
+  {
+    return;
+  }
+  ring->head = 0U;
+  ring->credit_wait = 0U;
+  ring->tail = 0U;
+  ring->credits = 0U;
+  ring->backlog = 0U;
+  ring->backlog_peak = 0U;
+  __DMB();
+}
+
+ipc_msg_t *ipc_ring_claim(ipc_ring_t *ring, uint32_t frame_len)
+{
+  uint32_t head = ring->head;
+  uint32_t offset = head & IPC_RING_MASK;
+  uint32_t to_end = IPC_RING_BYTES - offset;
+  uint32_t span = IPC_RING_ROUND_UP(frame_len);
+  uint32_t needed = (span <= to_end) ? span : (to_end + span);
+
+  /* Tail is read before the space is reused: the consumer is done with it. */
+  if ((frame_len > sizeof(ipc_msg_t)) || ((IPC_RING_BYTES - (head - ring->tail)) < needed))
+  {
+    return NULL;
+  }
+  __DMB();
+
+  if (span > to_end)
+  {
+    /* Skip the tail end of buf[]; the consumer steps over it without a filler when no header fits. */
+    if (to_end >= IPC_MSG_HDR_LEN)
+    {
+      ((ipc_msg_t *)&ring->buf[offset])->cmd = IPC_RING_PAD_CMD;
+    }
+    __DMB();
+    ring->head = head + to_end;
+    offset = 0U;
+  }
+
+  return (ipc_msg_t *)&ring->buf[offset];
+}
+
+void ipc_ring_commit(ipc_ring_t *ring, uint32_t frame_len)
+{
+  /* Frame contents must land before the new head is visible to the peer. */
+  __DMB();
+  ring->head = ring->head + IPC_RING_ROUND_UP(frame_len);
+}
+
+const ipc_msg_t *ipc_ring_peek(ipc_ring_t *ring)
+{
+  uint32_t tail = ring->tail;
+
+  while (tail != ring->head)
+  {
+    uint32_t offset = tail & IPC_RING_MASK;
+    uint32_t to_end = IPC_RING_BYTES - offset;
+    const ipc_msg_t *msg = (const ipc_msg_t *)&ring->buf[offset];
+
+    /* Head was read before the frame: its contents are published. */
+    __DMB();
+    if ((to_end < IPC_MSG_HDR_LEN) || (IPC_RING_PAD_CMD == msg->cmd))
+    {
+      tail += to_end;
+      ring->tail = tail;
+      continue;
+    }
+    return msg;
+  }
+
+  return NULL;
+}
+
+void ipc_ring_release(ipc_ring_t *ring)
+{
+  uint32_t tail = ring->tail;
+  const ipc_msg_t *msg = (const ipc_msg_t *)&ring->buf[tail & IPC_RING_MASK];
+
+  /* Finish reading the frame before the producer may overwrite it. */
+  __DMB();
+  ring->tail = tail + IPC_RING_FRAME_SPAN(msg->len);
+}
+
+bool ipc_ring_is_empty(const ipc_ring_t *ring)
+{
+  if (NULL == ring)
+  {
+    return true;
+  }
+  return (ring->head == ring->tail);
+}
+
+uint32_t ipc_ring_used(const ipc_ring_t *ring)
+{
+  if (NULL == ring)
+  {
+    return 0U;
+  }
+  return ring->head - ring->tail;
+}
+
+bool ipc_ring_credit_acquire(ipc_ring_t *ring, uint32_t sent, uint32_t window)
+{
+  if ((sent - ring->credits) < window)
+  {
+    if (0U != ring->credit_wait)
+    {
+      ring->credit_wait = 0U;
+    }
+    return true;
+  }
+
+  /* Publish the wait before re-reading credits; pairs with the barrier in ipc_ring_credit_return(). */
+  ring->credit_wait = 1U;
+  __DMB();
+  if ((sent - ring->credits) < window)
+  {
+    ring->credit_wait = 0U;
+    return true;
+  }
+  return false;
+}
+
+bool ipc_ring_credit_return(ipc_ring_t *ring, uint32_t count)
+{
+  if ((NULL == ring) || (0U == count))
+  {
+    return false;
+  }
+  ring->credits = ring->credits + count;
+  __DMB();
+  return (0U != ring->credit_wait);
+}
+
+bool ipc_ring_credit_waiting(const ipc_ring_t *ring)
+{
+  if (NULL == ring)
+  {
+    return false;
+  }
+  return (0U != ring->credit_wait);
+}
+
+void ipc_ring_set_backlog(ipc_ring_t *ring, uint32_t backlog)
+{
+  if (NULL == ring)
+  {
+    return;
+  }
+  ring->backlog = backlog;
+  if (backlog > ring->backlog_peak)
+  {
+    ring->backlog_peak = backlog;
+  }
+}
+
+void ipc_ring_reset_backlog_peak(ipc_ring_t *ring)
+{
+  if (NULL == ring)
+  {
+    return;
+  }
+  ring->backlog_peak = ring->backlog;
+}
+
+uint32_t ipc_ring_backlog(const ipc_ring_t *ring, uint32_t *peak)
+{
+  if (NULL == ring)
+  {
+    if (NULL != peak)
+    {
+      *peak = 0U;
+    }
+    return 0U;
+  }
+  if (NULL != peak)
+  {
+    *peak = ring->backlog_peak;
+  }
+  return ring->backlog;
+}
+
+bool ipc_ring_backlog_below(ipc_ring_t *ring, uint32_t limit)
+{
+  if (ring->backlog < limit)
+  {
+    return true;
+  }
+
+  /* Same handshake as ipc_ring_credit_acquire(): the consumer lowers backlog before returning the
+   * credit that rings us, so a drop between the two reads is not missed. */
+  ring->credit_wait = 1U;
+  __DMB();
+  if (ring->backlog < limit)
+  {
+    ring->credit_wait = 0U;
+    return true;
+  }
+  return false;
+}
@@ -0,0 +1,233 @@
+/*******************************************************************************
+ * File Name        : ipc_stats.c
+ *
+ * Description      : Shared IPC timebase, log2 latency histograms and
+ *                    per-command pipe counters. Each core links its own copy;
+ *                    only the clock offset ties the two together.
+ *
+ * Author           : Asst.Prof.Santi Nuratch, Ph.D
+ *                    Thailand Embedded Systems Association (TESA)
+ *
+ *******************************************************************************/
+
+#include "ipc_stats.h"
+#include "FreeRTOS.h"
+#include "ipc_lane.h"
+#include "task.h"
+
+#include <stddef.h>
+#include <string.h>
+
+static uint32_t s_clock_cycles = 0U; /* ipc_lane_stamp() at the last clock update */
+static TickType_t s_clock_tick = 0U;  /* RTOS tick count at the last clock update */
+static uint32_t s_clock_rem = 0U;    /* Cycles not yet folded into s_clock_us */
+static uint32_t s_clock_us = 0U;     /* Local microseconds */
+static volatile int32_t s_offset_us = 0;
+static uint32_t s_sync_best_rtt_us = 0U;
+static ipc_stats_sync_t s_sync;
+static ipc_stats_cmd_t s_cmd_stats[IPC_STATS_CMD_SLOTS];
+
+/**
+ * Slot of a command: one per ID in IPC_STATS_CMD_FIRST..IPC_STATS_CMD_LAST, the last for the rest.
+ */
+static ipc_stats_cmd_t *ipc_stats_slot(uint32_t cmd)
+{
+  if ((cmd < IPC_STATS_CMD_FIRST) || (cmd > IPC_STATS_CMD_LAST))
+  {
+    return &s_cmd_stats[IPC_STATS_CMD_SLOTS - 1U];
+  }
+  return &s_cmd_stats[cmd - IPC_STATS_CMD_FIRST];
+}
+
+/**
+ * Local microseconds. The cycle counter wraps every 2^32 cycles (about 10 s on CM55), so the clock is
+ * advanced by the cycles elapsed since the previous call, carrying the sub-microsecond remainder. The
+ * RTOS tick count elapsed since then tells how many whole wraps the counter went through, so the
+ * clock needs no periodic call to stay right.
+ */
+static uint32_t ipc_stats_local_us(void)
+{
+  uint32_t cycles_per_us = SystemCoreClock / 1000000U;
+  uint32_t intr_state;
+  uint32_t now;
+  TickType_t tick;
+  uint64_t cycles;
+  uint64_t expected;
+  uint32_t us;
+
+  if (0U == cycles_per_us)
+  {
+    cycles_per_us = 1U;
+  }
+
+  intr_state = Cy_SysLib_EnterCriticalSection();
+  now = ipc_lane_stamp();
+  tick = xTaskGetTickCountFromISR();
+  cycles = (uint64_t)(now - s_clock_cycles);
+  expected = (uint64_t)(TickType_t)(tick - s_clock_tick) * (SystemCoreClock / configTICK_RATE_HZ);
+  if (expected > cycles)
+  {
+    /* Add the whole wraps nearest to what the ticks say; tick granularity is far below half a wrap */
+    cycles += ((expected - cycles + IPC_STATS_CLOCK_HALF_WRAP) >> 32) << 32;
+  }
+  cycles += s_clock_rem;
+  s_clock_cycles = now;
+  s_clock_tick = tick;
+  s_clock_us += (uint32_t)(cycles / cycles_per_us);
+  s_clock_rem = (uint32_t)(cycles % cycles_per_us);
+  us = s_clock_us;
+  Cy_SysLib_ExitCriticalSection(intr_state);
+
+  return us;
+}
+
+uint32_t ipc_stats_now_us(void)
+{
+  return ipc_stats_local_us() + (uint32_t)s_offset_us;
+}
+
+void ipc_stats_sync_sample(uint32_t t0_us, uint32_t t1_us, uint32_t t2_us, uint32_t t3_us)
+{
+  int32_t out = (int32_t)(t1_us - t0_us);  /* Request transit plus our clock error */
+  int32_t back = (int32_t)(t3_us - t2_us); /* Reply transit minus our clock error */
+  uint32_t rtt = ((out + back) > 0) ? (uint32_t)(out + back) : 0U;
+
+  s_sync.samples++;
+  if ((0U != s_sync.accepted) && (rtt > (s_sync_best_rtt_us + IPC_STATS_SYNC_RTT_SLACK_US)))
+  {
+    /* Delayed by queueing on either side; relax the bar a little so a slower link still syncs */
+    s_sync_best_rtt_us += IPC_STATS_SYNC_RTT_SLACK_US;
+    return;
+  }
+
+  s_offset_us += (out - back) / 2;
+  s_sync.offset_us = s_offset_us;
+  s_sync.rtt_us = rtt;
+  if ((0U == s_sync.accepted) || (rtt < s_sync_best_rtt_us))
+  {
+    s_sync_best_rtt_us = rtt;
+  }
+  s_sync.accepted++;
+}
+
+bool ipc_stats_get_sync(ipc_stats_sync_t *sync)
+{
+  if (NULL == sync)
+  {
+    return false;
+  }
+  (void)memcpy(sync, &s_sync, sizeof(*sync));
+  sync->offset_us = s_offset_us;
+  return true;
+}
+
+void ipc_stats_hist_record(ipc_stats_hist_t *hist, uint32_t latency_us)
+{
+  uint32_t bucket = 0U;
+
+  if (NULL == hist)
+  {
+    return;
+  }
+  while ((latency_us >> bucket) != 0U)
+  {
+    bucket++;
+  }
+  if (bucket >= IPC_STATS_HIST_BUCKETS)
+  {
+    bucket = IPC_STATS_HIST_BUCKETS - 1U;
+  }
+
+  hist->hist[bucket]++;
+  hist->count++;
+  if (latency_us > hist->max_us)
+  {
+    hist->max_us = latency_us;
+  }
+}
+
+uint32_t ipc_stats_hist_percentile(const ipc_stats_hist_t *hist, uint32_t percent)
+{
+  uint32_t total = 0U;
+  uint32_t target;
+  uint32_t seen = 0U;
+
+  if ((NULL == hist) || (0U == percent))
+  {
+    return 0U;
+  }
+  for (uint32_t i = 0U; i < IPC_STATS_HIST_BUCKETS; i++)
+  {
+    total += hist->hist[i];
+  }
+  if (0U == total)
+  {
+    return 0U;
+  }
+
+  target = (uint32_t)((((uint64_t)total * ((percent > 100U) ? 100U : percent)) + 99U) / 100U);
+  for (uint32_t i = 0U; i < IPC_STATS_HIST_BUCKETS; i++)
+  {
+    seen += hist->hist[i];
+    if (seen >= target)
+    {
+      uint32_t upper = (0U == i) ? 0U : ((1UL << i) - 1U);
+      return ((i == (IPC_STATS_HIST_BUCKETS - 1U)) || (upper > hist->max_us)) ? hist->max_us : upper;
+    }
+  }
+  return hist->max_us;
+}
+
+void ipc_stats_on_drop(uint32_t cmd)
+{
+  ipc_stats_slot(cmd)->dropped++;
+}
+
+void ipc_stats_on_send(uint32_t cmd, uint32_t queue_us)
+{
+  ipc_stats_cmd_t *slot = ipc_stats_slot(cmd);
+
+  slot->sent++;
+  ipc_stats_hist_record(&slot->queue, queue_us);
+}
+
+uint32_t ipc_stats_on_receive(uint32_t cmd, uint32_t sent_us, uint32_t len)
+{
+  ipc_stats_cmd_t *slot = ipc_stats_slot(cmd);
+  uint32_t now = ipc_stats_now_us();
+  int32_t transit = (int32_t)(now - sent_us);
+
+  slot->received++;
+  slot->received_bytes += len;
+  /* Until CM55 has synced, or within the offset error, a transit can come out slightly negative */
+  ipc_stats_hist_record(&slot->transit, (transit > 0) ? (uint32_t)transit : 0U);
+  return now;
+}
+
+void ipc_stats_on_dispatch(uint32_t cmd, uint32_t rx_us)
+{
+  ipc_stats_hist_record(&ipc_stats_slot(cmd)->dispatch, ipc_stats_now_us() - rx_us);
+}
+
+void ipc_stats_on_overflow(uint32_t cmd)
+{
+  ipc_stats_slot(cmd)->overflows++;
+}
+
+bool ipc_stats_get(uint32_t cmd, ipc_stats_cmd_t *stats)
+{
+  if (NULL == stats)
+  {
+    return false;
+  }
+  (void)memcpy(stats, ipc_stats_slot(cmd), sizeof(*stats));
+  return true;
+}
+
+void ipc_stats_reset(void)
+{
+  uint32_t intr_state = Cy_SysLib_EnterCriticalSection();
+
+  (void)memset(s_cmd_stats, 0, sizeof(s_cmd_stats));
+  Cy_SysLib_ExitCriticalSection(intr_state);
+}